@@ -190,7 +190,17 @@ public:
     OCP_DBL GetWellDg(const USI& w, const USI& p) const { return wells[w].dG[p]; }
     OCP_DBL CalWellQT();
     void ShowWellStatus(const Bulk& myBulk) { for (USI w = 0; w < numWell; w++) wells[w].ShowPerfStatus(myBulk); }
+    /// Save or load the states of wells and field rates.
+    void SyncCheckpoint(OCPCheckpoint& ckpt);
     bool GetWellChange() const { return wellChange; }
+    /// Return true if reinjection exists in some well group.
+    bool GetReinjection() const
+    {
+        for (const auto& wG : wellGroup) {
+            if (wG.reInj) return true;
+        }
+        return false;
+    }
 
 private:
     USI          numWell;   ///< num of wells.
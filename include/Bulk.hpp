@@ -16,6 +16,10 @@
 #include <iostream>
 #include <vector>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 // OpenCAEPoro header files
 #include "DenseMat.hpp"
 #include "FlowUnit.hpp"
@@ -48,6 +52,19 @@ private:
     OCPTable PBVD; ///< PBVD Table: bubble point pressere vs depth
 };
 
+/// Groups of bulk variables, which are saved by UpdateLastStepFIM and restored by
+/// ResetFIM only if they have been changed since then.
+const USI BULK_PRIMARY = 1;  ///< P, Ni
+const USI BULK_FLASH   = 2;  ///< Results of flash and their derivatives
+const USI BULK_KRPC    = 4;  ///< Kr, Pc, Pj and their derivatives
+const USI BULK_VPORE   = 8;  ///< Pore volume
+const USI BULK_ALL     = 15; ///< All groups
+
+/// Num of bulks handed to a FlowUnit by one batched call of kr and Pc.
+const OCP_USI KRPC_CHUNK = 256;
+/// Num of bulks handed to a Mixture by one batched flash call.
+const OCP_USI FLASH_CHUNK = 64;
+
 /// Physical information of each active reservoir bulk.
 //  Note: Bulk contains main physical infomation of active grids. It describes the
 //  actural geometric domain for simulating. Variables are stored bulk by bulk, and then
@@ -95,6 +112,9 @@ public:
     void FlashCOMP();
     /// Perform flash calculation with Ni and calculate derivatives.
     void FlashDeriv();
+    /// Calculate fugacities of the hydrocarbon phases of each bulk, used by ocp_bench.
+    /// If ref is true, the expression before Aik was kept is used.
+    void CalFugPhiBulks(const bool& ref);
     void FlashDeriv_n();
     /// Perform flash calculation with Ni in Black Oil Model
     void FlashDerivBLKOIL();
@@ -102,13 +122,41 @@ public:
     /// Perform flash calculation with Ni in Compositional Model
     void FlashDerivCOMP();
     void FlashDerivCOMP_n();
+    /// Perform flash calculation with Ni and derivatives region by region in chunks.
+    void FlashDerivRegions();
+    /// Perform FlashDeriv of mix on the listed bulks and pass the results to Bulk,
+    /// NR diagnostics of saturations of these bulks are kept in the given slot.
+    //  Note: It is called by Mixture::FlashDerivBatch with Mix the class of mix, so
+    //  FlashDeriv is called directly rather than virtually for each bulk.
+    template <typename Mix, bool comp>
+    void FlashDerivBulks(Mix&           mix,
+                         const OCP_USI* bulks,
+                         const OCP_USI& num,
+                         const OCP_USI& slot);
     /// determine which flash type will be used
     USI  CalFlashType(const OCP_USI& n) const;
+    /// Return the flash class of PVT region used by the calling thread, which is
+    /// flashCal outside parallel regions.
+    Mixture* ThreadFlash(const USI& pvtnum) const
+    {
+#ifdef _OPENMP
+        if (omp_get_level() > 0) return flashCalT[omp_get_thread_num()][pvtnum];
+#endif
+        return flashCal[pvtnum];
+    }
     /// Pass values from Flash to Bulk after Flash calculation.
     void PassFlashValue(const OCP_USI& n);
     void PassFlashValueAIMc(const OCP_USI& n);
     /// Pass derivative values from Flash to Bulk after Flash calculation.
     void PassFlashValueDeriv(const OCP_USI& n);
+    /// Pass derivative values from mix to bulk n, the NR diagnostics of saturations
+    /// are accumulated into dSSP, maxdSSP and imaxdSSP.
+    void PassFlashValueDeriv(const OCP_USI& n, Mixture* mix, OCP_DBL& dSSP,
+                             OCP_DBL& maxdSSP, OCP_USI& imaxdSSP);
+    /// Merge the NR diagnostics of saturations of a group of bulks, which is called
+    /// outside parallel regions.
+    void MergeNRdSSP(const OCP_DBL& dSSP, const OCP_DBL& maxdSSP,
+                     const OCP_USI& imaxdSSP);
     void PassFlashValueDeriv_n(const OCP_USI& n);
     /// Reset variables in flash calculations.
     void ResetFlash();
@@ -117,6 +165,8 @@ public:
     void CalKrPc();
     /// Calculate relative permeability and capillary pressure and their derivatives.
     void CalKrPcDeriv();
+    /// Calculate kr and Pc, with derivatives if deriv, region by region in chunks.
+    void CalKrPcRegions(const bool& deriv);
     /// Calculate volume of pore with pressure.
     void CalVpore();
     /// Calculate average pressure in reservoir.
@@ -209,6 +259,8 @@ public:
     void AllocateWellBulkId(const USI& n) { wellBulkId.reserve(n); }
     void ClearWellBulkId() { wellBulkId.clear(); }
     OCP_DBL CalNT() { NT = Dnorm1(numBulk, &Nt[0]);  return NT;   }
+    /// Save or load the dynamic variables of bulks.
+    void SyncCheckpoint(OCPCheckpoint& ckpt);
     
 
 private:
@@ -233,10 +285,15 @@ private:
 
     USI               PVTmode;  ///< Identify PVT mode in blackoil model.
     vector<USI>       PVTNUM;   ///< Identify PVT region in blackoil model: numBulk.
+    vector<OCP_USI>   pvtCell;  ///< Bulks sorted by PVT region: numBulk.
+    vector<OCP_USI>   pvtBegin; ///< Bulks of region i are pvtCell[pvtBegin[i], pvtBegin[i+1]).
     USI               NTPVT;    ///< num of PVT regions
     vector<Mixture*>  flashCal; ///< Flash calculation class.
+    vector<vector<Mixture*>> flashCalT; ///< Copies of flashCal for threads of parallel regions.
     USI               SATmode;  ///< Identify SAT mode.
     vector<USI>       SATNUM;   ///< Identify SAT region: numBulk.
+    vector<OCP_USI>   satCell;  ///< Bulks sorted by SAT region: numBulk.
+    vector<OCP_USI>   satBegin; ///< Bulks of region i are satCell[satBegin[i], satBegin[i+1]).
     USI               NTSFUN;   ///< num of SAT regions
     vector<FlowUnit*> flow;     ///< Vector for capillary pressure, relative perm.
     vector<vector<OCP_DBL>> satcm; ///< critical saturation when phase becomes mobile / immobile.
@@ -413,9 +470,9 @@ public:
     void CalRelResFIM(ResFIM& resFIM) const;
     // Show Res
     void ShowRes(const vector<OCP_DBL>& res) const;
-    /// Reset FIM.
+    /// Reset FIM, only changed groups of variables are restored.
     void ResetFIM();
-    /// Update values of last step for FIM.
+    /// Update values of last step for FIM, only changed groups of variables are saved.
     void UpdateLastStepFIM();
     /// Calculate some auxiliary variable, for example, dSmax
     OCP_DBL CalNRdSmax(OCP_USI& index);
@@ -464,6 +521,8 @@ private:
     vector<OCP_USI> lresIndex;   ///< last res_n
     vector<USI>     lpEnumCom;   ///< last pEnumCom
 
+    USI varChanged{BULK_ALL}; ///< Groups changed since last UpdateLastStepFIM or ResetFIM
+
 
     vector<OCP_DBL> dSNR;        ///< saturation change between NR steps
     vector<OCP_DBL> dSNRP;       ///< predicted saturation change between NR steps
@@ -473,6 +532,11 @@ private:
     OCP_DBL NRdSSP;  ///< difference between dSNR and dSNRP, 2-norm
     OCP_DBL maxNRdSSP; ///< max difference between dSNR and dSNRP
     OCP_USI index_maxNRdSSP;
+    // Chunks of flashes keep their NR diagnostics in their own slots, which are merged
+    // in the order of chunks, so the result does not depend on the thread schedule.
+    vector<OCP_DBL> slotdSSP;     ///< NRdSSP of each chunk of flashes
+    vector<OCP_DBL> slotMaxdSSP;  ///< maxNRdSSP of each chunk of flashes
+    vector<OCP_USI> slotImaxdSSP; ///< index_maxNRdSSP of each chunk of flashes
     OCP_DBL NRdPmax;  ///< Max pressure difference in an NR step
     OCP_DBL NRdNmax;  ///< Max Ni difference in an NR step
     OCP_DBL NRdSmax;  ///< Max saturation difference in an NR step(Real)
@@ -484,16 +548,25 @@ private:
 public:
     // for debug!
     void OutputInfo(const OCP_USI& n) const;
-    OCP_ULL GetSSMSTAiters()const { return flashCal[0]->GetSSMSTAiters(); }
-    OCP_ULL GetNRSTAiters()const { return flashCal[0]->GetNRSTAiters(); }
-    OCP_ULL GetSSMSPiters()const { return flashCal[0]->GetSSMSPiters(); }
-    OCP_ULL GetNRSPiters()const { return flashCal[0]->GetNRSPiters(); }
-    OCP_ULL GetRRiters()const { return flashCal[0]->GetRRiters(); }
-    OCP_ULL GetSSMSTAcounts()const { return flashCal[0]->GetSSMSTAcounts(); }
-    OCP_ULL GetNRSTAcounts()const { return flashCal[0]->GetNRSTAcounts(); }
-    OCP_ULL GetSSMSPcounts()const { return flashCal[0]->GetSSMSPcounts(); }
-    OCP_ULL GetNRSPcounts()const { return flashCal[0]->GetNRSPcounts(); }
-    OCP_ULL GetRRcounts()const { return flashCal[0]->GetRRcounts(); }
+    /// Sum up a flash counter of the first PVT region over all threads.
+    OCP_ULL SumFlashCount(OCP_ULL (Mixture::*count)()) const
+    {
+        OCP_ULL sum = (flashCal[0]->*count)();
+        for (auto& f : flashCalT) {
+            if (f[0] != flashCal[0]) sum += (f[0]->*count)();
+        }
+        return sum;
+    }
+    OCP_ULL GetSSMSTAiters()const { return SumFlashCount(&Mixture::GetSSMSTAiters); }
+    OCP_ULL GetNRSTAiters()const { return SumFlashCount(&Mixture::GetNRSTAiters); }
+    OCP_ULL GetSSMSPiters()const { return SumFlashCount(&Mixture::GetSSMSPiters); }
+    OCP_ULL GetNRSPiters()const { return SumFlashCount(&Mixture::GetNRSPiters); }
+    OCP_ULL GetRRiters()const { return SumFlashCount(&Mixture::GetRRiters); }
+    OCP_ULL GetSSMSTAcounts()const { return SumFlashCount(&Mixture::GetSSMSTAcounts); }
+    OCP_ULL GetNRSTAcounts()const { return SumFlashCount(&Mixture::GetNRSTAcounts); }
+    OCP_ULL GetSSMSPcounts()const { return SumFlashCount(&Mixture::GetSSMSPcounts); }
+    OCP_ULL GetNRSPcounts()const { return SumFlashCount(&Mixture::GetNRSPcounts); }
+    OCP_ULL GetRRcounts()const { return SumFlashCount(&Mixture::GetRRcounts); }
 
 
     /////////////////////////////////////////////////////////////////////
@@ -560,6 +633,12 @@ public:
     void GetSolAIMc01(const vector<OCP_DBL>& u, const OCP_DBL& dPmaxlim,
         const OCP_DBL& dSmaxlim);
     void UpdatePj();
+    /// Return true if the bulk is among the current FIM bulks.
+    bool IsFIMBulk(const OCP_USI& n) const
+    {
+        return map_Bulk2FIM[n] > -1 &&
+               static_cast<OCP_USI>(map_Bulk2FIM[n]) < numFIMBulk;
+    }
        
 private:
     vector<OCP_USI>   wellBulkId;   ///< Index of bulks which are penetrated by wells ans their K-neighbor
@@ -570,6 +649,30 @@ private:
     vector<OCP_DBL>   FIMNi;        ///< Ni in FIMBulk
 };
 
+template <typename Mix, bool comp>
+void Bulk::FlashDerivBulks(Mix&           mix,
+                           const OCP_USI* bulks,
+                           const OCP_USI& num,
+                           const OCP_USI& slot)
+{
+    OCP_DBL dSSP     = 0;
+    OCP_DBL maxdSSP  = 0;
+    OCP_USI imaxdSSP = 0;
+    for (OCP_USI i = 0; i < num; i++) {
+        const OCP_USI n = bulks[i];
+        if (comp) {
+            mix.Mix::FlashDeriv(P[n], T, &Ni[n * numCom], CalFlashType(n), phaseNum[n],
+                                &Ks[n * numCom_1]);
+        } else {
+            mix.Mix::FlashDeriv(P[n], T, &Ni[n * numCom], 0, 0, 0);
+        }
+        PassFlashValueDeriv(n, &mix, dSSP, maxdSSP, imaxdSSP);
+    }
+    slotdSSP[slot]     = dSSP;
+    slotMaxdSSP[slot]  = maxdSSP;
+    slotImaxdSSP[slot] = imaxdSSP;
+}
+
 #endif /* end if __BULK_HEADER__ */
 
 /*----------------------------------------------------------------------------*/
@@ -68,6 +68,9 @@ public:
     /// Setup active connections and calculate necessary properties using Grid and Bulk.
     void Setup(const Grid& myGrid, const Bulk& myBulk);
 
+    /// Save or load the results of Setup for the deck cache.
+    void SyncSetup(OCPCheckpoint& cache);
+
     /// Setup k-neighbor for bulks
     void SetupWellBulk_K(Bulk& myBulk) const;
 
@@ -86,9 +89,20 @@ public:
     /// Check differences between the current and previous steps.
     void CheckDiff() const;
 
+    /// Save or load the upwinding information.
+    void SyncCheckpoint(OCPCheckpoint& ckpt);
+
     /// Return number of bulks.
     OCP_USI GetBulkNum() const { return numBulk; }
 
+    /// Return the maximum number of neighbors of bulks, self-included.
+    USI GetMaxNeighborNum() const
+    {
+        USI maxNum = 0;
+        for (const auto& n : neighborNum) maxNum = max(maxNum, n);
+        return maxNum;
+    }
+
     /// Print information of connections on screen.
     void PrintConnectionInfo(const Grid& myGrid) const;
     void PrintConnectionInfoCoor(const Grid& myGrid) const;
@@ -112,6 +126,10 @@ private:
     /// Number of neighbors of the i-th bulk: activeGridNum, self-included
     vector<USI> neighborNum;
 
+    /// Slots of off-diagonal blocks in the matrix for each connection: numConn * 2.
+    //  Note: They are positions of EId in neighbor[BId] and BId in neighbor[EId].
+    vector<USI> offDiagPtr;
+
     /// All connections (pair of indices) between bulks: numConn.
     //  Note: In each pair, the index of first bulk is greater than the second. The data
     //  in iteratorConn is generated from neighbor.
@@ -136,6 +154,12 @@ private:
     vector<OCP_DBL> lastUpblock_Trans;    ///< Transmisbility at the last time step
     vector<OCP_DBL> lastUpblock_Velocity; ///< Velocity at the last time step
 
+    ////// Work space for assembling matrix
+    /// Blocks of connections to BId and EId: numConn * 2 * block size.
+    mutable vector<OCP_DBL> connBlock;
+    /// Rhs (or scalar) terms of connections: numConn * 2 * block dim.
+    mutable vector<OCP_DBL> connRhs;
+
     /////////////////////////////////////////////////////////////////////
     // IMPEC
     /////////////////////////////////////////////////////////////////////
@@ -165,6 +189,10 @@ public:
     /// Allocate memory for auxiliary variables used by the FIM method.
     void AllocateAuxFIM(const USI& np);
 
+    /// Add blocks of connections in connBlock into the matrix in order of connections.
+    void AssembleConnBlock(LinearSystem& myLS, const USI& bsize,
+                           const bool& withRhs = false) const;
+
     /// Assmeble coefficient matrix for FIM, terms related to bulks only.
     void AssembleMat_FIM(LinearSystem& myLS, const Bulk& myBulk,
                          const OCP_DBL& dt) const;
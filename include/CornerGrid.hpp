@@ -26,7 +26,6 @@ using namespace std;
 const OCP_DBL SMALL_REAL   = 1E-10; ///< Used for checking determinate of a small matrix
 const OCP_DBL TEENY        = 1E-3;  ///< Used for checking distance b/w center to face
 const OCP_DBL SMALL        = 1E-3;  ///< Small number as tolerance
-const USI     MAX_NEIGHBOR = 80;    ///< Max number of  neighbors allowed
 
 /// A point in 2D.
 class Point2D
@@ -109,23 +108,20 @@ OCP_DBL CalAreaNotQuadr(const HexahedronFace& FACE1, const HexahedronFace& FACE2
 
 
 
-/// ???
+/// Half of a connection, seen from the block owning it.
 class HalfConn
 {
 public:
     OCP_DBL Ad_dd;
-    Point3D d;
     OCP_USI neigh;
     USI     directionType; // 1 - x, 2 - y, 3 - z, 4 - extension
 };
 
-/// ???
+/// Half connections of a range of blocks, appended block by block.
 class ConnGrid
 {
 public:
-    USI              nConn, maxConn;
     vector<HalfConn> halfConn;
-    void             Allocate(const USI& max_neighbor);
     void AddHalfConn(const OCP_USI& n, const Point3D& area, const Point3D& d,
                      const USI& direction, const OCP_DBL& flag = 1);
 };
@@ -140,7 +136,22 @@ public:
     OCP_DBL Ad_dd_end;
 };
 
+/// Relative position of a face of a block and the face of its neighbor.
+class FaceFlags
+{
+public:
+    // if the i th point of oFace is deeper than the one of Face, then flagpi = 1;
+    // if the i th point of oFace is higher than the one of Face, then flagpi = -1;
+    // if the i th point of oFace is very close to the one of Face, then flagpi = 0;
+    OCP_INT        flagp0, flagp1, flagp2, flagp3;
+    bool           flagQuad; ///< If the interface is quadrilateral
+    bool           flagJump; ///< If the interface is empty
+    HexahedronFace tmpFace;  ///< The interface if it is quadrilateral
+};
+
 /// ???
+//  Note: Arrays are flat and blocks are numbered as k * nx * ny + j * nx + i, so
+//  geometry and half connections of blocks are computed in parallel.
 class COORD
 {
     friend class Grid;
@@ -152,17 +163,32 @@ public:
     bool InputZCORNDATA(const vector<OCP_DBL>& zcorn);
     // New version
     void SetupCornerPoints();
-    void SetAllFlags(const HexahedronFace& oFace, const HexahedronFace& Face);
+    void SetAllFlags(const HexahedronFace& oFace, const HexahedronFace& Face,
+                     FaceFlags& ff) const;
     // functions
-    OCP_DBL OCP_SIGN(const OCP_DBL& x) { return x >= 0 ? 1 : -1; }
+    OCP_DBL OCP_SIGN(const OCP_DBL& x) const { return x >= 0 ? 1 : -1; }
+
+private:
+    /// Append the half connections of block (i, j, k) with its neighbors to bconn.
+    void SetupConnOfBlock(const USI& i, const USI& j, const USI& k, ConnGrid& bconn);
+    /// Return the index of block (i, j, k).
+    OCP_USI Index(const USI& i, const USI& j, const USI& k) const
+    {
+        return (k * ny + j) * nx + i;
+    }
+    /// Return the top and bottom points of pillar (i, j).
+    const OCP_DBL* Pillar(const USI& i, const USI& j) const
+    {
+        return &COORDDATA[(j * (nx + 1) + i) * 6];
+    }
 
 private:
-    USI           nx;
-    USI           ny;
-    USI           nz;
-    OCP_DBL***    COORDDATA;
-    OCP_DBL****   ZCORNDATA;
-    Hexahedron*** cornerPoints;
+    USI                nx;
+    USI                ny;
+    USI                nz;
+    vector<OCP_DBL>    COORDDATA;    ///< x, y, z of top and bottom of each pillar
+    vector<OCP_DBL>    ZCORNDATA;    ///< Depths of 8 corners of each block
+    vector<Hexahedron> cornerPoints; ///< Corner points of each block
 
     OCP_USI         numGrid;
     OCP_USI         numConn;
@@ -176,15 +202,6 @@ private:
 
     vector<GeneralConnect> connect;
 
-    // Auxiliary variables
-    // if the i th point of oFace is deeper than the one of Face, then flagpi = 1;
-    // if the i th point of oFace is higher than the one of Face, then flagpi = -1;
-    // if the i th point of oFace is very close to the one of Face, then flagpi = 0;
-    OCP_INT flagp0, flagp1, flagp2, flagp3;
-    bool flagQuad;
-    bool upNNC, downNNC;
-    bool flagJump;
-    HexahedronFace tmpFace;
     // after the Axes are determined, blocks will be placed along the y+, or along the y-
     // if y+, then flagForward equals 1.0, else -1.0, this relates to calculation of 
     // area normal vector
@@ -200,4 +217,6 @@ private:
 /*----------------------------------------------------------------------------*/
 /*  Shizhe Li           Nov/16/2021      Create file                          */
 /*  Chensong Zhang      Jan/16/2022      Update Doxygen                       */
+/*  OpenCAEPoro team    Oct/16/2026      Flat arrays, parallel block geometry */
+/*  OpenCAEPoro team    Oct/16/2026      Pair half connections by buckets     */
 /*----------------------------------------------------------------------------*/
\ No newline at end of file
@@ -0,0 +1,69 @@
+/*! \file    DeckCache.hpp
+ *  \brief   Binary cache of a preprocessed input deck
+ *  \author  OpenCAEPoro team
+ *  \date    Oct/16/2026
+ *
+ *-----------------------------------------------------------------------------------
+ *  Copyright (C) 2021--present by the OpenCAEPoro team. All rights reserved.
+ *  Released under the terms of the GNU Lesser General Public License 3.0 or later.
+ *-----------------------------------------------------------------------------------
+ */
+
+#ifndef __DECKCACHE_HEADER__
+#define __DECKCACHE_HEADER__
+
+// Standard header files
+#include <string>
+#include <vector>
+
+// OpenCAEPoro header files
+#include "OCPConst.hpp"
+#include "ParamRead.hpp"
+#include "UtilCheckpoint.hpp"
+
+using namespace std;
+
+/// A binary image of the parsed deck and the static grid, kept next to the input file.
+//  Note: The image holds the params read from the input file and its INCLUDE files,
+//  followed by the results of Grid::Setup and BulkConn::Setup. It is keyed by the size
+//  and hash of every file read, so a changed deck or INCLUDE file is parsed again and
+//  the image is rewritten. Options given in the command line are not part of the key.
+class DeckCache
+{
+public:
+    /// Switch the cache of an input file on or off.
+    void Setup(const string& file, const bool& on);
+    /// Return true if the cache is in use.
+    bool IsOn() const { return useCache; }
+    /// Load params from the image if it is up to date, return true if loaded.
+    bool LoadParam(ParamRead& param);
+    /// Start a new image with params just read from the input files.
+    void SaveParam(ParamRead& param);
+    /// Return true if the params have been loaded from the image.
+    bool IsLoaded() const { return loaded; }
+    /// Return the image to save or load the results of setup.
+    OCPCheckpoint& Image() { return image; }
+    /// Check the end of a loaded image, or write a new image in the background.
+    void Finish();
+
+private:
+    /// Return the hash of a file and its size, return false if it can not be read.
+    static bool HashFile(const string& file, OCP_ULL& size, OCP_ULL& hash);
+
+private:
+    bool          useCache{false}; ///< If the cache is used
+    bool          loaded{false};   ///< If params come from the image
+    string        inputFile;       ///< Input file
+    string        cacheFile;       ///< Image file: inputFile + ".cache"
+    OCPCheckpoint image;           ///< Image being saved or loaded
+};
+
+#endif /* end if __DECKCACHE_HEADER__ */
+
+/*----------------------------------------------------------------------------*/
+/*  Brief Change History of This File                                         */
+/*----------------------------------------------------------------------------*/
+/*  Author              Date             Actions                              */
+/*----------------------------------------------------------------------------*/
+/*  OpenCAEPoro team    Oct/16/2026      Create file                          */
+/*----------------------------------------------------------------------------*/
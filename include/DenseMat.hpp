@@ -14,6 +14,7 @@
 
 // Standard header files
 #include <algorithm>
+#include <cmath>
 #include <iomanip>
 #include <iostream>
 #include <string>
@@ -96,6 +97,7 @@ void Dscalar(const int& n, const double& alpha, double* x);
 void Daxpy(const int& n, const double& alpha, const double* x, double* y);
 
 /// Computes C' = alpha B'A' + beta C', all matrices are column-major.
+/// Square blocks up to 8 x 8 use the fixed-size kernel, others call dgemm.
 void DaABpbC(const int& m, const int& n, const int& k, const double& alpha,
              const double* A, const double* B, const double& beta, double* C);
 
@@ -110,6 +112,7 @@ void DaAxpby(const int& m, const int& n, const double& a, const double* A,
              const double* x, const double& b, double* y);
 
 /// Calls dgesv to solve the linear system for general matrices.
+/// Systems up to order 8 are solved with the fixed-size kernel.
 void LUSolve(const int& nrhs, const int& N, double* A, double* b, int* pivot);
 
 /// Calls dsysy to solve the linear system for symm matrices.
@@ -117,6 +120,86 @@ void SYSSolve(const int& nrhs, const char* uplo, const int& N, double* A,
     double* b, int* pivot, double* work, const int& lwork);
 
 
+/////////////////////////////////////////////////////////////////////
+// Fixed-size kernels for small blocks, larger blocks go to BLAS/LAPACK
+/////////////////////////////////////////////////////////////////////
+
+/// Computes y = alpha x + y with compile-time length.
+template <int N>
+inline void DaxpyFixed(const double& alpha, const double* x, double* y)
+{
+    for (int i = 0; i < N; i++) y[i] += alpha * x[i];
+}
+
+/// Computes C = alpha A B + beta C with compile-time row/column sizes.
+/// A: M x k, B: k x N, C: M x N, all matrices are row-major.
+template <int M, int N>
+inline void DaABpbCFixed(const int& k, const double& alpha, const double* A,
+                         const double* B, const double& beta, double* C)
+{
+    double c[N];
+    for (int i = 0; i < M; i++) {
+        double*       Ci = C + i * N;
+        const double* Ai = A + i * k;
+        if (beta == 0) {
+            for (int j = 0; j < N; j++) c[j] = 0;
+        } else {
+            for (int j = 0; j < N; j++) c[j] = beta * Ci[j];
+        }
+        for (int p = 0; p < k; p++) {
+            const double  a  = alpha * Ai[p];
+            const double* Bp = B + p * N;
+            for (int j = 0; j < N; j++) c[j] += a * Bp[j];
+        }
+        for (int j = 0; j < N; j++) Ci[j] = c[j];
+    }
+}
+
+/// Solves A X = B with LU factorization and partial pivoting for compile-time N.
+/// A (N x N) and B (N x nrhs) are column-major as in dgesv, A is overwritten by its
+/// factors and B by the solution. Returns 0 on success, or j if U(j,j) is zero.
+template <int N>
+inline int LUSolveFixed(const int& nrhs, double* A, double* b, int* pivot)
+{
+    for (int j = 0; j < N; j++) {
+        double* Aj   = A + j * N;
+        int     p    = j;
+        double  amax = fabs(Aj[j]);
+        for (int i = j + 1; i < N; i++) {
+            if (fabs(Aj[i]) > amax) {
+                amax = fabs(Aj[i]);
+                p    = i;
+            }
+        }
+        pivot[j] = p + 1;
+        if (Aj[p] == 0) return j + 1;
+        if (p != j) {
+            for (int k = 0; k < N; k++) swap(A[k * N + j], A[k * N + p]);
+            for (int r = 0; r < nrhs; r++) swap(b[r * N + j], b[r * N + p]);
+        }
+        const double inv = 1 / Aj[j];
+        for (int i = j + 1; i < N; i++) Aj[i] *= inv;
+        for (int k = j + 1; k < N; k++) {
+            double*      Ak  = A + k * N;
+            const double akj = Ak[j];
+            for (int i = j + 1; i < N; i++) Ak[i] -= Aj[i] * akj;
+        }
+    }
+    for (int r = 0; r < nrhs; r++) {
+        double* x = b + r * N;
+        for (int j = 0; j < N; j++) {
+            const double* Aj = A + j * N;
+            for (int i = j + 1; i < N; i++) x[i] -= x[j] * Aj[i];
+        }
+        for (int j = N - 1; j >= 0; j--) {
+            const double* Aj = A + j * N;
+            x[j] /= Aj[j];
+            for (int i = 0; i < j; i++) x[i] -= x[j] * Aj[i];
+        }
+    }
+    return 0;
+}
+
 /// Prints a  vector.
 template <typename T>
 void PrintDX(const int& N, const T* x)
@@ -42,6 +42,7 @@ extern "C" {
 
 // OpenCAEPoro header files
 #include "LinearSolver.hpp"
+#include "UtilProfiler.hpp"
 
 using namespace std;
 
@@ -95,18 +96,19 @@ private:
     void InitParam() override;
 
     /// Assemble coefficient matrix.
-    void AssembleMat(const vector<vector<USI>>&     colId,
-                     const vector<vector<OCP_DBL>>& val,
-                     const OCP_USI&                 dim,
-                     const USI&                     blockDim,
-                     vector<OCP_DBL>&               rhs,
-                     vector<OCP_DBL>&               u) override;
+    void AssembleMat(OCP_USI*         IA,
+                     OCP_USI*         JA,
+                     OCP_DBL*         val,
+                     const OCP_USI&   dim,
+                     const USI&       blockDim,
+                     vector<OCP_DBL>& rhs,
+                     vector<OCP_DBL>& u) override;
 
     /// Solve the linear system.
     OCP_INT Solve() override;
 
 private:
-    dCSRmat A; ///< Matrix for scalar-value problems
+    dCSRmat A; ///< Matrix for scalar-value problems, sharing storage with LinearSystem
     dvector b; ///< Right-hand side for scalar-value problems
     dvector x; ///< Solution for scalar-value problems
 };
@@ -116,6 +118,13 @@ class VectorFaspSolver : public FaspSolver
 {
     friend class LinearSystem;
 
+public:
+    /// Free the ILU factors kept for PC_BILU.
+    ~VectorFaspSolver() override
+    {
+        if (iluReady) fasp_ilu_data_free(&iluData);
+    }
+
 private:
     /// Allocate memory for the linear system.
     void Allocate(const vector<USI>& rowCapacity,
@@ -126,16 +135,23 @@ private:
     void InitParam() override;
 
     /// Assemble coefficient matrix.
-    void AssembleMat(const vector<vector<USI>>&     colId,
-                     const vector<vector<OCP_DBL>>& val,
-                     const OCP_USI&                 dim,
-                     const USI&                     blockDim,
-                     vector<OCP_DBL>&               rhs,
-                     vector<OCP_DBL>&               u) override;
+    void AssembleMat(OCP_USI*         IA,
+                     OCP_USI*         JA,
+                     OCP_DBL*         val,
+                     const OCP_USI&   dim,
+                     const USI&       blockDim,
+                     vector<OCP_DBL>& rhs,
+                     vector<OCP_DBL>& u) override;
 
     /// Solve the linear system.
     OCP_INT Solve() override;
 
+    /// Return true for BILU and the sharing-setup preconditioners.
+    bool CanReusePrecond() const override;
+
+    /// Keep the preconditioner of the last solve in the next one if reuse is true.
+    void SetReusePrecond(const bool& reuse) override { reusePrecond = reuse; }
+
     /// Apply decoupling to the linear system.
     void Decoupling(dBSRmat* Absr,
                     dvector* b,
@@ -146,7 +162,7 @@ private:
                     int      decouple_type);
 
 private:
-    dBSRmat A; ///< Matrix for vector-value problems
+    dBSRmat A; ///< Matrix for vector-value problems, sharing storage with LinearSystem
     dvector b; ///< Right-hand side for vector-value problems
     dvector x; ///< Solution for vector-value problems
 
@@ -155,6 +171,10 @@ private:
     ivector order; ///< User-defined ordering for smoothing process
 
     vector<OCP_DBL> Dmat; ///< Decoupling matrices
+
+    bool     reusePrecond{false}; ///< If the preconditioner of last solve is kept
+    ILU_data iluData;             ///< ILU factors kept for PC_BILU
+    bool     iluReady{false};     ///< If iluData holds factors
 };
 
 #endif // __FASPSOLVER_HEADER__
@@ -168,4 +188,5 @@ private:
 /*  Chensong Zhang      Jan/08/2022      Update Doxygen                       */
 /*  Chensong Zhang      Jan/19/2022      Set FASP4BLKOIL as optional          */
 /*  Li Zhao             Apr/04/2022      Set FASP4CUDA   as optional          */
+/*  OpenCAEPoro team    Oct/17/2026      Reuse of preconditioners             */
 /*----------------------------------------------------------------------------*/
@@ -19,8 +19,29 @@
 #include "OCPTable.hpp"
 #include "ParamReservoir.hpp"
 
+/// Arrays of Bulk read and written by the batched calls of FlowUnit.
+//  Note: Values of a bulk n begin at n * np, derivatives at n * np * np.
+class KrPcArrays
+{
+public:
+    USI            np;               ///< Num of phases
+    USI            wId;              ///< Index of water phase
+    const OCP_DBL* P;                ///< Pressure
+    const OCP_DBL* S;                ///< Saturations
+    OCP_DBL*       kr;               ///< Relative permeability
+    OCP_DBL*       Pc;               ///< Capillary pressure
+    OCP_DBL*       Pj;               ///< Phase pressure
+    OCP_DBL*       dKr_dS{nullptr};  ///< dKr / dS, used with derivatives
+    OCP_DBL*       dPcj_dS{nullptr}; ///< dPcj / dS, used with derivatives
+    const OCP_DBL* surTen{nullptr};  ///< Surface tension, used in miscible runs
+    OCP_DBL*       Fk{nullptr};      ///< Kr interpolation parameter, used in miscible runs
+    OCP_DBL*       Fp{nullptr};      ///< Pc interpolation parameter, used in miscible runs
+    const OCP_DBL* scalePcow{nullptr}; ///< Scale of Pcow, used if Pcow is scaled
+};
+
 /// designed to deal with matters related to saturation table.
 /// relative permeability, capillary pressure will be calculated here.
+//  Note: CalKrPc and CalKrPcDeriv keep no state, so a FlowUnit is shared by threads.
 class FlowUnit
 {
 public:
@@ -42,14 +63,62 @@ public:
 
     /// Calculate relative permeability and capillary pressure.
     virtual void CalKrPc(const OCP_DBL* S_in, OCP_DBL* kr_out, OCP_DBL* pc_out,
-                         const OCP_DBL& MySurTen, OCP_DBL& MyFk, OCP_DBL& MyFp) = 0;
+                         const OCP_DBL& MySurTen, OCP_DBL& MyFk, OCP_DBL& MyFp) const = 0;
 
     /// Calculate derivatives of relative permeability and capillary pressure.
     virtual void CalKrPcDeriv(const OCP_DBL* S_in, OCP_DBL* kr_out, OCP_DBL* pc_out,
                               OCP_DBL* dkrdS, OCP_DBL* dPcjdS, const OCP_DBL& MySurTen,
-                              OCP_DBL& MyFk, OCP_DBL& MyFp) = 0;
+                              OCP_DBL& MyFk, OCP_DBL& MyFp) const = 0;
+
+    /// Calculate kr and Pc of the listed bulks, then scale Pcow and set Pj = P + Pc.
+    virtual void CalKrPcBatch(const OCP_USI* bulks, const OCP_USI& num,
+                              const KrPcArrays& a) const = 0;
+
+    /// Calculate kr, Pc and their derivatives of the listed bulks, then scale Pcow
+    /// and set Pj = P + Pc.
+    virtual void CalKrPcDerivBatch(const OCP_USI* bulks, const OCP_USI& num,
+                                   const KrPcArrays& a) const = 0;
 };
 
+/// Loop over the listed bulks with the routines of Unit, which are called directly
+/// rather than virtually, so that each FlowUnit class has its own batched loop.
+template <typename Unit, bool deriv>
+void CalKrPcBulks(const Unit& unit, const OCP_USI* bulks, const OCP_USI& num,
+                  const KrPcArrays& a)
+{
+    const USI np = a.np;
+    OCP_DBL   tmp;
+    for (OCP_USI i = 0; i < num; i++) {
+        const OCP_USI n   = bulks[i];
+        const OCP_USI bId = n * np;
+        const OCP_DBL st  = a.surTen ? a.surTen[n] : 0;
+        OCP_DBL&      fk  = a.surTen ? a.Fk[n] : tmp;
+        OCP_DBL&      fp  = a.surTen ? a.Fp[n] : tmp;
+        if (deriv) {
+            unit.Unit::CalKrPcDeriv(&a.S[bId], &a.kr[bId], &a.Pc[bId],
+                                    &a.dKr_dS[bId * np], &a.dPcj_dS[bId * np], st, fk,
+                                    fp);
+        } else {
+            unit.Unit::CalKrPc(&a.S[bId], &a.kr[bId], &a.Pc[bId], st, fk, fp);
+        }
+        if (a.scalePcow) a.Pc[bId + a.wId] *= a.scalePcow[n];
+        for (USI j = 0; j < np; j++) a.Pj[bId + j] = a.P[n] + a.Pc[bId + j];
+    }
+}
+
+/// Define the batched calls of a FlowUnit class with its own routines.
+#define OCP_FLOWUNIT_BATCH(Unit)                                                       \
+    void CalKrPcBatch(const OCP_USI* bulks, const OCP_USI& num, const KrPcArrays& a)  \
+        const override                                                                 \
+    {                                                                                  \
+        CalKrPcBulks<Unit, false>(*this, bulks, num, a);                               \
+    }                                                                                  \
+    void CalKrPcDerivBatch(const OCP_USI* bulks, const OCP_USI& num,                   \
+                           const KrPcArrays& a) const override                         \
+    {                                                                                  \
+        CalKrPcBulks<Unit, true>(*this, bulks, num, a);                                \
+    }
+
 ///////////////////////////////////////////////
 // FlowUnit_W
 ///////////////////////////////////////////////
@@ -61,10 +130,11 @@ public:
     FlowUnit_W(const ParamReservoir& rs_param, const USI& i){};
 
     void CalKrPc(const OCP_DBL* S_in, OCP_DBL* kr_out, OCP_DBL* pc_out,
-                 const OCP_DBL& MySurTen, OCP_DBL& MyFk, OCP_DBL& MyFp) override;
+                 const OCP_DBL& MySurTen, OCP_DBL& MyFk, OCP_DBL& MyFp) const override;
     void CalKrPcDeriv(const OCP_DBL* S_in, OCP_DBL* kr_out, OCP_DBL* pc_out,
                       OCP_DBL* dkrdS, OCP_DBL* dPcjdS, const OCP_DBL& MySurTen,
-                      OCP_DBL& MyFk, OCP_DBL& MyFp) override;
+                      OCP_DBL& MyFk, OCP_DBL& MyFp) const override;
+    OCP_FLOWUNIT_BATCH(FlowUnit_W)
 
     OCP_DBL GetSwco() const override { return Swco; };
 
@@ -91,10 +161,11 @@ public:
     FlowUnit_OW(const ParamReservoir& rs_param, const USI& i);
 
     void CalKrPc(const OCP_DBL* S_in, OCP_DBL* kr_out, OCP_DBL* pc_out,
-                 const OCP_DBL& MySurTen, OCP_DBL& MyFk, OCP_DBL& MyFp) override;
+                 const OCP_DBL& MySurTen, OCP_DBL& MyFk, OCP_DBL& MyFp) const override;
     void CalKrPcDeriv(const OCP_DBL* S_in, OCP_DBL* kr_out, OCP_DBL* pc_out,
                       OCP_DBL* dkrdS, OCP_DBL* dPcjdS, const OCP_DBL& MySurTen,
-                      OCP_DBL& MyFk, OCP_DBL& MyFp) override;
+                      OCP_DBL& MyFk, OCP_DBL& MyFp) const override;
+    OCP_FLOWUNIT_BATCH(FlowUnit_OW)
 
     OCP_DBL GetPcowBySw(const OCP_DBL& sw) override { return SWOF.Eval(0, sw, 3); }
     OCP_DBL GetSwByPcow(const OCP_DBL& pcow) override
@@ -112,8 +183,6 @@ public:
 
 private:
     OCPTable        SWOF;  ///< saturation table about water and oil.
-    vector<OCP_DBL> data;  ///< container to store the values of interpolation.
-    vector<OCP_DBL> cdata; ///< container to store the slopes of interpolation.
     OCP_DBL         kroMax;
     OCP_DBL         Swco; ///< Saturation of connate water.
 };
@@ -129,10 +198,11 @@ public:
     FlowUnit_OG(const ParamReservoir& rs_param, const USI& i);
 
     void    CalKrPc(const OCP_DBL* S_in, OCP_DBL* kr_out, OCP_DBL* pc_out,
-                    const OCP_DBL& MySurTen, OCP_DBL& MyFk, OCP_DBL& MyFp) override;
+                    const OCP_DBL& MySurTen, OCP_DBL& MyFk, OCP_DBL& MyFp) const override;
     void    CalKrPcDeriv(const OCP_DBL* S_in, OCP_DBL* kr_out, OCP_DBL* pc_out,
                          OCP_DBL* dkrdS, OCP_DBL* dPcjdS, const OCP_DBL& MySurTen,
-                         OCP_DBL& MyFk, OCP_DBL& MyFp) override;
+                         OCP_DBL& MyFk, OCP_DBL& MyFp) const override;
+    OCP_FLOWUNIT_BATCH(FlowUnit_OG)
     OCP_DBL GetPcgoBySg(const OCP_DBL& sg) override { return SGOF.Eval(0, sg, 3); }
     OCP_DBL GetSgByPcgo(const OCP_DBL& pcgo) override { return SGOF.Eval(3, pcgo, 0); }
 
@@ -146,8 +216,6 @@ public:
 
 private:
     OCPTable        SGOF;  ///< saturation table about gas and oil.
-    vector<OCP_DBL> data;  ///< container to store the values of interpolation.
-    vector<OCP_DBL> cdata; ///< container to store the slopes of interpolation.
     OCP_DBL         kroMax;
 };
 
@@ -186,10 +254,11 @@ public:
 
     virtual void CalKrPc(const OCP_DBL* S_in, OCP_DBL* kr_out, OCP_DBL* pc_out,
                          const OCP_DBL& MySurTen, OCP_DBL& MyFk,
-                         OCP_DBL& MyFp) override;
+                         OCP_DBL& MyFp) const override;
     virtual void CalKrPcDeriv(const OCP_DBL* S_in, OCP_DBL* kr_out, OCP_DBL* pc_out,
                               OCP_DBL* dkrdS, OCP_DBL* dPcjdS, const OCP_DBL& MySurTen,
-                              OCP_DBL& MyFk, OCP_DBL& MyFp) override;
+                              OCP_DBL& MyFk, OCP_DBL& MyFp) const override;
+    OCP_FLOWUNIT_BATCH(FlowUnit_ODGW01)
 
     OCP_DBL CalKro_Stone2Der(OCP_DBL krow, OCP_DBL krog, OCP_DBL krw, OCP_DBL krg,
                              OCP_DBL dkrwdSw, OCP_DBL dkrowdSw, OCP_DBL dkrgdSg,
@@ -218,8 +287,6 @@ public:
 protected:
     OCPTable        SGOF;   ///< saturation table about gas and oil.
     OCPTable        SWOF;   ///< saturation table about water and oil.
-    vector<OCP_DBL> data;   ///< container to store the values of interpolation.
-    vector<OCP_DBL> cdata;  ///< container to store the slopes of interpolation.
     OCPTable        SWPCGW; ///< auxiliary table: saturation of water vs. capillary
                             ///< pressure between water and gas.
 };
@@ -251,10 +318,11 @@ public:
     }
 
     void CalKrPc(const OCP_DBL* S_in, OCP_DBL* kr_out, OCP_DBL* pc_out,
-                 const OCP_DBL& MySurTen, OCP_DBL& MyFk, OCP_DBL& MyFp) override;
+                 const OCP_DBL& MySurTen, OCP_DBL& MyFk, OCP_DBL& MyFp) const override;
     void CalKrPcDeriv(const OCP_DBL* S_in, OCP_DBL* kr_out, OCP_DBL* pc_out,
                       OCP_DBL* dkrdS, OCP_DBL* dPcjdS, const OCP_DBL& MySurTen,
-                      OCP_DBL& MyFk, OCP_DBL& MyFp) override;
+                      OCP_DBL& MyFk, OCP_DBL& MyFp) const override;
+    OCP_FLOWUNIT_BATCH(FlowUnit_ODGW01_Miscible)
 
 private:
     OCP_DBL kroMis{0};  ///< miscible oil relative permeability
@@ -263,12 +331,9 @@ private:
     OCP_DBL socrMis{0}; ///< oil critical miscible saturations
     OCP_DBL sgcrMis{0}; ///< gas critical miscible saturations
 
-    OCP_DBL Fk{0};        ///< The relative permeability interpolation parameter
-    OCP_DBL Fp{0};        ///< The capillary pressure interpolation parameter
     OCP_DBL surTenRef{0}; ///< Reference surface tension
     OCP_DBL Fkexp{0.25};  ///< Exponent set used to calculate Fk
     OCP_DBL surTenPc{0};  ///< Maximum surface tension for capillary pressure/surTenRef
-    OCP_DBL surTen{0};    ///< Surface tension
 };
 
 ///////////////////////////////////////////////
@@ -282,10 +347,11 @@ public:
     FlowUnit_ODGW02(const ParamReservoir& rs_param, const USI& i);
 
     void    CalKrPc(const OCP_DBL* S_in, OCP_DBL* kr_out, OCP_DBL* pc_out,
-                    const OCP_DBL& MySurTen, OCP_DBL& MyFk, OCP_DBL& MyFp) override;
+                    const OCP_DBL& MySurTen, OCP_DBL& MyFk, OCP_DBL& MyFp) const override;
     void    CalKrPcDeriv(const OCP_DBL* S_in, OCP_DBL* kr_out, OCP_DBL* pc_out,
                          OCP_DBL* dkrdS, OCP_DBL* dPcjdS, const OCP_DBL& MySurTen,
-                         OCP_DBL& MyFk, OCP_DBL& MyFp) override;
+                         OCP_DBL& MyFk, OCP_DBL& MyFp) const override;
+    OCP_FLOWUNIT_BATCH(FlowUnit_ODGW02)
     OCP_DBL CalKro_Stone2Der(OCP_DBL krow, OCP_DBL krog, OCP_DBL krw, OCP_DBL krg,
                              OCP_DBL dkrwdSw, OCP_DBL dkrowdSo, OCP_DBL dkrgdSg,
                              OCP_DBL dkrogdSo, OCP_DBL& out_dkrodSo) const;
@@ -310,8 +376,6 @@ private:
     OCPTable        SWFN;   ///< saturation table about water.
     OCPTable        SGFN;   ///< saturation table about gas.
     OCPTable        SOF3;   ///< saturation table about oil.
-    vector<OCP_DBL> data;   ///< container to store the values of interpolation.
-    vector<OCP_DBL> cdata;  ///< container to store the slopes of interpolation.
     OCPTable        SWPCGW; ///< auxiliary table: saturation of water vs. capillary
                             ///< pressure between water and gas.
 };
@@ -325,4 +389,5 @@ private:
 /*----------------------------------------------------------------------------*/
 /*  Shizhe Li           Oct/01/2021      Create file                          */
 /*  Chensong Zhang      Oct/05/2022      Format file                          */
+/*  OpenCAEPoro team    Oct/16/2026      Batched kr and Pc over cell lists    */
 /*----------------------------------------------------------------------------*/
\ No newline at end of file
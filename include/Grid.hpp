@@ -24,8 +24,15 @@
 
 using namespace std;
 
-
-
+/// Natural i-j-k ordering of bulks, which is the default
+//  Note: With block ILU0 of the built-in solver, RCM cuts Krylov iterations of SPE1
+//  and SPE5 by about 30% but adds 28% to those of the corner-point example, together
+//  with more Newton steps. So the natural ordering is kept unless asked otherwise.
+const USI BULK_NATURAL = 0;
+/// Reverse Cuthill-McKee ordering of bulks
+const USI BULK_RCM = 1;
+/// Nested dissection ordering of bulks by METIS
+const USI BULK_METIS = 2;
 
 /// Effective area of intersection surfaces with neighboring cells.
 class GPair
@@ -85,6 +92,8 @@ public:
     void InputParam(const ParamReservoir& rs_param);
     /// Setup the grid information and calculate the properties.
     void Setup();
+    /// Save or load the results of Setup for the deck cache.
+    void SyncSetup(OCPCheckpoint& cache);
 
     /// Setup an orthogonal grid.
     void SetupOrthogonalGrid();
@@ -105,6 +114,13 @@ public:
 
     /// Calculate the activeness of grid cells.
     void CalActiveGrid(const OCP_DBL& e1, const OCP_DBL& e2);
+    /// Renumber bulks (active cells) in the given ordering.
+    //  Note: Only activeMap_B2G and activeMap_G2B change. Bulks, connections, wells and
+    //  output all find bulks of grid cells through them, so nothing else is aware of
+    //  the ordering. Bulks are always renumbered from the natural ordering.
+    void SetupBulkOrder(const USI& order);
+    /// Return the ordering of bulks.
+    USI GetBulkOrder() const { return bulkOrder; }
     /// Mapping from grid cells to bulks (active cells).
     const GB_Pair& MapG2B(const OCP_USI& i) const { return activeMap_G2B[i]; }
     /// Return nx of grid cell.
@@ -167,6 +183,7 @@ private:
     OCP_USI         activeGridNum; ///< Num of active grid.
     vector<OCP_USI> activeMap_B2G; ///< Mapping from active grid to grid: activeGridNum = numBulk
     vector<GB_Pair> activeMap_G2B; ///< Mapping from grid to active grid: numGrid.
+    USI             bulkOrder{BULK_NATURAL}; ///< Ordering of active grids
 
 private:
     // Auxiliary variable
@@ -188,4 +205,5 @@ public:
 /*  Chensong Zhang      Oct/15/2021      Format file                          */
 /*  Shizhe Li           Nov/18/2021      Add Connections between Grids        */
 /*  Chensong Zhang      Jan/16/2022      Finish Doxygen                       */
+/*  OpenCAEPoro team    Oct/16/2026      Add bulk ordering                    */
 /*----------------------------------------------------------------------------*/
\ No newline at end of file
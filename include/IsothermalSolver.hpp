@@ -35,6 +35,12 @@ public:
     bool FinishNR(Reservoir& rs, OCPControl& ctrl);
     /// Finish the current time step.
     void FinishStep(Reservoir& rs, OCPControl& ctrl);
+    /// Drop the sparsity pattern of linear systems.
+    void ResetPattern();
+    /// Save or load the solutions of linear systems.
+    void SyncCheckpoint(OCPCheckpoint& ckpt);
+    /// Print statistics of linear systems.
+    void PrintLinearInfo(ostream& out) const;
 
 private:
     USI           method = FIM;
@@ -25,6 +25,9 @@ using namespace std;
 class LinearSolver
 {
 public:
+    /// Free the memory kept by derived solvers.
+    virtual ~LinearSolver() = default;
+
     /// Read the params for linear solvers from an input file.
     virtual void SetupParam(const string& dir, const string& file) = 0;
 
@@ -37,18 +40,27 @@ public:
                           const USI&         blockDim) = 0;
 
     /// Assemble matrix for linear solver from the internal matrix data.
-    virtual void AssembleMat(const vector<vector<USI>>&     colId,
-                             const vector<vector<OCP_DBL>>& val,
-                             const OCP_USI&                 dim,
-                             const USI&                     blockDim,
-                             vector<OCP_DBL>&               rhs,
-                             vector<OCP_DBL>&               u) = 0;
+    //  Note: IA, JA, and val are the compressed internal storage in CSR/BSR form,
+    //  which should be used in place rather than copied.
+    virtual void AssembleMat(OCP_USI*         IA,
+                             OCP_USI*         JA,
+                             OCP_DBL*         val,
+                             const OCP_USI&   dim,
+                             const USI&       blockDim,
+                             vector<OCP_DBL>& rhs,
+                             vector<OCP_DBL>& u) = 0;
 
     /// Solve the linear system and return the number of iterations.
     virtual OCP_INT Solve() = 0;
 
     /// Get number of iterations.
     virtual USI GetNumIters() const = 0;
+
+    /// Return true if the preconditioner can be kept for the next solve.
+    virtual bool CanReusePrecond() const { return false; }
+
+    /// Keep the preconditioner of the last solve in the next one if reuse is true.
+    virtual void SetReusePrecond(const bool& reuse) {}
 };
 
 #endif // __LINEARSOLVER_HEADER__
@@ -60,4 +72,5 @@ public:
 /*----------------------------------------------------------------------------*/
 /*  Shizhe Li           Nov/22/2021      Create file                          */
 /*  Chensong Zhang      Jan/18/2022      Update Doxygen                       */
+/*  OpenCAEPoro team    Oct/17/2026      Reuse of preconditioners             */
 /*----------------------------------------------------------------------------*/
\ No newline at end of file
@@ -20,13 +20,195 @@
 
 // OpenCAEPoro header files
 #include "FaspSolver.hpp"
+#include "NativeSolver.hpp"
 #include "OCPConst.hpp"
+#include "UtilCheckpoint.hpp"
 
 using namespace std;
 
+/// A matrix row living in a fixed segment of a contiguous array.
+//  Note: It provides the part of the vector interface used during matrix assembly,
+//  but entries are written in place into the storage shared with linear solvers.
+template <typename T>
+class MatRow
+{
+public:
+    /// Create a row view with data, length and capacity of the segment.
+    MatRow(T* d, USI& l, const OCP_USI& c)
+        : data(d)
+        , len(l)
+        , cap(c){};
+
+    USI  size() const { return len; }                  ///< Return length of row.
+    T*   begin() const { return data; }                ///< Return first entry.
+    T*   end() const { return data + len; }            ///< Return end of row.
+    T&   operator[](const USI& i) const { return data[i]; } ///< Return ith entry.
+    void clear() { len = 0; }                           ///< Clear the row.
+
+    /// Append an entry at the end of row.
+    void push_back(const T& v)
+    {
+        CheckCap(1);
+        data[len++] = v;
+    }
+    /// Insert an entry before pos.
+    T* insert(T* pos, const T& v)
+    {
+        CheckCap(1);
+        copy_backward(pos, data + len, data + len + 1);
+        *pos = v;
+        len++;
+        return pos;
+    }
+    /// Insert entries in [first, last) before pos.
+    template <typename It>
+    T* insert(T* pos, It first, It last)
+    {
+        const USI n = distance(first, last);
+        CheckCap(n);
+        copy_backward(pos, data + len, data + len + n);
+        copy(first, last, pos);
+        len += n;
+        return pos;
+    }
+    /// Replace the row with entries in [first, last).
+    template <typename It>
+    void assign(It first, It last)
+    {
+        len = 0;
+        insert(data, first, last);
+    }
+
+private:
+    /// Check if n more entries can be stored in the segment.
+    void CheckCap(const USI& n) const
+    {
+        if (len + n > cap) OCP_ABORT("Row capacity of the linear system is exceeded!");
+    }
+
+private:
+    T*      data; ///< Beginning of the segment.
+    USI&    len;  ///< Number of entries in the row.
+    OCP_USI cap;  ///< Capacity of the segment.
+};
+
+/// Row-segmented storage of a sparse matrix in one contiguous array (CSRx).
+//  Note: Each row owns a segment whose size is its capacity. After assembly, rows are
+//  compressed in place so that the storage is in standard CSR/BSR form, which is
+//  used by the linear solver directly.
+template <typename T>
+class MatRowArray
+{
+public:
+    /// Allocate segments, capacity of each row is rowCap * unit.
+    void Allocate(const vector<USI>& rowCap, const USI& unit)
+    {
+        const OCP_USI nrow = rowCap.size();
+        capStart.resize(nrow + 1);
+        capStart[0] = 0;
+        for (OCP_USI n = 0; n < nrow; n++) {
+            capStart[n + 1] = capStart[n] + rowCap[n] * unit;
+        }
+        start = capStart;
+        len.assign(nrow, 0);
+        data.resize(capStart[nrow]);
+    }
+    /// Return the view of row n.
+    MatRow<T> operator[](const OCP_USI& n)
+    {
+        return MatRow<T>(data.data() + start[n], len[n], capStart[n + 1] - capStart[n]);
+    }
+    /// Return the entries of row n.
+    const T* RowData(const OCP_USI& n) const { return data.data() + start[n]; }
+    /// Return the length of row n.
+    USI RowLen(const OCP_USI& n) const { return len[n]; }
+    /// Move the first dim rows together, then Start() is the row pointer.
+    void Compress(const OCP_USI& dim)
+    {
+        OCP_USI pos = 0;
+        for (OCP_USI n = 0; n < dim; n++) {
+            if (start[n] != pos) {
+                copy(data.begin() + start[n], data.begin() + start[n] + len[n],
+                     data.begin() + pos);
+                start[n] = pos;
+            }
+            pos += len[n];
+        }
+        start[dim] = pos;
+    }
+    /// Set entries of the first dim rows to zero, which must have been compressed.
+    void Zero(const OCP_USI& dim)
+    {
+        fill(data.begin() + start[0], data.begin() + start[dim], T(0));
+    }
+    /// Clear all rows and restore their segments.
+    void Clear()
+    {
+        start = capStart;
+        fill(len.begin(), len.end(), 0);
+    }
+    OCP_USI* Start() { return start.data(); } ///< Return starting position of rows.
+    T*       Data() { return data.data(); }   ///< Return the contiguous storage.
+
+private:
+    vector<T>       data;     ///< Contiguous storage of all rows.
+    vector<OCP_USI> capStart; ///< Starting positions of segments.
+    vector<OCP_USI> start;    ///< Starting positions of rows.
+    vector<USI>     len;      ///< Lengths of rows.
+};
+
+/// Reasons why a preconditioner is built again.
+enum PrecondSetupReason : USI {
+    SETUP_PATTERN, ///< First solve, or the size or pattern changed, e.g. by wells
+    SETUP_FAILURE, ///< The last solve failed
+    SETUP_ITERS,   ///< Iterations grew too much since the last setup
+    SETUP_DRIFT,   ///< Values drifted too much since the last setup
+    SETUP_AGE,     ///< Reused too many times
+    SETUP_REASON_NUM
+};
+
+/// Policy to decide when a preconditioner is built again or reused.
+//  Note: The matrix is measured by the absolute sum of each row, which is compared with
+//  that at the last setup. The iterations right after a setup are the reference of
+//  later ones. Both are used across Newton iterations and time steps.
+class PrecondReuse
+{
+public:
+    /// Switch the policy on or off, the preconditioner is always built if off.
+    void Setup(const bool& on) { active = on; }
+    /// Return true if the preconditioner is built for the matrix with the row sums.
+    bool NeedSetup(const vector<OCP_DBL>& rowSum);
+    /// Record the status and iterations of the solve.
+    void Record(const OCP_INT& status, const USI& iters);
+    /// The sparsity pattern is dropped, e.g. wells open or shut.
+    void PatternChanged() { patternChanged = true; }
+    /// Print statistics of setups and reuses.
+    void PrintInfo(ostream& out) const;
+
+private:
+    bool    active{true};   ///< If false, the preconditioner is always built
+    OCP_DBL maxGrowth{1.5}; ///< Max ratio of iterations to those after the last setup
+    USI     minGrowth{3};   ///< Iterations may grow by minGrowth anyway
+    OCP_DBL maxDrift{0.1};  ///< Max relative change of row sums since the last setup
+    USI     maxAge{20};     ///< Max num of solves with the same preconditioner
+
+    bool            patternChanged{true}; ///< If the pattern changed since last setup
+    bool            lastSetup{false};     ///< If the last solve built a preconditioner
+    bool            lastFailed{false};    ///< If the last solve failed
+    USI             baseIters{0};         ///< Iterations right after the last setup
+    USI             lastIters{0};         ///< Iterations of the last solve
+    USI             age{0};               ///< Num of solves since the last setup
+    vector<OCP_DBL> baseRowSum;           ///< Row sums at the last setup
+
+    USI numSetup{0};                    ///< Num of setups
+    USI numReuse{0};                    ///< Num of reuses
+    USI numReason[SETUP_REASON_NUM]{0}; ///< Num of setups for each reason
+};
+
 /// Linear solvers for discrete systems.
 //  Note: The matrix is stored in the form of row-segmented CSRx internaly, whose
-//  sparsity pattern is almost the same as neighbor in BulkConn.
+//  sparsity pattern is almost the same as neighbor in BulkConn. The storage is
+//  compressed in place and passed to linear solvers without copy.
 class LinearSystem
 {
     friend class OpenCAEPoro;
@@ -34,6 +216,12 @@ class LinearSystem
     friend class Well;
 
 public:
+    LinearSystem() = default;
+    LinearSystem(const LinearSystem&) = delete;
+    LinearSystem& operator=(const LinearSystem&) = delete;
+    /// Free the linear solver.
+    ~LinearSystem() { delete LS; }
+
     /// Allocate memory for linear system with max possible number of rows.
     void AllocateRowMem(const OCP_USI& dimMax, const USI& nb);
     /// Allocate memory for each matrix row with max possible number of columns.
@@ -47,6 +235,33 @@ public:
     /// Clear the internal matrix data for scalar-value problems.
     void ClearData();
 
+    // Sparsity pattern
+    /// Keep the current sparsity pattern, then only values are assembled later.
+    void FixPattern() { patternFixed = true; }
+    /// Drop the sparsity pattern, it will be built again in the next assembly.
+    void ResetPattern();
+    /// Return true if the sparsity pattern is kept from the last assembly.
+    bool IfPatternFixed() const { return patternFixed; }
+    /// Save or load the solution, which is the initial guess of the next solve.
+    void SyncCheckpoint(OCPCheckpoint& ckpt) { ckpt.Sync(u); }
+    /// Put a block into the slot of row n, or append it if the pattern is being built.
+    void InsertBlock(const OCP_USI& n, const USI& slot, const OCP_DBL* blk)
+    {
+        if (patternFixed)
+            copy(blk, blk + blockSize, &val[n][slot * blockSize]);
+        else
+            val[n].insert(val[n].end(), blk, blk + blockSize);
+    }
+    /// Put a block of column col into row n, and return the slot it occupies.
+    USI InsertBlock(const OCP_USI& n, const OCP_USI& col, const USI& slot,
+                    const OCP_DBL* blk)
+    {
+        const USI k = patternFixed ? slot : colId[n].size();
+        if (!patternFixed) colId[n].push_back(col);
+        InsertBlock(n, k, blk);
+        return k;
+    }
+
     
     /// Return the solution.
     vector<OCP_DBL>& GetSolution() { return u; }
@@ -63,9 +278,13 @@ public:
     /// Setup LinearSolver
     void SetupLinearSolver(const USI& i, const string& dir, const string& file);
     /// Assemble Mat for Linear Solver
-    void AssembleMatLinearSolver() { LS->AssembleMat(colId, val, dim, blockDim, b, u); }
-    /// Solve the Linear System
-    OCP_INT Solve() { return LS->Solve(); }
+    void AssembleMatLinearSolver();
+    /// Solve the Linear System, the preconditioner may be reused if it's allowed.
+    OCP_INT Solve();
+    /// Switch the reuse policy of preconditioners on or off.
+    void SetupPrecondReuse(const bool& on) { precondReuse.Setup(on); }
+    /// Print statistics of preconditioner reuse.
+    void PrintReuseInfo(ostream& out) const { precondReuse.PrintInfo(out); }
 
     /// Return the Max Iters
     USI GetNumIters() { return LS->GetNumIters(); }
@@ -85,17 +304,24 @@ private:
     // actual size and is used to allocate memory at the beginning of simulation.
     // diagVal is an auxiliary variable used to help setup entries in diagnal line and
     // it will only be used when matrix is assembled.
-    vector<USI>             rowCapacity; ///< Maximal capacity of each row.
-    vector<vector<OCP_USI>> colId;       ///< Column indices of nonzero entry.
-    vector<USI>             diagPtr;     ///< Indices of diagonal entries.
-    vector<vector<OCP_DBL>> val;         ///< Nonzero values.
-    vector<OCP_DBL>         diagVal;     ///< Diagonal values
-    vector<OCP_DBL>         b;           ///< Right-hand side of linear system.
-    vector<OCP_DBL>         u;           ///< Solution of linear system.
+    vector<USI>          rowCapacity; ///< Maximal capacity of each row.
+    MatRowArray<OCP_USI> colId;       ///< Column indices of nonzero entry.
+    vector<USI>          diagPtr;     ///< Indices of diagonal entries.
+    MatRowArray<OCP_DBL> val;         ///< Nonzero values.
+    vector<OCP_DBL>      diagVal;     ///< Diagonal values
+    vector<OCP_DBL>      b;           ///< Right-hand side of linear system.
+    vector<OCP_DBL>      u;           ///< Solution of linear system.
+
+    // Before the pattern is fixed, colId is built with each assembly; after that, it
+    // is kept until wells change and values are put into known slots directly.
+    bool patternFixed{false}; ///< If true, the sparsity pattern is reused.
 
     string solveDir; ///< Current workdir.
 
-    LinearSolver* LS;
+    PrecondReuse    precondReuse; ///< Policy to build or reuse the preconditioner.
+    vector<OCP_DBL> rowSum;       ///< Absolute sum of each row, used by the policy.
+
+    LinearSolver* LS{nullptr}; ///< Linear solver chosen by SetupLinearSolver.
 };
 
 #endif /* end if __LINEARSOLVER_HEADER__ */
@@ -109,4 +335,5 @@ private:
 /*  Chensong Zhang      Oct/15/2021      Format file                          */
 /*  Chensong Zhang      Nov/09/2021      Remove decoupling methods            */
 /*  Chensong Zhang      Nov/22/2021      renamed to LinearSystem              */
+/*  OpenCAEPoro team    Oct/17/2026      Add reuse policy of preconditioners  */
 /*----------------------------------------------------------------------------*/
\ No newline at end of file
@@ -22,6 +22,8 @@
 
 using namespace std;
 
+class Bulk;
+
 /// Mixture is an abstract class, who contains all information used for flash
 /// calculation including variables, functions. any properties of phases such as mass
 /// density can calculated by it. it has the same data structure as the ones in bulks.
@@ -70,6 +72,8 @@ public:
         
     };
     virtual void SetPVTW(){};
+    /// Return a copy of the mixture with its own working variables.
+    virtual Mixture* Clone() const = 0;
     /// return type of mixture.
     USI GetType() const { return mixtureType; }
     /// Check whether Table PVDG is empty, it will only be used in black oil model.
@@ -96,6 +100,12 @@ public:
         const OCP_DBL* Niin, const OCP_DBL* Sjin, const OCP_DBL* xijin,
         const OCP_DBL* njin, const USI& ftype, const USI* phaseExistin, 
         const USI& lastNP, const OCP_DBL* lastKs) = 0;
+    /// Flash calculation with derivatives for the listed bulks, whose results are
+    /// passed to bk bulk by bulk, NR diagnostics go to the given slot of bk.
+    virtual void FlashDerivBatch(const OCP_USI* bulks,
+                                 const OCP_USI& num,
+                                 Bulk&          bk,
+                                 const OCP_USI& slot) = 0;
     /// Return molar density of phase, it's used to calculate the molar density of
     /// injection fluids in injection wells.
     virtual OCP_DBL XiPhase(const OCP_DBL& Pin, const OCP_DBL& Tin,
@@ -209,4 +219,5 @@ protected:
 /*----------------------------------------------------------------------------*/
 /*  Shizhe Li           Oct/01/2021      Create file                          */
 /*  Chensong Zhang      Oct/15/2021      Format file                          */
+/*  OpenCAEPoro team    Oct/16/2026      Batched flash over bulk lists        */
 /*----------------------------------------------------------------------------*/
\ No newline at end of file
@@ -90,6 +90,7 @@ public:
 
     BOMixture_W() = default;
     BOMixture_W(const ParamReservoir& rs_param, const USI& i) { OCP_ABORT("Not Completed!"); };
+    Mixture* Clone() const override { return new BOMixture_W(*this); }
 
     void InitFlash(const OCP_DBL& Pin, const OCP_DBL& Pbbin, const OCP_DBL& Tin,
         const OCP_DBL* Sjin, const OCP_DBL& Vpore,
@@ -124,6 +125,10 @@ public:
         const USI& lastNP, const OCP_DBL* lastKs) override {
         OCP_ABORT("Not Completed!");
     }
+    void FlashDerivBatch(const OCP_USI* bulks, const OCP_USI& num, Bulk& bk,
+                         const OCP_USI& slot) override {
+        OCP_ABORT("Not Completed!");
+    }
     OCP_DBL XiPhase(const OCP_DBL& Pin, const OCP_DBL& Tin, const OCP_DBL* Ziin) override { OCP_ABORT("Not Completed!"); return 0; };
     OCP_DBL RhoPhase(const OCP_DBL& Pin, const OCP_DBL& Tin, const OCP_DBL* Ziin) override { OCP_ABORT("Not Completed!"); return 0; };
     OCP_DBL GammaPhaseW(const OCP_DBL& Pin) override { OCP_ABORT("Not Completed!"); return 0; };
@@ -141,6 +146,7 @@ class BOMixture_OW : public BOMixture
 public:
     BOMixture_OW() = default;
     BOMixture_OW(const ParamReservoir& rs_param, const USI& i);
+    Mixture* Clone() const override { return new BOMixture_OW(*this); }
 
     void InitFlash(const OCP_DBL& Pin, const OCP_DBL& Pbbin, const OCP_DBL& Tin,
         const OCP_DBL* Sjin, const OCP_DBL& Vpore,
@@ -168,6 +174,8 @@ public:
         const USI& lastNP, const OCP_DBL* lastKs) override {
         OCP_ABORT("Not Completed!");
     }
+    void FlashDerivBatch(const OCP_USI* bulks, const OCP_USI& num, Bulk& bk,
+                         const OCP_USI& slot) override;
     OCP_DBL XiPhase(const OCP_DBL& Pin, const OCP_DBL& Tin, const OCP_DBL* Ziin) override;
     OCP_DBL RhoPhase(const OCP_DBL& Pin, const OCP_DBL& Tin, const OCP_DBL* Ziin) override;
     OCP_DBL GammaPhaseO(const OCP_DBL& Pin, const OCP_DBL& Pbbin) override;
@@ -192,6 +200,7 @@ class BOMixture_ODGW : public BOMixture
 public:
     BOMixture_ODGW() = default;
     BOMixture_ODGW(const ParamReservoir& rs_param, const USI& i);
+    Mixture* Clone() const override { return new BOMixture_ODGW(*this); }
 
     void InitFlash(const OCP_DBL& Pin, const OCP_DBL& Pbbin, const OCP_DBL& Tin,
         const OCP_DBL* Sjin, const OCP_DBL& Vpore,
@@ -219,6 +228,8 @@ public:
         const USI& lastNP, const OCP_DBL* lastKs) override {
         OCP_ABORT("Not Completed!");
     }
+    void FlashDerivBatch(const OCP_USI* bulks, const OCP_USI& num, Bulk& bk,
+                         const OCP_USI& slot) override;
     OCP_DBL XiPhase(const OCP_DBL& Pin, const OCP_DBL& Tin, const OCP_DBL* Ziin) override;
     OCP_DBL RhoPhase(const OCP_DBL& Pin, const OCP_DBL& Tin, const OCP_DBL* Ziin) override;
     OCP_DBL GammaPhaseO(const OCP_DBL& Pin, const OCP_DBL& Pbbin) override;
@@ -245,4 +256,5 @@ private:
 /*----------------------------------------------------------------------------*/
 /*  Shizhe Li           Oct/01/2021      Create file                          */
 /*  Chensong Zhang      Oct/15/2021      Format file                          */
+/*  OpenCAEPoro team    Oct/16/2026      Batched flash over bulk lists        */
 /*----------------------------------------------------------------------------*/
\ No newline at end of file
@@ -174,6 +174,7 @@ public:
 		}
 	};
 	MixtureComp(const EoSparam& param, const USI& i);
+	Mixture* Clone() const override { return new MixtureComp(*this); }
 	void InitFlash(const OCP_DBL& Pin, const OCP_DBL& Pbbin, const OCP_DBL& Tin,
 		const OCP_DBL* Sjin, const OCP_DBL& Vpore,
 		const OCP_DBL* Ziin) override;
@@ -196,6 +197,8 @@ public:
         const OCP_DBL* Niin, const OCP_DBL* Sjin, const OCP_DBL* xijin,
         const OCP_DBL* njin, const USI& ftype, const USI* phaseExistin, 
         const USI& lastNP, const OCP_DBL* lastKs)override;
+    void FlashDerivBatch(const OCP_USI* bulks, const OCP_USI& num, Bulk& bk,
+                         const OCP_USI& slot) override;
 	OCP_DBL XiPhase(const OCP_DBL& Pin, const OCP_DBL& Tin, const OCP_DBL* Ziin) override;
 	OCP_DBL RhoPhase(const OCP_DBL& Pin, const OCP_DBL& Tin,
 		const OCP_DBL* Ziin) override;
@@ -287,6 +290,7 @@ private:
     // EoS Variables
     vector<OCP_DBL>         Ai;
     vector<OCP_DBL>         Bi;
+    vector<OCP_DBL>         Aik; ///< (1 - BIC) * sqrt(Ai * Ak), updated in CalAiBi
     vector<OCP_DBL>         Aj;
     vector<OCP_DBL>         Bj;
     vector<OCP_DBL>         Zj;
@@ -308,6 +312,11 @@ public:
     void CalFugPhi(OCP_DBL* phiT, OCP_DBL* fugT, const OCP_DBL* xj);
 	void CalFugPhi(OCP_DBL* fugT, const OCP_DBL* xj);
 	void CalFugPhiAll();
+    /// CalFugPhi without Aik and CalPhiKernel, kept as the reference of ocp_bench.
+    void CalFugPhiRef(OCP_DBL* phiT, OCP_DBL* fugT, const OCP_DBL* xj);
+    /// Calculate fugacity coefficients of a phase with its Aj, Bj and Zj.
+    void CalPhiKernel(OCP_DBL* phiT, const OCP_DBL* xj, const OCP_DBL& aj,
+                      const OCP_DBL& bj, const OCP_DBL& zj) const;
 	void CalMW();
 	void CalVfXiRho();
 	void CalSaturation();
@@ -0,0 +1,135 @@
+/*! \file    NativeSolver.hpp
+ *  \brief   Built-in vector linear solver in BSR format with OpenMP
+ *  \author  OpenCAEPoro team
+ *  \date    Oct/17/2026
+ *
+ *-----------------------------------------------------------------------------------
+ *  Copyright (C) 2021--present by the OpenCAEPoro team. All rights reserved.
+ *  Released under the terms of the GNU Lesser General Public License 3.0 or later.
+ *-----------------------------------------------------------------------------------
+ */
+
+#ifndef __NATIVESOLVER_HEADER__
+#define __NATIVESOLVER_HEADER__
+
+// Standard header files
+#include <string>
+#include <vector>
+
+// OpenCAEPoro header files
+#include "LinearSolver.hpp"
+
+using namespace std;
+
+// Preconditioner types of the built-in solver, given by precond_type of the FASP file
+#define PC_OCP_BILU 81 ///< Block ILU0 of the built-in solver
+#define PC_OCP_BJAC 82 ///< Block Jacobi of the built-in solver
+
+/// Built-in vector solver in BSR format, which needs no optional library.
+//  Note: It is chosen by precond_type of the FASP file, or takes the place of FASP4BLKOIL
+//  preconditioners if the library is not available. solver_type 2 is BiCGStab, other
+//  Krylov methods are GMRES with right preconditioning. Block ILU0 is factorized and
+//  applied by levels of rows, where rows of one level are independent of each other.
+class VectorNativeSolver : public LinearSolver
+{
+public:
+    /// Return true if the built-in solver is used for params in an input file.
+    static bool IsChosen(const string& dir, const string& file);
+
+    /// Read params from an input file in the format of FASP.
+    void SetupParam(const string& dir, const string& file) override;
+
+    /// Initialize the params for the built-in solver.
+    void InitParam() override;
+
+    /// Allocate memory for vectors of Krylov methods.
+    void Allocate(const vector<USI>& rowCapacity,
+                  const OCP_USI&     maxDim,
+                  const USI&         blockDim) override;
+
+    /// Use the matrix of LinearSystem in place, and set up the pattern if it changes.
+    void AssembleMat(OCP_USI*         IA,
+                     OCP_USI*         JA,
+                     OCP_DBL*         val,
+                     const OCP_USI&   dim,
+                     const USI&       blockDim,
+                     vector<OCP_DBL>& rhs,
+                     vector<OCP_DBL>& u) override;
+
+    /// Solve the linear system and return the number of iterations.
+    OCP_INT Solve() override;
+
+    /// Get number of iterations.
+    USI GetNumIters() const override { return numIters; }
+
+    /// The built-in preconditioners can always be kept.
+    bool CanReusePrecond() const override { return true; }
+
+    /// Keep the preconditioner of the last solve in the next one if reuse is true.
+    void SetReusePrecond(const bool& reuse) override { reusePrecond = reuse; }
+
+private:
+    /// Sort columns of each row, and find levels of rows for ILU0.
+    void SetupPattern();
+    /// Compute inverses of diagonal blocks or ILU0 factors, return false if singular.
+    bool SetupPrecond();
+    /// z = M^{-1} r.
+    void Precond(const OCP_DBL* r, OCP_DBL* z) const;
+    /// y = A * x.
+    void MatVec(const OCP_DBL* x, OCP_DBL* y) const;
+    /// GMRES with right preconditioning.
+    OCP_INT GMRES();
+    /// BiCGStab with right preconditioning.
+    OCP_INT BiCGStab();
+
+private:
+    // Params
+    OCP_INT solverType{6};            ///< 2 for BiCGStab, others for GMRES
+    OCP_INT precondType{PC_OCP_BILU}; ///< PC_OCP_BILU or PC_OCP_BJAC
+    OCP_DBL tol{1e-3};                ///< Relative tolerance of residual
+    USI     maxit{100};               ///< Max num of iterations
+    USI     restart{30};              ///< Restart of GMRES
+    OCP_INT printLevel{1};            ///< Print level of FASP
+
+    // Matrix of LinearSystem, whose columns may be in any order in a row
+    OCP_USI          dim{0};       ///< Num of block rows
+    USI              nb{0};        ///< Dimens of small block matrix
+    USI              nb2{0};       ///< Size of small block matrix
+    const OCP_USI*   IA{nullptr};  ///< Row pointer
+    const OCP_USI*   JA{nullptr};  ///< Column indices
+    const OCP_DBL*   val{nullptr}; ///< Values of blocks in row-major order
+    vector<OCP_DBL>* rhs{nullptr}; ///< Right-hand side
+    vector<OCP_DBL>* sol{nullptr}; ///< Solution
+
+    // Pattern, which is kept until IA or JA changes
+    vector<OCP_USI> patIA;      ///< Row pointer of the current pattern
+    vector<OCP_USI> patJA;      ///< Column indices of the current pattern
+    vector<OCP_USI> luCol;      ///< Columns sorted in each row
+    vector<OCP_USI> luPos;      ///< Position in val of each sorted entry
+    vector<OCP_USI> luDiag;     ///< Sorted entry of the diagonal block of each row
+    vector<OCP_USI> lowerStart; ///< First row of each level of the lower part
+    vector<OCP_USI> lowerRows;  ///< Rows ordered by levels of the lower part
+    vector<OCP_USI> upperStart; ///< First row of each level of the upper part
+    vector<OCP_USI> upperRows;  ///< Rows ordered by levels of the upper part
+
+    // Preconditioner
+    bool            reusePrecond{false}; ///< If the preconditioner of last solve is kept
+    bool            precondReady{false}; ///< If the preconditioner is set up
+    vector<OCP_DBL> luVal;               ///< ILU0 factors in sorted order
+    vector<OCP_DBL> diagInv;             ///< Inverses of diagonal blocks of M
+
+    // Krylov methods
+    vector<vector<OCP_DBL>> V;           ///< Basis of GMRES, or vectors of BiCGStab
+    vector<vector<OCP_DBL>> Z;           ///< Preconditioned basis of GMRES
+    USI                     numIters{0}; ///< Num of iterations of the last solve
+};
+
+#endif /* end if __NATIVESOLVER_HEADER__ */
+
+/*----------------------------------------------------------------------------*/
+/*  Brief Change History of This File                                         */
+/*----------------------------------------------------------------------------*/
+/*  Author              Date             Actions                              */
+/*----------------------------------------------------------------------------*/
+/*  OpenCAEPoro team    Oct/17/2026      Create file                          */
+/*----------------------------------------------------------------------------*/
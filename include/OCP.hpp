@@ -13,11 +13,13 @@
 #define __OCP_HEADER__
 
 // OpenCAEPoro header files
+#include "DeckCache.hpp"
 #include "OCPControl.hpp"
 #include "OCPOutput.hpp"
 #include "ParamRead.hpp"
 #include "Reservoir.hpp"
 #include "Solver.hpp"
+#include "UtilProfiler.hpp"
 #include "UtilTiming.hpp"
 
 #define OCPVersion "0.2.1" ///< Software version tag used for git
@@ -54,11 +56,42 @@ public:
              << "  dtMax:  maximum time stepsize  " << endl
              << "  dtMin:  minimum time stepsize  " << endl
              << "  pl:     print level on screen  " << endl
+             << "  prof:   stage profiling (off, on, trace)" << endl
+             << "  ckpt:   write a checkpoint every ckpt TSTEPs" << endl
+             << "  restart: restart from a checkpoint file" << endl
+             << "  cache:  keep the preprocessed deck in a cache file (off, on)" << endl
+             << "  rpt:    format of the detail report (text, bin)" << endl
+             << "  async:  write reports in a background thread (on, off)" << endl
+             << "  order:  ordering of bulks (natural, rcm, metis)" << endl
+             << "  reuse:  reuse preconditioners across solves (on, off)" << endl
+             << "  ls:     linear solver file next to the input file" << endl
              << endl;
 
         cout << "Attention: " << endl
              << "  - These cmd options will override those in the input file;" << endl
              << "  - Only if `method' is set, other options will take effect;" << endl
+             << "  - `prof' takes effect alone, `trace' also writes Profile.json;"
+             << endl
+             << "  - `ckpt' and `restart' take effect alone, a restart needs the same"
+             << endl
+             << "    input file and method as the run that wrote CHECKPOINT.bin;" << endl
+             << "  - `cache' takes effect alone, it writes <InputFileName>.cache and"
+             << endl
+             << "    loads it instead of the input files while they are unchanged;" << endl
+             << "  - `rpt' takes effect alone, `bin' writes RPT.bin instead of RPT.out,"
+             << endl
+             << "    which ocp_rpt2text converts to the text of RPT.out;" << endl
+             << "  - `async' takes effect alone, reports are flushed at exit or abort;"
+             << endl
+             << "  - `order' takes effect alone, natural by default, `metis' needs a"
+             << endl
+             << "    build with USE_METIS;"
+             << endl
+             << "  - `reuse' takes effect alone, it applies to BILU and FASP1/4_SHARE;"
+             << endl
+             << "  - `ls' replaces csr.fasp or bsr.fasp of the method, the implicit"
+             << endl
+             << "    part of AIMt still reads bsr.fasp;" << endl
              << "  - If (dtInit,dtMax,dtMin) are not set, default values will be used."
              << endl;
 
@@ -69,6 +102,12 @@ public:
              << endl;
     }
 
+    /// Switch on the stage profiler if requested in cmd options.
+    void SetupProfiler(const USI& argc, const char* options[]) const;
+
+    /// Read the input file, or load it from the deck cache if requested.
+    void ReadInputFile(ParamRead& param, const USI& argc, const char* options[]);
+
     /// Read input parameters to an internal structure.
     void InputParam(ParamRead& param);
 
@@ -96,6 +135,9 @@ private:
 
     /// Output class handles output level of the program.
     OCPOutput output;
+
+    /// Preprocessed input deck.
+    DeckCache deckCache;
 };
 
 #endif /* end if __OCP_HEADER__ */
@@ -109,4 +151,11 @@ private:
 /*  Chensong Zhang      Oct/15/2021      Format file                          */
 /*  Chensong Zhang      Jan/08/2022      New tag info                         */
 /*  Chensong Zhang      Sep/21/2022      Add PrintUsage                       */
+/*  OpenCAEPoro team    Oct/16/2026      Add SetupProfiler                    */
+/*  OpenCAEPoro team    Oct/16/2026      Add deck cache                       */
+/*  OpenCAEPoro team    Oct/16/2026      Add binary detail report             */
+/*  OpenCAEPoro team    Oct/16/2026      Add async output                     */
+/*  OpenCAEPoro team    Oct/16/2026      Add bulk ordering                    */
+/*  OpenCAEPoro team    Oct/17/2026      Add reuse of preconditioners         */
+/*  OpenCAEPoro team    Oct/17/2026      Add linear solver file option        */
 /*----------------------------------------------------------------------------*/
\ No newline at end of file
@@ -86,6 +86,15 @@ public:
     OCP_DBL timeMax;       ///< Maximum time step during running
     OCP_DBL timeMin;       ///< Minmum time step during running
     USI     printLevel{0}; ///< Decide the depth for printfing
+    USI     profile{PROFILE_OFF}; ///< Stage profiling: off, on, or trace
+    USI     ckpt{0};       ///< Write a checkpoint every ckpt TSTEPs, 0 for never
+    string  restart;       ///< Checkpoint file to restart from
+    bool    cache{false};  ///< Use the deck cache next to the input file
+    bool    rptBin{false}; ///< Write the detail report as RPT.bin instead of RPT.out
+    bool    asyncOut{true}; ///< Write reports in a background thread
+    USI     bulkOrder{BULK_NATURAL}; ///< Ordering of bulks: natural, rcm, or metis
+    bool    precondReuse{true}; ///< Reuse preconditioners by the policy of LinearSystem
+    string  lsFile;        ///< Linear solver file in place of csr.fasp or bsr.fasp
 };
 
 /// All control parameters except for well controlers.
@@ -183,6 +192,24 @@ public:
 
     // Set wellChange
     void SetWellChange(const bool& flag) { wellChange = flag; }
+    /// Return wellChange
+    bool GetWellChange() const { return wellChange; }
+
+    /// Return true if a checkpoint should be written after the TSTEP d.
+    bool IfCheckpoint(const USI& d) const
+    {
+        return ckptInterval > 0 && (d + 1) % ckptInterval == 0;
+    }
+    /// Return the checkpoint file to write.
+    string GetCheckpointFile() const { return workDir + "CHECKPOINT.bin"; }
+    /// Return the checkpoint file to restart from, empty if not restarted.
+    const string& GetRestartFile() const { return restartFile; }
+    /// Return the ordering of bulks given in cmd options.
+    USI GetBulkOrder() const { return ctrlFast.bulkOrder; }
+    /// Return true if preconditioners may be reused, given in cmd options.
+    bool GetPrecondReuse() const { return ctrlFast.precondReuse; }
+    /// Save or load time and iteration counters.
+    void SyncCheckpoint(OCPCheckpoint& ckpt);
 
 private:
     USI    method;  ///< Discrete method
@@ -199,6 +226,7 @@ private:
     OCP_DBL totalSimTime{0}; ///< Total simulation time
     OCP_DBL totalLStime{0};  ///< Total linear solver time
     OCP_DBL init_dt;         ///< from prediction for next TSTEP
+    bool    firstInit{true}; ///< If InitTime has not been called yet
 
     // Record iteration information
     USI numTstep{0};     ///< Number of time step
@@ -225,6 +253,10 @@ private:
 
     // Well 
     bool wellChange;       ///< if wells change, then false
+
+    // Checkpoint
+    USI    ckptInterval{0}; ///< Num of TSTEPs between checkpoints, 0 for never
+    string restartFile;     ///< Checkpoint file to restart from
 };
 
 #endif /* end if __OCP_Control_HEADER__ */
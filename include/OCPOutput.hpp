@@ -13,6 +13,7 @@
 #define __OCP_OUTPUT_HEADER__
 
 // Standard header files
+#include <fstream>
 #include <iomanip>
 #include <iostream>
 
@@ -20,6 +21,9 @@
 #include "OCPControl.hpp"
 #include "ParamOutput.hpp"
 #include "Reservoir.hpp"
+#include "UtilAsyncWriter.hpp"
+#include "UtilGridReport.hpp"
+#include "UtilSummaryFile.hpp"
 #include "UtilOutput.hpp"
 
 using namespace std;
@@ -71,40 +75,36 @@ public:
         index; ///< Records the index of bulk or well, whose properties will be printed
 };
 
-/// The SumPair class is an auxiliary structure storing summary data to output.
-class SumPair
-{
-public:
-    SumPair(const string& item, const string& obj, const string& unit)
-        : Item(item)
-        , Obj(obj)
-        , Unit(unit){};
-    string          Item;
-    string          Obj;
-    string          Unit;
-    vector<OCP_DBL> val;
-};
-
 /// The Summary class manages the output in the summary file.
 //  Note: It contains the most interested information in each time step, which usually
-//  will be convert to figures for later analysis.
+//  will be convert to figures for later analysis. The values of each time step are
+//  appended to SUMMARY.bin at once, and SUMMARY.out is converted from it.
 class Summary
 {
 public:
     /// TODO: Add Doxygen
     void InputParam(const OutputSummary& summary_param);
 
-    /// TODO: Add Doxygen
-    void Setup(const Reservoir& reservoir, const OCP_DBL& totalTime);
+    /// Create dir/SUMMARY.bin, which is resumed from the checkpoint if restart.
+    void Setup(const string& dir, const Reservoir& reservoir, const bool& restart);
 
-    /// TODO: Add Doxygen
+    /// Append the values of the current time step to SUMMARY.bin.
     void SetVal(const Reservoir& reservoir, const OCPControl& ctrl);
 
-    /// Write output information to a file.
-    void PrintInfo(const string& dir) const;
+    /// Return num of time steps in SUMMARY.bin.
+    OCP_ULL GetNumRows() const { return sumFile.GetNumRows(); }
+
+    /// Write the first nrow time steps of dir/SUMMARY.bin to dir/SUMMARY.out.
+    static void PrintInfo(const string& dir, const OCP_ULL& nrow);
+
+    /// Save or load num of time steps in SUMMARY.bin.
+    void SyncCheckpoint(OCPCheckpoint& ckpt);
 
 private:
     vector<SumPair> Sumdata; ///< Contains all information to be printed.
+    vector<OCP_DBL> row;     ///< Values of the current time step
+    string          sumName; ///< Name of the summary file
+    SummaryFile     sumFile; ///< The summary file
 
     bool FPR{false};  ///< Field average Pressure.
     bool FOPR{false}; ///< Field oil production rate.
@@ -150,6 +150,9 @@ public:
     /// TODO: Add Doxygen
     void PrintInfo(const string& dir) const;
 
+    /// Save or load the values collected so far.
+    void SyncCheckpoint(OCPCheckpoint& ckpt);
+
 private:
     vector<OCP_DBL> time;  ///< TODO: Add Doxygen
     vector<OCP_DBL> dt;    ///< TODO: Add Doxygen
@@ -161,14 +164,32 @@ private:
 };
 
 /// Collect more detailed information of each time step.
+//  Note: The report goes to RPT.out as text, or to RPT.bin with one array per property
+//  per report time if binary is set, which ocp_rpt2text converts to the same text.
 class DetailInfo
 {
 public:
     void InputParam(const OutputDetail& detail_param);
-    void Setup(const string& dir);
-    void PrintInfo(const string& dir, const Reservoir& rs, const OCP_DBL& days) const;
+    /// Create the report file, RPT.bin if binary, otherwise RPT.out.
+    void Setup(const string& dir, const Reservoir& rs, const bool& binary);
+    /// Take a snapshot of the report and hand it over to writer.
+    void PrintInfo(const Reservoir& rs, const OCP_DBL& days,
+                   OCPAsyncWriter& writer) const;
+
+private:
+    /// Write a snapshot of the report to file.
+    void WriteInfo(const OCP_DBL& days, const string& wellInfo,
+                   const vector<GridArray>& arrays) const;
+    /// Write the information of wells as text.
+    void SetWellInfo(const Reservoir& rs, const OCP_DBL& days, ostream& out) const;
+    /// Collect the grid arrays asked for.
+    void SetGridArrays(const Reservoir& rs, vector<GridArray>& arrays) const;
 
 private:
+    bool                   binary{false}; ///< Write RPT.bin instead of RPT.out
+    GridLayout             grid;          ///< Layout of grids
+    mutable ofstream       outF;          ///< RPT.out, kept open during the run
+    mutable GridReportFile rptBin;        ///< RPT.bin
     bool PRE{false};  ///< Pressure of grids.
     bool PGAS{false}; ///< Gas pressure of grids.
     bool PWAT{false}; ///< Water pressure of grids.
@@ -206,15 +227,22 @@ public:
     void InputParam(const ParamOutput& paramOutput);
     void Setup(const Reservoir& reservoir, const OCPControl& ctrl);
     void SetVal(const Reservoir& reservoir, const OCPControl& ctrl);
+    /// Hand the summary and the critical information over to the writer.
     void PrintInfo() const;
     void PrintInfoSched(const Reservoir& rs, const OCPControl& ctrl,
                         const OCP_DBL& time) const;
+    /// Wait until all reports handed over to the writer are on disk.
+    void Wait() const { writer.Wait(); }
+    /// Save or load the values collected so far.
+    //  Note: RPT.out is not included, it's written from the restart on.
+    void SyncCheckpoint(OCPCheckpoint& ckpt);
 
 private:
     string       wordDir;
     Summary      summary;
     CriticalInfo crtInfo;
     DetailInfo   dtlInfo;
+    mutable OCPAsyncWriter writer; ///< Writes reports in the background
 };
 
 #endif /* end if __OCPOUTPUT_HEADER__ */
@@ -227,4 +255,7 @@ private:
 /*  Shizhe Li           Oct/01/2021      Create file                          */
 /*  Chensong Zhang      Oct/15/2021      Format file                          */
 /*  Chensong Zhang      Jan/08/2022      Update Doxygen                       */
+/*  OpenCAEPoro team    Oct/16/2026      Binary detail report RPT.bin         */
+/*  OpenCAEPoro team    Oct/16/2026      Write reports in the background      */
+/*  OpenCAEPoro team    Oct/16/2026      Stream summary to SUMMARY.bin        */
 /*----------------------------------------------------------------------------*/
\ No newline at end of file
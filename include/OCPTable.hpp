@@ -23,13 +23,18 @@ using namespace std;
 
 /// OCPTable is a Table class, which used to deal with everything about table
 /// in OpenCAEPoro such as PVT table, saturation table.
+//  Note: Evaluation does not change the table, so a table can be shared by threads.
+//  Slopes of all intervals are computed once in Setup or SetRowCol, and rows are
+//  also stored row by row, so all columns are evaluated by one short loop. A row is
+//  found directly in uniformly spaced columns and by binary search in others; a
+//  caller walking through values in order may keep a hint row of its own.
 class OCPTable
 {
 public:
     /// Default constructor.
     OCPTable() = default;
 
-    /// Construct a table of fixed size.
+    /// Construct a table of fixed size, call SetRowCol after filling it.
     OCPTable(const USI& row, const USI& col);
 
     /// Construct from existing data
@@ -50,47 +55,67 @@ public:
     /// push v into the last column of table.
     void PushCol(const vector<OCP_DBL>& v) { data.push_back(v); }
 
-    /// return the jth column in table to modify or use.
+    /// return the jth column in table to modify, call SetRowCol after modifying.
     vector<OCP_DBL>& GetCol(const USI& j) { return data[j]; }
 
-    /// Setup row nums and col nums of tables, initialize the bId.
-    void SetRowCol()
-    {
-        nRow = data[0].size();
-        nCol = data.size();
-        bId  = nRow / 2;
-    }
+    /// return the jth column in table to use.
+    const vector<OCP_DBL>& GetCol(const USI& j) const { return data[j]; }
+
+    /// Setup row nums and col nums of tables, and the slopes for interpolation.
+    void SetRowCol();
+
+    /// return the row i with data[j][i] <= val < data[j][i+1] in a monotonically
+    /// increasing column, -1 if val is below the column, nRow-1 if it is above.
+    OCP_INT FindRow(const USI& j, const OCP_DBL& val) const;
+
+    /// find the row as above, beginning with the row hint found last time.
+    OCP_INT FindRow(const USI& j, const OCP_DBL& val, USI& hint) const;
 
     /// interpolate the specified monotonically increasing column in table to evaluate
     /// all columns and return slope
     USI Eval_All(const USI& j, const OCP_DBL& val, vector<OCP_DBL>& outdata,
-                 vector<OCP_DBL>& slope);
+                 vector<OCP_DBL>& slope) const;
+
+    /// interpolate all columns as above, beginning with the row hint found last time.
+    USI Eval_All(const USI& j, const OCP_DBL& val, vector<OCP_DBL>& outdata,
+                 vector<OCP_DBL>& slope, USI& hint) const;
+
+    /// interpolate all columns as above into arrays of nCol values.
+    USI Eval_All(const USI& j, const OCP_DBL& val, OCP_DBL* outdata, OCP_DBL* slope) const;
 
     /// interpolate the specified monotonically increasing column in table to evaluate
     /// all columns, j = 0 here and index of returnning date begins from 1
-    USI Eval_All0(const OCP_DBL& val, vector<OCP_DBL>& outdata);
+    USI Eval_All0(const OCP_DBL& val, vector<OCP_DBL>& outdata) const;
 
     /// interpolate the specified monotonically increasing column in table to evaluate
     /// the target column.
-    OCP_DBL Eval(const USI& j, const OCP_DBL& val, const USI& destj);
+    OCP_DBL Eval(const USI& j, const OCP_DBL& val, const USI& destj) const;
 
     /// interpolate the specified monotonically increasing column in table to evaluate
     /// the target column, and return corresponding slope.
-    OCP_DBL Eval(const USI& j, const OCP_DBL& val, const USI& destj, OCP_DBL& myK);
+    OCP_DBL Eval(const USI& j, const OCP_DBL& val, const USI& destj, OCP_DBL& myK) const;
 
     /// interpolate the specified monotonically decreasing column in table to evaluate
     /// the target column.
 
-    OCP_DBL Eval_Inv(const USI& j, const OCP_DBL& val, const USI& destj);
+    OCP_DBL Eval_Inv(const USI& j, const OCP_DBL& val, const USI& destj) const;
 
     /// Display the data of table on screen.
     void Display() const;
 
+private:
+    /// Evaluate all columns in row i found by FindRow for column j.
+    USI EvalRow(const USI& j, const OCP_DBL& val, const OCP_INT& i, OCP_DBL* outdata,
+                OCP_DBL* slope) const;
+
 private:
     USI                     nRow; ///< number of rows of the table
     USI                     nCol; ///< number of columns of the table
-    USI                     bId;  ///< the starting point of rows when interpolating
     vector<vector<OCP_DBL>> data; ///< data of the table, data[i] is the ith column.
+    vector<OCP_DBL>         rowData; ///< data stored row by row
+    /// slopes[j][i*nCol+k]: slope of column k over column j in the interval of row i.
+    vector<vector<OCP_DBL>> slopes;
+    vector<OCP_DBL>         invStep; ///< 1/step of uniformly spaced columns, 0 for others
 };
 
 #endif /* end if __OCP_TABLE_HEADER__ */
@@ -102,4 +127,5 @@ private:
 /*----------------------------------------------------------------------------*/
 /*  Shizhe Li           Oct/01/2021      Create file                          */
 /*  Chensong Zhang      Oct/15/2021      Format file                          */
+/*  OpenCAEPoro team    Oct/16/2026      Stateless evaluation, direct lookup  */
 /*----------------------------------------------------------------------------*/
\ No newline at end of file
@@ -19,6 +19,7 @@
 
 // OpenCAEPoro header files
 #include "OCPConst.hpp"
+#include "UtilCheckpoint.hpp"
 #include "UtilInput.hpp"
 
 /// Tuning is a set of param of control, which contains three main parts
@@ -32,9 +33,16 @@ typedef vector<vector<OCP_DBL>> TUNING;
 class TuningPair
 {
 public:
+    TuningPair() = default;
     TuningPair(const USI& t, const TUNING& tmp)
         : d(t)
         , Tuning(tmp){};
+    /// Save or load the params.
+    void SyncCheckpoint(OCPCheckpoint& ckpt)
+    {
+        ckpt.Sync(d);
+        ckpt.Sync(Tuning);
+    }
     USI    d;
     TUNING Tuning;
 };
@@ -57,6 +65,16 @@ public:
 
     /// Assign default values to parameters.
     void Init(string& indir);
+    /// Save or load all params of control.
+    void SyncCheckpoint(OCPCheckpoint& ckpt)
+    {
+        ckpt.Sync(dir);
+        ckpt.Sync(method);
+        ckpt.Sync(linearSolve);
+        ckpt.Sync(tuning_T);
+        ckpt.Sync(tuning);
+        ckpt.Sync(criticalTime);
+    }
     /// Init the critical time.
     void InitTime() { criticalTime.push_back(0); };
     /// Determine the default discrete method.
@@ -80,4 +98,5 @@ public:
 /*----------------------------------------------------------------------------*/
 /*  Shizhe Li           Oct/01/2021      Create file                          */
 /*  Chensong Zhang      Oct/15/2021      Format file                          */
+/*  OpenCAEPoro team    Oct/16/2026      Sync params for the deck cache       */
 /*----------------------------------------------------------------------------*/
\ No newline at end of file
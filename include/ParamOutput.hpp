@@ -17,6 +17,7 @@
 #include <vector>
 
 // OpenCAEPoro header files
+#include "UtilCheckpoint.hpp"
 #include "UtilInput.hpp"
 
 /// A structure of three-dimensional coordinates.
@@ -37,6 +38,13 @@ public:
 class Type_B_o
 {
 public:
+    /// Save or load the params.
+    void SyncCheckpoint(OCPCheckpoint& ckpt)
+    {
+        ckpt.Sync(activity);
+        ckpt.Sync(obj);
+    }
+
     bool           activity{false};
     vector<COOIJK> obj;
 };
@@ -45,6 +53,13 @@ public:
 class Type_A_o
 {
 public:
+    /// Save or load the params.
+    void SyncCheckpoint(OCPCheckpoint& ckpt)
+    {
+        ckpt.Sync(activity);
+        ckpt.Sync(obj);
+    }
+
     bool           activity{false};
     vector<string> obj;
 };
@@ -55,6 +70,9 @@ class OutputSummary
 {
 
 public:
+    /// Save or load the params.
+    void SyncCheckpoint(OCPCheckpoint& ckpt);
+
     bool FPR{false};  ///< Field average Pressure.
     bool FOPR{false}; ///< Field oil production rate.
     bool FOPT{false}; ///< Field total oil production.
@@ -125,6 +143,13 @@ public:
     OutputSummary summary;    ///< See OutputSummary.
     OutputDetail  detailInfo; ///< See OutputDetail.
 
+    /// Save or load all params of output.
+    void SyncCheckpoint(OCPCheckpoint& ckpt)
+    {
+        ckpt.Sync(summary);
+        ckpt.Sync(detailInfo);
+    }
+
     /// Input the keyword SUMMARY, which contains many subkeyword, indicating which
     /// results are interested by user. After the simulation, these results will be
     /// output into a summary file.
@@ -150,4 +175,5 @@ public:
 /*----------------------------------------------------------------------------*/
 /*  Shizhe Li           Oct/01/2021      Create file                          */
 /*  Chensong Zhang      Oct/15/2021      Format file                          */
+/*  OpenCAEPoro team    Oct/16/2026      Sync params for the deck cache       */
 /*----------------------------------------------------------------------------*/
\ No newline at end of file
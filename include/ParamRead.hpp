@@ -25,6 +25,7 @@
 #include "ParamOutput.hpp"
 #include "ParamReservoir.hpp"
 #include "ParamWell.hpp"
+#include "UtilProfiler.hpp"
 
 using namespace std;
 
@@ -35,6 +36,7 @@ public:
     string inputFile; ///< Input file with its path (absolute or relative).
     string workDir;   ///< Current work directory.
     string fileName;  ///< File name of input file.
+    vector<string> fileList; ///< Input file and INCLUDE files in the order read.
 
     // Main workloads for ParamRead: read reservoir params, read well params,
     // read control params, and read output param. These workloads are assigned
@@ -62,6 +64,9 @@ public:
 
     /// Check whether the params contain error.
     void CheckParam();
+
+    /// Save or load all params read from input files.
+    void SyncCheckpoint(OCPCheckpoint& ckpt);
 };
 
 #endif /* end if __PARAMREAD_HEADER__ */
@@ -73,4 +78,5 @@ public:
 /*----------------------------------------------------------------------------*/
 /*  Shizhe Li           Oct/01/2021      Create file                          */
 /*  Chensong Zhang      Oct/16/2021      Format file                          */
-/*----------------------------------------------------------------------------*/
\ No newline at end of file
+/*  OpenCAEPoro team    Oct/16/2026      Sync params for the deck cache       */
+/*----------------------------------------------------------------------------*/
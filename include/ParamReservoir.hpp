@@ -18,6 +18,7 @@
 
 // OpenCAEPoro header files
 #include "OCPConst.hpp"
+#include "UtilCheckpoint.hpp"
 #include "UtilInput.hpp"
 
 using namespace std;
@@ -28,6 +29,7 @@ class TableSet
 {
 public:
     void DisplayTable() const; ///< Print table
+    void SyncCheckpoint(OCPCheckpoint& ckpt); ///< Save or load the table set
 
 public:
     string                          name;   ///< Name of table.
@@ -57,6 +59,13 @@ public:
 template <typename T> class Type_A_r
 {
 public:
+    /// Save or load the param.
+    void SyncCheckpoint(OCPCheckpoint& ckpt)
+    {
+        ckpt.Sync(activity);
+        ckpt.Sync(data);
+    }
+
     bool      activity{false}; ///< If false, this param is not given.
     vector<T> data;            ///< Data of param.
 };
@@ -88,6 +97,8 @@ public:
     void InputSSMSP(ifstream& ifs);
     void InputNRSP(ifstream& ifs);
     void InputRR(ifstream& ifs);
+    /// Save or load the params.
+    void SyncCheckpoint(OCPCheckpoint& ckpt);
 
 public:
     USI NTPVT{1}; ///< num of EoS region, constant now.
@@ -123,6 +134,9 @@ public:
 class Miscstr
 {
 public:
+    /// Save or load the params.
+    void SyncCheckpoint(OCPCheckpoint& ckpt) { ckpt.Sync(surTenRef); }
+
     vector<OCP_DBL> surTenRef;
     // 0th entry: reference surface tension - flow is immiscible when the surface tension is greater than or equal to this value.
     // 1th entry: maximum surface tension expected, it should be greater than surTenRef.
@@ -149,6 +163,8 @@ public:
     // Corner point geometry
     vector<OCP_DBL> coord; ///< TODO: Add Doxygen.
     vector<OCP_DBL> zcorn; ///< TODO: Add Doxygen.
+    OCP_ULL         gridBytes{0};  ///< Bytes of grid arrays read by InputGRID.
+    OCP_DBL         gridTime{0};   ///< Time of reading grid arrays in ms.
 
     // Rock
     vector<OCP_DBL> ntg;    ///< Net to gross for each grid.
@@ -220,6 +236,9 @@ public:
     /// Initialize the default value in reservoir, such as temperature, density, table.
     void Init();
 
+    /// Save or load all params read from the input file.
+    void SyncCheckpoint(OCPCheckpoint& ckpt);
+
     /// Initialize the tables' name and num of colum.
     void InitTable();
 
@@ -257,7 +276,10 @@ public:
 
     /// Input the keyword about grids, actually, it's a supplement for EQUALS.
     /// It supplies another way to input the params in EQUALS.
-    void InputGRID(ifstream& ifs, string& keyword);
+    void InputGRID(ifstream& ifs, MappedFile& file, string& keyword);
+
+    /// Display the size and parse rate of grid arrays read by InputGRID.
+    void DisplayGRID() const;
 
     /// Input the keyword: COPY. COPY could copy the value of one variable to another.
     void InputCOPY(ifstream& ifs);
@@ -344,4 +366,7 @@ public:
 /*  Shizhe Li           Oct/01/2021      Create file                          */
 /*  Chensong Zhang      Oct/15/2021      Format file                          */
 /*  Chensong Zhang      Jan/09/2022      Update Doxygen                       */
+/*  OpenCAEPoro team    Oct/16/2026      Measure parse rate of grid arrays    */
+/*  OpenCAEPoro team    Oct/16/2026      Read grid arrays from mapped files   */
+/*  OpenCAEPoro team    Oct/16/2026      Sync params for the deck cache       */
 /*----------------------------------------------------------------------------*/
\ No newline at end of file
@@ -19,6 +19,7 @@
 
 // OpenCAEPoro header files
 #include "OCPConst.hpp"
+#include "UtilCheckpoint.hpp"
 #include "UtilInput.hpp"
 
 using namespace std;
@@ -28,7 +29,10 @@ using namespace std;
 class WellOptParam
 {
 public:
+    WellOptParam() = default;
     WellOptParam(string intype, vector<string>& vbuf);
+    /// Save or load the params.
+    void SyncCheckpoint(OCPCheckpoint& ckpt);
     // WCONINJE & WCONPROD
     string type;      ///< Type of well, injection or production?
     string fluidType; ///< Type of fluid into the injection well. (injection well only)
@@ -49,9 +53,16 @@ public:
 class WellOptPair
 {
 public:
+    WellOptPair() = default;
     WellOptPair(USI i, string type, vector<string>& vbuf)
         : d(i)
         , opt(type, vbuf){};
+    /// Save or load the params.
+    void SyncCheckpoint(OCPCheckpoint& ckpt)
+    {
+        ckpt.Sync(d);
+        ckpt.Sync(opt);
+    }
     USI          d;
     WellOptParam opt;
 };
@@ -60,7 +71,10 @@ public:
 class WellParam
 {
 public:
+    WellParam() = default;
     WellParam(vector<string>& info);
+    /// Save or load the params.
+    void SyncCheckpoint(OCPCheckpoint& ckpt);
     // static infomation
     // WELSPECS
     string  name;           ///< Name of Well
@@ -89,6 +103,12 @@ class Solvent
 public:
     Solvent() = default;
     Solvent(const vector<string>& vbuf);
+    /// Save or load the params.
+    void SyncCheckpoint(OCPCheckpoint& ckpt)
+    {
+        ckpt.Sync(name);
+        ckpt.Sync(comRatio);
+    }
     string          name;
     vector<OCP_DBL> comRatio;
 };
@@ -106,6 +126,13 @@ public:
 
     /// Initialize the inputting the params of wells.
     void Init() { InitTime(); };
+    /// Save or load all params of wells.
+    void SyncCheckpoint(OCPCheckpoint& ckpt)
+    {
+        ckpt.Sync(well);
+        ckpt.Sync(criticalTime);
+        ckpt.Sync(solSet);
+    }
     /// Initialize the critical time.
     void InitTime() { criticalTime.push_back(0); };
     /// Input the well keyword WELSPECS. WELSPECS defines wells including well name,
@@ -150,4 +177,5 @@ public:
 /*----------------------------------------------------------------------------*/
 /*  Shizhe Li           Oct/01/2021      Create file                          */
 /*  Chensong Zhang      Oct/15/2021      Format file                          */
+/*  OpenCAEPoro team    Oct/16/2026      Sync params for the deck cache       */
 /*----------------------------------------------------------------------------*/
\ No newline at end of file
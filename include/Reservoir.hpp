@@ -15,9 +15,11 @@
 // OpenCAEPoro header files
 #include "Bulk.hpp"
 #include "BulkConn.hpp"
+#include "DeckCache.hpp"
 #include "Grid.hpp"
 #include "ParamRead.hpp"
 #include "AllWells.hpp"
+#include "UtilProfiler.hpp"
 
 /// Reservoir is the core component in our simulator, it contains the all reservoir
 /// information, and all operations on it.
@@ -51,7 +53,10 @@ public:
     /// input files.
     void InputParam(ParamRead& param);
     /// Setup static information for reservoir with input params.
-    void Setup();
+    void Setup(const USI& bulkOrder = BULK_NATURAL);
+    /// Setup static information, taking the grid and connections from the deck cache
+    /// if the params came from it, otherwise adding them to the cache.
+    void Setup(DeckCache& cache, const USI& bulkOrder);
     /// Apply the control of ith critical time point.
     void ApplyControl(const USI& i);
     /// Calculate Well Properties at the beginning of each time step.
@@ -82,8 +87,12 @@ public:
     USI GetWellNum() const { return allWells.GetWellNum(); }
     /// Return the num of Components
     USI GetComNum() const { return bulk.GetComNum(); }
+    /// Return the mixture model, BLKOIL or EOS_PVTW
+    USI GetMixMode() const { return bulk.GetMixMode(); }
     void SetupWellBulk() { allWells.SetupWellBulk(bulk); }
     void GetNTQT(const OCP_DBL& dt);
+    /// Save or load the dynamic state of bulks, connections, and wells.
+    void SyncCheckpoint(OCPCheckpoint& ckpt);
 
 private:
     Grid      grid;      ///< Grid class.
@@ -145,6 +154,8 @@ public:
     /// Calculate Flash for FIM, some derivatives are needed
     void CalFlashDerivFIM();
     void CalFlashDerivFIM_n();
+    /// Calculate fugacities of each bulk for ocp_bench, see Bulk::CalFugPhiBulks.
+    void CalFugPhiBulks(const bool& ref) { bulk.CalFugPhiBulks(ref); }
     /// Calculate Relative Permeability and Capillary and some derivatives for each Bulk
     void CalKrPcDerivFIM();
     /// Update value of last step for FIM.
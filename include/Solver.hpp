@@ -26,6 +26,10 @@ public:
     void InitReservoir(Reservoir& rs) const;
     /// Start simulation.
     void RunSimulation(Reservoir& rs, OCPControl& ctrl, OCPOutput& output);
+    /// Load the state of a checkpoint after initialization.
+    void Restart(Reservoir& rs, OCPControl& ctrl, OCPOutput& output);
+    /// Print statistics of linear systems.
+    void PrintLinearInfo(ostream& out) const { IsoTSolver.PrintLinearInfo(out); }
 
 private:
     /// Run one time step.
@@ -42,12 +46,16 @@ private:
     bool FinishNR(Reservoir& rs, OCPControl& ctrl);
     /// Finish the current time step.
     void FinishStep(Reservoir& rs, OCPControl& ctrl);
+    /// Save or load the state of a checkpoint.
+    void SyncCheckpoint(Reservoir& rs, OCPControl& ctrl, OCPOutput& output);
 
 private:
     /// Solver for isothermal models with fixed T
     IsothermalSolver IsoTSolver;
     /// Linear solver
     LinearSystem LSolver;
+    /// Checkpoint of the simulator state
+    OCPCheckpoint ckpt;
 };
 
 #endif /* end if __SOLVER_HEADER__ */
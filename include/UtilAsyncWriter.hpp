@@ -0,0 +1,68 @@
+/*! \file    UtilAsyncWriter.hpp
+ *  \brief   Background thread writing output snapshots
+ *  \author  OpenCAEPoro team
+ *  \date    Oct/16/2026
+ *
+ *-----------------------------------------------------------------------------------
+ *  Copyright (C) 2021--present by the OpenCAEPoro team. All rights reserved.
+ *  Released under the terms of the GNU Lesser General Public License 3.0 or later.
+ *-----------------------------------------------------------------------------------
+ */
+
+#ifndef __UTILASYNCWRITER_HEADER__
+#define __UTILASYNCWRITER_HEADER__
+
+// Standard header files
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+using namespace std;
+
+/// Formats and writes output snapshots in a background thread.
+//  Note: A job owns a snapshot of the fields to write, so the solver goes on with the
+//  next time step while the job runs. Post waits while a job is still queued, hence at
+//  most two snapshots exist: one being written and one just handed over. Jobs run in
+//  the order they are posted. Pending jobs are finished by Wait, by the destructor, and
+//  by OCP_ABORT before the program aborts.
+class OCPAsyncWriter
+{
+public:
+    ~OCPAsyncWriter() { Stop(); }
+
+    /// Start the background thread, jobs run in the caller before it's started.
+    void Start();
+    /// Hand a job over to the background thread.
+    void Post(function<void()> job);
+    /// Wait until all posted jobs are done.
+    void Wait();
+    /// Finish all posted jobs and stop the background thread.
+    void Stop();
+
+private:
+    /// Loop of the background thread.
+    void Run();
+    /// Finish pending jobs of the running writer when OCP_ABORT is called.
+    static void FlushOnAbort();
+
+private:
+    mutex                    mtx;          ///< Guards the members below
+    condition_variable       cv;           ///< Signals changes of jobs and busy
+    deque<function<void()>>  jobs;         ///< Jobs not started yet
+    bool                     busy{false};  ///< If a job is running
+    bool                     stop{false};  ///< If the thread should quit when idle
+    thread                   writer;       ///< Background thread
+    static OCPAsyncWriter*   running;      ///< Writer with a background thread
+};
+
+#endif /* end if __UTILASYNCWRITER_HEADER__ */
+
+/*----------------------------------------------------------------------------*/
+/*  Brief Change History of This File                                         */
+/*----------------------------------------------------------------------------*/
+/*  Author              Date             Actions                              */
+/*----------------------------------------------------------------------------*/
+/*  OpenCAEPoro team    Oct/16/2026      Create file                          */
+/*----------------------------------------------------------------------------*/
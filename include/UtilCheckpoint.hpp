@@ -0,0 +1,114 @@
+/*! \file    UtilCheckpoint.hpp
+ *  \brief   Binary checkpoint of the simulator state
+ *  \author  OpenCAEPoro team
+ *  \date    Oct/16/2026
+ *
+ *-----------------------------------------------------------------------------------
+ *  Copyright (C) 2021--present by the OpenCAEPoro team. All rights reserved.
+ *  Released under the terms of the GNU Lesser General Public License 3.0 or later.
+ *-----------------------------------------------------------------------------------
+ */
+
+#ifndef __UTILCHECKPOINT_HEADER__
+#define __UTILCHECKPOINT_HEADER__
+
+// Standard header files
+#include <cstring>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+// OpenCAEPoro header files
+#include "OCPConst.hpp"
+#include "UtilError.hpp"
+
+using namespace std;
+
+/// A binary image of the dynamic state, written at the end of a TSTEP.
+//  Note: Each class syncs its own members with SyncCheckpoint(ckpt), which writes them
+//  when saving and reads them back in the same order when loading, so a single list
+//  of members serves both ways. The image is built in memory and written to disk by a
+//  background thread, so the run only waits for copying the state.
+class OCPCheckpoint
+{
+public:
+    ~OCPCheckpoint() { Wait(); }
+
+    /// Start a new image in memory.
+    void BeginSave();
+    /// Read an image from file for loading.
+    void BeginLoad(const string& file);
+    /// Read an image from file for loading, return false if it is not a valid image.
+    bool TryBeginLoad(const string& file);
+    /// Return true if members are written into the image.
+    bool IsSaving() const { return saving; }
+    /// Write the image to file in the background, replacing the file when done.
+    void WriteAsync(const string& file);
+    /// Wait until the last image is on disk.
+    void Wait();
+    /// Abort if the image has not been read to its end, then release it.
+    void EndLoad();
+
+    /// Sync a scalar, or a class with its own SyncCheckpoint.
+    template <typename T> void Sync(T& v)
+    {
+        SyncItem(v, is_trivially_copyable<T>());
+    }
+    /// Sync a vector, its length is restored when loading.
+    template <typename T> void Sync(vector<T>& v)
+    {
+        OCP_USI len = v.size();
+        Sync(len);
+        if (!saving) v.resize(len);
+        SyncItems(v, is_trivially_copyable<T>());
+    }
+    /// Sync a string.
+    void Sync(string& v);
+    /// Sync a vector of bool, which is not stored contiguously.
+    void Sync(vector<bool>& v);
+    /// Check a value of the deck, abort if a loaded image does not match it.
+    template <typename T> void Check(const T& v, const string& name)
+    {
+        T tmp = v;
+        Sync(tmp);
+        if (!saving && memcmp(&tmp, &v, sizeof(T)) != 0)
+            OCP_ABORT("Checkpoint does not match the input file: " + name);
+    }
+
+private:
+    /// Copy bytes from or to the image.
+    void SyncBytes(void* p, const size_t& n);
+    /// Sync plain data as bytes.
+    template <typename T> void SyncItem(T& v, true_type) { SyncBytes(&v, sizeof(T)); }
+    /// Sync a class member by member.
+    template <typename T> void SyncItem(T& v, false_type) { v.SyncCheckpoint(*this); }
+    /// Sync a vector of plain data as bytes.
+    template <typename T> void SyncItems(vector<T>& v, true_type)
+    {
+        SyncBytes(v.data(), v.size() * sizeof(T));
+    }
+    /// Sync a vector item by item.
+    template <typename T> void SyncItems(vector<T>& v, false_type)
+    {
+        for (auto& e : v) Sync(e);
+    }
+
+private:
+    bool         saving{true}; ///< Save or load
+    vector<char> buf;          ///< Image being built or read
+    size_t       pos{0};       ///< Read position in buf
+    vector<char> outBuf;       ///< Image being written by writer
+    thread       writer;       ///< Background writer
+};
+
+#endif /* end if __UTILCHECKPOINT_HEADER__ */
+
+/*----------------------------------------------------------------------------*/
+/*  Brief Change History of This File                                         */
+/*----------------------------------------------------------------------------*/
+/*  Author              Date             Actions                              */
+/*----------------------------------------------------------------------------*/
+/*  OpenCAEPoro team    Oct/16/2026      Create file                          */
+/*  OpenCAEPoro team    Oct/16/2026      Sync strings and nested classes      */
+/*----------------------------------------------------------------------------*/
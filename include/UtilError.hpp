@@ -41,12 +41,31 @@
         OCP_MESSAGE("### WARNING: " << (msg));                                         \
     } while (false)
 
+/// Function called by OCP_ABORT before aborting, such as to flush pending output
+typedef void (*OCPAbortHandler)();
+
+/// Return the handler called by OCP_ABORT, nullptr if there is none
+inline OCPAbortHandler& GetAbortHandler()
+{
+    static OCPAbortHandler handler = nullptr;
+    return handler;
+}
+
+/// Call the abort handler once, it's cleared first in case it aborts itself
+inline void RunAbortHandler()
+{
+    OCPAbortHandler handler = GetAbortHandler();
+    GetAbortHandler()       = nullptr;
+    if (handler != nullptr) handler();
+}
+
 /// Abort if critical error happens
 //  msg: user-defined abort message
 //  We use do-while to allow the macro to be ended with ";"
 #define OCP_ABORT(msg)                                                                 \
     do {                                                                               \
         OCP_MESSAGE("### ABORT: " << (msg));                                           \
+        RunAbortHandler();                                                             \
         std::abort();                                                                  \
     } while (false)
 
@@ -90,4 +109,5 @@
 /*  Shizhe Li           Oct/01/2021      Create file                          */
 /*  Chensong Zhang      Oct/15/2021      Format file                          */
 /*  Chensong Zhang      Nov/15/2021      Test DEBUG mode                      */
+/*  OpenCAEPoro team    Oct/16/2026      Add abort handler                    */
 /*----------------------------------------------------------------------------*/
\ No newline at end of file
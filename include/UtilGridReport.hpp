@@ -0,0 +1,121 @@
+/*! \file    UtilGridReport.hpp
+ *  \brief   Grid arrays of the detail report in text and binary files
+ *  \author  OpenCAEPoro team
+ *  \date    Oct/16/2026
+ *
+ *-----------------------------------------------------------------------------------
+ *  Copyright (C) 2021--present by the OpenCAEPoro team. All rights reserved.
+ *  Released under the terms of the GNU Lesser General Public License 3.0 or later.
+ *-----------------------------------------------------------------------------------
+ */
+
+#ifndef __UTILGRIDREPORT_HEADER__
+#define __UTILGRIDREPORT_HEADER__
+
+// Standard header files
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// OpenCAEPoro header files
+#include "OCPConst.hpp"
+
+using namespace std;
+
+/// Layout of grids needed to print grid arrays as text.
+class GridLayout
+{
+public:
+    USI             nx;       ///< Num of grids along x-direction
+    USI             ny;       ///< Num of grids along y-direction
+    USI             nz;       ///< Num of grids along z-direction
+    USI             digits;   ///< Width of an index in the IJK label of a row
+    vector<OCP_INT> activeId; ///< Active bulk of each grid, -1 if the grid is inactive
+};
+
+/// A grid array of the detail report with the format of its text.
+//  Note: Values are stored for active grids only. A NaN value stands for a phase
+//  which does not exist, it's printed as "0.0...N". Inactive grids are printed as
+//  "-----  " if width is 12, and " --- " otherwise.
+class GridArray
+{
+public:
+    string          name;       ///< Key of the array, such as PRESSURE, XMF1
+    string          title;      ///< Title line in the text report
+    USI             width;      ///< Width of a value in text, 12 or 10
+    USI             prec;       ///< Precision of a value in text
+    USI             layerBreak; ///< Num of extra line breaks before each layer in text
+    USI             endBreak;   ///< Num of line breaks after the array in text
+    bool            sep;        ///< If a separating line is printed before the title
+    vector<OCP_DBL> val;        ///< Values of active grids
+};
+
+/// Print a grid array of report time days as RPT.out does.
+void PrintGridArray(ostream& out, const GridLayout& grid, const GridArray& a,
+                    const OCP_DBL& days);
+
+/// Print the head of a report time with the information of wells as RPT.out does.
+void PrintReportHead(ostream& out, const string& wellInfo);
+
+/// Binary detail report with one array per property per report time.
+//  Note: The file starts with a magic word, the position of the last report index and
+//  the layout of grids. Each report time appends its arrays and then its index, which
+//  lists name, format, position and length of every array and links to the index of
+//  the previous report. The head is updated only after a report is on disk, so the
+//  file is readable at any time, and a reader seeks to any time or property through
+//  the indices without reading the arrays in between.
+class GridReportFile
+{
+public:
+    /// An array or the well information of a report time.
+    class Entry
+    {
+    public:
+        GridArray head;       ///< Name and format of the array, no values
+        OCP_ULL   offset;     ///< Position of the values in file
+        OCP_ULL   count;      ///< Num of values, or chars for the well information
+    };
+    /// Index of a report time.
+    class Report
+    {
+    public:
+        OCP_DBL       days;   ///< Report time
+        Entry         wells;  ///< The well information
+        vector<Entry> arrays; ///< Grid arrays
+    };
+
+    /// Create a file with the layout of grids.
+    void Create(const string& file, const GridLayout& grid);
+    /// Append a report time and update the head.
+    void Append(const OCP_DBL& days, const string& wellInfo,
+                const vector<GridArray>& arrays);
+    /// Open a file and read the layout and all report indices.
+    void Open(const string& file);
+    /// Return the layout of grids.
+    const GridLayout& GetLayout() const { return grid; }
+    /// Return the report times in order.
+    const vector<Report>& GetReports() const { return reports; }
+    /// Read the well information of a report.
+    void ReadWells(const Report& r, string& wellInfo);
+    /// Read the values of an array, together with its name and format.
+    void ReadArray(const Entry& e, GridArray& a);
+    /// Write all report times as text, the same as RPT.out.
+    void PrintText(ostream& out);
+
+private:
+    fstream        fs;      ///< File stream
+    GridLayout     grid;    ///< Layout of grids
+    OCP_ULL        lastPos; ///< Position of the index of the last report, 0 if none
+    vector<Report> reports; ///< Report indices, filled by Open
+};
+
+#endif /* end if __UTILGRIDREPORT_HEADER__ */
+
+/*----------------------------------------------------------------------------*/
+/*  Brief Change History of This File                                         */
+/*----------------------------------------------------------------------------*/
+/*  Author              Date             Actions                              */
+/*----------------------------------------------------------------------------*/
+/*  OpenCAEPoro team    Oct/16/2026      Create file                          */
+/*----------------------------------------------------------------------------*/
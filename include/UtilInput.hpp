@@ -49,6 +49,50 @@ constexpr inline long long Map_Str2Int(const char* mystr, const USI& len)
 /// end of file.
 bool ReadLine(ifstream& ifs, vector<string>& result);
 
+/// Minimum bytes of a grid array given to one thread by ReadNumbers
+const OCP_USI NUM_CHUNK_BYTES = 4 * 1024 * 1024;
+
+/// A read-only view of a whole input file in memory.
+//  Note: The file is mapped on the first call of Map(), so a file without large arrays
+//  is never mapped. The system pages it in as it is read.
+class MappedFile
+{
+public:
+    explicit MappedFile(const string& file) : name(file) {};
+    ~MappedFile();
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    /// Map the file if it has not been mapped.
+    void Map();
+    /// Return the first byte of the file.
+    const char* Data() const { return data; }
+    /// Return the size of the file in bytes.
+    OCP_ULL Size() const { return size; }
+    /// Return the name of the file.
+    const string& Name() const { return name; }
+
+private:
+    string      name;            ///< File name
+    bool        mapped{false};   ///< If Map() has been called
+    const char* data{nullptr};   ///< Mapped bytes
+    OCP_ULL     size{0};         ///< Bytes of the file
+#if defined(_CONSOLE) || defined(_WIN32) || defined(_WIN64)
+    void*       handle{nullptr};  ///< File handle
+    void*       mapping{nullptr}; ///< Mapping handle
+#endif
+};
+
+/// ReadNumbers appends the numbers of a grid array to obj until '/' or the end of file,
+/// with m*n expanded to n repeated m times, and returns the bytes it consumed. The
+/// numbers are read from file, the mapped view of ifs, at the current position of ifs,
+/// and ifs is moved behind the line of '/'.
+//  Note: The lines are scanned in place without creating a string for each number;
+//  comments follow the rules of ReadLine, and "--" also ends a line after numbers.
+//  Arrays longer than NUM_CHUNK_BYTES are split into chunks at line ends, which are
+//  parsed by OpenMP threads and joined in order.
+OCP_ULL ReadNumbers(ifstream& ifs, MappedFile& file, vector<OCP_DBL>& obj);
+
 /// DealDefault is used to deal with the expression with asterisk, for example
 /// m*n  -> <n,...,n> size m ,  m* -> <DEFAULT,..., DEFAULT> size m.
 void DealDefault(vector<string>& result);
@@ -0,0 +1,128 @@
+/*! \file    UtilProfiler.hpp
+ *  \brief   Hierarchical stage profiler declaration
+ *  \author  OpenCAEPoro team
+ *  \date    Oct/16/2026
+ *
+ *-----------------------------------------------------------------------------------
+ *  Copyright (C) 2021--present by the OpenCAEPoro team. All rights reserved.
+ *  Released under the terms of the GNU Lesser General Public License 3.0 or later.
+ *-----------------------------------------------------------------------------------
+ */
+
+#ifndef __UTILPROFILER_HEADER__
+#define __UTILPROFILER_HEADER__
+
+// Standard header files
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+// OpenCAEPoro header files
+#include "OCPConst.hpp"
+
+using namespace std;
+
+/// Profiling is off.
+const USI PROFILE_OFF = 0;
+/// Accumulate time of each stage and print a breakdown at the end.
+const USI PROFILE_ON = 1;
+/// Also record every stage call and write a Chrome trace file.
+const USI PROFILE_TRACE = 2;
+
+/// Timing tree of the stages of a run.
+//  Note: Stages are opened and closed by ProfileZone. Each distinct call path is a node
+//  of the tree, so "Flash" under "UpdateProperty" and "Flash" under "Init" are kept
+//  apart. Only the master thread records; zones met inside a parallel region are
+//  ignored. When the profiler is off, a zone costs one branch.
+class StageProfiler
+{
+public:
+    /// Return the profiler of this run.
+    static StageProfiler& Get();
+
+    /// Switch on the profiler with a mode.
+    void Setup(const USI& mode);
+    /// Return true if the profiler is recording.
+    bool IsOn() const { return mode != PROFILE_OFF; }
+    /// Enter a stage as a child of the current stage.
+    void Begin(const char* name);
+    /// Leave the current stage.
+    void End();
+    /// Print the time breakdown of all stages.
+    void PrintInfo(ostream& out) const;
+    /// Write the breakdown and, in trace mode, the Chrome trace into dir.
+    void OutputInfo(const string& dir) const;
+
+private:
+    /// A node of the timing tree
+    class Zone
+    {
+    public:
+        Zone(const char* n, const USI& p) : name(n), parent(p) {};
+        const char* name;      ///< Name of the stage
+        USI         parent;    ///< Parent node
+        vector<USI> child;     ///< Child nodes
+        OCP_DBL     time{0};   ///< Accumulated wall time in ms
+        OCP_USI     calls{0};  ///< Number of calls
+    };
+    /// A closed call of a stage for the Chrome trace
+    class Event
+    {
+    public:
+        USI     zone;  ///< Node of the stage
+        OCP_DBL begin; ///< Begin time in us since Setup
+        OCP_DBL dur;   ///< Duration in us
+    };
+
+    /// Print node z and its children with an indent of depth.
+    void PrintZone(ostream& out, const USI& z, const USI& depth, const OCP_DBL& total) const;
+    /// Return microseconds since Setup.
+    OCP_DBL Now() const;
+
+    USI                                   mode{PROFILE_OFF}; ///< Profiling mode
+    vector<Zone>                          zones;   ///< Timing tree, zones[0] is root
+    USI                                   current; ///< Current node
+    vector<OCP_DBL>                       start;   ///< Begin time of open stages
+    vector<Event>                         events;  ///< Closed calls for the trace
+    std::chrono::steady_clock::time_point t0;      ///< Time of Setup
+};
+
+/// Times the enclosing scope as a stage of the StageProfiler.
+class ProfileZone
+{
+public:
+    explicit ProfileZone(const char* name) : active(StageProfiler::Get().IsOn())
+    {
+#ifdef _OPENMP
+        if (omp_in_parallel()) active = false;
+#endif
+        if (active) StageProfiler::Get().Begin(name);
+    }
+    ~ProfileZone()
+    {
+        if (active) StageProfiler::Get().End();
+    }
+    ProfileZone(const ProfileZone&) = delete;
+    ProfileZone& operator=(const ProfileZone&) = delete;
+
+private:
+    bool active; ///< If the stage is recorded
+};
+
+/// Time the rest of the current scope as stage "name"
+#define OCP_PROFILE(name) ProfileZone ocpProfileZone(name)
+
+#endif /* end if __UTILPROFILER_HEADER__ */
+
+/*----------------------------------------------------------------------------*/
+/*  Brief Change History of This File                                         */
+/*----------------------------------------------------------------------------*/
+/*  Author              Date             Actions                              */
+/*----------------------------------------------------------------------------*/
+/*  OpenCAEPoro team    Oct/16/2026      Create file                          */
+/*----------------------------------------------------------------------------*/
@@ -0,0 +1,87 @@
+/*! \file    UtilSummaryFile.hpp
+ *  \brief   Append-only binary file of the summary items of each time step
+ *  \author  OpenCAEPoro team
+ *  \date    Oct/16/2026
+ *
+ *-----------------------------------------------------------------------------------
+ *  Copyright (C) 2021--present by the OpenCAEPoro team. All rights reserved.
+ *  Released under the terms of the GNU Lesser General Public License 3.0 or later.
+ *-----------------------------------------------------------------------------------
+ */
+
+#ifndef __UTILSUMMARYFILE_HEADER__
+#define __UTILSUMMARYFILE_HEADER__
+
+// Standard header files
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// OpenCAEPoro header files
+#include "OCPConst.hpp"
+
+using namespace std;
+
+/// The SumPair class describes an item of the summary file.
+class SumPair
+{
+public:
+    SumPair() = default;
+    SumPair(const string& item, const string& obj, const string& unit)
+        : Item(item)
+        , Obj(obj)
+        , Unit(unit){};
+    string Item;
+    string Obj;
+    string Unit;
+};
+
+/// Summary items of each time step, streamed to a binary file.
+//  Note: The file starts with a magic word and the index of items, i.e., name, object
+//  and unit of each column. Then each time step appends a row with the values of all
+//  items, which is flushed at once, so the memory use does not grow with time steps
+//  and a crashed run keeps every finished step. Num of rows is given by the size of the
+//  file, a partly written row is ignored.
+class SummaryFile
+{
+public:
+    /// Create a file with the index of items.
+    void Create(const string& file, const vector<SumPair>& items);
+    /// Keep the first nrow rows of a file written by an earlier run and append to it.
+    void Resume(const string& file, const vector<SumPair>& items, const OCP_ULL& nrow);
+    /// Append a row and flush it.
+    void Append(const vector<OCP_DBL>& row);
+    /// Open a file for reading.
+    void Open(const string& file);
+    /// Return the items of each row.
+    const vector<SumPair>& GetItems() const { return items; }
+    /// Return num of rows.
+    OCP_ULL GetNumRows() const { return numRows; }
+    /// Read the n-th row.
+    void ReadRow(const OCP_ULL& n, vector<OCP_DBL>& row);
+    /// Print the first nrow rows in blocks of 10 columns, the same as SUMMARY.out.
+    void PrintText(ostream& out, const OCP_ULL& nrow);
+    /// Print the first nrow rows as comma separated values.
+    void PrintCSV(ostream& out, const OCP_ULL& nrow);
+
+private:
+    /// Write the magic word and the index of items.
+    void WriteHead();
+
+private:
+    fstream         fs;         ///< File stream
+    vector<SumPair> items;      ///< Index of items
+    OCP_ULL         dataPos{0}; ///< Position of the first row
+    OCP_ULL         numRows{0}; ///< Num of rows
+};
+
+#endif /* end if __UTILSUMMARYFILE_HEADER__ */
+
+/*----------------------------------------------------------------------------*/
+/*  Brief Change History of This File                                         */
+/*----------------------------------------------------------------------------*/
+/*  Author              Date             Actions                              */
+/*----------------------------------------------------------------------------*/
+/*  OpenCAEPoro team    Oct/16/2026      Create file                          */
+/*----------------------------------------------------------------------------*/
@@ -176,6 +176,9 @@ public:
     OCP_DBL GetPerfPre(const USI& p) const { return perf[p].P; }
     /// Display operation mode of well and state of perforations.
     void ShowPerfStatus(const Bulk& myBulk) const;
+    /// Save or load the well pressure, rates, and states of perforations.
+    //  Note: opt is not included, it's reset from optSet at each critical time.
+    void SyncCheckpoint(OCPCheckpoint& ckpt);
     
 
 private:
@@ -66,6 +66,9 @@ private:
                             ///< perforation.
     OCP_DBL qt_ft3;         ///< Flow rate of volume of fluids from into/out current
                             ///< perforation.
+    /// Slot of the well in the matrix row of the connected bulk, it's recorded when
+    /// the sparsity pattern is built and used when the pattern is reused.
+    mutable USI matPtr{0};
 };
 
 #endif /* end if __PERFORATION_HEADER__ */
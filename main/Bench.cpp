@@ -0,0 +1,183 @@
+/*! \file    Bench.cpp
+ *  \brief   Time the stages of one FIM Newton step in isolation
+ *  \author  OpenCAEPoro team
+ *  \date    Oct/16/2026
+ *
+ *-----------------------------------------------------------------------------------
+ *  Copyright (C) 2021--present by the OpenCAEPoro team. All rights reserved.
+ *  Released under the terms of the GNU Lesser General Public License 3.0 or later.
+ *-----------------------------------------------------------------------------------
+ */
+
+// Standard header files
+#include <algorithm>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// OpenCAEPoro header files
+#include "OCPControl.hpp"
+#include "ParamRead.hpp"
+#include "Reservoir.hpp"
+#include "UtilTiming.hpp"
+
+using namespace std;
+
+/// Default number of repetitions of each stage
+const USI BENCH_NREP = 10;
+
+/// Print usage of the benchmark.
+static void PrintBenchUsage(const string& cmdname)
+{
+    cout << "Usage: " << endl
+         << "  " << cmdname << " <InputFileName> [nrep=<N>] [<options>]" << endl
+         << endl
+         << "The deck is set up once and brought to the first Newton step of FIM;"
+         << endl
+         << "then each stage is repeated N times (default " << BENCH_NREP << ")."
+         << endl
+         << "Other options are passed on as cmd options of the simulator;" << endl
+         << "the method is always FIM." << endl
+         << endl
+         << "For example: time the stages of a scaling deck 20 times" << endl
+         << "  " << cmdname
+         << " examples/scaling/FIM/spe1a_80x80x80.data nrep=20" << endl;
+}
+
+/// Repeat a stage and print the median, min, and throughput of its calls.
+//  Note: prep and post are not timed; they bring the stage to the same input state.
+template <typename Prep, typename Stage, typename Post>
+static void BenchStage(const string& name, const USI& nrep, const OCP_USI& nb,
+                       Prep prep, Stage stage, Post post)
+{
+    vector<OCP_DBL> t(nrep);
+    GetWallTime     timer;
+    for (USI n = 0; n < nrep; n++) {
+        prep();
+        timer.Start();
+        stage();
+        t[n] = timer.Stop();
+        post();
+    }
+    sort(t.begin(), t.end());
+    const OCP_DBL median = nrep % 2 ? t[nrep / 2] : 0.5 * (t[nrep / 2 - 1] + t[nrep / 2]);
+
+    cout << left << setw(20) << name << right << fixed << setprecision(3) << setw(14)
+         << median << setw(14) << t[0] << setw(16) << scientific << setprecision(3)
+         << (median > 0 ? nb / (median / 1000) : 0.0) << endl;
+}
+
+/// Set up a deck once and time flash, fugacity, KrPc, assembly, linear solve, and
+/// residual.
+int main(int argc, const char* argv[])
+{
+    if (argc < 2 || !strcmp(argv[1], "-h") || !strcmp(argv[1], "--help")) {
+        PrintBenchUsage(argv[0]);
+        return argc < 2 ? OCP_ERROR_NUM_INPUT : OCP_SUCCESS;
+    }
+
+    // Split nrep from the options understood by the simulator
+    USI                 nrep = BENCH_NREP;
+    vector<const char*> options{argv[0], argv[1]};
+    bool                setMethod = false;
+    for (int n = 2; n < argc; n++) {
+        if (!strncmp(argv[n], "nrep=", 5)) {
+            nrep = stoi(argv[n] + 5);
+            if (nrep == 0) OCP_ABORT("nrep must be positive!");
+        } else {
+            if (!strncmp(argv[n], "method=", 7)) {
+                if (strcmp(argv[n], "method=FIM")) OCP_ABORT("Only FIM is timed!");
+                setMethod = true;
+            }
+            options.push_back(argv[n]);
+        }
+    }
+    // Use FIM and its linear solver file whatever the deck says
+    if (!setMethod) options.push_back("method=FIM");
+
+    Reservoir    rs;
+    OCPControl   ctrl;
+    LinearSystem myLS;
+    ResFIM       resFIM;
+
+    { // Set up the deck as FIM does
+        ParamRead rp;
+        rp.ReadInputFile(argv[1]);
+        rs.InputParam(rp);
+        ctrl.InputParam(rp.paramControl);
+    }
+    ctrl.SetupFastControl(options.size(), options.data());
+    rs.Setup(ctrl.GetBulkOrder());
+    rs.AllocateAuxFIM();
+    rs.AllocateMatFIM(myLS);
+    resFIM.res.resize((rs.GetBulkNum() + rs.GetWellNum()) * (rs.GetComNum() + 1));
+    myLS.SetupLinearSolver(VECTORFASP, ctrl.GetWorkDir(), ctrl.GetLsFile());
+
+    // Bring the reservoir to the first Newton step
+    rs.InitFIM();
+    rs.ApplyControl(0);
+    ctrl.ApplyControl(0, rs);
+    if (ctrl.GetWellChange()) myLS.ResetPattern();
+    const OCP_DBL dt = ctrl.GetCurDt();
+    rs.PrepareWell();
+    rs.CalWellFlux();
+    rs.CalResFIM(resFIM, dt);
+
+    const OCP_USI nb = rs.GetBulkNum();
+    cout << endl
+         << "=========================================" << endl
+         << "Bulks: " << nb << "   Wells: " << rs.GetWellNum() << "   Repeats: " << nrep
+         << endl
+         << left << setw(20) << "Stage" << right << setw(14) << "Median (ms)" << setw(14)
+         << "Min (ms)" << setw(16) << "Cells/s" << endl;
+
+    auto none = []() {};
+    BenchStage("CalFlashDerivFIM", nrep, nb, none, [&]() { rs.CalFlashDerivFIM(); },
+               none);
+    if (rs.GetMixMode() == EOS_PVTW) {
+        // Fugacity of the EoS, against the expression before Aik was kept
+        BenchStage("CalFugPhi", nrep, nb, none, [&]() { rs.CalFugPhiBulks(false); },
+                   none);
+        BenchStage("CalFugPhi (ref)", nrep, nb, none,
+                   [&]() { rs.CalFugPhiBulks(true); }, none);
+    }
+    BenchStage("CalKrPcDerivFIM", nrep, nb, none, [&]() { rs.CalKrPcDerivFIM(); },
+               none);
+    BenchStage(
+        "AssembleMatFIM", nrep, nb, none, [&]() { rs.AssembleMatFIM(myLS, dt); },
+        [&]() { myLS.ClearData(); });
+
+    USI iters = 0;
+    BenchStage(
+        "Solve", nrep, nb,
+        [&]() {
+            rs.AssembleMatFIM(myLS, dt);
+            myLS.AssembleRhs(resFIM.res);
+            myLS.AssembleMatLinearSolver();
+        },
+        [&]() {
+            OCP_INT status = myLS.Solve();
+            iters += status < 0 ? myLS.GetNumIters() : status;
+        },
+        [&]() { myLS.ClearData(); });
+
+    BenchStage("CalResFIM", nrep, nb, none, [&]() { rs.CalResFIM(resFIM, dt); }, none);
+
+    cout << "Linear iterations per solve: " << fixed << setprecision(1)
+         << 1.0 * iters / nrep << endl
+         << "=========================================" << endl;
+
+    return OCP_SUCCESS;
+}
+
+/*----------------------------------------------------------------------------*/
+/*  Brief Change History of This File                                         */
+/*----------------------------------------------------------------------------*/
+/*  Author              Date             Actions                              */
+/*----------------------------------------------------------------------------*/
+/*  OpenCAEPoro team    Oct/16/2026      Create file                          */
+/*  OpenCAEPoro team    Oct/16/2026      Use the bulk ordering of cmd options */
+/*  OpenCAEPoro team    Oct/17/2026      Time CalFugPhi of EoS                */
+/*----------------------------------------------------------------------------*/
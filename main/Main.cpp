@@ -36,12 +36,16 @@ int main(int argc, const char* argv[])
         }
     }
 
+    // Switch on the stage profiler if `prof' is given, so reading is timed too.
+    simulator.SetupProfiler(argc, argv);
+
     { // Read and process input parameters
         ParamRead rp;
 
         // Step 1. Read params from an input file to internal params data structure.
         // Remark: The keywords are almost compatible with Ecl100/300; see Keywords.md.
-        rp.ReadInputFile(argv[1]);
+        // Remark: With `cache=on', an unchanged deck is loaded from its cache file.
+        simulator.ReadInputFile(rp, argc, argv);
 
         // Step 2. Set params using command-line and params read from input file.
         // Remark: It sets up static info, such as active grids and their connections.
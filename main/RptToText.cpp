@@ -0,0 +1,72 @@
+/*! \file    RptToText.cpp
+ *  \brief   Convert a binary detail report RPT.bin to the text of RPT.out
+ *  \author  OpenCAEPoro team
+ *  \date    Oct/16/2026
+ *
+ *-----------------------------------------------------------------------------------
+ *  Copyright (C) 2021--present by the OpenCAEPoro team. All rights reserved.
+ *  Released under the terms of the GNU Lesser General Public License 3.0 or later.
+ *-----------------------------------------------------------------------------------
+ */
+
+// Standard header files
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+// OpenCAEPoro header files
+#include "OCPConst.hpp"
+#include "UtilError.hpp"
+#include "UtilGridReport.hpp"
+
+using namespace std;
+
+/// Print usage of the converter.
+static void PrintRptUsage(const string& cmdname)
+{
+    cout << "Usage: " << endl
+         << "  " << cmdname << " <RPT.bin> [<OutputFileName>]" << endl
+         << endl
+         << "The binary detail report written with rpt=bin is converted to the" << endl
+         << "text of RPT.out, which is written next to RPT.bin by default." << endl;
+}
+
+/// Read a binary detail report and write it as text.
+int main(int argc, const char* argv[])
+{
+    if (argc < 2 || argc > 3 || !strcmp(argv[1], "-h") || !strcmp(argv[1], "--help")) {
+        PrintRptUsage(argv[0]);
+        return argc < 2 ? OCP_ERROR_NUM_INPUT : OCP_SUCCESS;
+    }
+
+    const string inFile = argv[1];
+    string       outFile;
+    if (argc == 3) {
+        outFile = argv[2];
+    } else {
+        const size_t pos = inFile.find_last_of("/\\");
+        outFile = (pos == string::npos ? "" : inFile.substr(0, pos + 1)) + "RPT.out";
+    }
+
+    GridReportFile rpt;
+    rpt.Open(inFile);
+
+    ofstream outF(outFile);
+    if (!outF.is_open()) OCP_ABORT("Can not open " + outFile);
+    rpt.PrintText(outF);
+    outF.close();
+    if (!outF) OCP_ABORT("Can not write " + outFile);
+
+    cout << rpt.GetReports().size() << " report times are written to " << outFile
+         << endl;
+    return OCP_SUCCESS;
+}
+
+/*----------------------------------------------------------------------------*/
+/*  Brief Change History of This File                                         */
+/*----------------------------------------------------------------------------*/
+/*  Author              Date             Actions                              */
+/*----------------------------------------------------------------------------*/
+/*  OpenCAEPoro team    Oct/16/2026      Create file                          */
+/*----------------------------------------------------------------------------*/
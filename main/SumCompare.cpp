@@ -0,0 +1,118 @@
+/*! \file    SumCompare.cpp
+ *  \brief   Compare a binary summary SUMMARY.bin with a reference in CSV
+ *  \author  OpenCAEPoro team
+ *  \date    Oct/17/2026
+ *
+ *-----------------------------------------------------------------------------------
+ *  Copyright (C) 2021--present by the OpenCAEPoro team. All rights reserved.
+ *  Released under the terms of the GNU Lesser General Public License 3.0 or later.
+ *-----------------------------------------------------------------------------------
+ */
+
+// Standard header files
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// OpenCAEPoro header files
+#include "OCPConst.hpp"
+#include "UtilError.hpp"
+#include "UtilSummaryFile.hpp"
+
+using namespace std;
+
+/// Print usage of the comparer.
+static void PrintCmpUsage(const string& cmdname)
+{
+    cout << "Usage: " << endl
+         << "  " << cmdname << " <SUMMARY.bin> <Reference.csv> [<tol>]" << endl
+         << endl
+         << "The binary summary is compared with a reference written by" << endl
+         << "`ocp_sum2text SUMMARY.bin csv'. Both must have the same items and" << endl
+         << "time steps. The difference of an item must not exceed tol (1e-3 by" << endl
+         << "default) times the maximum of the item in the reference. NRiter and" << endl
+         << "LSiter depend on the linear solver and are not compared." << endl;
+}
+
+/// Read a CSV summary into its header and rows of values.
+static void ReadSumCSV(istream& in, vector<string>& head, vector<vector<OCP_DBL>>& rows)
+{
+    string line, cell;
+    getline(in, line);
+    istringstream hs(line);
+    while (getline(hs, cell, ',')) head.push_back(cell);
+    while (getline(in, line)) {
+        if (line.empty()) continue;
+        istringstream  ls(line);
+        vector<OCP_DBL> row;
+        while (getline(ls, cell, ',')) row.push_back(stod(cell));
+        if (row.size() != head.size()) OCP_ABORT("Wrong num of values in a row!");
+        rows.push_back(row);
+    }
+}
+
+/// Compare a binary summary with a reference, return 0 if they agree.
+int main(int argc, const char* argv[])
+{
+    if (argc < 3 || argc > 4 || !strcmp(argv[1], "-h") || !strcmp(argv[1], "--help")) {
+        PrintCmpUsage(argv[0]);
+        return argc < 3 ? OCP_ERROR_NUM_INPUT : OCP_SUCCESS;
+    }
+    const OCP_DBL tol = argc == 4 ? stod(argv[3]) : 1e-3;
+
+    // The summary goes through the same CSV as the reference
+    SummaryFile  sumFile;
+    stringstream sumCSV;
+    sumFile.Open(argv[1]);
+    sumFile.PrintCSV(sumCSV, sumFile.GetNumRows());
+    vector<string>          head, refHead;
+    vector<vector<OCP_DBL>> rows, refRows;
+    ReadSumCSV(sumCSV, head, rows);
+
+    ifstream refF(argv[2]);
+    if (!refF.is_open()) OCP_ABORT("Can not open " + string(argv[2]));
+    ReadSumCSV(refF, refHead, refRows);
+
+    if (head != refHead) OCP_ABORT("Items differ from the reference!");
+    if (rows.size() != refRows.size()) {
+        cout << rows.size() << " time steps, but " << refRows.size()
+             << " in the reference" << endl;
+        return OCP_ERROR;
+    }
+
+    OCP_INT numFail = 0;
+    for (USI i = 0; i < head.size(); i++) {
+        if (head[i] == "NRiter" || head[i] == "LSiter") continue;
+        OCP_DBL scale = 0, maxDiff = 0;
+        OCP_ULL lmax  = 0;
+        for (OCP_ULL l = 0; l < rows.size(); l++) {
+            scale = max(scale, fabs(refRows[l][i]));
+            if (fabs(rows[l][i] - refRows[l][i]) > maxDiff) {
+                maxDiff = fabs(rows[l][i] - refRows[l][i]);
+                lmax    = l;
+            }
+        }
+        if (maxDiff > tol * scale) {
+            cout << head[i] << " differs by " << maxDiff << " at time step " << lmax + 1
+                 << ", over " << tol << " of " << scale << endl;
+            numFail++;
+        }
+    }
+    if (numFail > 0) return OCP_ERROR;
+
+    cout << rows.size() << " time steps agree with " << argv[2] << " within " << tol
+         << endl;
+    return OCP_SUCCESS;
+}
+
+/*----------------------------------------------------------------------------*/
+/*  Brief Change History of This File                                         */
+/*----------------------------------------------------------------------------*/
+/*  Author              Date             Actions                              */
+/*----------------------------------------------------------------------------*/
+/*  OpenCAEPoro team    Oct/17/2026      Create file                          */
+/*----------------------------------------------------------------------------*/
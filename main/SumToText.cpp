@@ -0,0 +1,82 @@
+/*! \file    SumToText.cpp
+ *  \brief   Convert a binary summary SUMMARY.bin to text or CSV
+ *  \author  OpenCAEPoro team
+ *  \date    Oct/16/2026
+ *
+ *-----------------------------------------------------------------------------------
+ *  Copyright (C) 2021--present by the OpenCAEPoro team. All rights reserved.
+ *  Released under the terms of the GNU Lesser General Public License 3.0 or later.
+ *-----------------------------------------------------------------------------------
+ */
+
+// Standard header files
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+// OpenCAEPoro header files
+#include "OCPConst.hpp"
+#include "UtilError.hpp"
+#include "UtilSummaryFile.hpp"
+
+using namespace std;
+
+/// Print usage of the converter.
+static void PrintSumUsage(const string& cmdname)
+{
+    cout << "Usage: " << endl
+         << "  " << cmdname << " <SUMMARY.bin> [text|csv] [<OutputFileName>]" << endl
+         << endl
+         << "The binary summary is converted to the text of SUMMARY.out (default)," << endl
+         << "or to SUMMARY.csv with one row per time step; the output file is" << endl
+         << "written next to SUMMARY.bin by default. A summary of a running or" << endl
+         << "crashed simulation is converted up to its last finished time step."
+         << endl;
+}
+
+/// Read a binary summary and write it as text or CSV.
+int main(int argc, const char* argv[])
+{
+    if (argc < 2 || argc > 4 || !strcmp(argv[1], "-h") || !strcmp(argv[1], "--help")) {
+        PrintSumUsage(argv[0]);
+        return argc < 2 ? OCP_ERROR_NUM_INPUT : OCP_SUCCESS;
+    }
+
+    const string inFile = argv[1];
+    const string format = argc > 2 ? argv[2] : "text";
+    if (format != "text" && format != "csv") OCP_ABORT("Wrong format: " + format);
+
+    string outFile;
+    if (argc == 4) {
+        outFile = argv[3];
+    } else {
+        const size_t pos = inFile.find_last_of("/\\");
+        outFile = (pos == string::npos ? "" : inFile.substr(0, pos + 1)) +
+                  (format == "csv" ? "SUMMARY.csv" : "SUMMARY.out");
+    }
+
+    SummaryFile sumFile;
+    sumFile.Open(inFile);
+
+    ofstream outF(outFile);
+    if (!outF.is_open()) OCP_ABORT("Can not open " + outFile);
+    if (format == "csv") {
+        sumFile.PrintCSV(outF, sumFile.GetNumRows());
+    } else {
+        sumFile.PrintText(outF, sumFile.GetNumRows());
+    }
+    outF.close();
+    if (!outF) OCP_ABORT("Can not write " + outFile);
+
+    cout << sumFile.GetNumRows() << " time steps are written to " << outFile << endl;
+    return OCP_SUCCESS;
+}
+
+/*----------------------------------------------------------------------------*/
+/*  Brief Change History of This File                                         */
+/*----------------------------------------------------------------------------*/
+/*  Author              Date             Actions                              */
+/*----------------------------------------------------------------------------*/
+/*  OpenCAEPoro team    Oct/16/2026      Create file                          */
+/*----------------------------------------------------------------------------*/
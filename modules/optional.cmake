@@ -124,6 +124,28 @@ if(USE_MUMPS)
 
 endif(USE_MUMPS)
 
+##################################################################
+# For METIS
+##################################################################
+
+if(USE_METIS)
+
+    # set the path to find specific modules
+    set(METIS_DIR "${METIS_DIR}")
+
+    # try to find METIS
+    find_package(METIS)
+
+    if (METIS_FOUND)
+        add_definitions("-DWITH_METIS=1")
+        include_directories(${METIS_INCLUDE_DIRS})
+        set(OPTIONAL_LIBS ${OPTIONAL_LIBS} ${METIS_LIBRARIES})
+    else(METIS_FOUND)
+        message("-- WARNING: METIS was requested but not supported! Continue without it.")
+    endif(METIS_FOUND)
+
+endif(USE_METIS)
+
 ##################################################################
 # For Intel MKL PARDISO
 ##################################################################
@@ -431,6 +431,28 @@ OCP_DBL AllWells::CalWellQT()
     return QT;
 }
 
+void AllWells::SyncCheckpoint(OCPCheckpoint& ckpt)
+{
+    OCP_FUNCNAME;
+
+    ckpt.Check(numWell, "number of wells");
+    for (auto& w : wells) w.SyncCheckpoint(ckpt);
+
+    // Groups are built again at each critical time, only field values are kept
+    ckpt.Sync(dPmax);
+    ckpt.Sync(FGIR);
+    ckpt.Sync(FGIT);
+    ckpt.Sync(FWIR);
+    ckpt.Sync(FWIT);
+    ckpt.Sync(FOPR);
+    ckpt.Sync(FOPT);
+    ckpt.Sync(FGPR);
+    ckpt.Sync(FGPt);
+    ckpt.Sync(FWPR);
+    ckpt.Sync(FWPT);
+    ckpt.Sync(QT);
+}
+
 /////////////////////////////////////////////////////////////////////
 // IMPEC
 /////////////////////////////////////////////////////////////////////
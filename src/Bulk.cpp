@@ -142,6 +142,18 @@ void Bulk::InputParam(ParamReservoir& rs_param)
         cout << "Bulk::InputParam --- COMPOSITIONAL" << endl;
     }
 
+    // Mixture keeps its working variables as members, so each thread flashes with
+    // its own copies. flashCal is kept for wells and serial calls, whose results
+    // then do not depend on which bulks a thread flashed last.
+#ifdef _OPENMP
+    for (OCP_INT t = 0; t < omp_get_max_threads(); t++) {
+        flashCalT.push_back(vector<Mixture*>());
+        for (auto& f : flashCal) flashCalT[t].push_back(f->Clone());
+    }
+#else
+    flashCalT.push_back(flashCal);
+#endif
+
     if (SATmode == PHASE_ODGW01 && miscible) {
         SATmode = PHASE_ODGW01_MISCIBLE;
     }
@@ -179,11 +191,26 @@ void Bulk::InputParam(ParamReservoir& rs_param)
     }
 }
 
+/// Sort bulks by region with a counting sort, bulks of region i are
+/// cell[begin[i], begin[i+1]) in increasing order.
+static void SortByRegion(const vector<USI>& regnum, const USI& nreg,
+                         vector<OCP_USI>& cell, vector<OCP_USI>& begin)
+{
+    begin.assign(nreg + 1, 0);
+    for (auto& r : regnum) begin[r + 1]++;
+    for (USI i = 0; i < nreg; i++) begin[i + 1] += begin[i];
+    cell.resize(regnum.size());
+    vector<OCP_USI> pos(begin.begin(), begin.end() - 1);
+    for (OCP_USI n = 0; n < regnum.size(); n++) cell[pos[regnum[n]]++] = n;
+}
+
 /// Setup bulk information.
 void Bulk::Setup(const Grid& myGrid)
 {
     OCP_FUNCNAME;
 
+    varChanged |= BULK_ALL;
+
     // Rock/Grid properties
 
     numBulk = myGrid.activeGridNum;
@@ -230,6 +257,10 @@ void Bulk::Setup(const Grid& myGrid)
         }
     }
 
+    // Sort bulks by region, so kr, Pc and flash are calculated region by region
+    SortByRegion(SATNUM, NTSFUN, satCell, satBegin);
+    SortByRegion(PVTNUM, NTPVT, pvtCell, pvtBegin);
+
     rockVp = rockVpInit;
     rockKx = rockKxInit;
     rockKy = rockKyInit;
@@ -372,6 +403,8 @@ void Bulk::InitSjPcBo(const USI& tabrow)
 {
     OCP_FUNCNAME;
 
+    varChanged |= BULK_ALL;
+
     OCP_DBL Dref = EQUIL.Dref;
     OCP_DBL Pref = EQUIL.Pref;
     OCP_DBL DOWC = EQUIL.DOWC;
@@ -715,10 +748,12 @@ void Bulk::InitSjPcBo(const USI& tabrow)
         }
     }
 
+    DepthP.SetRowCol();
     DepthP.Display();
 
     // calculate Pc from DepthP to calculate Sj
     std::vector<OCP_DBL> data(4, 0), cdata(4, 0);
+    USI                  hint = 0; // last row of DepthP, cells are close in depth
     // if capillary between water and oil is considered
     vector<bool> FlagPcow(NTSFUN, true);
     for (USI i = 0; i < NTSFUN; i++) {
@@ -729,7 +764,7 @@ void Bulk::InitSjPcBo(const USI& tabrow)
     }
 
     for (OCP_USI n = 0; n < numBulk; n++) {
-        DepthP.Eval_All(0, depth[n], data, cdata);
+        DepthP.Eval_All(0, depth[n], data, cdata, hint);
         OCP_DBL Po   = data[1];
         OCP_DBL Pg   = data[2];
         OCP_DBL Pw   = data[3];
@@ -775,7 +810,7 @@ void Bulk::InitSjPcBo(const USI& tabrow)
             OCP_DBL tmpSw = 0;
             OCP_DBL tmpSg = 0;
             OCP_DBL dep   = depth[n] + dz[n] / ncut * (k - (ncut - 1) / 2.0);
-            DepthP.Eval_All(0, dep, data, cdata);
+            DepthP.Eval_All(0, dep, data, cdata, hint);
             Po    = data[1];
             Pg    = data[2];
             Pw    = data[3];
@@ -813,6 +848,8 @@ void Bulk::InitSjPcComp(const USI& tabrow, const Grid& myGrid)
 {
     OCP_FUNCNAME;
 
+    varChanged |= BULK_ALL;
+
     OCP_DBL Dref = EQUIL.Dref;
     OCP_DBL Pref = EQUIL.Pref;
     OCP_DBL DOWC = EQUIL.DOWC;
@@ -1154,10 +1191,12 @@ void Bulk::InitSjPcComp(const USI& tabrow, const Grid& myGrid)
          << "Poil    "
          << "Pwat    "
          << "Pgas" << endl;
+    DepthP.SetRowCol();
     DepthP.Display();
 
     // calculate Pc from DepthP to calculate Sj
     std::vector<OCP_DBL> data(4, 0), cdata(4, 0);
+    USI                  hint = 0; // last row of DepthP, cells are close in depth
     // if capillary between water and oil is considered
     vector<bool> FlagPcow(NTSFUN, true);
     for (USI i = 0; i < NTSFUN; i++) {
@@ -1173,7 +1212,7 @@ void Bulk::InitSjPcComp(const USI& tabrow, const Grid& myGrid)
             initZi[n * numCom + i] = tmpInitZi[i];
         }
 
-        DepthP.Eval_All(0, depth[n], data, cdata);
+        DepthP.Eval_All(0, depth[n], data, cdata, hint);
         OCP_DBL Po   = data[1];
         OCP_DBL Pw   = data[2];
         OCP_DBL Pg   = data[3];
@@ -1219,7 +1258,7 @@ void Bulk::InitSjPcComp(const USI& tabrow, const Grid& myGrid)
             OCP_DBL tmpSw = 0;
             OCP_DBL tmpSg = 0;
             OCP_DBL dep   = depth[n] + dz[n] / ncut * (k - (ncut - 1) / 2.0);
-            DepthP.Eval_All(0, dep, data, cdata);
+            DepthP.Eval_All(0, dep, data, cdata, hint);
             Po   = data[1];
             Pw   = data[2];
             Pg   = data[3];
@@ -1281,6 +1320,8 @@ void Bulk::InitFlash(const bool& flag)
 {
     OCP_FUNCNAME;
 
+    varChanged |= BULK_PRIMARY | BULK_FLASH;
+
     for (OCP_USI n = 0; n < numBulk; n++) {
         flashCal[PVTNUM[n]]->InitFlash(P[n], Pb[n], T, &S[n * numPhase], rockVp[n],
                                        initZi.data() + n * numCom);
@@ -1303,6 +1344,8 @@ void Bulk::InitFlashDer()
 {
     OCP_FUNCNAME;
 
+    varChanged |= BULK_PRIMARY | BULK_FLASH;
+
     if (comps) {
         for (OCP_USI n = 0; n < numBulk; n++) {
             flashCal[PVTNUM[n]]->InitFlashDer(P[n], Pb[n], T, &S[n * numPhase],
@@ -1322,6 +1365,8 @@ void Bulk::InitFlashDer_n()
 {
     OCP_FUNCNAME;
 
+    varChanged |= BULK_PRIMARY | BULK_FLASH;
+
     if (comps) {
         for (OCP_USI n = 0; n < numBulk; n++) {
             flashCal[PVTNUM[n]]->InitFlashDer_n(P[n], Pb[n], T, &S[n * numPhase],
@@ -1341,6 +1386,8 @@ void Bulk::Flash()
 {
     OCP_FUNCNAME;
 
+    varChanged |= BULK_FLASH;
+
     if (comps) {
         FlashCOMP();
     } else {
@@ -1354,8 +1401,11 @@ void Bulk::Flash()
 
 void Bulk::FlashBLKOIL()
 {
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 64)
+#endif
     for (OCP_USI n = 0; n < numBulk; n++) {
-        flashCal[PVTNUM[n]]->Flash(P[n], T, &Ni[n * numCom], 0, 0, 0);
+        ThreadFlash(PVTNUM[n])->Flash(P[n], T, &Ni[n * numCom], 0, 0, 0);
         PassFlashValue(n);
     }
 }
@@ -1367,6 +1417,9 @@ void Bulk::FlashCOMP()
     OCP_DBL Ntw;
     OCP_DBL minEig;
     // cout << endl << "==================================" << endl;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 64) private(ftype, bId, Ntw, minEig)
+#endif
     for (OCP_USI n = 0; n < numBulk; n++) {
         ftype = 1;
         if (flagSkip[n]) {
@@ -1391,17 +1444,41 @@ void Bulk::FlashCOMP()
         } else {
             ftype = 0;
         }
-        flashCal[PVTNUM[n]]->Flash(P[n], T, &Ni[n * numCom], ftype, phaseNum[n],
+        ThreadFlash(PVTNUM[n])->Flash(P[n], T, &Ni[n * numCom], ftype, phaseNum[n],
                                    &Ks[n * numCom_1]);
         PassFlashValue(n);
     }
 }
 
 /// Use moles of component and pressure both in blackoil and compositional model.
+void Bulk::CalFugPhiBulks(const bool& ref)
+{
+    if (!comps) return;
+
+    vector<OCP_DBL> phiT(numCom_1);
+    vector<OCP_DBL> fugT(numCom_1);
+    for (OCP_USI n = 0; n < numBulk; n++) {
+        MixtureComp* mix = static_cast<MixtureComp*>(flashCal[PVTNUM[n]]);
+        mix->setPT(P[n], T);
+        mix->CalAiBi();
+        for (USI j = 0; j < numPhase - 1; j++) {
+            if (!phaseExist[n * numPhase + j]) continue;
+            const OCP_DBL* xj = &xij[(n * numPhase + j) * numCom];
+            if (ref) {
+                mix->CalFugPhiRef(phiT.data(), fugT.data(), xj);
+            } else {
+                mix->CalFugPhi(phiT.data(), fugT.data(), xj);
+            }
+        }
+    }
+}
+
 void Bulk::FlashDeriv()
 {
     OCP_FUNCNAME;
 
+    varChanged |= BULK_FLASH;
+
     if (comps) {
         FlashDerivCOMP();
     } else {
@@ -1417,6 +1494,8 @@ void Bulk::FlashDeriv_n()
 {
     OCP_FUNCNAME;
 
+    varChanged |= BULK_FLASH;
+
     if (comps) {
         FlashDerivCOMP_n();
     } else {
@@ -1428,10 +1507,7 @@ void Bulk::FlashDeriv_n()
 void Bulk::FlashDerivBLKOIL()
 {
     // dSec_dPri.clear();
-    for (OCP_USI n = 0; n < numBulk; n++) {
-        flashCal[PVTNUM[n]]->FlashDeriv(P[n], T, &Ni[n * numCom], 0, 0, 0);
-        PassFlashValueDeriv(n);
-    }
+    FlashDerivRegions();
 }
 
 void Bulk::FlashDerivBLKOIL_n() {}
@@ -1439,19 +1515,52 @@ void Bulk::FlashDerivBLKOIL_n() {}
 /// Perform flash calculation with Ni in Compositional Model
 void Bulk::FlashDerivCOMP()
 {
-    USI     ftype;
     NRdSSP          = 0;
     maxNRdSSP       = 0;
     index_maxNRdSSP = 0;
 
-    for (OCP_USI n = 0; n < numBulk; n++) {
-
-        ftype = CalFlashType(n);
+    FlashDerivRegions();
+}
 
-        flashCal[PVTNUM[n]]->FlashDeriv(P[n], T, &Ni[n * numCom], ftype, phaseNum[n],
-                                        &Ks[n * numCom_1]);
-        PassFlashValueDeriv(n);
+void Bulk::FlashDerivRegions()
+{
+#ifdef OCP_NEW_FIM
+    // dSdPindex is built in the order of bulks
+    slotdSSP.resize(1);
+    slotMaxdSSP.resize(1);
+    slotImaxdSSP.resize(1);
+    for (OCP_USI n = 0; n < numBulk; n++) {
+        flashCal[PVTNUM[n]]->FlashDerivBatch(&n, 1, *this, 0);
+        MergeNRdSSP(slotdSSP[0], slotMaxdSSP[0], slotImaxdSSP[0]);
+    }
+#else
+    OCP_USI numSlot = 0;
+    for (USI i = 0; i < NTPVT; i++) {
+        numSlot += (pvtBegin[i + 1] - pvtBegin[i] + FLASH_CHUNK - 1) / FLASH_CHUNK;
+    }
+    slotdSSP.resize(numSlot);
+    slotMaxdSSP.resize(numSlot);
+    slotImaxdSSP.resize(numSlot);
+
+    OCP_USI slot0 = 0;
+    for (USI i = 0; i < NTPVT; i++) {
+        const OCP_USI* cells = pvtCell.data() + pvtBegin[i];
+        const OCP_USI  num   = pvtBegin[i + 1] - pvtBegin[i];
+        const OCP_USI  nc    = (num + FLASH_CHUNK - 1) / FLASH_CHUNK;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+        for (OCP_USI c = 0; c < nc; c++) {
+            const OCP_USI len = min(FLASH_CHUNK, num - c * FLASH_CHUNK);
+            ThreadFlash(i)->FlashDerivBatch(cells + c * FLASH_CHUNK, len, *this,
+                                            slot0 + c);
+        }
+        slot0 += nc;
     }
+    for (OCP_USI c = 0; c < numSlot; c++) {
+        MergeNRdSSP(slotdSSP[c], slotMaxdSSP[c], slotImaxdSSP[c]);
+    }
+#endif // OCP_NEW_FIM
 }
 
 void Bulk::FlashDerivCOMP_n()
@@ -1468,7 +1577,7 @@ void Bulk::FlashDerivCOMP_n()
 
         for (USI j = 0; j < numPhase; j++) flagB[j] = phaseExist[n * numPhase + j];
 
-        flashCal[PVTNUM[n]]->FlashDeriv_n(
+        ThreadFlash(PVTNUM[n])->FlashDeriv_n(
             P[n], T, &Ni[n * numCom], &S[n * numPhase], &xij[n * numPhase * numCom],
             &nj[n * numPhase], ftype, &flagB[0], phaseNum[n], &Ks[n * numCom_1]);
 
@@ -1531,33 +1640,33 @@ void Bulk::PassFlashValue(const OCP_USI& n)
     OCP_FUNCNAME;
 
     OCP_USI bIdp   = n * numPhase;
-    USI     pvtnum = PVTNUM[n];
+    Mixture* mix   = ThreadFlash(PVTNUM[n]);
     USI     nptmp  = 0;
     for (USI j = 0; j < numPhase; j++) {
-        phaseExist[bIdp + j] = flashCal[pvtnum]->phaseExist[j];
+        phaseExist[bIdp + j] = mix->phaseExist[j];
         // Important! Saturation must be passed no matter if the phase exists. This is
         // because it will be used to calculate relative permeability and capillary
         // pressure at each time step. Make sure that all saturations are updated at
         // each step!
-        S[bIdp + j] = flashCal[pvtnum]->S[j];
+        S[bIdp + j] = mix->S[j];
         if (phaseExist[bIdp + j]) { // j -> bId + j   fix bugs.
             nptmp++;
-            rho[bIdp + j] = flashCal[pvtnum]->rho[j];
-            xi[bIdp + j]  = flashCal[pvtnum]->xi[j];
+            rho[bIdp + j] = mix->rho[j];
+            xi[bIdp + j]  = mix->xi[j];
             for (USI i = 0; i < numCom; i++) {
                 xij[bIdp * numCom + j * numCom + i] =
-                    flashCal[pvtnum]->xij[j * numCom + i];
+                    mix->xij[j * numCom + i];
             }
-            mu[bIdp + j] = flashCal[pvtnum]->mu[j];
-            vj[bIdp + j] = flashCal[pvtnum]->v[j];
+            mu[bIdp + j] = mix->mu[j];
+            vj[bIdp + j] = mix->v[j];
         }
     }
-    Nt[n]        = flashCal[pvtnum]->Nt;
-    vf[n]        = flashCal[pvtnum]->vf;
-    vfp[n]       = flashCal[pvtnum]->vfp;
+    Nt[n]        = mix->Nt;
+    vf[n]        = mix->vf;
+    vfp[n]       = mix->vfp;
     OCP_USI bIdc = n * numCom;
     for (USI i = 0; i < numCom; i++) {
-        vfi[bIdc + i] = flashCal[pvtnum]->vfi[i];
+        vfi[bIdc + i] = mix->vfi[i];
     }
 
     phaseNum[n] = nptmp - 1; // water is excluded
@@ -1568,18 +1677,18 @@ void Bulk::PassFlashValue(const OCP_USI& n)
             OCP_USI bIdc1 = n * numCom_1;
             for (USI i = 0; i < numCom_1; i++) {
                 Ks[bIdc1 + i] =
-                    flashCal[pvtnum]->xij[i] / flashCal[pvtnum]->xij[numCom + i];
+                    mix->xij[i] / mix->xij[numCom + i];
             }
         }
 
-        if (flashCal[pvtnum]->GetFtype() == 0) {
-            flagSkip[n] = flashCal[pvtnum]->GetFlagSkip();
+        if (mix->GetFtype() == 0) {
+            flagSkip[n] = mix->GetFlagSkip();
             if (flagSkip[n]) {
-                minEigenSkip[n] = flashCal[pvtnum]->GetMinEigenSkip();
+                minEigenSkip[n] = mix->GetMinEigenSkip();
                 for (USI j = 0; j < numPhase - 1; j++) {
                     if (phaseExist[bIdp + j]) {
                         for (USI i = 0; i < numCom - 1; i++) {
-                            ziSkip[bIdc + i] = flashCal[pvtnum]->xij[j * numCom + i];
+                            ziSkip[bIdc + i] = mix->xij[j * numCom + i];
                         }
                         break;
                     }
@@ -1589,7 +1698,7 @@ void Bulk::PassFlashValue(const OCP_USI& n)
         }
 
         if (miscible) {
-            surTen[n] = flashCal[pvtnum]->GetSurTen();
+            surTen[n] = mix->GetSurTen();
         }
     }
 }
@@ -1653,66 +1762,87 @@ void Bulk::PassFlashValueAIMc(const OCP_USI& n)
 }
 
 void Bulk::PassFlashValueDeriv(const OCP_USI& n)
+{
+    OCP_DBL dSSP     = 0;
+    OCP_DBL maxdSSP  = 0;
+    OCP_USI imaxdSSP = 0;
+    PassFlashValueDeriv(n, ThreadFlash(PVTNUM[n]), dSSP, maxdSSP, imaxdSSP);
+    MergeNRdSSP(dSSP, maxdSSP, imaxdSSP);
+}
+
+void Bulk::MergeNRdSSP(const OCP_DBL& dSSP, const OCP_DBL& maxdSSP,
+                       const OCP_USI& imaxdSSP)
+{
+    NRdSSP += dSSP;
+    if (fabs(maxNRdSSP) < fabs(maxdSSP) ||
+        (fabs(maxNRdSSP) == fabs(maxdSSP) && imaxdSSP < index_maxNRdSSP)) {
+        maxNRdSSP       = maxdSSP;
+        index_maxNRdSSP = imaxdSSP;
+    }
+}
+
+void Bulk::PassFlashValueDeriv(const OCP_USI& n, Mixture* mix, OCP_DBL& dSSP,
+                               OCP_DBL& maxdSSP, OCP_USI& imaxdSSP)
 {
     OCP_FUNCNAME;
 
     OCP_USI bIdp   = n * numPhase;
-    USI     pvtnum = PVTNUM[n];
     USI     nptmp  = 0;
     USI     len    = 0;
 
+    for (USI j = 0; j < numPhase; j++) {
+        const OCP_DBL dS = mix->S[j] - dSNR[bIdp + j];
+        if (phaseExist[bIdp + j]) {
+            dSSP += (dS - dSNRP[bIdp + j]) * (dS - dSNRP[bIdp + j]);
+            if (fabs(maxdSSP) < fabs(dS - dSNRP[bIdp + j]) ||
+                (fabs(maxdSSP) == fabs(dS - dSNRP[bIdp + j]) && n < imaxdSSP)) {
+                maxdSSP  = dS - dSNRP[bIdp + j];
+                imaxdSSP = n;
+            }
+        }
+    }
+
     for (USI j = 0; j < numPhase; j++) {
         // Important! Saturation must be passed no matter if the phase exists. This is
         // because it will be used to calculate relative permeability and capillary
         // pressure at each time step. Make sure that all saturations are updated at
         // each step!
-        S[bIdp + j]    = flashCal[pvtnum]->S[j];
+        S[bIdp + j]    = mix->S[j];
         dSNR[bIdp + j] = S[bIdp + j] - dSNR[bIdp + j];
-        if (phaseExist[bIdp + j]) {
-            NRdSSP +=
-                (dSNR[bIdp + j] - dSNRP[bIdp + j]) * (dSNR[bIdp + j] - dSNRP[bIdp + j]);
-            if (fabs(maxNRdSSP) < fabs(dSNR[bIdp + j] - dSNRP[bIdp + j])) {
-                maxNRdSSP       = dSNR[bIdp + j] - dSNRP[bIdp + j];
-                index_maxNRdSSP = n;
-            }
-            // cout << n << "   " << scientific << setprecision(6) << dSNR[bIdp + j] <<
-            // "   " << dSNRP[bIdp + j] << endl;
-        }
-
-        phaseExist[bIdp + j] = flashCal[pvtnum]->phaseExist[j];
-        pEnumCom[bIdp + j]   = flashCal[pvtnum]->pEnumCom[j];
+        phaseExist[bIdp + j] = mix->phaseExist[j];
+        pEnumCom[bIdp + j]   = mix->pEnumCom[j];
         len += pEnumCom[bIdp + j];
         if (phaseExist[bIdp + j]) { // j -> bId + j fix bugs.
             nptmp++;
-            nj[bIdp + j]  = flashCal[pvtnum]->nj[j];
-            rho[bIdp + j] = flashCal[pvtnum]->rho[j];
-            xi[bIdp + j]  = flashCal[pvtnum]->xi[j];
-            mu[bIdp + j]  = flashCal[pvtnum]->mu[j];
-            vj[bIdp + j]  = flashCal[pvtnum]->v[j];
+            nj[bIdp + j]  = mix->nj[j];
+            rho[bIdp + j] = mix->rho[j];
+            xi[bIdp + j]  = mix->xi[j];
+            mu[bIdp + j]  = mix->mu[j];
+            vj[bIdp + j]  = mix->v[j];
 
             // Derivatives
-            muP[bIdp + j]  = flashCal[pvtnum]->muP[j];
-            xiP[bIdp + j]  = flashCal[pvtnum]->xiP[j];
-            rhoP[bIdp + j] = flashCal[pvtnum]->rhoP[j];
+            muP[bIdp + j]  = mix->muP[j];
+            xiP[bIdp + j]  = mix->xiP[j];
+            rhoP[bIdp + j] = mix->rhoP[j];
             for (USI i = 0; i < numCom; i++) {
                 xij[bIdp * numCom + j * numCom + i] =
-                    flashCal[pvtnum]->xij[j * numCom + i];
+                    mix->xij[j * numCom + i];
                 mux[bIdp * numCom + j * numCom + i] =
-                    flashCal[pvtnum]->mux[j * numCom + i];
+                    mix->mux[j * numCom + i];
                 xix[bIdp * numCom + j * numCom + i] =
-                    flashCal[pvtnum]->xix[j * numCom + i];
+                    mix->xix[j * numCom + i];
                 rhox[bIdp * numCom + j * numCom + i] =
-                    flashCal[pvtnum]->rhox[j * numCom + i];
+                    mix->rhox[j * numCom + i];
             }
         }
     }
-    Nt[n]  = flashCal[pvtnum]->Nt;
-    vf[n]  = flashCal[pvtnum]->vf;
-    vfp[n] = flashCal[pvtnum]->vfp;
+    Nt[n]  = mix->Nt;
+    vf[n]  = mix->vf;
+    vfp[n] = mix->vfp;
 
     OCP_USI bIdc = n * numCom;
     for (USI i = 0; i < numCom; i++) {
-        vfi[bIdc + i] = flashCal[pvtnum]->vfi[i];
+        vfi[bIdc + i] = mix->vfi[i];
     }
 
     len += nptmp;
@@ -1720,16 +1850,16 @@ void Bulk::PassFlashValueDeriv(const OCP_USI& n)
 #ifdef OCP_NEW_FIM
     len *= (numCom + 1);
     dSdPindex[n + 1] = dSdPindex[n] + len;
-    Dcopy(len, &dSec_dPri[0] + dSdPindex[n], &flashCal[pvtnum]->dXsdXp[0]);
+    Dcopy(len, &dSec_dPri[0] + dSdPindex[n], &mix->dXsdXp[0]);
 #else
-    Dcopy(lendSdP, &dSec_dPri[0] + n * lendSdP, &flashCal[pvtnum]->dXsdXp[0]);
+    Dcopy(lendSdP, &dSec_dPri[0] + n * lendSdP, &mix->dXsdXp[0]);
 #endif // OCP_NEW_FIM
 
     // test
     phaseNum[n] = nptmp - 1; // So water must exist!!!
 
     if (comps) {
-        ePEC[n] = flashCal[pvtnum]->GetErrorPEC();
+        ePEC[n] = mix->GetErrorPEC();
         if (nptmp == 3) {
             // num of hydrocarbon phase equals 2
             // Calculate Ks
@@ -1741,18 +1871,18 @@ void Bulk::PassFlashValueDeriv(const OCP_USI& n)
             OCP_USI bIdc1 = n * numCom_1;
             for (USI i = 0; i < numCom_1; i++) {
                 Ks[bIdc1 + i] =
-                    flashCal[pvtnum]->xij[i] / flashCal[pvtnum]->xij[numCom + i];
+                    mix->xij[i] / mix->xij[numCom + i];
             }
         }
 
-        if (flashCal[pvtnum]->GetFtype() == 0) {
-            flagSkip[n] = flashCal[pvtnum]->GetFlagSkip();
+        if (mix->GetFtype() == 0) {
+            flagSkip[n] = mix->GetFlagSkip();
             if (flagSkip[n]) {
-                minEigenSkip[n] = flashCal[pvtnum]->GetMinEigenSkip();
+                minEigenSkip[n] = mix->GetMinEigenSkip();
                 for (USI j = 0; j < numPhase - 1; j++) {
                     if (phaseExist[bIdp + j]) {
                         for (USI i = 0; i < numCom - 1; i++) {
-                            ziSkip[bIdc + i] = flashCal[pvtnum]->xij[j * numCom + i];
+                            ziSkip[bIdc + i] = mix->xij[j * numCom + i];
                         }
                         break;
                     }
@@ -1761,7 +1891,7 @@ void Bulk::PassFlashValueDeriv(const OCP_USI& n)
             }
         }
         if (miscible) {
-            surTen[n] = flashCal[pvtnum]->GetSurTen();
+            surTen[n] = mix->GetSurTen();
         }
     }
 }
@@ -1771,76 +1901,83 @@ void Bulk::PassFlashValueDeriv_n(const OCP_USI& n)
     OCP_FUNCNAME;
 
     OCP_USI bIdp   = n * numPhase;
-    USI     pvtnum = PVTNUM[n];
+    Mixture* mix   = ThreadFlash(PVTNUM[n]);
     USI     nptmp  = 0;
     USI     len    = 0;
 
+    // NR diagnostics are shared by all threads
+#ifdef _OPENMP
+#pragma omp critical(NRdSSP)
+#endif
     for (USI j = 0; j < numPhase; j++) {
-        // Important! Saturation must be passed no matter if the phase exists. This is
-        // because it will be used to calculate relative permeability and capillary
-        // pressure at each time step. Make sure that all saturations are updated at
-        // each step!
-        S[bIdp + j]    = flashCal[pvtnum]->S[j];
-        dSNR[bIdp + j] = S[bIdp + j] - dSNR[bIdp + j];
+        const OCP_DBL dS = mix->S[j] - dSNR[bIdp + j];
         if (phaseExist[bIdp + j]) {
-            NRdSSP +=
-                (dSNR[bIdp + j] - dSNRP[bIdp + j]) * (dSNR[bIdp + j] - dSNRP[bIdp + j]);
-            if (fabs(maxNRdSSP) < fabs(dSNR[bIdp + j] - dSNRP[bIdp + j])) {
-                maxNRdSSP       = dSNR[bIdp + j] - dSNRP[bIdp + j];
+            NRdSSP += (dS - dSNRP[bIdp + j]) * (dS - dSNRP[bIdp + j]);
+            if (fabs(maxNRdSSP) < fabs(dS - dSNRP[bIdp + j]) ||
+                (fabs(maxNRdSSP) == fabs(dS - dSNRP[bIdp + j]) && n < index_maxNRdSSP)) {
+                maxNRdSSP       = dS - dSNRP[bIdp + j];
                 index_maxNRdSSP = n;
             }
         }
+    }
 
-        phaseExist[bIdp + j] = flashCal[pvtnum]->phaseExist[j];
-        pEnumCom[bIdp + j]   = flashCal[pvtnum]->pEnumCom[j];
+    for (USI j = 0; j < numPhase; j++) {
+        // Important! Saturation must be passed no matter if the phase exists. This is
+        // because it will be used to calculate relative permeability and capillary
+        // pressure at each time step. Make sure that all saturations are updated at
+        // each step!
+        S[bIdp + j]    = mix->S[j];
+        dSNR[bIdp + j] = S[bIdp + j] - dSNR[bIdp + j];
+        phaseExist[bIdp + j] = mix->phaseExist[j];
+        pEnumCom[bIdp + j]   = mix->pEnumCom[j];
         len += pEnumCom[bIdp + j];
         if (phaseExist[bIdp + j]) { // j -> bId + j fix bugs.
             nptmp++;
-            nj[bIdp + j]  = flashCal[pvtnum]->nj[j];
-            rho[bIdp + j] = flashCal[pvtnum]->rho[j];
-            xi[bIdp + j]  = flashCal[pvtnum]->xi[j];
-            mu[bIdp + j]  = flashCal[pvtnum]->mu[j];
-            vj[bIdp + j]  = flashCal[pvtnum]->v[j];
+            nj[bIdp + j]  = mix->nj[j];
+            rho[bIdp + j] = mix->rho[j];
+            xi[bIdp + j]  = mix->xi[j];
+            mu[bIdp + j]  = mix->mu[j];
+            vj[bIdp + j]  = mix->v[j];
 
             // Derivatives
-            muP[bIdp + j]  = flashCal[pvtnum]->muP[j];
-            xiP[bIdp + j]  = flashCal[pvtnum]->xiP[j];
-            rhoP[bIdp + j] = flashCal[pvtnum]->rhoP[j];
+            muP[bIdp + j]  = mix->muP[j];
+            xiP[bIdp + j]  = mix->xiP[j];
+            rhoP[bIdp + j] = mix->rhoP[j];
             for (USI i = 0; i < numCom; i++) {
                 xij[bIdp * numCom + j * numCom + i] =
-                    flashCal[pvtnum]->xij[j * numCom + i];
+                    mix->xij[j * numCom + i];
                 mux[bIdp * numCom + j * numCom + i] =
-                    flashCal[pvtnum]->mux[j * numCom + i];
+                    mix->mux[j * numCom + i];
                 xix[bIdp * numCom + j * numCom + i] =
-                    flashCal[pvtnum]->xix[j * numCom + i];
+                    mix->xix[j * numCom + i];
                 rhox[bIdp * numCom + j * numCom + i] =
-                    flashCal[pvtnum]->rhox[j * numCom + i];
+                    mix->rhox[j * numCom + i];
             }
         }
     }
-    Nt[n]  = flashCal[pvtnum]->Nt;
-    vf[n]  = flashCal[pvtnum]->vf;
-    vfp[n] = flashCal[pvtnum]->vfp;
+    Nt[n]  = mix->Nt;
+    vf[n]  = mix->vf;
+    vfp[n] = mix->vfp;
 
     OCP_USI bIdc = n * numCom;
     for (USI i = 0; i < numCom; i++) {
-        vfi[bIdc + i] = flashCal[pvtnum]->vfi[i];
+        vfi[bIdc + i] = mix->vfi[i];
     }
 
     len += nptmp;
     resIndex[n + 1] = resIndex[n] + len;
-    Dcopy(len, &res_n[0] + resIndex[n], &flashCal[pvtnum]->res[0]);
+    Dcopy(len, &res_n[0] + resIndex[n], &mix->res[0]);
     len *= (numCom + 1);
     dSdPindex[n + 1] = dSdPindex[n] + len;
-    Dcopy(len, &dSec_dPri[0] + dSdPindex[n], &flashCal[pvtnum]->dXsdXp[0]);
+    Dcopy(len, &dSec_dPri[0] + dSdPindex[n], &mix->dXsdXp[0]);
 
-    resPc[n] = flashCal[pvtnum]->resPc;
+    resPc[n] = mix->resPc;
 
     // test
     phaseNum[n] = nptmp - 1; // So water must exist!!!
 
     if (comps) {
-        ePEC[n] = flashCal[pvtnum]->GetErrorPEC();
+        ePEC[n] = mix->GetErrorPEC();
         if (nptmp == 3) {
             // num of hydrocarbon phase equals 2
             // Calculate Ks
@@ -1852,18 +1989,18 @@ void Bulk::PassFlashValueDeriv_n(const OCP_USI& n)
             OCP_USI bIdc1 = n * numCom_1;
             for (USI i = 0; i < numCom_1; i++) {
                 Ks[bIdc1 + i] =
-                    flashCal[pvtnum]->xij[i] / flashCal[pvtnum]->xij[numCom + i];
+                    mix->xij[i] / mix->xij[numCom + i];
             }
         }
 
-        if (flashCal[pvtnum]->GetFtype() == 0) {
-            flagSkip[n] = flashCal[pvtnum]->GetFlagSkip();
+        if (mix->GetFtype() == 0) {
+            flagSkip[n] = mix->GetFlagSkip();
             if (flagSkip[n]) {
-                minEigenSkip[n] = flashCal[pvtnum]->GetMinEigenSkip();
+                minEigenSkip[n] = mix->GetMinEigenSkip();
                 for (USI j = 0; j < numPhase - 1; j++) {
                     if (phaseExist[bIdp + j]) {
                         for (USI i = 0; i < numCom - 1; i++) {
-                            ziSkip[bIdc + i] = flashCal[pvtnum]->xij[j * numCom + i];
+                            ziSkip[bIdc + i] = mix->xij[j * numCom + i];
                         }
                         break;
                     }
@@ -1872,7 +2009,7 @@ void Bulk::PassFlashValueDeriv_n(const OCP_USI& n)
             }
         }
         if (miscible) {
-            surTen[n] = flashCal[pvtnum]->GetSurTen();
+            surTen[n] = mix->GetSurTen();
         }
     }
 }
@@ -1881,6 +2018,8 @@ void Bulk::ResetFlash()
 {
     OCP_FUNCNAME;
 
+    varChanged |= BULK_FLASH;
+
     phaseExist = lphaseExist;
     S          = lS;
     rho        = lrho;
@@ -1898,64 +2037,53 @@ void Bulk::CalKrPc()
 {
     OCP_FUNCNAME;
 
-    if (!miscible) {
-        OCP_DBL tmp = 0;
-        for (OCP_USI n = 0; n < numBulk; n++) {
-            OCP_USI bId = n * numPhase;
-            flow[SATNUM[n]]->CalKrPc(&S[bId], &kr[bId], &Pc[bId], 0, tmp, tmp);
-            for (USI j = 0; j < numPhase; j++)
-                Pj[n * numPhase + j] = P[n] + Pc[n * numPhase + j];
-        }
-    } else {
-        for (OCP_USI n = 0; n < numBulk; n++) {
-            OCP_USI bId = n * numPhase;
-            flow[SATNUM[n]]->CalKrPc(&S[bId], &kr[bId], &Pc[bId], surTen[n], Fk[n],
-                                     Fp[n]);
-            for (USI j = 0; j < numPhase; j++)
-                Pj[n * numPhase + j] = P[n] + Pc[n * numPhase + j];
-        }
-    }
-
-    if (ScalePcow) {
-        // correct
-        USI Wid = phase2Index[WATER];
-        for (USI n = 0; n < numBulk; n++) {
-            Pc[n * numPhase + Wid] *= ScaleValuePcow[n];
-            Pj[n * numPhase + Wid] = P[n] + Pc[n * numPhase + Wid];
-        }
-    }
+    CalKrPcRegions(false);
 }
 
 void Bulk::CalKrPcDeriv()
 {
     OCP_FUNCNAME;
 
-    if (!miscible) {
-        OCP_DBL tmp = 0;
-        for (OCP_USI n = 0; n < numBulk; n++) {
-            OCP_USI bId = n * numPhase;
-            flow[SATNUM[n]]->CalKrPcDeriv(&S[bId], &kr[bId], &Pc[bId],
-                                          &dKr_dS[bId * numPhase],
-                                          &dPcj_dS[bId * numPhase], 0, tmp, tmp);
-            for (USI j = 0; j < numPhase; j++) Pj[bId + j] = P[n] + Pc[bId + j];
-        }
-    } else {
-        for (OCP_USI n = 0; n < numBulk; n++) {
-            OCP_USI bId = n * numPhase;
-            flow[SATNUM[n]]->CalKrPcDeriv(
-                &S[bId], &kr[bId], &Pc[bId], &dKr_dS[bId * numPhase],
-                &dPcj_dS[bId * numPhase], surTen[n], Fk[n], Fp[n]);
-            for (USI j = 0; j < numPhase; j++)
-                Pj[n * numPhase + j] = P[n] + Pc[n * numPhase + j];
-        }
+    CalKrPcRegions(true);
+}
+
+void Bulk::CalKrPcRegions(const bool& deriv)
+{
+    varChanged |= BULK_KRPC;
+
+    KrPcArrays a;
+    a.np  = numPhase;
+    a.wId = ScalePcow ? phase2Index[WATER] : 0;
+    a.P   = P.data();
+    a.S   = S.data();
+    a.kr  = kr.data();
+    a.Pc  = Pc.data();
+    a.Pj  = Pj.data();
+    if (deriv) {
+        a.dKr_dS  = dKr_dS.data();
+        a.dPcj_dS = dPcj_dS.data();
     }
+    if (miscible) {
+        a.surTen = surTen.data();
+        a.Fk     = Fk.data();
+        a.Fp     = Fp.data();
+    }
+    if (ScalePcow) a.scalePcow = ScaleValuePcow.data();
 
-    if (ScalePcow) {
-        // correct
-        USI Wid = phase2Index[WATER];
-        for (USI n = 0; n < numBulk; n++) {
-            Pc[n * numPhase + Wid] *= ScaleValuePcow[n];
-            Pj[n * numPhase + Wid] = P[n] + Pc[n * numPhase + Wid];
+    for (USI i = 0; i < NTSFUN; i++) {
+        const FlowUnit* unit  = flow[i];
+        const OCP_USI*  cells = satCell.data() + satBegin[i];
+        const OCP_USI   num   = satBegin[i + 1] - satBegin[i];
+        const OCP_USI   nc    = (num + KRPC_CHUNK - 1) / KRPC_CHUNK;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+        for (OCP_USI c = 0; c < nc; c++) {
+            const OCP_USI len = min(KRPC_CHUNK, num - c * KRPC_CHUNK);
+            if (deriv)
+                unit->CalKrPcDerivBatch(cells + c * KRPC_CHUNK, len, a);
+            else
+                unit->CalKrPcBatch(cells + c * KRPC_CHUNK, len, a);
         }
     }
 }
@@ -1964,6 +2092,8 @@ void Bulk::CalVpore()
 {
     OCP_FUNCNAME;
 
+    varChanged |= BULK_VPORE;
+
     for (OCP_USI n = 0; n < numBulk; n++) {
         OCP_DBL dP = rockC1 * (P[n] - rockPref);
         rockVp[n]  = rockVpInit[n] * (1 + dP);
@@ -2380,36 +2510,162 @@ void Bulk::CalSomeInfo(const Grid& myGrid) const
     cout << "---------------------" << endl
          << "BULK" << endl
          << "---------------------" << endl;
-    myGrid.GetIJKGrid(I, J, K, ndepa);
+    myGrid.GetIJKBulk(I, J, K, ndepa);
     cout << "  Depthmax = " << depthMax << " feet " << GetIJKformat(to_string(I), to_string(J), to_string(K), sp) << endl;
-    myGrid.GetIJKGrid(I, J, K, ndepi);
+    myGrid.GetIJKBulk(I, J, K, ndepi);
     cout << "  Depthmin = " << depthMin << " feet " << GetIJKformat(to_string(I), to_string(J), to_string(K), sp) << endl;
-    myGrid.GetIJKGrid(I, J, K, nxa);
+    myGrid.GetIJKBulk(I, J, K, nxa);
     cout << "  DXmax    = " << dxMax << " feet " << GetIJKformat(to_string(I), to_string(J), to_string(K), sp) << endl;
-    myGrid.GetIJKGrid(I, J, K, nxi);
+    myGrid.GetIJKBulk(I, J, K, nxi);
     cout << "  DXmin    = " << dxMin << " feet " << GetIJKformat(to_string(I), to_string(J), to_string(K), sp) << endl;
-    myGrid.GetIJKGrid(I, J, K, nya);
+    myGrid.GetIJKBulk(I, J, K, nya);
     cout << "  DYmax    = " << dyMax << " feet " << GetIJKformat(to_string(I), to_string(J), to_string(K), sp) << endl;
-    myGrid.GetIJKGrid(I, J, K, nyi);
+    myGrid.GetIJKBulk(I, J, K, nyi);
     cout << "  DYmin    = " << dyMin << " feet " << GetIJKformat(to_string(I), to_string(J), to_string(K), sp) << endl;
-    myGrid.GetIJKGrid(I, J, K, nza);
+    myGrid.GetIJKBulk(I, J, K, nza);
     cout << "  DZmax    = " << dzMax << " feet " << GetIJKformat(to_string(I), to_string(J), to_string(K), sp) << endl;
-    myGrid.GetIJKGrid(I, J, K, nzi);
+    myGrid.GetIJKBulk(I, J, K, nzi);
     cout << "  DZmin    = " << dzMin << " feet " << GetIJKformat(to_string(I), to_string(J), to_string(K), sp) << endl;
-    myGrid.GetIJKGrid(I, J, K, nRVa);
+    myGrid.GetIJKBulk(I, J, K, nRVa);
     cout << "  RVmax    = " << RVMax / CONV1 << " rb " << GetIJKformat(to_string(I), to_string(J), to_string(K), sp) << endl;
-    myGrid.GetIJKGrid(I, J, K, nRVi);
+    myGrid.GetIJKBulk(I, J, K, nRVi);
     cout << "  RVmin    = " << RVMin / CONV1 << " rb " << GetIJKformat(to_string(I), to_string(J), to_string(K), sp) << endl;
-    myGrid.GetIJKGrid(I, J, K, nRVPa);
+    myGrid.GetIJKBulk(I, J, K, nRVPa);
     cout << "  RVmax    = " << RVPMax / CONV1 << " rb " << GetIJKformat(to_string(I), to_string(J), to_string(K), sp) << endl;
-    myGrid.GetIJKGrid(I, J, K, nRVPi);
+    myGrid.GetIJKBulk(I, J, K, nRVPi);
     cout << "  RVmin    = " << RVPMin / CONV1 << " rb " << GetIJKformat(to_string(I), to_string(J), to_string(K), sp) << endl;
-    myGrid.GetIJKGrid(I, J, K, nPerxa);
+    myGrid.GetIJKBulk(I, J, K, nPerxa);
     cout << "  Perxmax  = " << PerxMax << "   " << GetIJKformat(to_string(I), to_string(J), to_string(K), sp) << endl;
-    myGrid.GetIJKGrid(I, J, K, nPerxi);
+    myGrid.GetIJKBulk(I, J, K, nPerxi);
     cout << "  Perxmin  = " << scientific << PerxMin << "   " << GetIJKformat(to_string(I), to_string(J), to_string(K), sp) << endl;
 }
 
+void Bulk::SyncCheckpoint(OCPCheckpoint& ckpt)
+{
+    OCP_FUNCNAME;
+
+    ckpt.Check(numBulk, "number of bulks");
+    ckpt.Check(numPhase, "number of phases");
+    ckpt.Check(numCom, "number of components");
+
+    // Phase split
+    ckpt.Sync(phaseNum);
+    ckpt.Sync(lphaseNum);
+    ckpt.Sync(NRphaseNum);
+    ckpt.Sync(minEigenSkip);
+    ckpt.Sync(flagSkip);
+    ckpt.Sync(ziSkip);
+    ckpt.Sync(PSkip);
+    ckpt.Sync(lminEigenSkip);
+    ckpt.Sync(lflagSkip);
+    ckpt.Sync(lziSkip);
+    ckpt.Sync(lPSkip);
+    ckpt.Sync(Ks);
+    ckpt.Sync(lKs);
+
+    // Current and last variables
+    ckpt.Sync(Pb);
+    ckpt.Sync(P);
+    ckpt.Sync(Pj);
+    ckpt.Sync(Pc);
+    ckpt.Sync(phaseExist);
+    ckpt.Sync(S);
+    ckpt.Sync(nj);
+    ckpt.Sync(rho);
+    ckpt.Sync(xi);
+    ckpt.Sync(xij);
+    ckpt.Sync(Ni);
+    ckpt.Sync(mu);
+    ckpt.Sync(kr);
+    ckpt.Sync(vj);
+    ckpt.Sync(vf);
+    ckpt.Sync(Nt);
+    ckpt.Sync(NT);
+    ckpt.Sync(vfi);
+    ckpt.Sync(vfp);
+    ckpt.Sync(lP);
+    ckpt.Sync(lPj);
+    ckpt.Sync(lPc);
+    ckpt.Sync(lphaseExist);
+    ckpt.Sync(lS);
+    ckpt.Sync(lnj);
+    ckpt.Sync(lrho);
+    ckpt.Sync(lxi);
+    ckpt.Sync(lxij);
+    ckpt.Sync(lNi);
+    ckpt.Sync(lmu);
+    ckpt.Sync(lkr);
+    ckpt.Sync(lvj);
+    ckpt.Sync(lvf);
+    ckpt.Sync(lNt);
+    ckpt.Sync(lvfi);
+    ckpt.Sync(lvfp);
+    ckpt.Sync(lrockVp);
+    ckpt.Sync(surTen);
+    ckpt.Sync(Fk);
+    ckpt.Sync(Fp);
+    ckpt.Sync(lsurTen);
+    ckpt.Sync(rockVp);
+    ckpt.Sync(rockKx);
+    ckpt.Sync(rockKy);
+    ckpt.Sync(rockKz);
+    ckpt.Sync(dPmax);
+    ckpt.Sync(dSmax);
+    ckpt.Sync(dNmax);
+    ckpt.Sync(dVmax);
+
+    // Derivatives for FIM
+    ckpt.Sync(muP);
+    ckpt.Sync(xiP);
+    ckpt.Sync(rhoP);
+    ckpt.Sync(mux);
+    ckpt.Sync(xix);
+    ckpt.Sync(rhox);
+    ckpt.Sync(dPcj_dS);
+    ckpt.Sync(dKr_dS);
+    ckpt.Sync(dSec_dPri);
+    ckpt.Sync(res_n);
+    ckpt.Sync(resPc);
+    ckpt.Sync(dSdPindex);
+    ckpt.Sync(resIndex);
+    ckpt.Sync(pEnumCom);
+    ckpt.Sync(lmuP);
+    ckpt.Sync(lxiP);
+    ckpt.Sync(lrhoP);
+    ckpt.Sync(lmux);
+    ckpt.Sync(lxix);
+    ckpt.Sync(lrhox);
+    ckpt.Sync(ldPcj_dS);
+    ckpt.Sync(ldKr_dS);
+    ckpt.Sync(ldSec_dPri);
+    ckpt.Sync(lres_n);
+    ckpt.Sync(lresPc);
+    ckpt.Sync(ldSdPindex);
+    ckpt.Sync(lresIndex);
+    ckpt.Sync(lpEnumCom);
+    ckpt.Sync(dSNR);
+    ckpt.Sync(dSNRP);
+    ckpt.Sync(dNNR);
+    ckpt.Sync(dPNR);
+    ckpt.Sync(NRdSSP);
+    ckpt.Sync(maxNRdSSP);
+    ckpt.Sync(index_maxNRdSSP);
+    ckpt.Sync(NRdPmax);
+    ckpt.Sync(NRdNmax);
+    ckpt.Sync(NRdSmax);
+    ckpt.Sync(NRdSmaxP);
+    ckpt.Sync(NRstep);
+
+    // Bulks of AIM
+    ckpt.Sync(map_Bulk2FIM);
+    ckpt.Sync(FIMBulk);
+    ckpt.Sync(numFIMBulk);
+    ckpt.Sync(FIMNi);
+
+    // All groups differ from what UpdateLastStepFIM saw last
+    varChanged = BULK_ALL;
+}
+
 /////////////////////////////////////////////////////////////////////
 // IMPEC
 /////////////////////////////////////////////////////////////////////
@@ -2418,6 +2674,8 @@ void Bulk::AllocateAuxIMPEC()
 {
     OCP_FUNCNAME;
 
+    varChanged |= BULK_ALL;
+
     // IMPEC var
     vfi.resize(numBulk * numCom);
     vfp.resize(numBulk);
@@ -2447,6 +2705,8 @@ void Bulk::GetSolIMPEC(const vector<OCP_DBL>& u)
 {
     OCP_FUNCNAME;
 
+    varChanged |= BULK_PRIMARY | BULK_KRPC;
+
     for (OCP_USI n = 0; n < numBulk; n++) {
         P[n] = u[n];
         for (USI j = 0; j < numPhase; j++) {
@@ -2523,6 +2783,8 @@ void Bulk::AllocateAuxFIM()
 {
     OCP_FUNCNAME;
 
+    varChanged |= BULK_ALL;
+
     // FIM var
     nj.resize(numBulk * numPhase);
     vfi.resize(numBulk * numCom);
@@ -2589,6 +2851,8 @@ void Bulk::GetSolFIM(const vector<OCP_DBL>& u, const OCP_DBL& dPmaxlim,
 {
     OCP_FUNCNAME;
 
+    varChanged |= BULK_PRIMARY | BULK_FLASH;
+
     dSNR       = S;
     NRphaseNum = phaseNum;
 
@@ -2704,6 +2968,8 @@ void Bulk::GetSolFIM(const vector<OCP_DBL>& u, const OCP_DBL& dPmaxlim,
 void Bulk::GetSolFIM_n(const vector<OCP_DBL>& u, const OCP_DBL& dPmaxlim,
                        const OCP_DBL& dSmaxlim)
 {
+    varChanged |= BULK_PRIMARY | BULK_FLASH;
+
     // For saturations changes:
     // 1. maximum changes must be less than dSmaxlim,
     // 2. if phases become mobile/immobile, then set it to crtical point,
@@ -2951,97 +3217,112 @@ void Bulk::ResetFIM()
 {
     OCP_FUNCNAME;
 
-    phaseNum     = lphaseNum;
-    minEigenSkip = lminEigenSkip;
-    flagSkip     = lflagSkip;
-    ziSkip       = lziSkip;
-    PSkip        = lPSkip;
-    Ks           = lKs;
-
-    P          = lP;
-    Pj         = lPj;
-    Pc         = lPc;
-    phaseExist = lphaseExist;
-    S          = lS;
-    nj         = lnj;
-    rho        = lrho;
-    xi         = lxi;
-    xij        = lxij;
-    Ni         = lNi;
-    mu         = lmu;
-    kr         = lkr;
-    vj         = lvj;
-    vf         = lvf;
-    Nt         = lNt;
-    vfi        = lvfi;
-    vfp        = lvfp;
-    rockVp     = lrockVp;
-    muP        = lmuP;
-    xiP        = lxiP;
-    rhoP       = lrhoP;
-    mux        = lmux;
-    xix        = lxix;
-    rhox       = lrhox;
-    dSec_dPri  = ldSec_dPri;
-    res_n      = lres_n;
-    resPc      = lresPc;
-    dSdPindex  = ldSdPindex;
-    resIndex   = lresIndex;
-    pEnumCom   = lpEnumCom;
-    dKr_dS     = ldKr_dS;
-    dPcj_dS    = ldPcj_dS;
-
-    if (miscible) {
-        surTen = lsurTen;
+    if (varChanged & BULK_PRIMARY) {
+        P  = lP;
+        Ni = lNi;
     }
+    if (varChanged & BULK_FLASH) {
+        phaseNum     = lphaseNum;
+        minEigenSkip = lminEigenSkip;
+        flagSkip     = lflagSkip;
+        ziSkip       = lziSkip;
+        PSkip        = lPSkip;
+        Ks           = lKs;
+        phaseExist   = lphaseExist;
+        S            = lS;
+        nj           = lnj;
+        rho          = lrho;
+        xi           = lxi;
+        xij          = lxij;
+        mu           = lmu;
+        vj           = lvj;
+        vf           = lvf;
+        Nt           = lNt;
+        vfi          = lvfi;
+        vfp          = lvfp;
+        muP          = lmuP;
+        xiP          = lxiP;
+        rhoP         = lrhoP;
+        mux          = lmux;
+        xix          = lxix;
+        rhox         = lrhox;
+        dSec_dPri    = ldSec_dPri;
+        res_n        = lres_n;
+        resPc        = lresPc;
+        dSdPindex    = ldSdPindex;
+        resIndex     = lresIndex;
+        pEnumCom     = lpEnumCom;
+        if (miscible) {
+            surTen = lsurTen;
+        }
+    }
+    if (varChanged & BULK_KRPC) {
+        Pj      = lPj;
+        Pc      = lPc;
+        kr      = lkr;
+        dKr_dS  = ldKr_dS;
+        dPcj_dS = ldPcj_dS;
+    }
+    if (varChanged & BULK_VPORE) {
+        rockVp = lrockVp;
+    }
+    varChanged = 0;
 }
 
 void Bulk::UpdateLastStepFIM()
 {
     OCP_FUNCNAME;
-    lphaseNum     = phaseNum;
-    lminEigenSkip = minEigenSkip;
-    lflagSkip     = flagSkip;
-    lziSkip       = ziSkip;
-    lPSkip        = PSkip;
-    lKs           = Ks;
-
-    lP          = P;
-    lPj         = Pj;
-    lPc         = Pc;
-    lphaseExist = phaseExist;
-    lS          = S;
-    lnj         = nj;
-    lrho        = rho;
-    lxi         = xi;
-    lxij        = xij;
-    lNi         = Ni;
-    lmu         = mu;
-    lkr         = kr;
-    lvj         = vj;
-    lvf         = vf;
-    lNt         = Nt;
-    lvfi        = vfi;
-    lvfp        = vfp;
-    lrockVp     = rockVp;
-    lmuP        = muP;
-    lxiP        = xiP;
-    lrhoP       = rhoP;
-    lmux        = mux;
-    lxix        = xix;
-    lrhox       = rhox;
-    ldSec_dPri  = dSec_dPri;
-    lres_n      = res_n;
-    lresPc      = resPc;
-    ldSdPindex  = dSdPindex;
-    lresIndex   = resIndex;
-    lpEnumCom   = pEnumCom;
-    ldKr_dS     = dKr_dS;
-    ldPcj_dS    = dPcj_dS;
 
-    if (miscible) {
-        lsurTen = surTen;
+    if (varChanged & BULK_PRIMARY) {
+        lP  = P;
+        lNi = Ni;
+    }
+    if (varChanged & BULK_FLASH) {
+        lphaseNum     = phaseNum;
+        lminEigenSkip = minEigenSkip;
+        lflagSkip     = flagSkip;
+        lziSkip       = ziSkip;
+        lPSkip        = PSkip;
+        lKs           = Ks;
+        lphaseExist   = phaseExist;
+        lS            = S;
+        lnj           = nj;
+        lrho          = rho;
+        lxi           = xi;
+        lxij          = xij;
+        lmu           = mu;
+        lvj           = vj;
+        lvf           = vf;
+        lNt           = Nt;
+        lvfi          = vfi;
+        lvfp          = vfp;
+        lmuP          = muP;
+        lxiP          = xiP;
+        lrhoP         = rhoP;
+        lmux          = mux;
+        lxix          = xix;
+        lrhox         = rhox;
+        ldSec_dPri    = dSec_dPri;
+        lres_n        = res_n;
+        lresPc        = resPc;
+        ldSdPindex    = dSdPindex;
+        lresIndex     = resIndex;
+        lpEnumCom     = pEnumCom;
+        if (miscible) {
+            lsurTen = surTen;
+        }
     }
+    if (varChanged & BULK_KRPC) {
+        lPj      = Pj;
+        lPc      = Pc;
+        lkr      = kr;
+        ldKr_dS  = dKr_dS;
+        ldPcj_dS = dPcj_dS;
+    }
+    if (varChanged & BULK_VPORE) {
+        lrockVp = rockVp;
+    }
+    varChanged = 0;
 }
 
 OCP_DBL Bulk::CalNRdSmax(OCP_USI& index)
@@ -3066,6 +3347,8 @@ OCP_DBL Bulk::GetNRdNmax() { return NRdNmax; }
 
 void Bulk::CorrectNi(const vector<OCP_DBL>& res)
 {
+    varChanged |= BULK_PRIMARY;
+
     for (OCP_USI n = 0; n < numBulk; n++) {
         for (USI i = 0; i < numCom; i++) {
             Ni[n * numCom + i] += res[n * (numCom + 1) + i];
@@ -3139,6 +3422,8 @@ void Bulk::AllocateAuxAIM(const OCP_DBL& ratio)
 {
     OCP_FUNCNAME;
 
+    varChanged |= BULK_ALL;
+
     maxNumFIMBulk = numBulk * ratio;
     if (maxNumFIMBulk < wellBulkId.capacity()) {
         maxNumFIMBulk = wellBulkId.capacity();
@@ -3174,6 +3459,8 @@ void Bulk::FlashDerivAIM(const bool& IfAIMs)
 {
     OCP_FUNCNAME;
 
+    varChanged |= BULK_FLASH;
+
     USI     ftype;
     OCP_USI n, bIdc;
     OCP_DBL Ntw;
@@ -3310,6 +3597,8 @@ void Bulk::CalKrPcDerivAIM(const bool& IfAIMs)
 {
     OCP_FUNCNAME;
 
+    varChanged |= BULK_KRPC;
+
     USI len;
     if (IfAIMs) {
         len = FIMBulk.size();
@@ -3362,6 +3651,8 @@ void Bulk::GetSolAIMt(const vector<OCP_DBL>& u, const OCP_DBL& dPmaxlim,
 {
     OCP_FUNCNAME;
 
+    varChanged |= BULK_PRIMARY;
+
     NRdSmaxP = 0;
     NRdPmax  = 0;
     OCP_DBL         dP;
@@ -3457,6 +3748,8 @@ void Bulk::GetSolAIMs(const vector<OCP_DBL>& u, const OCP_DBL& dPmaxlim,
 {
     OCP_FUNCNAME;
 
+    varChanged |= BULK_PRIMARY;
+
     NRdSmaxP = 0;
     NRdPmax  = 0;
     OCP_DBL         dP;
@@ -3545,6 +3838,8 @@ void Bulk::UpdateLastStepAIM()
 
 void Bulk::ResetFIMBulk()
 {
+    varChanged |= BULK_FLASH | BULK_KRPC;
+
     muP       = lmuP;
     xiP       = lxiP;
     rhoP      = lrhoP;
@@ -3613,6 +3908,8 @@ void Bulk::InFIMNi()
 
 void Bulk::OutFIMNi()
 {
+    varChanged |= BULK_PRIMARY;
+
     OCP_USI bIdb, bIdf;
     for (OCP_USI n = 0; n < numFIMBulk; n++) {
         bIdf = n * numCom;
@@ -3631,6 +3928,8 @@ void Bulk::AllocateAuxAIMc()
 
 void Bulk::FlashAIMc()
 {
+    varChanged |= BULK_FLASH;
+
     if (comps) {
         FlashCOMPAIMc();
     } else {
@@ -3695,6 +3994,8 @@ void Bulk::FlashCOMPAIMc()
 
 void Bulk::FlashAIMc01()
 {
+    varChanged |= BULK_FLASH;
+
     if (comps) {
         FlashCOMPAIMc01();
     } else {
@@ -3759,6 +4060,8 @@ void Bulk::FlashCOMPAIMc01()
 
 void Bulk::FlashDerivAIMc()
 {
+    varChanged |= BULK_FLASH;
+
     if (comps) {
         FlashDerivCOMPAIMc();
     } else {
@@ -3816,6 +4119,8 @@ void Bulk::FlashDerivCOMPAIMc()
 
 void Bulk::CalKrPcAIMc()
 {
+    varChanged |= BULK_KRPC;
+
     OCP_DBL tmp = 0;
     for (OCP_USI n = 0; n < numBulk; n++) {
         if (map_Bulk2FIM[n] > -1) {
@@ -3831,6 +4136,8 @@ void Bulk::CalKrPcAIMc()
 
 void Bulk::CalKrPcDerivAIMc()
 {
+    varChanged |= BULK_KRPC;
+
     OCP_DBL tmp;
     for (auto& n : FIMBulk) {
         OCP_USI bId = n * numPhase;
@@ -3844,6 +4151,8 @@ void Bulk::CalKrPcDerivAIMc()
 void Bulk::GetSolAIMc(const vector<OCP_DBL>& u, const OCP_DBL& dPmaxlim,
                       const OCP_DBL& dSmaxlim)
 {
+    varChanged |= BULK_PRIMARY;
+
     NRdPmax = 0;
     NRdNmax = 0;
     OCP_DBL tmp;
@@ -3893,6 +4202,8 @@ void Bulk::GetSolAIMc(const vector<OCP_DBL>& u, const OCP_DBL& dPmaxlim,
 void Bulk::GetSolAIMc01(const vector<OCP_DBL>& u, const OCP_DBL& dPmaxlim,
                         const OCP_DBL& dSmaxlim)
 {
+    varChanged |= BULK_PRIMARY;
+
     NRdSmaxP = 0;
     NRdPmax  = 0;
     OCP_DBL         dP;
@@ -3955,6 +4266,8 @@ void Bulk::GetSolAIMc01(const vector<OCP_DBL>& u, const OCP_DBL& dPmaxlim,
 
 void Bulk::UpdatePj()
 {
+    varChanged |= BULK_KRPC;
+
     for (OCP_USI n = 0; n < numBulk; n++) {
         for (USI j = 0; j < numPhase; j++) {
             Pj[n * numPhase + j] = P[n] + Pc[n * numPhase + j];
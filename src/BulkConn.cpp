@@ -29,57 +29,80 @@ void BulkConn::Setup(const Grid& myGrid, const Bulk& myBulk)
     numConn = 0;
     numBulk = myGrid.activeGridNum;
 
-    neighbor.resize(numBulk);
+    neighbor.assign(numBulk, vector<OCP_USI>());
     selfPtr.resize(numBulk);
     neighborNum.resize(numBulk);
+    iteratorConn.clear();
 
     vector<GPair> tmp1, tmp2;
     USI           len;
-    OCP_USI       bIdb;
 
-    for (OCP_USI n = 0; n < myGrid.numGrid; n++) {
-        const GB_Pair& GBtmp = myGrid.activeMap_G2B[n];
+    // Connections follow the ordering of bulks
+    for (OCP_USI bIdb = 0; bIdb < numBulk; bIdb++) {
+        const OCP_USI n = myGrid.activeMap_B2G[bIdb];
 
-        if (GBtmp.IsAct()) {
-            bIdb = GBtmp.GetId();
+        // Get rid of inactive neighbor
+        tmp1 = myGrid.gNeighbor[n];
+        len  = tmp1.size();
+        tmp2.clear();
+        for (USI i = 0; i < len; i++) {
+            const GB_Pair& GBtmp2 = myGrid.activeMap_G2B[tmp1[i].id];
 
-            // Get rid of inactive neighbor
-            tmp1 = myGrid.gNeighbor[n];
-            len  = tmp1.size();
-            tmp2.clear();
-            for (USI i = 0; i < len; i++) {
-                const GB_Pair& GBtmp2 = myGrid.activeMap_G2B[tmp1[i].id];
-
-                if (GBtmp2.IsAct()) {
-                    tmp1[i].id = GBtmp2.GetId();
-                    tmp2.push_back(tmp1[i]);
-                }
-            }
-            // Add Self
-            tmp2.push_back(GPair(bIdb, 0.0));
-            // Sort: Ascending
-            sort(tmp2.begin(), tmp2.end(), GPair::lessG);
-            // Find SelfPtr and Assign to neighbor and area
-            len = tmp2.size();
-            for (USI i = 0; i < len; i++) {
-                neighbor[bIdb].push_back(tmp2[i].id);
-                if (tmp2[i].id == bIdb) {
-                    selfPtr[bIdb] = i;
-                }
+            if (GBtmp2.IsAct()) {
+                tmp1[i].id = GBtmp2.GetId();
+                tmp2.push_back(tmp1[i]);
             }
-            for (USI j = selfPtr[bIdb] + 1; j < len; j++) {
-                iteratorConn.push_back(BulkPair(bIdb, tmp2[j].id, tmp2[j].area));
+        }
+        // Add Self
+        tmp2.push_back(GPair(bIdb, 0.0));
+        // Sort: Ascending
+        sort(tmp2.begin(), tmp2.end(), GPair::lessG);
+        // Find SelfPtr and Assign to neighbor and area
+        len = tmp2.size();
+        for (USI i = 0; i < len; i++) {
+            neighbor[bIdb].push_back(tmp2[i].id);
+            if (tmp2[i].id == bIdb) {
+                selfPtr[bIdb] = i;
             }
-            neighborNum[bIdb] = len;
         }
+        for (USI j = selfPtr[bIdb] + 1; j < len; j++) {
+            iteratorConn.push_back(BulkPair(bIdb, tmp2[j].id, tmp2[j].area));
+        }
+        neighborNum[bIdb] = len;
     }
 
     numConn = iteratorConn.size();
 
+    // Find slots of off-diagonal blocks for each connection
+    offDiagPtr.resize(numConn * 2);
+    for (OCP_USI c = 0; c < numConn; c++) {
+        const OCP_USI bId = iteratorConn[c].BId;
+        const OCP_USI eId = iteratorConn[c].EId;
+        offDiagPtr[c * 2] =
+            lower_bound(neighbor[bId].begin(), neighbor[bId].end(), eId) -
+            neighbor[bId].begin();
+        offDiagPtr[c * 2 + 1] =
+            lower_bound(neighbor[eId].begin(), neighbor[eId].end(), bId) -
+            neighbor[eId].begin();
+    }
+
     // PrintConnectionInfoCoor(myGrid);
 }
 
 
+void BulkConn::SyncSetup(OCPCheckpoint& cache)
+{
+    OCP_FUNCNAME;
+
+    cache.Sync(numBulk);
+    cache.Sync(numConn);
+    cache.Sync(neighbor);
+    cache.Sync(selfPtr);
+    cache.Sync(neighborNum);
+    cache.Sync(offDiagPtr);
+    cache.Sync(iteratorConn);
+}
+
 void BulkConn::SetupWellBulk_K(Bulk& myBulk) const
 { 
     // For K = 1 now, defaulted
@@ -118,6 +141,8 @@ void BulkConn::SetupMatSparsity(LinearSystem& myLS) const
     OCP_FUNCNAME;
 
     myLS.dim = numBulk;
+    // the kept pattern has already included neighbors
+    if (myLS.IfPatternFixed()) return;
     for (OCP_USI n = 0; n < numBulk; n++) {
         myLS.colId[n].assign(neighbor[n].begin(), neighbor[n].end());
         myLS.diagPtr[n] = selfPtr[n];
@@ -144,6 +169,21 @@ void BulkConn::Reset()
     upblock_Velocity = lastUpblock_Velocity;
 }
 
+void BulkConn::SyncCheckpoint(OCPCheckpoint& ckpt)
+{
+    OCP_FUNCNAME;
+
+    ckpt.Check(numConn, "number of connections");
+    ckpt.Sync(upblock);
+    ckpt.Sync(upblock_Rho);
+    ckpt.Sync(upblock_Trans);
+    ckpt.Sync(upblock_Velocity);
+    ckpt.Sync(lastUpblock);
+    ckpt.Sync(lastUpblock_Rho);
+    ckpt.Sync(lastUpblock_Trans);
+    ckpt.Sync(lastUpblock_Velocity);
+}
+
 void BulkConn::CheckDiff() const
 {
     OCP_FUNCNAME;
@@ -464,6 +504,66 @@ void BulkConn::AllocateAuxFIM(const USI& np)
     upblock_Rho.resize(numConn * np);
 }
 
+void BulkConn::AssembleConnBlock(LinearSystem& myLS, const USI& bsize,
+                                 const bool& withRhs) const
+{
+    OCP_FUNCNAME;
+
+    const USI ncol = myLS.blockDim;
+
+    // Becareful when first bulk has no neighbors!
+    OCP_USI lastbId = iteratorConn[0].EId;
+    for (OCP_USI c = 0; c < numConn; c++) {
+        const OCP_USI bId     = iteratorConn[c].BId;
+        const OCP_USI eId     = iteratorConn[c].EId;
+        const USI     diagptr = myLS.diagPtr[bId];
+
+        if (bId != lastbId) {
+            // new bulk
+            assert(myLS.IfPatternFixed() || myLS.val[bId].size() == diagptr * bsize);
+            myLS.InsertBlock(bId, diagptr, myLS.diagVal.data() + bId * bsize);
+            lastbId = bId;
+        }
+
+        if (withRhs) {
+            const OCP_DBL* rhs = &connRhs[c * 2 * ncol];
+            for (USI i = 0; i < ncol; i++) {
+                myLS.b[bId * ncol + i] += rhs[i];
+                myLS.b[eId * ncol + i] += rhs[ncol + i];
+            }
+        }
+
+        OCP_DBL* blkB = &connBlock[c * 2 * bsize];
+        OCP_DBL* blkE = blkB + bsize;
+        // Begin
+        // Add
+        OCP_DBL* diagB = &myLS.val[bId][diagptr * bsize];
+        for (USI i = 0; i < bsize; i++) {
+            diagB[i] += blkB[i];
+        }
+        // End
+        // Insert
+        Dscalar(bsize, -1, blkB);
+        myLS.InsertBlock(eId, offDiagPtr[c * 2 + 1], blkB);
+
+        // Begin
+        // Insert
+        myLS.InsertBlock(bId, offDiagPtr[c * 2], blkE);
+        // End
+        // Add
+        Dscalar(bsize, -1, blkE);
+        for (USI i = 0; i < bsize; i++) {
+            myLS.diagVal[eId * bsize + i] += blkE[i];
+        }
+    }
+    // Add the rest of diag value. Important!
+    for (OCP_USI n = 0; n < numBulk; n++) {
+        // bulks without neighbors of bigger index
+        if (selfPtr[n] + 1 == neighborNum[n])
+            myLS.InsertBlock(n, myLS.diagPtr[n], myLS.diagVal.data() + n * bsize);
+    }
+}
+
 void BulkConn::AssembleMat_FIM(LinearSystem& myLS, const Bulk& myBulk,
                                const OCP_DBL& dt) const
 {
@@ -482,6 +582,9 @@ void BulkConn::AssembleMat_FIM(LinearSystem& myLS, const Bulk& myBulk,
     for (USI i = 1; i < ncol; i++) {
         bmat[i * ncol + i] = 1;
     }
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) firstprivate(bmat)
+#endif
     for (OCP_USI n = 0; n < numBulk; n++) {
         bmat[0] = myBulk.rockC1 * myBulk.rockVpInit[n] - myBulk.vfp[n];
         for (USI i = 0; i < nc; i++) {
@@ -508,8 +611,16 @@ void BulkConn::AssembleMat_FIM(LinearSystem& myLS, const Bulk& myBulk,
     OCP_DBL dP, dGamma;
     OCP_DBL tmp;
 
-    // Becareful when first bulk has no neighbors!
-    OCP_USI lastbId = iteratorConn[0].EId;
+    // Blocks of connections are computed in parallel, then they are added into the
+    // matrix in order of connections, so the result is independent of threads.
+    connBlock.resize(numConn * 2 * bsize);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) firstprivate(bmat, dFdXpB, dFdXpE, dFdXsB, \
+    dFdXsE) \
+    private(Akd, transJ, transIJ, bId, eId, uId, bId_np_j, eId_np_j, uId_np_j, \
+    phaseExistBj, phaseExistEj, kr, mu, xi, xij, rhoP, xiP, muP, rhox, xix, mux, dP, \
+    dGamma, tmp)
+#endif
     for (OCP_USI c = 0; c < numConn; c++) {
         bId = iteratorConn[c].BId;
         eId = iteratorConn[c].EId;
@@ -651,17 +762,7 @@ void BulkConn::AssembleMat_FIM(LinearSystem& myLS, const Bulk& myBulk,
             }
         }
 
-        USI diagptr = myLS.diagPtr[bId];
-
-        if (bId != lastbId) {
-            // new bulk
-            assert(myLS.val[bId].size() == diagptr * bsize);
-            OCP_USI id = bId * bsize;
-            myLS.val[bId].insert(myLS.val[bId].end(), myLS.diagVal.data() + id,
-                                 myLS.diagVal.data() + id + bsize);
-
-            lastbId = bId;
-        }
+        OCP_DBL* blk = &connBlock[c * 2 * bsize];
         
         // Assemble
 
@@ -672,15 +773,7 @@ void BulkConn::AssembleMat_FIM(LinearSystem& myLS, const Bulk& myBulk,
         DaABpbC(ncol, ncol, ncol2, 1, dFdXsB.data(), &myBulk.dSec_dPri[bId * bsize2], 1,
                 bmat.data());
         Dscalar(bsize, dt, bmat.data());
-        // Begin
-        // Add
-        for (USI i = 0; i < bsize; i++) {
-            myLS.val[bId][diagptr * bsize + i] += bmat[i];
-        }
-        // End
-        // Insert
-        Dscalar(bsize, -1, bmat.data());
-        myLS.val[eId].insert(myLS.val[eId].end(), bmat.begin(), bmat.end());
+        copy(bmat.begin(), bmat.end(), blk);
 
 #ifdef OCP_NANCHECK
         if (!CheckNan(bmat.size(), &bmat[0]))
@@ -697,14 +790,7 @@ void BulkConn::AssembleMat_FIM(LinearSystem& myLS, const Bulk& myBulk,
         DaABpbC(ncol, ncol, ncol2, 1, dFdXsE.data(), &myBulk.dSec_dPri[eId * bsize2], 1,
                 bmat.data());
         Dscalar(bsize, dt, bmat.data());
-        // Begin
-        // Insert
-        myLS.val[bId].insert(myLS.val[bId].end(), bmat.begin(), bmat.end());
-        // Add
-        Dscalar(bsize, -1, bmat.data());
-        for (USI i = 0; i < bsize; i++) {
-            myLS.diagVal[eId * bsize + i] += bmat[i];
-        }
+        copy(bmat.begin(), bmat.end(), blk + bsize);
 
 #ifdef OCP_NANCHECK
         if (!CheckNan(bmat.size(), &bmat[0]))
@@ -714,12 +800,8 @@ void BulkConn::AssembleMat_FIM(LinearSystem& myLS, const Bulk& myBulk,
 #endif
 
     }
-    // Add the rest of diag value. Important!
-    for (OCP_USI n = 0; n < numBulk; n++) {
-        if (myLS.val[n].size() == myLS.diagPtr[n] * bsize)
-            myLS.val[n].insert(myLS.val[n].end(), myLS.diagVal.data() + n * bsize,
-                               myLS.diagVal.data() + n * bsize + bsize);
-    }
+    // Add blocks of connections into the matrix
+    AssembleConnBlock(myLS, bsize);
 }
 
 
@@ -1018,6 +1100,9 @@ void BulkConn::AssembleMat_FIM_new(LinearSystem& myLS, const Bulk& myBulk,
     for (USI i = 1; i < ncol; i++) {
         bmat[i * ncol + i] = 1;
     }
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) firstprivate(bmat)
+#endif
     for (OCP_USI n = 0; n < numBulk; n++) {
         bmat[0] = myBulk.rockC1 * myBulk.rockVpInit[n] - myBulk.vfp[n];
         for (USI i = 0; i < nc; i++) {
@@ -1049,8 +1134,16 @@ void BulkConn::AssembleMat_FIM_new(LinearSystem& myLS, const Bulk& myBulk,
     OCP_DBL tmp;
 
 
-    // Becareful when first bulk has no neighbors!
-    OCP_USI lastbId = iteratorConn[0].EId;
+    // Blocks of connections are computed in parallel, then they are added into the
+    // matrix in order of connections, so the result is independent of threads.
+    connBlock.resize(numConn * 2 * bsize);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) firstprivate(bmat, dFdXpB, dFdXpE, dFdXsB, \
+    dFdXsE, phaseExistB, phaseExistE, pEnumComB, pEnumComE) \
+    private(Akd, transJ, transIJ, phaseExistU, ncolB, ncolE, bId, eId, uId, bId_np_j, \
+    eId_np_j, uId_np_j, kr, mu, xi, xij, rhoP, xiP, muP, rhox, xix, mux, dP, dGamma, \
+    tmp)
+#endif
     for (OCP_USI c = 0; c < numConn; c++) {
         bId = iteratorConn[c].BId;
         eId = iteratorConn[c].EId;
@@ -1230,17 +1323,7 @@ void BulkConn::AssembleMat_FIM_new(LinearSystem& myLS, const Bulk& myBulk,
             jxE += pEnumComE[j];
         }
 
-        USI diagptr = myLS.diagPtr[bId];
-
-        if (bId != lastbId) {
-            // new bulk
-            assert(myLS.val[bId].size() == diagptr * bsize);
-            OCP_USI id = bId * bsize;
-            myLS.val[bId].insert(myLS.val[bId].end(), myLS.diagVal.data() + id,
-                myLS.diagVal.data() + id + bsize);
-
-            lastbId = bId;
-        }
+        OCP_DBL* blk = &connBlock[c * 2 * bsize];
 
         // Assemble
         bmat = dFdXpB;       
@@ -1248,15 +1331,7 @@ void BulkConn::AssembleMat_FIM_new(LinearSystem& myLS, const Bulk& myBulk,
         DaABpbC(ncol, ncol, ncolB, 1, dFdXsB.data(), &myBulk.dSec_dPri[myBulk.dSdPindex[bId]], 1,
             bmat.data());
         Dscalar(bsize, dt, bmat.data());
-        // Begin
-        // Add
-        for (USI i = 0; i < bsize; i++) {
-            myLS.val[bId][diagptr * bsize + i] += bmat[i];
-        }
-        // End
-        // Insert
-        Dscalar(bsize, -1, bmat.data());
-        myLS.val[eId].insert(myLS.val[eId].end(), bmat.begin(), bmat.end());
+        copy(bmat.begin(), bmat.end(), blk);
 
 #ifdef OCP_NANCHECK
         if (!CheckNan(bmat.size(), &bmat[0]))
@@ -1271,14 +1346,7 @@ void BulkConn::AssembleMat_FIM_new(LinearSystem& myLS, const Bulk& myBulk,
         DaABpbC(ncol, ncol, ncolE, 1, dFdXsE.data(), &myBulk.dSec_dPri[myBulk.dSdPindex[eId]], 1,
             bmat.data());
         Dscalar(bsize, dt, bmat.data());
-        // Begin
-        // Insert
-        myLS.val[bId].insert(myLS.val[bId].end(), bmat.begin(), bmat.end());
-        // Add
-        Dscalar(bsize, -1, bmat.data());
-        for (USI i = 0; i < bsize; i++) {
-            myLS.diagVal[eId * bsize + i] += bmat[i];
-        }
+        copy(bmat.begin(), bmat.end(), blk + bsize);
 
 #ifdef OCP_NANCHECK
         if (!CheckNan(bmat.size(), &bmat[0]))
@@ -1287,12 +1355,8 @@ void BulkConn::AssembleMat_FIM_new(LinearSystem& myLS, const Bulk& myBulk,
         }
 #endif
     }
-    // Add the rest of diag value. Important!
-    for (OCP_USI n = 0; n < numBulk; n++) {
-        if (myLS.val[n].size() == myLS.diagPtr[n] * bsize)
-            myLS.val[n].insert(myLS.val[n].end(), myLS.diagVal.data() + n * bsize,
-                myLS.diagVal.data() + n * bsize + bsize);
-    }
+    // Add blocks of connections into the matrix
+    AssembleConnBlock(myLS, bsize);
 }
 
 
@@ -1315,6 +1379,9 @@ void BulkConn::AssembleMat_FIM_newS(LinearSystem& myLS, const Bulk& myBulk,
     for (USI i = 1; i < ncol; i++) {
         bmat[i * ncol + i] = 1;
     }
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) firstprivate(bmat)
+#endif
     for (OCP_USI n = 0; n < numBulk; n++) {
         bmat[0] = myBulk.rockC1 * myBulk.rockVpInit[n] - myBulk.vfp[n];
         for (USI i = 0; i < nc; i++) {
@@ -1346,8 +1413,16 @@ void BulkConn::AssembleMat_FIM_newS(LinearSystem& myLS, const Bulk& myBulk,
     OCP_DBL tmp;
     OCP_DBL wghtb, wghte;
 
-    // Becareful when first bulk has no neighbors!
-    OCP_USI lastbId = iteratorConn[0].EId;
+    // Blocks of connections are computed in parallel, then they are added into the
+    // matrix in order of connections, so the result is independent of threads.
+    connBlock.resize(numConn * 2 * bsize);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) firstprivate(bmat, dFdXpB, dFdXpE, dFdXsB, \
+    dFdXsE, phaseExistB, phaseExistE, pEnumComB, pEnumComE) \
+    private(Akd, transJ, transIJ, phaseExistU, ncolB, ncolE, bId, eId, uId, bId_np_j, \
+    eId_np_j, uId_np_j, kr, mu, xi, xij, rhoP, xiP, muP, rhox, xix, mux, dP, dGamma, \
+    tmp, wghtb, wghte)
+#endif
     for (OCP_USI c = 0; c < numConn; c++) {
         bId = iteratorConn[c].BId;
         eId = iteratorConn[c].EId;
@@ -1552,17 +1627,7 @@ void BulkConn::AssembleMat_FIM_newS(LinearSystem& myLS, const Bulk& myBulk,
             jxE += pEnumComE[j];
         }
 
-        USI diagptr = myLS.diagPtr[bId];
-
-        if (bId != lastbId) {
-            // new bulk
-            assert(myLS.val[bId].size() == diagptr * bsize);
-            OCP_USI id = bId * bsize;
-            myLS.val[bId].insert(myLS.val[bId].end(), myLS.diagVal.data() + id,
-                myLS.diagVal.data() + id + bsize);
-
-            lastbId = bId;
-        }
+        OCP_DBL* blk = &connBlock[c * 2 * bsize];
 
         // Assemble
         bmat = dFdXpB;
@@ -1570,15 +1635,7 @@ void BulkConn::AssembleMat_FIM_newS(LinearSystem& myLS, const Bulk& myBulk,
         DaABpbC(ncol, ncol, ncolB, 1, dFdXsB.data(), &myBulk.dSec_dPri[myBulk.dSdPindex[bId]], 1,
             bmat.data());
         Dscalar(bsize, dt, bmat.data());
-        // Begin
-        // Add
-        for (USI i = 0; i < bsize; i++) {
-            myLS.val[bId][diagptr * bsize + i] += bmat[i];
-        }
-        // End
-        // Insert
-        Dscalar(bsize, -1, bmat.data());
-        myLS.val[eId].insert(myLS.val[eId].end(), bmat.begin(), bmat.end());
+        copy(bmat.begin(), bmat.end(), blk);
 
 #ifdef OCP_NANCHECK
         if (!CheckNan(bmat.size(), &bmat[0]))
@@ -1593,14 +1650,7 @@ void BulkConn::AssembleMat_FIM_newS(LinearSystem& myLS, const Bulk& myBulk,
         DaABpbC(ncol, ncol, ncolE, 1, dFdXsE.data(), &myBulk.dSec_dPri[myBulk.dSdPindex[eId]], 1,
             bmat.data());
         Dscalar(bsize, dt, bmat.data());
-        // Begin
-        // Insert
-        myLS.val[bId].insert(myLS.val[bId].end(), bmat.begin(), bmat.end());
-        // Add
-        Dscalar(bsize, -1, bmat.data());
-        for (USI i = 0; i < bsize; i++) {
-            myLS.diagVal[eId * bsize + i] += bmat[i];
-        }
+        copy(bmat.begin(), bmat.end(), blk + bsize);
 
 #ifdef OCP_NANCHECK
         if (!CheckNan(bmat.size(), &bmat[0]))
@@ -1609,12 +1659,8 @@ void BulkConn::AssembleMat_FIM_newS(LinearSystem& myLS, const Bulk& myBulk,
         }
 #endif
     }
-    // Add the rest of diag value. Important!
-    for (OCP_USI n = 0; n < numBulk; n++) {
-        if (myLS.val[n].size() == myLS.diagPtr[n] * bsize)
-            myLS.val[n].insert(myLS.val[n].end(), myLS.diagVal.data() + n * bsize,
-                myLS.diagVal.data() + n * bsize + bsize);
-    }
+    // Add blocks of connections into the matrix
+    AssembleConnBlock(myLS, bsize);
 }
 
 
@@ -1637,6 +1683,9 @@ void BulkConn::AssembleMat_FIM_new_n(LinearSystem& myLS, const Bulk& myBulk,
     for (USI i = 1; i < ncol; i++) {
         bmat[i * ncol + i] = 1;
     }
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) firstprivate(bmat)
+#endif
     for (OCP_USI n = 0; n < numBulk; n++) {
         bmat[0] = myBulk.rockC1 * myBulk.rockVpInit[n] - myBulk.vfp[n];
         for (USI i = 0; i < nc; i++) {
@@ -1669,8 +1718,17 @@ void BulkConn::AssembleMat_FIM_new_n(LinearSystem& myLS, const Bulk& myBulk,
     OCP_DBL tmp;
 
 
-    // Becareful when first bulk has no neighbors!
-    OCP_USI lastbId = iteratorConn[0].EId;
+    // Blocks of connections are computed in parallel, then they are added into the
+    // matrix in order of connections, so the result is independent of threads.
+    connBlock.resize(numConn * 2 * bsize);
+    connRhs.resize(numConn * 2 * ncol);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) firstprivate(bmat, dFdXpB, dFdXpE, dFdXsB, \
+    dFdXsE, phaseExistB, phaseExistE, pEnumComB, pEnumComE) \
+    private(Akd, transJ, transIJ, phaseExistU, ncolB, ncolE, bId, eId, uId, bId_np_j, \
+    eId_np_j, uId_np_j, kr, mu, xi, xij, rhoP, xiP, muP, rhox, xix, mux, dP, dGamma, \
+    tmp)
+#endif
     for (OCP_USI c = 0; c < numConn; c++) {
         bId = iteratorConn[c].BId;
         eId = iteratorConn[c].EId;
@@ -1860,23 +1918,15 @@ void BulkConn::AssembleMat_FIM_new_n(LinearSystem& myLS, const Bulk& myBulk,
             jxE += pEnumComE[j];
         }
 
-        USI diagptr = myLS.diagPtr[bId];
-
-        if (bId != lastbId) {
-            // new bulk
-            assert(myLS.val[bId].size() == diagptr * bsize);
-            OCP_USI id = bId * bsize;
-            myLS.val[bId].insert(myLS.val[bId].end(), myLS.diagVal.data() + id,
-                myLS.diagVal.data() + id + bsize);
-
-            lastbId = bId;
-        }
+        OCP_DBL* blk = &connBlock[c * 2 * bsize];
+        OCP_DBL* rhs = &connRhs[c * 2 * ncol];
+        fill(rhs, rhs + 2 * ncol, 0.0);
 
         // Assemble rhs
         // Begin
         if (npB > 2) {
             DaAxpby(ncol, ncolB, -1.0, dFdXsB.data(),
-                &myBulk.res_n[myBulk.resIndex[bId]], 1.0, &myLS.b[bId * ncol]);
+                &myBulk.res_n[myBulk.resIndex[bId]], 1.0, rhs);
 
             //cout << "----------- " << bId << " ------------" << endl;
             //PrintDX(ncol, &myLS.b[bId * ncol]);
@@ -1888,15 +1938,7 @@ void BulkConn::AssembleMat_FIM_new_n(LinearSystem& myLS, const Bulk& myBulk,
         DaABpbC(ncol, ncol, ncolB, 1, dFdXsB.data(), &myBulk.dSec_dPri[myBulk.dSdPindex[bId]], 1,
             bmat.data());
         Dscalar(bsize, dt, bmat.data());
-        // Begin
-        // Add
-        for (USI i = 0; i < bsize; i++) {
-            myLS.val[bId][diagptr * bsize + i] += bmat[i];
-        }
-        // End
-        // Insert
-        Dscalar(bsize, -1, bmat.data());
-        myLS.val[eId].insert(myLS.val[eId].end(), bmat.begin(), bmat.end());
+        copy(bmat.begin(), bmat.end(), blk);
 
 #ifdef OCP_NANCHECK
         if (!CheckNan(bmat.size(), &bmat[0]))
@@ -1909,7 +1951,7 @@ void BulkConn::AssembleMat_FIM_new_n(LinearSystem& myLS, const Bulk& myBulk,
         // End
         if (npE > 2) {
             DaAxpby(ncol, ncolE, -1.0, dFdXsE.data(),
-                &myBulk.res_n[myBulk.resIndex[eId]], 1.0, &myLS.b[eId * ncol]);
+                &myBulk.res_n[myBulk.resIndex[eId]], 1.0, rhs + ncol);
 
             //cout << "----------- " << eId << " ------------" << endl;
             //PrintDX(ncol, &myLS.b[eId * ncol]);
@@ -1922,14 +1964,7 @@ void BulkConn::AssembleMat_FIM_new_n(LinearSystem& myLS, const Bulk& myBulk,
             bmat.data());
         Dscalar(bsize, dt, bmat.data());
 
-        // Begin
-        // Insert
-        myLS.val[bId].insert(myLS.val[bId].end(), bmat.begin(), bmat.end());
-        // Add
-        Dscalar(bsize, -1, bmat.data());
-        for (USI i = 0; i < bsize; i++) {
-            myLS.diagVal[eId * bsize + i] += bmat[i];
-        }
+        copy(bmat.begin(), bmat.end(), blk + bsize);
 
 #ifdef OCP_NANCHECK
         if (!CheckNan(bmat.size(), &bmat[0]))
@@ -1938,12 +1973,8 @@ void BulkConn::AssembleMat_FIM_new_n(LinearSystem& myLS, const Bulk& myBulk,
         }
 #endif
     }
-    // Add the rest of diag value. Important!
-    for (OCP_USI n = 0; n < numBulk; n++) {
-        if (myLS.val[n].size() == myLS.diagPtr[n] * bsize)
-            myLS.val[n].insert(myLS.val[n].end(), myLS.diagVal.data() + n * bsize,
-                myLS.diagVal.data() + n * bsize + bsize);
-    }
+    // Add blocks of connections into the matrix
+    AssembleConnBlock(myLS, bsize, true);
 }
 
 
@@ -2590,12 +2621,15 @@ void BulkConn::AssembleMat_AIMs(LinearSystem& myLS, vector<OCP_DBL>& res, const
     }
     vector<OCP_DBL> bmatTmp(bmat);
 
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) firstprivate(bmat, bmatTmp) private(Vp0, Vp, vf, vfp)
+#endif
     for (OCP_USI n = 0; n < numBulk; n++) {
         Vp0 = myBulk.rockVpInit[n];
         Vp = myBulk.rockVp[n];
         vfp = myBulk.vfp[n];
         
-        if (myBulk.map_Bulk2FIM[n] < 0 || myBulk.map_Bulk2FIM[n] >= myBulk.numFIMBulk) {
+        if (!myBulk.IsFIMBulk(n)) {
             // IMPEC bulk
             bmat[0] = cr * Vp0 - vfp;
             vf = myBulk.vf[n];
@@ -2642,8 +2676,17 @@ void BulkConn::AssembleMat_AIMs(LinearSystem& myLS, vector<OCP_DBL>& res, const
     vector<OCP_DBL> dFdXsE(bsize2, 0);
     vector<OCP_DBL> IMPECbmat(bsize, 0);
 
-    // Be careful when first bulk has no neighbors!
-    OCP_USI lastbId = iteratorConn[0].EId;
+    // Terms of connections are computed in parallel, then they are added into the
+    // matrix in order of connections, so the result is independent of threads.
+    connBlock.resize(numConn * 2 * bsize);
+    connRhs.resize(numConn * 2 * ncol);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) firstprivate(dFdXpB, dFdXpE, dFdXsB, dFdXsE) \
+    private(bId, eId, uId, bIde, eIde, uIde, valupi, valdowni, valup, rhsup, valdown, \
+    rhsdown, uId_np_j, uIde_np_j, kr, mu, xi, xij, rhoP, xiP, muP, rhox, xix, mux, dP, \
+    dGamma, tmp, bIdFIM, eIdFIM, otherFIM, FIMbId, FIMeId, FIMbIde, FIMeIde, IMPECbId, \
+    IMPECeId, Akd, transJ, transIJ)
+#endif
     for (OCP_USI c = 0; c < numConn; c++) {
         bId = iteratorConn[c].BId;
         eId = iteratorConn[c].EId;
@@ -2652,9 +2695,8 @@ void BulkConn::AssembleMat_AIMs(LinearSystem& myLS, vector<OCP_DBL>& res, const
         bIde = myBulk.map_Bulk2FIM[bId];
         eIde = myBulk.map_Bulk2FIM[eId];
 
-        bIdFIM = eIdFIM = false;
-        if (bIde > -1 && bIde < myBulk.numFIMBulk)  bIdFIM = true;
-        if (eIde > -1 && eIde < myBulk.numFIMBulk)  eIdFIM = true;
+        bIdFIM = myBulk.IsFIMBulk(bId);
+        eIdFIM = myBulk.IsFIMBulk(eId);
 
         if (bIdFIM || eIdFIM) {
             // There exist at least one FIM bulk
@@ -2746,76 +2788,26 @@ void BulkConn::AssembleMat_AIMs(LinearSystem& myLS, vector<OCP_DBL>& res, const
                     }
                 }
             }
-            USI diagptr = myLS.diagPtr[bId];
-
-            // insert diag
-            if (bId != lastbId) {
-                // new bulk
-                assert(myLS.val[bId].size() == diagptr * bsize);
-                OCP_USI id = bId * bsize;
-                myLS.val[bId].insert(myLS.val[bId].end(), myLS.diagVal.data() + id,
-                    myLS.diagVal.data() + id + bsize);
-                lastbId = bId;
-            }
-
             // Assemble
-            bmat = dFdXpB;
+            OCP_DBL* blk = &connBlock[c * 2 * bsize];
+            copy(dFdXpB.begin(), dFdXpB.end(), blk);
             DaABpbC(ncol, ncol, ncol2, 1, dFdXsB.data(), &myBulk.dSec_dPri[FIMbIde * bsize2], 1,
-                bmat.data());
-            Dscalar(bsize, dt, bmat.data());
-            // Begin
-            // Add
-            if (FIMbId < FIMeId) {
-                diagptr = myLS.diagPtr[FIMbId];
-                for (USI i = 0; i < bsize; i++) {
-                    myLS.val[FIMbId][diagptr * bsize + i] += bmat[i];
-                }
-            }
-            else {
-                for (USI i = 0; i < bsize; i++) {
-                    myLS.diagVal[FIMbId * bsize + i] += bmat[i];
-                }
-            }
-            
-            
-            if (otherFIM) {
-                // End
-                // Insert
-                Dscalar(bsize, -1, bmat.data());
-                myLS.val[FIMeId].insert(myLS.val[FIMeId].end(), bmat.begin(), bmat.end());                
-            }
-            
-            // End
-            bmat = dFdXpE;
+                blk);
+            Dscalar(bsize, dt, blk);
+
+            blk += bsize;
+            copy(dFdXpE.begin(), dFdXpE.end(), blk);
             DaABpbC(ncol, ncol, ncol2, 1, dFdXsE.data(), &myBulk.dSec_dPri[FIMeIde * bsize2], 1,
-                bmat.data());
-            Dscalar(bsize, dt, bmat.data());
-            // Begin
-            // Insert
+                blk);
+            Dscalar(bsize, dt, blk);
             if (!otherFIM) {
                 // delete der about Ni
                 for (USI i = 0; i < ncol; i++) {
                     for (USI j = 1; j < ncol; j++) {
-                        bmat[i * ncol + j] = 0;
+                        blk[i * ncol + j] = 0;
                     }
                 }
             }
-            myLS.val[FIMbId].insert(myLS.val[FIMbId].end(), bmat.begin(), bmat.end());
-            if (otherFIM) {
-                // Add
-                Dscalar(bsize, -1, bmat.data());
-                if (FIMbId < FIMeId) {
-                    for (USI i = 0; i < bsize; i++) {
-                        myLS.diagVal[FIMeId * bsize + i] += bmat[i];
-                    }
-                }
-                else {
-                    diagptr = myLS.diagPtr[FIMeId];
-                    for (USI i = 0; i < bsize; i++) {
-                        myLS.val[FIMeId][diagptr * bsize + i] += bmat[i];
-                    }
-                }               
-            }
         }
 
         if (!bIdFIM || !eIdFIM) {
@@ -2863,17 +2855,104 @@ void BulkConn::AssembleMat_AIMs(LinearSystem& myLS, vector<OCP_DBL>& res, const
                 rhsdown -= temp * valdowni;
             }
 
-            // Add diag
-            USI diagptr = myLS.diagPtr[bId];
-            if (bId != lastbId) {
-                // new bulk
-                assert(myLS.val[bId].size() == diagptr * bsize);
-                OCP_USI id = bId * bsize;
-                myLS.val[bId].insert(myLS.val[bId].end(), myLS.diagVal.data() + id,
-                    myLS.diagVal.data() + id + bsize);
-                lastbId = bId;
+            OCP_DBL* tmpVal = &connRhs[c * 2 * ncol];
+            tmpVal[0] = valup;
+            tmpVal[1] = rhsup;
+            tmpVal[2] = valdown;
+            tmpVal[3] = rhsdown;
+        }
+    }
+
+    // Add terms of connections into the matrix
+    // Be careful when first bulk has no neighbors!
+    OCP_USI lastbId = iteratorConn[0].EId;
+    for (OCP_USI c = 0; c < numConn; c++) {
+        bId = iteratorConn[c].BId;
+        eId = iteratorConn[c].EId;
+
+        bIdFIM = myBulk.IsFIMBulk(bId);
+        eIdFIM = myBulk.IsFIMBulk(eId);
+
+        // insert diag
+        diagptr = myLS.diagPtr[bId];
+        if (bId != lastbId) {
+            // new bulk
+            assert(myLS.val[bId].size() == diagptr * bsize);
+            OCP_USI id = bId * bsize;
+            myLS.val[bId].insert(myLS.val[bId].end(), myLS.diagVal.data() + id,
+                myLS.diagVal.data() + id + bsize);
+            lastbId = bId;
+        }
+
+        if (bIdFIM || eIdFIM) {
+            FIMbId = bId;
+            FIMeId = eId;
+            otherFIM = eIdFIM;
+            if (!bIdFIM) {
+                FIMbId = eId;
+                FIMeId = bId;
+                otherFIM = bIdFIM;
+            }
+
+            OCP_DBL* blk = &connBlock[c * 2 * bsize];
+            // Begin
+            // Add
+            if (FIMbId < FIMeId) {
+                diagptr = myLS.diagPtr[FIMbId];
+                for (USI i = 0; i < bsize; i++) {
+                    myLS.val[FIMbId][diagptr * bsize + i] += blk[i];
+                }
+            }
+            else {
+                for (USI i = 0; i < bsize; i++) {
+                    myLS.diagVal[FIMbId * bsize + i] += blk[i];
+                }
+            }
+            if (otherFIM) {
+                // End
+                // Insert
+                Dscalar(bsize, -1, blk);
+                myLS.val[FIMeId].insert(myLS.val[FIMeId].end(), blk, blk + bsize);
             }
 
+            // End
+            blk += bsize;
+            // Begin
+            // Insert
+            myLS.val[FIMbId].insert(myLS.val[FIMbId].end(), blk, blk + bsize);
+            if (otherFIM) {
+                // Add
+                Dscalar(bsize, -1, blk);
+                if (FIMbId < FIMeId) {
+                    for (USI i = 0; i < bsize; i++) {
+                        myLS.diagVal[FIMeId * bsize + i] += blk[i];
+                    }
+                }
+                else {
+                    diagptr = myLS.diagPtr[FIMeId];
+                    for (USI i = 0; i < bsize; i++) {
+                        myLS.val[FIMeId][diagptr * bsize + i] += blk[i];
+                    }
+                }
+            }
+        }
+
+        if (!bIdFIM || !eIdFIM) {
+            IMPECbId = bId;
+            IMPECeId = eId;
+            otherFIM = eIdFIM;
+            if (bIdFIM) {
+                IMPECbId = eId;
+                IMPECeId = bId;
+                otherFIM = bIdFIM;
+            }
+
+            const OCP_DBL* tmpVal = &connRhs[c * 2 * ncol];
+            valup   = tmpVal[0];
+            rhsup   = tmpVal[1];
+            valdown = tmpVal[2];
+            rhsdown = tmpVal[3];
+
             // Begin
             if (IMPECbId < IMPECeId) {
                 diagptr = myLS.diagPtr[IMPECbId];
@@ -2900,13 +2979,11 @@ void BulkConn::AssembleMat_AIMs(LinearSystem& myLS, vector<OCP_DBL>& res, const
                 }                
             }            
 
-
             // rhs
             res[IMPECbId * ncol] += rhsup;
             if (!otherFIM) {
                 res[IMPECeId * ncol] += rhsdown;
             }
-            
         }
     }
     // Add the rest of diag value. Important!
@@ -2943,6 +3020,9 @@ void BulkConn::AssembleMat_AIMc(LinearSystem& myLS, const Bulk& myBulk, const OC
 	for (USI i = 1; i < nc + 1; i++) {
 		bmat[i * ncol + i] = 1;
 	}
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) firstprivate(bmat)
+#endif
 	for (OCP_USI n = 0; n < numBulk; n++) {
 		bmat[0] = myBulk.rockC1 * myBulk.rockVpInit[n] - myBulk.vfp[n];
 		for (USI i = 0; i < nc; i++) {
@@ -2967,8 +3047,15 @@ void BulkConn::AssembleMat_AIMc(LinearSystem& myLS, const Bulk& myBulk, const OC
 	OCP_DBL tmp;
     bool bIdFIM, eIdFIM;
 
-	// Becareful when first bulk has no neighbors!
-	OCP_USI lastbId = iteratorConn[0].EId;
+	// Blocks of connections are computed in parallel, then they are added into the
+	// matrix in order of connections, so the result is independent of threads.
+	connBlock.resize(numConn * 2 * bsize);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) firstprivate(bmat, dFdXpB, dFdXpE, dFdXsB, \
+    dFdXsE) \
+    private(Akd, transJ, transIJ, bId, eId, uId, uId_np_j, kr, mu, xi, xij, rhoP, \
+    xiP, muP, rhox, xix, mux, dP, dGamma, tmp, bIdFIM, eIdFIM)
+#endif
 	for (OCP_USI c = 0; c < numConn; c++) {
 		bId = iteratorConn[c].BId;
 		eId = iteratorConn[c].EId;
@@ -3053,25 +3140,13 @@ void BulkConn::AssembleMat_AIMc(LinearSystem& myLS, const Bulk& myBulk, const OC
 			}
 		}
 
-		USI diagptr = myLS.diagPtr[bId];
-
-		if (bId != lastbId) {
-			// new bulk
-			assert(myLS.val[bId].size() == diagptr * bsize);
-			OCP_USI id = bId * bsize;
-			myLS.val[bId].insert(myLS.val[bId].end(), myLS.diagVal.data() + id,
-				myLS.diagVal.data() + id + bsize);
-
-			lastbId = bId;
-		}
+		OCP_DBL* blk = &connBlock[c * 2 * bsize];
 
 		// Assemble
 		bmat = dFdXpB;
 		DaABpbC(ncol, ncol, ncol2, 1, dFdXsB.data(), &myBulk.dSec_dPri[bId * bsize2], 1,
 			bmat.data());
 		Dscalar(bsize, dt, bmat.data());
-		// Begin
-		// Add
         if (!bIdFIM) {
 			// delete der about Ni
 			for (USI i = 1; i < ncol; i++) {
@@ -3080,21 +3155,13 @@ void BulkConn::AssembleMat_AIMc(LinearSystem& myLS, const Bulk& myBulk, const OC
 				}
 			}
         }
-		for (USI i = 0; i < bsize; i++) {
-			myLS.val[bId][diagptr * bsize + i] += bmat[i];
-		}
-		// End
-		// Insert
-		Dscalar(bsize, -1, bmat.data());
-		myLS.val[eId].insert(myLS.val[eId].end(), bmat.begin(), bmat.end());
+		copy(bmat.begin(), bmat.end(), blk);
 
 		// End
 		bmat = dFdXpE;
 		DaABpbC(ncol, ncol, ncol2, 1, dFdXsE.data(), &myBulk.dSec_dPri[eId * bsize2], 1,
 			bmat.data());
 		Dscalar(bsize, dt, bmat.data());
-		// Begin
-		// Insert
         if (!eIdFIM) {
             // delete der about Ni
             for (USI i = 1; i < ncol; i++) {
@@ -3103,19 +3170,10 @@ void BulkConn::AssembleMat_AIMc(LinearSystem& myLS, const Bulk& myBulk, const OC
                 }
             }
         }
-		myLS.val[bId].insert(myLS.val[bId].end(), bmat.begin(), bmat.end());
-		// Add
-		Dscalar(bsize, -1, bmat.data());
-		for (USI i = 0; i < bsize; i++) {
-			myLS.diagVal[eId * bsize + i] += bmat[i];
-		}
-	}
-	// Add the rest of diag value. Important!
-	for (OCP_USI n = 0; n < numBulk; n++) {
-		if (myLS.val[n].size() == myLS.diagPtr[n] * bsize)
-			myLS.val[n].insert(myLS.val[n].end(), myLS.diagVal.data() + n * bsize,
-				myLS.diagVal.data() + n * bsize + bsize);
+		copy(bmat.begin(), bmat.end(), blk + bsize);
 	}
+	// Add blocks of connections into the matrix
+	AssembleConnBlock(myLS, bsize);
 }
 
 void BulkConn::AssembleMat_AIMc01(LinearSystem& myLS, const Bulk& myBulk, const OCP_DBL& dt) const
@@ -3133,6 +3191,9 @@ void BulkConn::AssembleMat_AIMc01(LinearSystem& myLS, const Bulk& myBulk, const
     for (USI i = 1; i < nc + 1; i++) {
         bmat[i * ncol + i] = 1;
     }
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) firstprivate(bmat)
+#endif
     for (OCP_USI n = 0; n < numBulk; n++) {
         bmat[0] = myBulk.rockC1 * myBulk.rockVpInit[n] - myBulk.vfp[n];
         for (USI i = 0; i < nc; i++) {
@@ -3150,7 +3211,6 @@ void BulkConn::AssembleMat_AIMc01(LinearSystem& myLS, const Bulk& myBulk, const
 	OCP_DBL dP, dGamma;
 	OCP_DBL tmp;
     bool bIdFIM, eIdFIM, uIdFIM;
-	USI diagptr;
 
 	OCP_DBL         Akd;
 	OCP_DBL         transJ, transIJ;
@@ -3159,8 +3219,15 @@ void BulkConn::AssembleMat_AIMc01(LinearSystem& myLS, const Bulk& myBulk, const
 	vector<OCP_DBL> dFdXsB(bsize2, 0);
 	vector<OCP_DBL> dFdXsE(bsize2, 0);
 
-	// Be careful when first bulk has no neighbors!
-	OCP_USI lastbId = iteratorConn[0].EId;
+	// Blocks of connections are computed in parallel, then they are added into the
+	// matrix in order of connections, so the result is independent of threads.
+	connBlock.resize(numConn * 2 * bsize);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) firstprivate(bmat, dFdXpB, dFdXpE, dFdXsB, \
+    dFdXsE) \
+    private(bId, eId, uId, uId_np_j, kr, mu, xi, xij, rhoP, xiP, muP, rhox, xix, mux, \
+    dP, dGamma, tmp, bIdFIM, eIdFIM, uIdFIM, Akd, transJ, transIJ)
+#endif
 	for (OCP_USI c = 0; c < numConn; c++) {
 		bId = iteratorConn[c].BId;
 		eId = iteratorConn[c].EId;
@@ -3275,17 +3342,7 @@ void BulkConn::AssembleMat_AIMc01(LinearSystem& myLS, const Bulk& myBulk, const
                 }
             }
         }
-        USI diagptr = myLS.diagPtr[bId];
-
-        if (bId != lastbId) {
-            // new bulk
-            assert(myLS.val[bId].size() == diagptr * bsize);
-            OCP_USI id = bId * bsize;
-            myLS.val[bId].insert(myLS.val[bId].end(), myLS.diagVal.data() + id,
-                myLS.diagVal.data() + id + bsize);
-
-            lastbId = bId;
-        }
+        OCP_DBL* blk = &connBlock[c * 2 * bsize];
 
         // Assemble
         bmat = dFdXpB;
@@ -3294,15 +3351,7 @@ void BulkConn::AssembleMat_AIMc01(LinearSystem& myLS, const Bulk& myBulk, const
                 bmat.data());
         }
         Dscalar(bsize, dt, bmat.data());
-        // Begin
-        // Add
-        for (USI i = 0; i < bsize; i++) {
-            myLS.val[bId][diagptr * bsize + i] += bmat[i];
-        }
-        // End
-        // Insert
-        Dscalar(bsize, -1, bmat.data());
-        myLS.val[eId].insert(myLS.val[eId].end(), bmat.begin(), bmat.end());
+        copy(bmat.begin(), bmat.end(), blk);
 
         // End
         bmat = dFdXpE;
@@ -3311,21 +3360,10 @@ void BulkConn::AssembleMat_AIMc01(LinearSystem& myLS, const Bulk& myBulk, const
                 bmat.data());
         }       
         Dscalar(bsize, dt, bmat.data());
-        // Begin
-        // Insert
-        myLS.val[bId].insert(myLS.val[bId].end(), bmat.begin(), bmat.end());
-        // Add
-        Dscalar(bsize, -1, bmat.data());
-        for (USI i = 0; i < bsize; i++) {
-            myLS.diagVal[eId * bsize + i] += bmat[i];
-        }
-	}
-	// Add the rest of diag value. Important!
-	for (OCP_USI n = 0; n < numBulk; n++) {
-		if (myLS.val[n].size() == myLS.diagPtr[n] * bsize)
-			myLS.val[n].insert(myLS.val[n].end(), myLS.diagVal.data() + n * bsize,
-				myLS.diagVal.data() + n * bsize + bsize);
+        copy(bmat.begin(), bmat.end(), blk + bsize);
 	}
+	// Add blocks of connections into the matrix
+	AssembleConnBlock(myLS, bsize);
 }
 
 void BulkConn::CalResAIMc(vector<OCP_DBL>& res, const Bulk& myBulk, const OCP_DBL& dt)
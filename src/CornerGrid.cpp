@@ -9,8 +9,15 @@
  *-----------------------------------------------------------------------------------
  */
 
+// Standard header files
+#include <algorithm>
+
+// OpenCAEPoro header files
 #include "CornerGrid.hpp"
 
+/// Number of blocks whose half connections are computed by a task
+const OCP_USI NUM_CHUNK_BLOCKS = 256;
+
 Point3D& Point3D::operator=(const Point3D& other)
 {
     x = other.x;
@@ -541,31 +548,16 @@ OCP_DBL CalAreaNotQuadr(const HexahedronFace& FACE1, const HexahedronFace& FACE2
     return CalAreaNotQuadr;
 }
 
-void ConnGrid::Allocate(const USI& max_neighbor)
-{
-    nConn   = 0;
-    maxConn = max_neighbor;
-    halfConn.resize(maxConn);
-}
-
 void ConnGrid::AddHalfConn(const OCP_USI& n, const Point3D& area, const Point3D& d,
                            const USI& direction, const OCP_DBL& flag)
 {
-    if (nConn >= maxConn) {
-        maxConn *= 2;
-        halfConn.resize(maxConn);
-        // get larger space
-        if (maxConn > MAX_NEIGHBOR) {
-            // OCP_ABORT("Too many Neighbors!");
-        }
-    }
-    halfConn[nConn].Ad_dd = area * d / (d * d) * flag;
-    halfConn[nConn].d             = d;
-    halfConn[nConn].neigh         = n;
-    halfConn[nConn].directionType = direction;
-    nConn++;
+    HalfConn hc;
+    hc.Ad_dd         = area * d / (d * d) * flag;
+    hc.neigh         = n;
+    hc.directionType = direction;
+    halfConn.push_back(hc);
 
-    // cout << n << "   " << direction << "   " << halfConn[nConn-1].Ad_dd << endl;
+    // cout << n << "   " << direction << "   " << hc.Ad_dd << endl;
 }
 
 void COORD::Allocate(const USI& Nx, const USI& Ny, const USI& Nz)
@@ -575,32 +567,9 @@ void COORD::Allocate(const USI& Nx, const USI& Ny, const USI& Nz)
     nz      = Nz;
     numGrid = nx * ny * nz;
 
-    COORDDATA = new OCP_DBL**[3];
-    for (USI i = 0; i < 3; i++) {
-        COORDDATA[i] = new OCP_DBL*[2];
-        for (USI j = 0; j < 2; j++) {
-            COORDDATA[i][j] = new OCP_DBL[(nx + 1) * (ny + 1)];
-        }
-    }
-
-    ZCORNDATA = new OCP_DBL***[nx];
-    for (USI i = 0; i < nx; i++) {
-        ZCORNDATA[i] = new OCP_DBL**[ny];
-        for (USI j = 0; j < ny; j++) {
-            ZCORNDATA[i][j] = new OCP_DBL*[nz];
-            for (USI k = 0; k < nz; k++) {
-                ZCORNDATA[i][j][k] = new OCP_DBL[8];
-            }
-        }
-    }
-
-    cornerPoints = new Hexahedron**[nx];
-    for (USI i = 0; i < nx; i++) {
-        cornerPoints[i] = new Hexahedron*[ny];
-        for (USI j = 0; j < ny; j++) {
-            cornerPoints[i][j] = new Hexahedron[nz];
-        }
-    }
+    COORDDATA.resize((nx + 1) * (ny + 1) * 6);
+    ZCORNDATA.resize(numGrid * 8);
+    cornerPoints.resize(numGrid);
 
     v.resize(numGrid);
     depth.resize(numGrid);
@@ -623,99 +592,74 @@ void COORD::InputData(const vector<OCP_DBL>& coord, const vector<OCP_DBL>& zcorn
 bool COORD::InputCOORDDATA(const vector<OCP_DBL>& coord)
 {
     // See Eclipse -- COORD
-    bool    flag = false;
-    OCP_USI iter = 0;
-
-    for (USI J = 0; J < ny + 1; J++) {
-        for (USI I = 0; I < nx + 1; I++) {
-            // top
-            for (USI i = 0; i < 3; i++) {
-                COORDDATA[i][0][J * (nx + 1) + I] = coord[iter];
-                iter++;
-            }
-            // bottom
-            for (USI i = 0; i < 3; i++) {
-                COORDDATA[i][1][J * (nx + 1) + I] = coord[iter];
-                iter++;
-            }
-        }
-    }
-
-    flag = true;
-    return flag;
+    // Pillars are stored in the order of input, top then bottom point of each
+    if (coord.size() != COORDDATA.size()) return false;
+    COORDDATA = coord;
+    return true;
 }
 
 bool COORD::InputZCORNDATA(const vector<OCP_DBL>& zcorn)
 {
     // See Eclipse -- ZCORN
-    bool    flag = false;
-    OCP_USI iter = 0;
+    if (zcorn.size() != ZCORNDATA.size()) return false;
 
+    OCP_USI iter = 0;
     for (USI K = 0; K < nz; K++) {
         for (USI J = 0; J < ny; J++) {
             for (USI I = 0; I < nx; I++) {
-                ZCORNDATA[I][J][K][0] = zcorn[iter];
-                iter++;
-                ZCORNDATA[I][J][K][1] = zcorn[iter];
-                iter++;
+                ZCORNDATA[Index(I, J, K) * 8 + 0] = zcorn[iter++];
+                ZCORNDATA[Index(I, J, K) * 8 + 1] = zcorn[iter++];
             }
             for (USI I = 0; I < nx; I++) {
-                ZCORNDATA[I][J][K][3] = zcorn[iter];
-                iter++;
-                ZCORNDATA[I][J][K][2] = zcorn[iter];
-                iter++;
+                ZCORNDATA[Index(I, J, K) * 8 + 3] = zcorn[iter++];
+                ZCORNDATA[Index(I, J, K) * 8 + 2] = zcorn[iter++];
             }
         }
         for (USI J = 0; J < ny; J++) {
             for (USI I = 0; I < nx; I++) {
-                ZCORNDATA[I][J][K][4] = zcorn[iter];
-                iter++;
-                ZCORNDATA[I][J][K][5] = zcorn[iter];
-                iter++;
+                ZCORNDATA[Index(I, J, K) * 8 + 4] = zcorn[iter++];
+                ZCORNDATA[Index(I, J, K) * 8 + 5] = zcorn[iter++];
             }
             for (USI I = 0; I < nx; I++) {
-                ZCORNDATA[I][J][K][7] = zcorn[iter];
-                iter++;
-                ZCORNDATA[I][J][K][6] = zcorn[iter];
-                iter++;
+                ZCORNDATA[Index(I, J, K) * 8 + 7] = zcorn[iter++];
+                ZCORNDATA[Index(I, J, K) * 8 + 6] = zcorn[iter++];
             }
         }
     }
-
-    flag = true;
-    return flag;
+    return true;
 }
 
 
-void COORD::SetAllFlags(const HexahedronFace& oFace, const HexahedronFace& Face)
+void COORD::SetAllFlags(const HexahedronFace& oFace, const HexahedronFace& Face,
+                        FaceFlags& ff) const
 {
-    tmpFace = Face;
+    ff.tmpFace = Face;
 
     if (oFace.p0.z > Face.p0.z + TEENY) {
-        tmpFace.p0 = oFace.p0;                  flagp0 =  1;
+        ff.tmpFace.p0 = oFace.p0;                  ff.flagp0 =  1;
     }
-    else if (oFace.p0.z < Face.p0.z - TEENY)    flagp0 = -1;
-    else                                        flagp0 =  0;
+    else if (oFace.p0.z < Face.p0.z - TEENY)    ff.flagp0 = -1;
+    else                                        ff.flagp0 =  0;
     
     
-    if (oFace.p1.z > Face.p1.z + TEENY)         flagp1 =  1;
+    if (oFace.p1.z > Face.p1.z + TEENY)         ff.flagp1 =  1;
     else if (oFace.p1.z < Face.p1.z - TEENY) {
-        tmpFace.p1 = oFace.p1;                  flagp1 = -1;
+        ff.tmpFace.p1 = oFace.p1;                  ff.flagp1 = -1;
     }
-    else                                        flagp1 =  0;
+    else                                        ff.flagp1 =  0;
 
     
-    if (oFace.p2.z > Face.p2.z + TEENY)         flagp2 =  1;
+    if (oFace.p2.z > Face.p2.z + TEENY)         ff.flagp2 =  1;
     else if (oFace.p2.z < Face.p2.z - TEENY) {
-        tmpFace.p2 = oFace.p2;                  flagp2 = -1;
+        ff.tmpFace.p2 = oFace.p2;                  ff.flagp2 = -1;
     }
-    else                                        flagp2 =  0;
+    else                                        ff.flagp2 =  0;
 
     if (oFace.p3.z > Face.p3.z + TEENY) {
-        tmpFace.p3 = oFace.p3;                  flagp3 =  1;
+        ff.tmpFace.p3 = oFace.p3;                  ff.flagp3 =  1;
     }
-    else if (oFace.p3.z < Face.p3.z - TEENY)    flagp3 = -1;
-    else                                        flagp3 =  0;
+    else if (oFace.p3.z < Face.p3.z - TEENY)    ff.flagp3 = -1;
+    else                                        ff.flagp3 =  0;
     
     // check if interface is empty set
     // check if interface is quadrilateral
@@ -723,151 +667,72 @@ void COORD::SetAllFlags(const HexahedronFace& oFace, const HexahedronFace& Face)
    
     if (((oFace.p1.z <= Face.p0.z) && (oFace.p2.z <= Face.p3.z)) ||
         ((oFace.p0.z >= Face.p1.z) && (oFace.p3.z >= Face.p2.z))){
-        flagJump = true;
+        ff.flagJump = true;
     }
     else {
-        flagJump = false;   
-        if ((flagp0 * flagp3 >= 0) && (oFace.p0.z <= Face.p1.z) && (oFace.p3.z <= Face.p2.z) &&
-            (flagp1 * flagp2 >= 0) && (oFace.p1.z >= Face.p0.z) && (oFace.p2.z >= Face.p3.z)) {
-            flagQuad = true;
+        ff.flagJump = false;   
+        if ((ff.flagp0 * ff.flagp3 >= 0) && (oFace.p0.z <= Face.p1.z) && (oFace.p3.z <= Face.p2.z) &&
+            (ff.flagp1 * ff.flagp2 >= 0) && (oFace.p1.z >= Face.p0.z) && (oFace.p2.z >= Face.p3.z)) {
+            ff.flagQuad = true;
         }
         else {
-            flagQuad = false;
+            ff.flagQuad = false;
         }
     }  
 }
 
 
+/// Find the point of depth zvalue on a pillar given by its top and bottom points.
+static Point3D PointOnPillar(const OCP_DBL* pillar, const OCP_DBL& zvalue)
+{
+    const OCP_DBL& xtop    = pillar[0];
+    const OCP_DBL& ytop    = pillar[1];
+    const OCP_DBL& ztop    = pillar[2];
+    const OCP_DBL& xbottom = pillar[3];
+    const OCP_DBL& ybottom = pillar[4];
+    const OCP_DBL& zbottom = pillar[5];
+
+    const OCP_DBL xvalue = xbottom - (zbottom - zvalue) / (zbottom - ztop) * (xbottom - xtop);
+    const OCP_DBL yvalue = ybottom - (zbottom - zvalue) / (zbottom - ztop) * (ybottom - ytop);
+    return Point3D(xvalue, yvalue, zvalue);
+}
+
 void COORD::SetupCornerPoints()
 {
-    OCP_USI cindex, oindex; // current block index and the other block index
-    OCP_USI nxny = nx * ny;
-     
-    // allocate memoery for connections
-    vector<ConnGrid> blockconn(numGrid);
-    for (OCP_USI iloop = 0; iloop < numGrid; iloop++) {
-        blockconn[iloop].Allocate(10);
-    }
+    const OCP_USI nxny = nx * ny;
 
     // setup each block including coordinates of points, center, depth, and volume
-    OCP_DBL xtop, ytop, ztop, xbottom, ybottom, zbottom, xvalue, yvalue, zvalue;
-    for (USI k = 0; k < nz; k++) {
-        for (USI j = 0; j < ny; j++) {
-            for (USI i = 0; i < nx; i++) {
-                //
-                // corner point 0 and 4
-                //
-                xtop = COORDDATA[0][0][j * (nx + 1) + i];
-                ytop = COORDDATA[1][0][j * (nx + 1) + i];
-                ztop = COORDDATA[2][0][j * (nx + 1) + i];
-                xbottom = COORDDATA[0][1][j * (nx + 1) + i];
-                ybottom = COORDDATA[1][1][j * (nx + 1) + i];
-                zbottom = COORDDATA[2][1][j * (nx + 1) + i];
-
-                zvalue = ZCORNDATA[i][j][k][0];
-                xvalue = xbottom - (zbottom - zvalue) / (zbottom - ztop) * (xbottom - xtop);
-                yvalue = ybottom - (zbottom - zvalue) / (zbottom - ztop) * (ybottom - ytop);
-                cornerPoints[i][j][k].p0 = Point3D(xvalue, yvalue, zvalue);
-
-                zvalue = ZCORNDATA[i][j][k][4];
-                xvalue = xbottom - (zbottom - zvalue) / (zbottom - ztop) * (xbottom - xtop);
-                yvalue = ybottom - (zbottom - zvalue) / (zbottom - ztop) * (ybottom - ytop);
-                cornerPoints[i][j][k].p4 = Point3D(xvalue, yvalue, zvalue);
-                //
-                //    corner point 1 and 5
-                //
-                xtop = COORDDATA[0][0][j * (nx + 1) + i + 1];
-                ytop = COORDDATA[1][0][j * (nx + 1) + i + 1];
-                ztop = COORDDATA[2][0][j * (nx + 1) + i + 1];
-                xbottom = COORDDATA[0][1][j * (nx + 1) + i + 1];
-                ybottom = COORDDATA[1][1][j * (nx + 1) + i + 1];
-                zbottom = COORDDATA[2][1][j * (nx + 1) + i + 1];
-
-                zvalue = ZCORNDATA[i][j][k][1];
-                xvalue = xbottom - (zbottom - zvalue) / (zbottom - ztop) * (xbottom - xtop);
-                yvalue = ybottom - (zbottom - zvalue) / (zbottom - ztop) * (ybottom - ytop);
-                cornerPoints[i][j][k].p1 = Point3D(xvalue, yvalue, zvalue);
-                
-                zvalue = ZCORNDATA[i][j][k][5];
-                xvalue = xbottom - (zbottom - zvalue) / (zbottom - ztop) * (xbottom - xtop);
-                yvalue = ybottom - (zbottom - zvalue) / (zbottom - ztop) * (ybottom - ytop);
-                cornerPoints[i][j][k].p5 = Point3D(xvalue, yvalue, zvalue);
-                //
-                //    corner point 2 and 6
-                //
-                xtop = COORDDATA[0][0][(j + 1) * (nx + 1) + i + 1];
-                ytop = COORDDATA[1][0][(j + 1) * (nx + 1) + i + 1];
-                ztop = COORDDATA[2][0][(j + 1) * (nx + 1) + i + 1];
-                xbottom = COORDDATA[0][1][(j + 1) * (nx + 1) + i + 1];
-                ybottom = COORDDATA[1][1][(j + 1) * (nx + 1) + i + 1];
-                zbottom = COORDDATA[2][1][(j + 1) * (nx + 1) + i + 1];
-
-                zvalue = ZCORNDATA[i][j][k][2];
-                xvalue = xbottom - (zbottom - zvalue) / (zbottom - ztop) * (xbottom - xtop);
-                yvalue = ybottom - (zbottom - zvalue) / (zbottom - ztop) * (ybottom - ytop);
-                cornerPoints[i][j][k].p2 = Point3D(xvalue, yvalue, zvalue);
-
-                zvalue = ZCORNDATA[i][j][k][6];
-                xvalue = xbottom - (zbottom - zvalue) / (zbottom - ztop) * (xbottom - xtop);
-                yvalue = ybottom - (zbottom - zvalue) / (zbottom - ztop) * (ybottom - ytop);
-                cornerPoints[i][j][k].p6 = Point3D(xvalue, yvalue, zvalue);
-                //
-                //    corner point 3 and 7
-                //
-                xtop = COORDDATA[0][0][(j + 1) * (nx + 1) + i];
-                ytop = COORDDATA[1][0][(j + 1) * (nx + 1) + i];
-                ztop = COORDDATA[2][0][(j + 1) * (nx + 1) + i];
-                xbottom = COORDDATA[0][1][(j + 1) * (nx + 1) + i];
-                ybottom = COORDDATA[1][1][(j + 1) * (nx + 1) + i];
-                zbottom = COORDDATA[2][1][(j + 1) * (nx + 1) + i];
-
-                zvalue = ZCORNDATA[i][j][k][3];
-                xvalue = xbottom - (zbottom - zvalue) / (zbottom - ztop) * (xbottom - xtop);
-                yvalue = ybottom - (zbottom - zvalue) / (zbottom - ztop) * (ybottom - ytop);
-                cornerPoints[i][j][k].p3 = Point3D(xvalue, yvalue, zvalue);
-
-                zvalue = ZCORNDATA[i][j][k][7];
-                xvalue = xbottom - (zbottom - zvalue) / (zbottom - ztop) * (xbottom - xtop);
-                yvalue = ybottom - (zbottom - zvalue) / (zbottom - ztop) * (ybottom - ytop);
-                cornerPoints[i][j][k].p7 = Point3D(xvalue, yvalue, zvalue);
-                
-                      
-                //    calculate volumes and pore volumes
-                cindex = k * nxny + j * nx + i;
-                //
-                // NOTE: if there are several points not well ordered, the calculated
-                // volume will be negative.
-                //
-                v[cindex] = VolumHexahedron(cornerPoints[i][j][k]); // NTG
-                v[cindex] = fabs(v[cindex]);
-                center[cindex] = CenterHexahedron(cornerPoints[i][j][k]);
-                depth[cindex] = center[cindex].z;
-            }
-        }
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for (OCP_USI cindex = 0; cindex < numGrid; cindex++) {
+        const USI i = cindex % nx;
+        const USI j = cindex / nx % ny;
+
+        const OCP_DBL* zvalue = &ZCORNDATA[cindex * 8];
+        Hexahedron&    block  = cornerPoints[cindex];
+        // corner point 0 and 4
+        block.p0 = PointOnPillar(Pillar(i, j), zvalue[0]);
+        block.p4 = PointOnPillar(Pillar(i, j), zvalue[4]);
+        // corner point 1 and 5
+        block.p1 = PointOnPillar(Pillar(i + 1, j), zvalue[1]);
+        block.p5 = PointOnPillar(Pillar(i + 1, j), zvalue[5]);
+        // corner point 2 and 6
+        block.p2 = PointOnPillar(Pillar(i + 1, j + 1), zvalue[2]);
+        block.p6 = PointOnPillar(Pillar(i + 1, j + 1), zvalue[6]);
+        // corner point 3 and 7
+        block.p3 = PointOnPillar(Pillar(i, j + 1), zvalue[3]);
+        block.p7 = PointOnPillar(Pillar(i, j + 1), zvalue[7]);
+
+        //
+        // NOTE: if there are several points not well ordered, the calculated
+        // volume will be negative.
+        //
+        v[cindex]      = fabs(VolumHexahedron(block)); // NTG
+        center[cindex] = CenterHexahedron(block);
+        depth[cindex]  = center[cindex].z;
     }
 
-    // find neighbor and calculate transmissibility
-    OCP_USI num_conn = 0; // record the num of connection, a->b & b->a are both included
-    Point3D Pcenter, Pface, Pc2f; // center of Hexahedron
-    HexahedronFace Face, oFace; // current face, the other face
-    HexahedronFace FaceP, oFaceP; // Projection of Face and the other face
-    Point3D areaV; // area vector of interface
-    OCP_DBL areaP; // area of projection of interface
-    OCP_INT iznnc;
-    Point3D dxpoint, dypoint, dzpoint;
-
-    // test 
-    //cornerPoints[13][1][72].p0; cornerPoints[13][1][72].p1;
-    //cornerPoints[13][1][72].p2; cornerPoints[13][1][72].p3;
-    //cornerPoints[13][1][72].p4; cornerPoints[13][1][72].p5;
-    //cornerPoints[13][1][72].p6; cornerPoints[13][1][72].p7;
-
-    //cornerPoints[13][2][74].p0; cornerPoints[13][2][74].p1;
-    //cornerPoints[13][2][74].p2; cornerPoints[13][2][74].p3;
-    //cornerPoints[13][2][74].p4; cornerPoints[13][2][74].p5;
-    //cornerPoints[13][2][74].p6; cornerPoints[13][2][74].p7;
-
-
     /////////////////////////////////////////////////////////////////////
     // Attention that The coordinate axis follows the right-hand rule ! //
     /////////////////////////////////////////////////////////////////////
@@ -883,814 +748,873 @@ void COORD::SetupCornerPoints()
     //       p1 ---- p2
     
     // Determine flagForward
-    if (COORDDATA[1][0][nx + 1] > COORDDATA[1][0][0])   flagForward =  1.0;
-    else                                                flagForward = -1.0;
-
-    for (USI k = 0; k < nz; k++) {
-        for (USI j = 0; j < ny; j++) {
-            for (USI i = 0; i < nx; i++) {
-                // begin from each block             
-                const Hexahedron& block = cornerPoints[i][j][k];
-                cindex = k * nxny + j * nx + i;
-                Pcenter = center[cindex];
-
-                // cout << "============= " << cindex << " =============" << endl;
-                //
-                // (x-) direction
-                //
-
-                Face.p0 = block.p0;
-                Face.p1 = block.p4;
-                Face.p2 = block.p7;
-                Face.p3 = block.p3;
-                Pface = CenterFace(Face);
-                Pc2f = Pface - Pcenter;
-                dxpoint = Pc2f;
-
-                if (i == 0) {   
-                    // nothing to do
-                }
-                else {
+    if (Pillar(0, 1)[1] > Pillar(0, 0)[1])  flagForward =  1.0;
+    else                                    flagForward = -1.0;
 
-                    const Hexahedron& leftblock = cornerPoints[i-1][j][k];
-                    oindex = k * nxny + j * nx + i - 1;
-                    
-                    oFace.p0 = leftblock.p1;
-                    oFace.p1 = leftblock.p5;
-                    oFace.p2 = leftblock.p6;
-                    oFace.p3 = leftblock.p2;
+    // find neighbor and calculate transmissibility
+    // Blocks are handled in chunks, each chunk appends the half connections of its
+    // blocks to its own list; faulted blocks have more NNCs to check, hence the
+    // dynamic schedule. Joined in chunk order, the lists are sorted by block.
+    const OCP_USI    numChunk = (numGrid + NUM_CHUNK_BLOCKS - 1) / NUM_CHUNK_BLOCKS;
+    vector<ConnGrid> chunkConn(numChunk);
+    // half connections of block n are halfConn[halfBegin[n]], ..., halfConn[halfBegin[n+1]-1]
+    vector<OCP_USI> halfBegin(numGrid + 1, 0);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for (OCP_USI c = 0; c < numChunk; c++) {
+        const OCP_USI bId = c * NUM_CHUNK_BLOCKS;
+        const OCP_USI eId = min(bId + NUM_CHUNK_BLOCKS, numGrid);
+        chunkConn[c].halfConn.reserve(6 * (eId - bId));
+        for (OCP_USI n = bId; n < eId; n++) {
+            SetupConnOfBlock(n % nx, n / nx % ny, n / nxny, chunkConn[c]);
+            halfBegin[n + 1] = chunkConn[c].halfConn.size();
+        }
+    }
 
-                    SetAllFlags(oFace, Face);
+    // record the num of connection, a->b & b->a are both included
+    vector<OCP_USI> chunkBegin(numChunk + 1, 0);
+    for (OCP_USI c = 0; c < numChunk; c++) {
+        chunkBegin[c + 1] = chunkBegin[c] + chunkConn[c].halfConn.size();
+    }
+    const OCP_USI num_conn = chunkBegin[numChunk];
+
+    vector<HalfConn> halfConn(num_conn);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for (OCP_USI c = 0; c < numChunk; c++) {
+        const OCP_USI bId = c * NUM_CHUNK_BLOCKS;
+        const OCP_USI eId = min(bId + NUM_CHUNK_BLOCKS, numGrid);
+        for (OCP_USI n = bId; n < eId; n++) halfBegin[n + 1] += chunkBegin[c];
+        copy(chunkConn[c].halfConn.begin(), chunkConn[c].halfConn.end(),
+             halfConn.begin() + chunkBegin[c]);
+        vector<HalfConn>().swap(chunkConn[c].halfConn);
+    }
 
-                    // calculate the interface of two face
-                    if (flagJump) {
-                        // nothing to do
-                    }
-                    else {
-                        if (flagQuad) {
-                            areaV = VectorFace(tmpFace);
-                        }
-                        else {
-                            FaceP.p0 = Point3D(Face.p3.y, Face.p3.z, 0);
-                            FaceP.p1 = Point3D(Face.p0.y, Face.p0.z, 0);
-                            FaceP.p2 = Point3D(Face.p1.y, Face.p1.z, 0);
-                            FaceP.p3 = Point3D(Face.p2.y, Face.p2.z, 0);
-                            oFaceP.p0 = Point3D(oFace.p3.y, oFace.p3.z, 0);
-                            oFaceP.p1 = Point3D(oFace.p0.y, oFace.p0.z, 0);
-                            oFaceP.p2 = Point3D(oFace.p1.y, oFace.p1.z, 0);
-                            oFaceP.p3 = Point3D(oFace.p2.y, oFace.p2.z, 0);
-                            areaP = CalAreaNotQuadr(FaceP, oFaceP);
-                            // attention the direction of vector
-                            areaV = VectorFace(Face);
-                            // correct
-                            if (fabs(areaV.x) < 1E-6) {
-                                OCP_WARNING("x is too small");
-                            }
-                            else {
-                                areaV.y = areaV.y / fabs(areaV.x) * areaP;
-                                areaV.z = areaV.z / fabs(areaV.x) * areaP;
-                                areaV.x = OCP_SIGN(areaV.x) * areaP;
-                            }
-                        }
-                        blockconn[cindex].AddHalfConn(oindex, areaV, Pc2f, 1, flagForward);
-                        num_conn++;
-                    }
-                    
-                    // then find all NNC for current block
-                    // check if upNNC and downNNC exist                   
-                    if ((flagp0 > 0) || (flagp3 > 0))  upNNC = true;
-                    else                               upNNC = false;                                      
-                    if ((flagp1 < 0) || (flagp2 < 0))  downNNC = true;
-                    else                               downNNC = false;
-
-                    iznnc = -1;
-                    while (upNNC) {
-                        if (-iznnc > k)  break;
-                        // find object block
-                        const Hexahedron& leftblock = cornerPoints[i - 1][j][k + iznnc];   
-                        oindex = (k + iznnc) * nxny + j * nx + i - 1;
-                        oFace.p0 = leftblock.p1;
-                        oFace.p1 = leftblock.p5;
-                        oFace.p2 = leftblock.p6;
-                        oFace.p3 = leftblock.p2;
-
-                        SetAllFlags(oFace, Face);
-
-                        // calculate the interface of two face
-                        if (flagJump) {
-                            // nothing to do
-                        }
-                        else {
-                            if (flagQuad) {
-                                areaV = VectorFace(tmpFace);
-                            }
-                            else {
-                                FaceP.p0 = Point3D(Face.p3.y, Face.p3.z, 0);
-                                FaceP.p1 = Point3D(Face.p0.y, Face.p0.z, 0);
-                                FaceP.p2 = Point3D(Face.p1.y, Face.p1.z, 0);
-                                FaceP.p3 = Point3D(Face.p2.y, Face.p2.z, 0);
-                                oFaceP.p0 = Point3D(oFace.p3.y, oFace.p3.z, 0);
-                                oFaceP.p1 = Point3D(oFace.p0.y, oFace.p0.z, 0);
-                                oFaceP.p2 = Point3D(oFace.p1.y, oFace.p1.z, 0);
-                                oFaceP.p3 = Point3D(oFace.p2.y, oFace.p2.z, 0);
-                                areaP = CalAreaNotQuadr(FaceP, oFaceP);
-                                // attention the direction of vector
-                                areaV = VectorFace(Face);
-                                // correct
-                                if (fabs(areaV.x) < 1E-6) {
-                                    OCP_WARNING("x is too small");
-                                }
-                                else {
-                                    areaV.y = areaV.y / fabs(areaV.x) * areaP;
-                                    areaV.z = areaV.z / fabs(areaV.x) * areaP;
-                                    areaV.x = OCP_SIGN(areaV.x) * areaP;
-                                }
-                            }
-                            blockconn[cindex].AddHalfConn(oindex, areaV, Pc2f, 1, flagForward);
-                            num_conn++;
-                            
-                        }
-                        iznnc--;
-                        if ((flagp0 > 0) || (flagp3 > 0))  upNNC = true;
-                        else                               upNNC = false;
-                    }
+    // Bucket the half connections pointing to a lower block by that block. Owners
+    // are visited in increasing order, so each bucket is sorted by owner and the
+    // partner of a half connection is found by a binary search in a short bucket.
+    vector<OCP_USI> lowBegin(numGrid + 1, 0);
+    for (OCP_USI n = 0; n < numGrid; n++) {
+        for (OCP_USI h = halfBegin[n]; h < halfBegin[n + 1]; h++) {
+            if (halfConn[h].neigh < n) lowBegin[halfConn[h].neigh + 1]++;
+        }
+    }
+    for (OCP_USI n = 0; n < numGrid; n++) lowBegin[n + 1] += lowBegin[n];
 
-                    iznnc = 1;
-                    while (downNNC) {
-                        if (k + iznnc > nz - 1)  break;
-                        // find object block
-                        const Hexahedron& leftblock = cornerPoints[i - 1][j][k + iznnc];
-                        oindex = (k + iznnc) * nxny + j * nx + i - 1;
-                        oFace.p0 = leftblock.p1;
-                        oFace.p1 = leftblock.p5;
-                        oFace.p2 = leftblock.p6;
-                        oFace.p3 = leftblock.p2;
-
-                        SetAllFlags(oFace, Face);
-
-                        // calculate the interface of two face
-                        if (flagJump) {
-                            // nothing to do
-                        }
-                        else {
-                            if (flagQuad) {
-                                areaV = VectorFace(tmpFace);
-                            }
-                            else {
-                                FaceP.p0 = Point3D(Face.p3.y, Face.p3.z, 0);
-                                FaceP.p1 = Point3D(Face.p0.y, Face.p0.z, 0);
-                                FaceP.p2 = Point3D(Face.p1.y, Face.p1.z, 0);
-                                FaceP.p3 = Point3D(Face.p2.y, Face.p2.z, 0);
-                                oFaceP.p0 = Point3D(oFace.p3.y, oFace.p3.z, 0);
-                                oFaceP.p1 = Point3D(oFace.p0.y, oFace.p0.z, 0);
-                                oFaceP.p2 = Point3D(oFace.p1.y, oFace.p1.z, 0);
-                                oFaceP.p3 = Point3D(oFace.p2.y, oFace.p2.z, 0);
-                                areaP = CalAreaNotQuadr(FaceP, oFaceP);
-                                // attention the direction of vector
-                                areaV = VectorFace(Face);
-                                // correct
-                                if (fabs(areaV.x) < 1E-6) {
-                                    OCP_WARNING("x is too small");
-                                }
-                                else {
-                                    areaV.y = areaV.y / fabs(areaV.x) * areaP;
-                                    areaV.z = areaV.z / fabs(areaV.x) * areaP;
-                                    areaV.x = OCP_SIGN(areaV.x) * areaP;
-                                }
-                            }
-                            blockconn[cindex].AddHalfConn(oindex, areaV, Pc2f, 1, flagForward);
-                            num_conn++;
-                        }                       
-                        iznnc++;
-                        
-                        if ((flagp1 < 0) || (flagp2 < 0))  downNNC = true;
-                        else                               downNNC = false;
-                    }
-                }
+    vector<pair<OCP_USI, OCP_USI>> lowConn(lowBegin[numGrid]); // owner, half connection
+    vector<OCP_USI>                lowPos(lowBegin.begin(), lowBegin.end() - 1);
+    for (OCP_USI n = 0; n < numGrid; n++) {
+        for (OCP_USI h = halfBegin[n]; h < halfBegin[n + 1]; h++) {
+            if (halfConn[h].neigh < n) lowConn[lowPos[halfConn[h].neigh]++] = {n, h};
+        }
+    }
+    vector<OCP_USI>().swap(lowPos);
 
-                //
-                // (x+) direction
-                //
-                Face.p0 = block.p2;
-                Face.p1 = block.p6;
-                Face.p2 = block.p5;
-                Face.p3 = block.p1;
-                Pface = CenterFace(Face);
-                Pc2f = Pface - Pcenter;
-                dxpoint = Pc2f - dxpoint;
-
-                if (i == nx - 1) {
-                    // nothing to do
-                }
-                else {
+    OCP_ASSERT(num_conn % 2 == 0, "Wrong Conn!");
+    numConnMax = num_conn / 2;
+    connect.resize(numConnMax);
+    //
+    //    calculate the x,y,z direction transmissibilities of each block and save them
+    //
+    // make the connections
+    OCP_USI iter_conn = 0;
+    for (OCP_USI n = 0; n < numGrid; n++) {
+        const auto bucketB = lowConn.begin() + lowBegin[n];
+        const auto bucketE = lowConn.begin() + lowBegin[n + 1];
+        for (OCP_USI h = halfBegin[n]; h < halfBegin[n + 1]; h++) {
+            const OCP_USI nn = halfConn[h].neigh;
+            if (nn < n) continue;
+            // the first half connection of nn pointing to n
+            const auto it = lower_bound(bucketB, bucketE, nn,
+                                        [](const pair<OCP_USI, OCP_USI>& lc,
+                                           const OCP_USI& owner) { return lc.first < owner; });
+            if (it == bucketE || it->first != nn) {
+                continue;
+            }
+            const OCP_USI hh = it->second;
+            if (halfConn[h].Ad_dd <= 0 || halfConn[hh].Ad_dd <= 0) {
+                // false connection
+                continue;
+            }
 
-                    const Hexahedron& rightblock = cornerPoints[i + 1][j][k];
-                    oindex = k * nxny + j * nx + i + 1;
-                    
-                    oFace.p0 = rightblock.p3;
-                    oFace.p1 = rightblock.p7;
-                    oFace.p2 = rightblock.p4;
-                    oFace.p3 = rightblock.p0;
+            //
+            // now, halfConn[h]
+            //     halfConn[hh]
+            //     are a pair of connections
+            connect[iter_conn].begin = n;
+            connect[iter_conn].Ad_dd_begin = halfConn[h].Ad_dd;
+            connect[iter_conn].end = nn;
+            connect[iter_conn].Ad_dd_end = halfConn[hh].Ad_dd;
+            connect[iter_conn].directionType = halfConn[h].directionType;
+            iter_conn++;
+        }
+    }
+    numConn = iter_conn;
+}
 
-                    SetAllFlags(oFace, Face);
 
-                    // calculate the interface of two face
-                    if (flagJump) {
-                        // nothing to do
+void COORD::SetupConnOfBlock(const USI& i, const USI& j, const USI& k,
+                             ConnGrid& bconn)
+{
+    const OCP_USI nxny = nx * ny;
+    OCP_USI oindex; // the other block index
+    Point3D Pcenter, Pface, Pc2f; // center of Hexahedron
+    HexahedronFace Face, oFace; // current face, the other face
+    HexahedronFace FaceP, oFaceP; // Projection of Face and the other face
+    Point3D areaV; // area vector of interface
+    OCP_DBL areaP; // area of projection of interface
+    OCP_INT iznnc;
+    bool upNNC, downNNC;
+    Point3D dxpoint, dypoint, dzpoint;
+    FaceFlags ff;
+
+    const Hexahedron& block = cornerPoints[Index(i, j, k)];
+    const OCP_USI cindex = Index(i, j, k);
+    Pcenter = center[cindex];
+
+    // cout << "============= " << cindex << " =============" << endl;
+    //
+    // (x-) direction
+    //
+
+    Face.p0 = block.p0;
+    Face.p1 = block.p4;
+    Face.p2 = block.p7;
+    Face.p3 = block.p3;
+    Pface = CenterFace(Face);
+    Pc2f = Pface - Pcenter;
+    dxpoint = Pc2f;
+
+    if (i == 0) {   
+        // nothing to do
+    }
+    else {
+
+        const Hexahedron& leftblock = cornerPoints[Index(i - 1, j, k)];
+        oindex = k * nxny + j * nx + i - 1;
+        
+        oFace.p0 = leftblock.p1;
+        oFace.p1 = leftblock.p5;
+        oFace.p2 = leftblock.p6;
+        oFace.p3 = leftblock.p2;
+
+        SetAllFlags(oFace, Face, ff);
+
+        // calculate the interface of two face
+        if (ff.flagJump) {
+            // nothing to do
+        }
+        else {
+            if (ff.flagQuad) {
+                areaV = VectorFace(ff.tmpFace);
+            }
+            else {
+                FaceP.p0 = Point3D(Face.p3.y, Face.p3.z, 0);
+                FaceP.p1 = Point3D(Face.p0.y, Face.p0.z, 0);
+                FaceP.p2 = Point3D(Face.p1.y, Face.p1.z, 0);
+                FaceP.p3 = Point3D(Face.p2.y, Face.p2.z, 0);
+                oFaceP.p0 = Point3D(oFace.p3.y, oFace.p3.z, 0);
+                oFaceP.p1 = Point3D(oFace.p0.y, oFace.p0.z, 0);
+                oFaceP.p2 = Point3D(oFace.p1.y, oFace.p1.z, 0);
+                oFaceP.p3 = Point3D(oFace.p2.y, oFace.p2.z, 0);
+                areaP = CalAreaNotQuadr(FaceP, oFaceP);
+                // attention the direction of vector
+                areaV = VectorFace(Face);
+                // correct
+                if (fabs(areaV.x) < 1E-6) {
+                    OCP_WARNING("x is too small");
+                }
+                else {
+                    areaV.y = areaV.y / fabs(areaV.x) * areaP;
+                    areaV.z = areaV.z / fabs(areaV.x) * areaP;
+                    areaV.x = OCP_SIGN(areaV.x) * areaP;
+                }
+            }
+            bconn.AddHalfConn(oindex, areaV, Pc2f, 1, flagForward);
+        }
+        
+        // then find all NNC for current block
+        // check if upNNC and downNNC exist                   
+        if ((ff.flagp0 > 0) || (ff.flagp3 > 0))  upNNC = true;
+        else                               upNNC = false;                                      
+        if ((ff.flagp1 < 0) || (ff.flagp2 < 0))  downNNC = true;
+        else                               downNNC = false;
+
+        iznnc = -1;
+        while (upNNC) {
+            if (-iznnc > k)  break;
+            // find object block
+            const Hexahedron& leftblock = cornerPoints[Index(i - 1, j, k + iznnc)];   
+            oindex = (k + iznnc) * nxny + j * nx + i - 1;
+            oFace.p0 = leftblock.p1;
+            oFace.p1 = leftblock.p5;
+            oFace.p2 = leftblock.p6;
+            oFace.p3 = leftblock.p2;
+
+            SetAllFlags(oFace, Face, ff);
+
+            // calculate the interface of two face
+            if (ff.flagJump) {
+                // nothing to do
+            }
+            else {
+                if (ff.flagQuad) {
+                    areaV = VectorFace(ff.tmpFace);
+                }
+                else {
+                    FaceP.p0 = Point3D(Face.p3.y, Face.p3.z, 0);
+                    FaceP.p1 = Point3D(Face.p0.y, Face.p0.z, 0);
+                    FaceP.p2 = Point3D(Face.p1.y, Face.p1.z, 0);
+                    FaceP.p3 = Point3D(Face.p2.y, Face.p2.z, 0);
+                    oFaceP.p0 = Point3D(oFace.p3.y, oFace.p3.z, 0);
+                    oFaceP.p1 = Point3D(oFace.p0.y, oFace.p0.z, 0);
+                    oFaceP.p2 = Point3D(oFace.p1.y, oFace.p1.z, 0);
+                    oFaceP.p3 = Point3D(oFace.p2.y, oFace.p2.z, 0);
+                    areaP = CalAreaNotQuadr(FaceP, oFaceP);
+                    // attention the direction of vector
+                    areaV = VectorFace(Face);
+                    // correct
+                    if (fabs(areaV.x) < 1E-6) {
+                        OCP_WARNING("x is too small");
                     }
                     else {
-                        if (flagQuad) {
-                            areaV = VectorFace(tmpFace);
-                        }
-                        else {
-                            FaceP.p0 = Point3D(Face.p3.y, Face.p3.z, 0);
-                            FaceP.p1 = Point3D(Face.p0.y, Face.p0.z, 0);
-                            FaceP.p2 = Point3D(Face.p1.y, Face.p1.z, 0);
-                            FaceP.p3 = Point3D(Face.p2.y, Face.p2.z, 0);
-                            oFaceP.p0 = Point3D(oFace.p3.y, oFace.p3.z, 0);
-                            oFaceP.p1 = Point3D(oFace.p0.y, oFace.p0.z, 0);
-                            oFaceP.p2 = Point3D(oFace.p1.y, oFace.p1.z, 0);
-                            oFaceP.p3 = Point3D(oFace.p2.y, oFace.p2.z, 0);
-                            areaP = CalAreaNotQuadr(FaceP, oFaceP);
-                            // attention the direction of vector
-                            areaV = VectorFace(Face);
-                            // correct
-                            if (fabs(areaV.x) < 1E-6) {
-                                OCP_WARNING("x is too small");
-                            }
-                            else {
-                                areaV.y = areaV.y / fabs(areaV.x) * areaP;
-                                areaV.z = areaV.z / fabs(areaV.x) * areaP;
-                                areaV.x = OCP_SIGN(areaV.x) * areaP;
-                            }
-                        }
-                        blockconn[cindex].AddHalfConn(oindex, areaV, Pc2f, 1, flagForward);
-                        num_conn++;
-                    }                   
-
-                    // then find all NNC for current block
-                    if ((flagp0 > 0) || (flagp3 > 0))  upNNC = true;
-                    else                               upNNC = false;
-                    if ((flagp1 < 0) || (flagp2 < 0))  downNNC = true;
-                    else                               downNNC = false;
-
-                    iznnc = -1;
-                    while (upNNC) {
-                        if (-iznnc > k)  break;
-                        // find object block
-                        const Hexahedron& rightblock = cornerPoints[i + 1][j][k + iznnc];
-                        oindex = (k + iznnc) * nxny + j * nx + i + 1;
-                        oFace.p0 = rightblock.p3;
-                        oFace.p1 = rightblock.p7;
-                        oFace.p2 = rightblock.p4;
-                        oFace.p3 = rightblock.p0;
-
-                        SetAllFlags(oFace, Face);
-
-                        // calculate the interface of two face
-                        if (flagJump) {
-                            // nothing to do
-                        }
-                        else {
-                            if (flagQuad) {
-                                areaV = VectorFace(tmpFace);
-                            }
-                            else {
-                                FaceP.p0 = Point3D(Face.p3.y, Face.p3.z, 0);
-                                FaceP.p1 = Point3D(Face.p0.y, Face.p0.z, 0);
-                                FaceP.p2 = Point3D(Face.p1.y, Face.p1.z, 0);
-                                FaceP.p3 = Point3D(Face.p2.y, Face.p2.z, 0);
-                                oFaceP.p0 = Point3D(oFace.p3.y, oFace.p3.z, 0);
-                                oFaceP.p1 = Point3D(oFace.p0.y, oFace.p0.z, 0);
-                                oFaceP.p2 = Point3D(oFace.p1.y, oFace.p1.z, 0);
-                                oFaceP.p3 = Point3D(oFace.p2.y, oFace.p2.z, 0);
-                                areaP = CalAreaNotQuadr(FaceP, oFaceP);
-                                // attention the direction of vector
-                                areaV = VectorFace(Face);
-                                // correct
-                                if (fabs(areaV.x) < 1E-6) {
-                                    OCP_WARNING("x is too small");
-                                }
-                                else {
-                                    areaV.y = areaV.y / fabs(areaV.x) * areaP;
-                                    areaV.z = areaV.z / fabs(areaV.x) * areaP;
-                                    areaV.x = OCP_SIGN(areaV.x) * areaP;
-                                }
-                            }
-                            blockconn[cindex].AddHalfConn(oindex, areaV, Pc2f, 1, flagForward);
-                            num_conn++;
-                        }                       
-                        iznnc--;
-
-                        if ((flagp0 > 0) || (flagp3 > 0))  upNNC = true;
-                        else                               upNNC = false;
-                    }
-
-                    iznnc = 1;
-                    while (downNNC) {
-                        if (k + iznnc > nz - 1)  break;
-                        // find object block
-                        const Hexahedron& rightblock = cornerPoints[i + 1][j][k + iznnc];
-                        oindex = (k + iznnc) * nxny + j * nx + i + 1;
-                        oFace.p0 = rightblock.p3;
-                        oFace.p1 = rightblock.p7;
-                        oFace.p2 = rightblock.p4;
-                        oFace.p3 = rightblock.p0;
-
-                        SetAllFlags(oFace, Face);
-
-                        // calculate the interface of two face
-                        if (flagJump) {
-                            // nothing to do
-                        }
-                        else {
-                            if (flagQuad) {
-                                areaV = VectorFace(tmpFace);
-                            }
-                            else {
-                                FaceP.p0 = Point3D(Face.p3.y, Face.p3.z, 0);
-                                FaceP.p1 = Point3D(Face.p0.y, Face.p0.z, 0);
-                                FaceP.p2 = Point3D(Face.p1.y, Face.p1.z, 0);
-                                FaceP.p3 = Point3D(Face.p2.y, Face.p2.z, 0);
-                                oFaceP.p0 = Point3D(oFace.p3.y, oFace.p3.z, 0);
-                                oFaceP.p1 = Point3D(oFace.p0.y, oFace.p0.z, 0);
-                                oFaceP.p2 = Point3D(oFace.p1.y, oFace.p1.z, 0);
-                                oFaceP.p3 = Point3D(oFace.p2.y, oFace.p2.z, 0);
-                                areaP = CalAreaNotQuadr(FaceP, oFaceP);
-                                // attention the direction of vector
-                                areaV = VectorFace(Face);
-                                // correct
-                                if (fabs(areaV.x) < 1E-6) {
-                                    OCP_WARNING("x is too small");
-                                }
-                                else {
-                                    areaV.y = areaV.y / fabs(areaV.x) * areaP;
-                                    areaV.z = areaV.z / fabs(areaV.x) * areaP;
-                                    areaV.x = OCP_SIGN(areaV.x) * areaP;
-                                }
-                            }
-                            blockconn[cindex].AddHalfConn(oindex, areaV, Pc2f, 1, flagForward);
-                            num_conn++;
-                        }                       
-                        iznnc++;
-
-                        if ((flagp1 < 0) || (flagp2 < 0))  downNNC = true;
-                        else                               downNNC = false;
+                        areaV.y = areaV.y / fabs(areaV.x) * areaP;
+                        areaV.z = areaV.z / fabs(areaV.x) * areaP;
+                        areaV.x = OCP_SIGN(areaV.x) * areaP;
                     }
                 }
+                bconn.AddHalfConn(oindex, areaV, Pc2f, 1, flagForward);
+                
+            }
+            iznnc--;
+            if ((ff.flagp0 > 0) || (ff.flagp3 > 0))  upNNC = true;
+            else                               upNNC = false;
+        }
 
-                //
-                // (y-) direction
-                //
-                Face.p0 = block.p1;
-                Face.p1 = block.p5;
-                Face.p2 = block.p4;
-                Face.p3 = block.p0;
-                Pface = CenterFace(Face);
-                Pc2f = Pface - Pcenter;
-                dypoint = Pc2f;
-
-                if (j == 0) {
-                    // nothing to do
+        iznnc = 1;
+        while (downNNC) {
+            if (k + iznnc > nz - 1)  break;
+            // find object block
+            const Hexahedron& leftblock = cornerPoints[Index(i - 1, j, k + iznnc)];
+            oindex = (k + iznnc) * nxny + j * nx + i - 1;
+            oFace.p0 = leftblock.p1;
+            oFace.p1 = leftblock.p5;
+            oFace.p2 = leftblock.p6;
+            oFace.p3 = leftblock.p2;
+
+            SetAllFlags(oFace, Face, ff);
+
+            // calculate the interface of two face
+            if (ff.flagJump) {
+                // nothing to do
+            }
+            else {
+                if (ff.flagQuad) {
+                    areaV = VectorFace(ff.tmpFace);
                 }
                 else {
+                    FaceP.p0 = Point3D(Face.p3.y, Face.p3.z, 0);
+                    FaceP.p1 = Point3D(Face.p0.y, Face.p0.z, 0);
+                    FaceP.p2 = Point3D(Face.p1.y, Face.p1.z, 0);
+                    FaceP.p3 = Point3D(Face.p2.y, Face.p2.z, 0);
+                    oFaceP.p0 = Point3D(oFace.p3.y, oFace.p3.z, 0);
+                    oFaceP.p1 = Point3D(oFace.p0.y, oFace.p0.z, 0);
+                    oFaceP.p2 = Point3D(oFace.p1.y, oFace.p1.z, 0);
+                    oFaceP.p3 = Point3D(oFace.p2.y, oFace.p2.z, 0);
+                    areaP = CalAreaNotQuadr(FaceP, oFaceP);
+                    // attention the direction of vector
+                    areaV = VectorFace(Face);
+                    // correct
+                    if (fabs(areaV.x) < 1E-6) {
+                        OCP_WARNING("x is too small");
+                    }
+                    else {
+                        areaV.y = areaV.y / fabs(areaV.x) * areaP;
+                        areaV.z = areaV.z / fabs(areaV.x) * areaP;
+                        areaV.x = OCP_SIGN(areaV.x) * areaP;
+                    }
+                }
+                bconn.AddHalfConn(oindex, areaV, Pc2f, 1, flagForward);
+            }                       
+            iznnc++;
+            
+            if ((ff.flagp1 < 0) || (ff.flagp2 < 0))  downNNC = true;
+            else                               downNNC = false;
+        }
+    }
+
+    //
+    // (x+) direction
+    //
+    Face.p0 = block.p2;
+    Face.p1 = block.p6;
+    Face.p2 = block.p5;
+    Face.p3 = block.p1;
+    Pface = CenterFace(Face);
+    Pc2f = Pface - Pcenter;
+    dxpoint = Pc2f - dxpoint;
+
+    if (i == nx - 1) {
+        // nothing to do
+    }
+    else {
 
-                    const Hexahedron& backblock = cornerPoints[i][j - 1][k];
-                    oindex = k * nxny + (j - 1) * nx + i;
-                    
-                    oFace.p0 = backblock.p2;
-                    oFace.p1 = backblock.p6;
-                    oFace.p2 = backblock.p7;
-                    oFace.p3 = backblock.p3;
+        const Hexahedron& rightblock = cornerPoints[Index(i + 1, j, k)];
+        oindex = k * nxny + j * nx + i + 1;
+        
+        oFace.p0 = rightblock.p3;
+        oFace.p1 = rightblock.p7;
+        oFace.p2 = rightblock.p4;
+        oFace.p3 = rightblock.p0;
 
-                    SetAllFlags(oFace, Face);
+        SetAllFlags(oFace, Face, ff);
 
-                    // calculate the interface of two face
-                    if (flagJump) {
-                        // nothing to do
+        // calculate the interface of two face
+        if (ff.flagJump) {
+            // nothing to do
+        }
+        else {
+            if (ff.flagQuad) {
+                areaV = VectorFace(ff.tmpFace);
+            }
+            else {
+                FaceP.p0 = Point3D(Face.p3.y, Face.p3.z, 0);
+                FaceP.p1 = Point3D(Face.p0.y, Face.p0.z, 0);
+                FaceP.p2 = Point3D(Face.p1.y, Face.p1.z, 0);
+                FaceP.p3 = Point3D(Face.p2.y, Face.p2.z, 0);
+                oFaceP.p0 = Point3D(oFace.p3.y, oFace.p3.z, 0);
+                oFaceP.p1 = Point3D(oFace.p0.y, oFace.p0.z, 0);
+                oFaceP.p2 = Point3D(oFace.p1.y, oFace.p1.z, 0);
+                oFaceP.p3 = Point3D(oFace.p2.y, oFace.p2.z, 0);
+                areaP = CalAreaNotQuadr(FaceP, oFaceP);
+                // attention the direction of vector
+                areaV = VectorFace(Face);
+                // correct
+                if (fabs(areaV.x) < 1E-6) {
+                    OCP_WARNING("x is too small");
+                }
+                else {
+                    areaV.y = areaV.y / fabs(areaV.x) * areaP;
+                    areaV.z = areaV.z / fabs(areaV.x) * areaP;
+                    areaV.x = OCP_SIGN(areaV.x) * areaP;
+                }
+            }
+            bconn.AddHalfConn(oindex, areaV, Pc2f, 1, flagForward);
+        }                   
+
+        // then find all NNC for current block
+        if ((ff.flagp0 > 0) || (ff.flagp3 > 0))  upNNC = true;
+        else                               upNNC = false;
+        if ((ff.flagp1 < 0) || (ff.flagp2 < 0))  downNNC = true;
+        else                               downNNC = false;
+
+        iznnc = -1;
+        while (upNNC) {
+            if (-iznnc > k)  break;
+            // find object block
+            const Hexahedron& rightblock = cornerPoints[Index(i + 1, j, k + iznnc)];
+            oindex = (k + iznnc) * nxny + j * nx + i + 1;
+            oFace.p0 = rightblock.p3;
+            oFace.p1 = rightblock.p7;
+            oFace.p2 = rightblock.p4;
+            oFace.p3 = rightblock.p0;
+
+            SetAllFlags(oFace, Face, ff);
+
+            // calculate the interface of two face
+            if (ff.flagJump) {
+                // nothing to do
+            }
+            else {
+                if (ff.flagQuad) {
+                    areaV = VectorFace(ff.tmpFace);
+                }
+                else {
+                    FaceP.p0 = Point3D(Face.p3.y, Face.p3.z, 0);
+                    FaceP.p1 = Point3D(Face.p0.y, Face.p0.z, 0);
+                    FaceP.p2 = Point3D(Face.p1.y, Face.p1.z, 0);
+                    FaceP.p3 = Point3D(Face.p2.y, Face.p2.z, 0);
+                    oFaceP.p0 = Point3D(oFace.p3.y, oFace.p3.z, 0);
+                    oFaceP.p1 = Point3D(oFace.p0.y, oFace.p0.z, 0);
+                    oFaceP.p2 = Point3D(oFace.p1.y, oFace.p1.z, 0);
+                    oFaceP.p3 = Point3D(oFace.p2.y, oFace.p2.z, 0);
+                    areaP = CalAreaNotQuadr(FaceP, oFaceP);
+                    // attention the direction of vector
+                    areaV = VectorFace(Face);
+                    // correct
+                    if (fabs(areaV.x) < 1E-6) {
+                        OCP_WARNING("x is too small");
                     }
                     else {
-                        if (flagQuad) {
-                            areaV = VectorFace(tmpFace);
-                        }
-                        else {
-                            FaceP.p0 = Point3D(Face.p0.x, Face.p0.z, 0);
-                            FaceP.p1 = Point3D(Face.p3.x, Face.p3.z, 0);
-                            FaceP.p2 = Point3D(Face.p2.x, Face.p2.z, 0);
-                            FaceP.p3 = Point3D(Face.p1.x, Face.p1.z, 0);
-                            oFaceP.p0 = Point3D(oFace.p0.x, oFace.p0.z, 0);
-                            oFaceP.p1 = Point3D(oFace.p3.x, oFace.p3.z, 0);
-                            oFaceP.p2 = Point3D(oFace.p2.x, oFace.p2.z, 0);
-                            oFaceP.p3 = Point3D(oFace.p1.x, oFace.p1.z, 0);
-                            areaP = CalAreaNotQuadr(FaceP, oFaceP);
-                            // attention the direction of vector
-                            areaV = VectorFace(Face);
-                            // correct
-                            if (fabs(areaV.y) < 1E-6) {
-                                OCP_WARNING("y is too small");
-                            }
-                            else {
-                                areaV.x = areaV.x / fabs(areaV.y) * areaP;
-                                areaV.z = areaV.z / fabs(areaV.y) * areaP;
-                                areaV.y = OCP_SIGN(areaV.y) * areaP;
-                            }
-                        }
-                        blockconn[cindex].AddHalfConn(oindex, areaV, Pc2f, 2, flagForward);
-                        num_conn++;
-                    }                   
-
-                    // then find all NNC for current block
-                    if ((flagp0 > 0) || (flagp3 > 0))  upNNC = true;
-                    else                               upNNC = false;
-                    if ((flagp1 < 0) || (flagp2 < 0))  downNNC = true;
-                    else                               downNNC = false;
-
-                    iznnc = -1;
-                    while (upNNC) {
-                        if (-iznnc > k)  break;
-                        // find object block
-                        const Hexahedron& backblock = cornerPoints[i][j - 1][k + iznnc];
-                        oindex = (k + iznnc) * nxny + (j - 1) * nx + i;
-                        oFace.p0 = backblock.p2;
-                        oFace.p1 = backblock.p6;
-                        oFace.p2 = backblock.p7;
-                        oFace.p3 = backblock.p3;
-
-                        SetAllFlags(oFace, Face);
-
-                        // calculate the interface of two face
-                        if (flagJump) {
-                            // nothing to do
-                        }
-                        else {
-                            if (flagQuad) {
-                                areaV = VectorFace(tmpFace);
-                            }
-                            else {
-                                FaceP.p0 = Point3D(Face.p0.x, Face.p0.z, 0);
-                                FaceP.p1 = Point3D(Face.p3.x, Face.p3.z, 0);
-                                FaceP.p2 = Point3D(Face.p2.x, Face.p2.z, 0);
-                                FaceP.p3 = Point3D(Face.p1.x, Face.p1.z, 0);
-                                oFaceP.p0 = Point3D(oFace.p0.x, oFace.p0.z, 0);
-                                oFaceP.p1 = Point3D(oFace.p3.x, oFace.p3.z, 0);
-                                oFaceP.p2 = Point3D(oFace.p2.x, oFace.p2.z, 0);
-                                oFaceP.p3 = Point3D(oFace.p1.x, oFace.p1.z, 0);
-                                areaP = CalAreaNotQuadr(FaceP, oFaceP);
-                                // attention the direction of vector
-                                areaV = VectorFace(Face);
-                                // correct
-                                if (fabs(areaV.y) < 1E-6) {
-                                    OCP_WARNING("y is too small");
-                                }
-                                else {
-                                    areaV.x = areaV.x / fabs(areaV.y) * areaP;
-                                    areaV.z = areaV.z / fabs(areaV.y) * areaP;
-                                    areaV.y = OCP_SIGN(areaV.y) * areaP;
-                                }
-                            }
-                            blockconn[cindex].AddHalfConn(oindex, areaV, Pc2f, 2, flagForward);
-                            num_conn++;
-                        }                       
-                        iznnc--;
-
-                        if ((flagp0 > 0) || (flagp3 > 0))  upNNC = true;
-                        else                               upNNC = false;
+                        areaV.y = areaV.y / fabs(areaV.x) * areaP;
+                        areaV.z = areaV.z / fabs(areaV.x) * areaP;
+                        areaV.x = OCP_SIGN(areaV.x) * areaP;
                     }
+                }
+                bconn.AddHalfConn(oindex, areaV, Pc2f, 1, flagForward);
+            }                       
+            iznnc--;
 
-                    iznnc = 1;
-                    while (downNNC) {
-                        if (k + iznnc > nz - 1)  break;
-                        // find object block
-                        const Hexahedron& backblock = cornerPoints[i][j - 1][k + iznnc];
-                        oindex = (k + iznnc) * nxny + (j - 1) * nx + i;
-                        oFace.p0 = backblock.p2;
-                        oFace.p1 = backblock.p6;
-                        oFace.p2 = backblock.p7;
-                        oFace.p3 = backblock.p3;
-
-                        SetAllFlags(oFace, Face);
-
-                        // calculate the interface of two face
-                        if (flagJump) {
-                            // nothing to do
-                        }
-                        else {
-                            if (flagQuad) {
-                                areaV = VectorFace(tmpFace);
-                            }
-                            else {
-                                FaceP.p0 = Point3D(Face.p0.x, Face.p0.z, 0);
-                                FaceP.p1 = Point3D(Face.p3.x, Face.p3.z, 0);
-                                FaceP.p2 = Point3D(Face.p2.x, Face.p2.z, 0);
-                                FaceP.p3 = Point3D(Face.p1.x, Face.p1.z, 0);
-                                oFaceP.p0 = Point3D(oFace.p0.x, oFace.p0.z, 0);
-                                oFaceP.p1 = Point3D(oFace.p3.x, oFace.p3.z, 0);
-                                oFaceP.p2 = Point3D(oFace.p2.x, oFace.p2.z, 0);
-                                oFaceP.p3 = Point3D(oFace.p1.x, oFace.p1.z, 0);
-                                areaP = CalAreaNotQuadr(FaceP, oFaceP);
-                                // attention the direction of vector
-                                areaV = VectorFace(Face);
-                                // correct
-                                if (fabs(areaV.y) < 1E-6) {
-                                    OCP_WARNING("y is too small");
-                                }
-                                else {
-                                    areaV.x = areaV.x / fabs(areaV.y) * areaP;
-                                    areaV.z = areaV.z / fabs(areaV.y) * areaP;
-                                    areaV.y = OCP_SIGN(areaV.y) * areaP;
-                                }
-                            }
-                            blockconn[cindex].AddHalfConn(oindex, areaV, Pc2f, 2, flagForward);
-                            num_conn++;
-                        }                       
-                        iznnc++;
-
-                        if ((flagp1 < 0) || (flagp2 < 0))  downNNC = true;
-                        else                               downNNC = false;
-                    }
-                }               
-
-                //
-                // (y+) direction
-                //
-                Face.p0 = block.p3;
-                Face.p1 = block.p7;
-                Face.p2 = block.p6;
-                Face.p3 = block.p2;
-                Pface = CenterFace(Face);
-                Pc2f = Pface - Pcenter;
-                dypoint = Pc2f - dypoint;
-
-                if (j == ny - 1) {
-                    // nothing to do
+            if ((ff.flagp0 > 0) || (ff.flagp3 > 0))  upNNC = true;
+            else                               upNNC = false;
+        }
+
+        iznnc = 1;
+        while (downNNC) {
+            if (k + iznnc > nz - 1)  break;
+            // find object block
+            const Hexahedron& rightblock = cornerPoints[Index(i + 1, j, k + iznnc)];
+            oindex = (k + iznnc) * nxny + j * nx + i + 1;
+            oFace.p0 = rightblock.p3;
+            oFace.p1 = rightblock.p7;
+            oFace.p2 = rightblock.p4;
+            oFace.p3 = rightblock.p0;
+
+            SetAllFlags(oFace, Face, ff);
+
+            // calculate the interface of two face
+            if (ff.flagJump) {
+                // nothing to do
+            }
+            else {
+                if (ff.flagQuad) {
+                    areaV = VectorFace(ff.tmpFace);
                 }
                 else {
+                    FaceP.p0 = Point3D(Face.p3.y, Face.p3.z, 0);
+                    FaceP.p1 = Point3D(Face.p0.y, Face.p0.z, 0);
+                    FaceP.p2 = Point3D(Face.p1.y, Face.p1.z, 0);
+                    FaceP.p3 = Point3D(Face.p2.y, Face.p2.z, 0);
+                    oFaceP.p0 = Point3D(oFace.p3.y, oFace.p3.z, 0);
+                    oFaceP.p1 = Point3D(oFace.p0.y, oFace.p0.z, 0);
+                    oFaceP.p2 = Point3D(oFace.p1.y, oFace.p1.z, 0);
+                    oFaceP.p3 = Point3D(oFace.p2.y, oFace.p2.z, 0);
+                    areaP = CalAreaNotQuadr(FaceP, oFaceP);
+                    // attention the direction of vector
+                    areaV = VectorFace(Face);
+                    // correct
+                    if (fabs(areaV.x) < 1E-6) {
+                        OCP_WARNING("x is too small");
+                    }
+                    else {
+                        areaV.y = areaV.y / fabs(areaV.x) * areaP;
+                        areaV.z = areaV.z / fabs(areaV.x) * areaP;
+                        areaV.x = OCP_SIGN(areaV.x) * areaP;
+                    }
+                }
+                bconn.AddHalfConn(oindex, areaV, Pc2f, 1, flagForward);
+            }                       
+            iznnc++;
 
-                    const Hexahedron& frontblock = cornerPoints[i][j + 1][k];
-                    oindex = k * nxny + (j + 1) * nx + i;
-                    
-                    oFace.p0 = frontblock.p0;
-                    oFace.p1 = frontblock.p4;
-                    oFace.p2 = frontblock.p5;
-                    oFace.p3 = frontblock.p1;
+            if ((ff.flagp1 < 0) || (ff.flagp2 < 0))  downNNC = true;
+            else                               downNNC = false;
+        }
+    }
 
-                    SetAllFlags(oFace, Face);
+    //
+    // (y-) direction
+    //
+    Face.p0 = block.p1;
+    Face.p1 = block.p5;
+    Face.p2 = block.p4;
+    Face.p3 = block.p0;
+    Pface = CenterFace(Face);
+    Pc2f = Pface - Pcenter;
+    dypoint = Pc2f;
+
+    if (j == 0) {
+        // nothing to do
+    }
+    else {
+
+        const Hexahedron& backblock = cornerPoints[Index(i, j - 1, k)];
+        oindex = k * nxny + (j - 1) * nx + i;
+        
+        oFace.p0 = backblock.p2;
+        oFace.p1 = backblock.p6;
+        oFace.p2 = backblock.p7;
+        oFace.p3 = backblock.p3;
+
+        SetAllFlags(oFace, Face, ff);
 
-                    // calculate the interface of two face
-                    if (flagJump) {
-                        // nothing to do
+        // calculate the interface of two face
+        if (ff.flagJump) {
+            // nothing to do
+        }
+        else {
+            if (ff.flagQuad) {
+                areaV = VectorFace(ff.tmpFace);
+            }
+            else {
+                FaceP.p0 = Point3D(Face.p0.x, Face.p0.z, 0);
+                FaceP.p1 = Point3D(Face.p3.x, Face.p3.z, 0);
+                FaceP.p2 = Point3D(Face.p2.x, Face.p2.z, 0);
+                FaceP.p3 = Point3D(Face.p1.x, Face.p1.z, 0);
+                oFaceP.p0 = Point3D(oFace.p0.x, oFace.p0.z, 0);
+                oFaceP.p1 = Point3D(oFace.p3.x, oFace.p3.z, 0);
+                oFaceP.p2 = Point3D(oFace.p2.x, oFace.p2.z, 0);
+                oFaceP.p3 = Point3D(oFace.p1.x, oFace.p1.z, 0);
+                areaP = CalAreaNotQuadr(FaceP, oFaceP);
+                // attention the direction of vector
+                areaV = VectorFace(Face);
+                // correct
+                if (fabs(areaV.y) < 1E-6) {
+                    OCP_WARNING("y is too small");
+                }
+                else {
+                    areaV.x = areaV.x / fabs(areaV.y) * areaP;
+                    areaV.z = areaV.z / fabs(areaV.y) * areaP;
+                    areaV.y = OCP_SIGN(areaV.y) * areaP;
+                }
+            }
+            bconn.AddHalfConn(oindex, areaV, Pc2f, 2, flagForward);
+        }                   
+
+        // then find all NNC for current block
+        if ((ff.flagp0 > 0) || (ff.flagp3 > 0))  upNNC = true;
+        else                               upNNC = false;
+        if ((ff.flagp1 < 0) || (ff.flagp2 < 0))  downNNC = true;
+        else                               downNNC = false;
+
+        iznnc = -1;
+        while (upNNC) {
+            if (-iznnc > k)  break;
+            // find object block
+            const Hexahedron& backblock = cornerPoints[Index(i, j - 1, k + iznnc)];
+            oindex = (k + iznnc) * nxny + (j - 1) * nx + i;
+            oFace.p0 = backblock.p2;
+            oFace.p1 = backblock.p6;
+            oFace.p2 = backblock.p7;
+            oFace.p3 = backblock.p3;
+
+            SetAllFlags(oFace, Face, ff);
+
+            // calculate the interface of two face
+            if (ff.flagJump) {
+                // nothing to do
+            }
+            else {
+                if (ff.flagQuad) {
+                    areaV = VectorFace(ff.tmpFace);
+                }
+                else {
+                    FaceP.p0 = Point3D(Face.p0.x, Face.p0.z, 0);
+                    FaceP.p1 = Point3D(Face.p3.x, Face.p3.z, 0);
+                    FaceP.p2 = Point3D(Face.p2.x, Face.p2.z, 0);
+                    FaceP.p3 = Point3D(Face.p1.x, Face.p1.z, 0);
+                    oFaceP.p0 = Point3D(oFace.p0.x, oFace.p0.z, 0);
+                    oFaceP.p1 = Point3D(oFace.p3.x, oFace.p3.z, 0);
+                    oFaceP.p2 = Point3D(oFace.p2.x, oFace.p2.z, 0);
+                    oFaceP.p3 = Point3D(oFace.p1.x, oFace.p1.z, 0);
+                    areaP = CalAreaNotQuadr(FaceP, oFaceP);
+                    // attention the direction of vector
+                    areaV = VectorFace(Face);
+                    // correct
+                    if (fabs(areaV.y) < 1E-6) {
+                        OCP_WARNING("y is too small");
                     }
                     else {
-                        if (flagQuad) {
-                            areaV = VectorFace(tmpFace);
-                        }
-                        else {
-                            FaceP.p0 = Point3D(Face.p0.x, Face.p0.z, 0);
-                            FaceP.p1 = Point3D(Face.p3.x, Face.p3.z, 0);
-                            FaceP.p2 = Point3D(Face.p2.x, Face.p2.z, 0);
-                            FaceP.p3 = Point3D(Face.p1.x, Face.p1.z, 0);
-                            oFaceP.p0 = Point3D(oFace.p0.x, oFace.p0.z, 0);
-                            oFaceP.p1 = Point3D(oFace.p3.x, oFace.p3.z, 0);
-                            oFaceP.p2 = Point3D(oFace.p2.x, oFace.p2.z, 0);
-                            oFaceP.p3 = Point3D(oFace.p1.x, oFace.p1.z, 0);
-                            areaP = CalAreaNotQuadr(FaceP, oFaceP);
-                            // attention the direction of vector
-                            areaV = VectorFace(Face);
-                            // correct
-                            if (fabs(areaV.y) < 1E-6) {
-                                OCP_WARNING("y is too small");
-                            }
-                            else {
-                                areaV.x = areaV.x / fabs(areaV.y) * areaP;
-                                areaV.z = areaV.z / fabs(areaV.y) * areaP;
-                                areaV.y = OCP_SIGN(areaV.y) * areaP;
-                            }
-                        }
-                        blockconn[cindex].AddHalfConn(oindex, areaV, Pc2f, 2, flagForward);
-                        num_conn++;
-                    }
-                    
-                    // then find all NNC for current block
-                    if ((flagp0 > 0) || (flagp3 > 0))  upNNC = true;
-                    else                               upNNC = false;
-                    if ((flagp1 < 0) || (flagp2 < 0))  downNNC = true;
-                    else                               downNNC = false;
-
-                    iznnc = -1;
-                    while (upNNC) {
-                        if (-iznnc > k)  break;
-                        // find object block
-                        const Hexahedron& frontblock = cornerPoints[i][j + 1][k + iznnc];
-                        oindex = (k + iznnc) * nxny + (j + 1) * nx + i;
-                        oFace.p0 = frontblock.p0;
-                        oFace.p1 = frontblock.p4;
-                        oFace.p2 = frontblock.p5;
-                        oFace.p3 = frontblock.p1;
-
-                        SetAllFlags(oFace, Face);
-
-                        // calculate the interface of two face
-                        if (flagJump) {
-                            // nothing to do
-                        }
-                        else {
-                            if (flagQuad) {
-                                areaV = VectorFace(tmpFace);
-                            }
-                            else {
-                                FaceP.p0 = Point3D(Face.p0.x, Face.p0.z, 0);
-                                FaceP.p1 = Point3D(Face.p3.x, Face.p3.z, 0);
-                                FaceP.p2 = Point3D(Face.p2.x, Face.p2.z, 0);
-                                FaceP.p3 = Point3D(Face.p1.x, Face.p1.z, 0);
-                                oFaceP.p0 = Point3D(oFace.p0.x, oFace.p0.z, 0);
-                                oFaceP.p1 = Point3D(oFace.p3.x, oFace.p3.z, 0);
-                                oFaceP.p2 = Point3D(oFace.p2.x, oFace.p2.z, 0);
-                                oFaceP.p3 = Point3D(oFace.p1.x, oFace.p1.z, 0);
-                                areaP = CalAreaNotQuadr(FaceP, oFaceP);
-                                // attention the direction of vector
-                                areaV = VectorFace(Face);
-                                // correct
-                                if (fabs(areaV.y) < 1E-6) {
-                                    OCP_WARNING("y is too small");
-                                }
-                                else {
-                                    areaV.x = areaV.x / fabs(areaV.y) * areaP;
-                                    areaV.z = areaV.z / fabs(areaV.y) * areaP;
-                                    areaV.y = OCP_SIGN(areaV.y) * areaP;
-                                }
-                            }
-                            blockconn[cindex].AddHalfConn(oindex, areaV, Pc2f, 2, flagForward);
-                            num_conn++;
-                        }                       
-                        iznnc--;
-
-                        if ((flagp0 > 0) || (flagp3 > 0))  upNNC = true;
-                        else                               upNNC = false;
+                        areaV.x = areaV.x / fabs(areaV.y) * areaP;
+                        areaV.z = areaV.z / fabs(areaV.y) * areaP;
+                        areaV.y = OCP_SIGN(areaV.y) * areaP;
                     }
+                }
+                bconn.AddHalfConn(oindex, areaV, Pc2f, 2, flagForward);
+            }                       
+            iznnc--;
+
+            if ((ff.flagp0 > 0) || (ff.flagp3 > 0))  upNNC = true;
+            else                               upNNC = false;
+        }
 
-                    iznnc = 1;
-                    while (downNNC) {
-                        if (k + iznnc > nz - 1)  break;
-                        // find object block
-                        const Hexahedron& frontblock = cornerPoints[i][j + 1][k + iznnc];
-                        oindex = (k + iznnc) * nxny + (j + 1) * nx + i;
-                        oFace.p0 = frontblock.p0;
-                        oFace.p1 = frontblock.p4;
-                        oFace.p2 = frontblock.p5;
-                        oFace.p3 = frontblock.p1;
-
-                        SetAllFlags(oFace, Face);
-
-                        // calculate the interface of two face
-                        if (flagJump) {
-                            // nothing to do
-                        }
-                        else {
-                            if (flagQuad) {
-                                areaV = VectorFace(tmpFace);
-                            }
-                            else {
-                                FaceP.p0 = Point3D(Face.p0.x, Face.p0.z, 0);
-                                FaceP.p1 = Point3D(Face.p3.x, Face.p3.z, 0);
-                                FaceP.p2 = Point3D(Face.p2.x, Face.p2.z, 0);
-                                FaceP.p3 = Point3D(Face.p1.x, Face.p1.z, 0);
-                                oFaceP.p0 = Point3D(oFace.p0.x, oFace.p0.z, 0);
-                                oFaceP.p1 = Point3D(oFace.p3.x, oFace.p3.z, 0);
-                                oFaceP.p2 = Point3D(oFace.p2.x, oFace.p2.z, 0);
-                                oFaceP.p3 = Point3D(oFace.p1.x, oFace.p1.z, 0);
-                                areaP = CalAreaNotQuadr(FaceP, oFaceP);
-                                // attention the direction of vector
-                                areaV = VectorFace(Face);
-                                // correct
-                                if (fabs(areaV.y) < 1E-6) {
-                                    OCP_WARNING("y is too small");
-                                }
-                                else {
-                                    areaV.x = areaV.x / fabs(areaV.y) * areaP;
-                                    areaV.z = areaV.z / fabs(areaV.y) * areaP;
-                                    areaV.y = OCP_SIGN(areaV.y) * areaP;
-                                }
-                            }
-                            blockconn[cindex].AddHalfConn(oindex, areaV, Pc2f, 2, flagForward);
-                            num_conn++;
-                        }                       
-                        iznnc++;
-
-                        if ((flagp1 < 0) || (flagp2 < 0))  downNNC = true;
-                        else                               downNNC = false;
+        iznnc = 1;
+        while (downNNC) {
+            if (k + iznnc > nz - 1)  break;
+            // find object block
+            const Hexahedron& backblock = cornerPoints[Index(i, j - 1, k + iznnc)];
+            oindex = (k + iznnc) * nxny + (j - 1) * nx + i;
+            oFace.p0 = backblock.p2;
+            oFace.p1 = backblock.p6;
+            oFace.p2 = backblock.p7;
+            oFace.p3 = backblock.p3;
+
+            SetAllFlags(oFace, Face, ff);
+
+            // calculate the interface of two face
+            if (ff.flagJump) {
+                // nothing to do
+            }
+            else {
+                if (ff.flagQuad) {
+                    areaV = VectorFace(ff.tmpFace);
+                }
+                else {
+                    FaceP.p0 = Point3D(Face.p0.x, Face.p0.z, 0);
+                    FaceP.p1 = Point3D(Face.p3.x, Face.p3.z, 0);
+                    FaceP.p2 = Point3D(Face.p2.x, Face.p2.z, 0);
+                    FaceP.p3 = Point3D(Face.p1.x, Face.p1.z, 0);
+                    oFaceP.p0 = Point3D(oFace.p0.x, oFace.p0.z, 0);
+                    oFaceP.p1 = Point3D(oFace.p3.x, oFace.p3.z, 0);
+                    oFaceP.p2 = Point3D(oFace.p2.x, oFace.p2.z, 0);
+                    oFaceP.p3 = Point3D(oFace.p1.x, oFace.p1.z, 0);
+                    areaP = CalAreaNotQuadr(FaceP, oFaceP);
+                    // attention the direction of vector
+                    areaV = VectorFace(Face);
+                    // correct
+                    if (fabs(areaV.y) < 1E-6) {
+                        OCP_WARNING("y is too small");
+                    }
+                    else {
+                        areaV.x = areaV.x / fabs(areaV.y) * areaP;
+                        areaV.z = areaV.z / fabs(areaV.y) * areaP;
+                        areaV.y = OCP_SIGN(areaV.y) * areaP;
                     }
                 }
+                bconn.AddHalfConn(oindex, areaV, Pc2f, 2, flagForward);
+            }                       
+            iznnc++;
+
+            if ((ff.flagp1 < 0) || (ff.flagp2 < 0))  downNNC = true;
+            else                               downNNC = false;
+        }
+    }               
+
+    //
+    // (y+) direction
+    //
+    Face.p0 = block.p3;
+    Face.p1 = block.p7;
+    Face.p2 = block.p6;
+    Face.p3 = block.p2;
+    Pface = CenterFace(Face);
+    Pc2f = Pface - Pcenter;
+    dypoint = Pc2f - dypoint;
+
+    if (j == ny - 1) {
+        // nothing to do
+    }
+    else {
 
-                //
-                // (z-) direction
-                //
-                Face.p0 = block.p0;
-                Face.p1 = block.p3;
-                Face.p2 = block.p2;
-                Face.p3 = block.p1;
-                Pface = CenterFace(Face);
-                Pc2f = Pface - Pcenter;
-                dzpoint = Pc2f;
-                if (k == 0) {
-                    // nothing to do                   
+        const Hexahedron& frontblock = cornerPoints[Index(i, j + 1, k)];
+        oindex = k * nxny + (j + 1) * nx + i;
+        
+        oFace.p0 = frontblock.p0;
+        oFace.p1 = frontblock.p4;
+        oFace.p2 = frontblock.p5;
+        oFace.p3 = frontblock.p1;
+
+        SetAllFlags(oFace, Face, ff);
+
+        // calculate the interface of two face
+        if (ff.flagJump) {
+            // nothing to do
+        }
+        else {
+            if (ff.flagQuad) {
+                areaV = VectorFace(ff.tmpFace);
+            }
+            else {
+                FaceP.p0 = Point3D(Face.p0.x, Face.p0.z, 0);
+                FaceP.p1 = Point3D(Face.p3.x, Face.p3.z, 0);
+                FaceP.p2 = Point3D(Face.p2.x, Face.p2.z, 0);
+                FaceP.p3 = Point3D(Face.p1.x, Face.p1.z, 0);
+                oFaceP.p0 = Point3D(oFace.p0.x, oFace.p0.z, 0);
+                oFaceP.p1 = Point3D(oFace.p3.x, oFace.p3.z, 0);
+                oFaceP.p2 = Point3D(oFace.p2.x, oFace.p2.z, 0);
+                oFaceP.p3 = Point3D(oFace.p1.x, oFace.p1.z, 0);
+                areaP = CalAreaNotQuadr(FaceP, oFaceP);
+                // attention the direction of vector
+                areaV = VectorFace(Face);
+                // correct
+                if (fabs(areaV.y) < 1E-6) {
+                    OCP_WARNING("y is too small");
                 }
                 else {
-                    // upblock
-                    oindex = (k - 1) * nxny + j * nx + i;
-                    
-                    tmpFace = Face;
-                    areaV = VectorFace(tmpFace);
-                    blockconn[cindex].AddHalfConn(oindex, areaV, Pc2f, 3, flagForward);
-                    num_conn++;
+                    areaV.x = areaV.x / fabs(areaV.y) * areaP;
+                    areaV.z = areaV.z / fabs(areaV.y) * areaP;
+                    areaV.y = OCP_SIGN(areaV.y) * areaP;
                 }
-
-                //
-                // (z+) direction
-                //
-                Face.p0 = block.p5;
-                Face.p1 = block.p6;
-                Face.p2 = block.p7;
-                Face.p3 = block.p4;
-                Pface = CenterFace(Face);
-                Pc2f = Pface - Pcenter;
-                dzpoint = Pc2f - dzpoint;
-
-                if (k == nz - 1) {
-                    // nothing to do                   
+            }
+            bconn.AddHalfConn(oindex, areaV, Pc2f, 2, flagForward);
+        }
+        
+        // then find all NNC for current block
+        if ((ff.flagp0 > 0) || (ff.flagp3 > 0))  upNNC = true;
+        else                               upNNC = false;
+        if ((ff.flagp1 < 0) || (ff.flagp2 < 0))  downNNC = true;
+        else                               downNNC = false;
+
+        iznnc = -1;
+        while (upNNC) {
+            if (-iznnc > k)  break;
+            // find object block
+            const Hexahedron& frontblock = cornerPoints[Index(i, j + 1, k + iznnc)];
+            oindex = (k + iznnc) * nxny + (j + 1) * nx + i;
+            oFace.p0 = frontblock.p0;
+            oFace.p1 = frontblock.p4;
+            oFace.p2 = frontblock.p5;
+            oFace.p3 = frontblock.p1;
+
+            SetAllFlags(oFace, Face, ff);
+
+            // calculate the interface of two face
+            if (ff.flagJump) {
+                // nothing to do
+            }
+            else {
+                if (ff.flagQuad) {
+                    areaV = VectorFace(ff.tmpFace);
                 }
                 else {
-                    // downblock
-                    oindex = (k + 1) * nxny + j * nx + i;
-                    
-                    tmpFace = Face;
-                    areaV = VectorFace(tmpFace);                    
-                    blockconn[cindex].AddHalfConn(oindex, areaV, Pc2f, 3, flagForward);
-                    num_conn++;
+                    FaceP.p0 = Point3D(Face.p0.x, Face.p0.z, 0);
+                    FaceP.p1 = Point3D(Face.p3.x, Face.p3.z, 0);
+                    FaceP.p2 = Point3D(Face.p2.x, Face.p2.z, 0);
+                    FaceP.p3 = Point3D(Face.p1.x, Face.p1.z, 0);
+                    oFaceP.p0 = Point3D(oFace.p0.x, oFace.p0.z, 0);
+                    oFaceP.p1 = Point3D(oFace.p3.x, oFace.p3.z, 0);
+                    oFaceP.p2 = Point3D(oFace.p2.x, oFace.p2.z, 0);
+                    oFaceP.p3 = Point3D(oFace.p1.x, oFace.p1.z, 0);
+                    areaP = CalAreaNotQuadr(FaceP, oFaceP);
+                    // attention the direction of vector
+                    areaV = VectorFace(Face);
+                    // correct
+                    if (fabs(areaV.y) < 1E-6) {
+                        OCP_WARNING("y is too small");
+                    }
+                    else {
+                        areaV.x = areaV.x / fabs(areaV.y) * areaP;
+                        areaV.z = areaV.z / fabs(areaV.y) * areaP;
+                        areaV.y = OCP_SIGN(areaV.y) * areaP;
+                    }
                 }
+                bconn.AddHalfConn(oindex, areaV, Pc2f, 2, flagForward);
+            }                       
+            iznnc--;
 
-                // calculate dx,dy,dz
-                dx[cindex] = sqrt(dxpoint.x * dxpoint.x + dxpoint.y * dxpoint.y +
-                    dxpoint.z * dxpoint.z);
-                dy[cindex] = sqrt(dypoint.x * dypoint.x + dypoint.y * dypoint.y +
-                    dypoint.z * dypoint.z);
-                dz[cindex] = sqrt(dzpoint.x * dzpoint.x + dzpoint.y * dzpoint.y +
-                    dzpoint.z * dzpoint.z);
-
-                OCP_ASSERT(!isfinite(dx[cindex]), "Wrong dx!");
-                OCP_ASSERT(!isfinite(dy[cindex]), "Wrong dy!");
-                OCP_ASSERT(!isfinite(dz[cindex]), "Wrong dz!");
+            if ((ff.flagp0 > 0) || (ff.flagp3 > 0))  upNNC = true;
+            else                               upNNC = false;
+        }
+
+        iznnc = 1;
+        while (downNNC) {
+            if (k + iznnc > nz - 1)  break;
+            // find object block
+            const Hexahedron& frontblock = cornerPoints[Index(i, j + 1, k + iznnc)];
+            oindex = (k + iznnc) * nxny + (j + 1) * nx + i;
+            oFace.p0 = frontblock.p0;
+            oFace.p1 = frontblock.p4;
+            oFace.p2 = frontblock.p5;
+            oFace.p3 = frontblock.p1;
+
+            SetAllFlags(oFace, Face, ff);
+
+            // calculate the interface of two face
+            if (ff.flagJump) {
+                // nothing to do
             }
+            else {
+                if (ff.flagQuad) {
+                    areaV = VectorFace(ff.tmpFace);
+                }
+                else {
+                    FaceP.p0 = Point3D(Face.p0.x, Face.p0.z, 0);
+                    FaceP.p1 = Point3D(Face.p3.x, Face.p3.z, 0);
+                    FaceP.p2 = Point3D(Face.p2.x, Face.p2.z, 0);
+                    FaceP.p3 = Point3D(Face.p1.x, Face.p1.z, 0);
+                    oFaceP.p0 = Point3D(oFace.p0.x, oFace.p0.z, 0);
+                    oFaceP.p1 = Point3D(oFace.p3.x, oFace.p3.z, 0);
+                    oFaceP.p2 = Point3D(oFace.p2.x, oFace.p2.z, 0);
+                    oFaceP.p3 = Point3D(oFace.p1.x, oFace.p1.z, 0);
+                    areaP = CalAreaNotQuadr(FaceP, oFaceP);
+                    // attention the direction of vector
+                    areaV = VectorFace(Face);
+                    // correct
+                    if (fabs(areaV.y) < 1E-6) {
+                        OCP_WARNING("y is too small");
+                    }
+                    else {
+                        areaV.x = areaV.x / fabs(areaV.y) * areaP;
+                        areaV.z = areaV.z / fabs(areaV.y) * areaP;
+                        areaV.y = OCP_SIGN(areaV.y) * areaP;
+                    }
+                }
+                bconn.AddHalfConn(oindex, areaV, Pc2f, 2, flagForward);
+            }                       
+            iznnc++;
+
+            if ((ff.flagp1 < 0) || (ff.flagp2 < 0))  downNNC = true;
+            else                               downNNC = false;
         }
     }
 
-
-    OCP_ASSERT(num_conn % 2 == 0, "Wrong Conn!");
-    numConnMax = num_conn / 2;
-    connect.resize(numConnMax);
     //
-    //    calculate the x,y,z direction transmissibilities of each block and save them
+    // (z-) direction
     //
-    // make the connections
-    OCP_USI iter_conn = 0;
-    for (OCP_USI n = 0; n < numGrid; n++) {
-        for (USI j = 0; j < blockconn[n].nConn; j++) {
-            OCP_USI nn = blockconn[n].halfConn[j].neigh;
-            if (nn < n) continue;
-            USI jj;
-            for (jj = 0; jj < blockconn[nn].nConn; jj++) {
-                if (blockconn[nn].halfConn[jj].neigh == n) {
-                    break;
-                }
-            }
-            if (jj == blockconn[nn].nConn) {
-                continue;
-            }
-            if (blockconn[n].halfConn[j].Ad_dd <= 0 ||
-                blockconn[nn].halfConn[jj].Ad_dd <= 0) {
-                // false connection
-                continue;
-            }
+    Face.p0 = block.p0;
+    Face.p1 = block.p3;
+    Face.p2 = block.p2;
+    Face.p3 = block.p1;
+    Pface = CenterFace(Face);
+    Pc2f = Pface - Pcenter;
+    dzpoint = Pc2f;
+    if (k == 0) {
+        // nothing to do                   
+    }
+    else {
+        // upblock
+        oindex = (k - 1) * nxny + j * nx + i;
+        
+        ff.tmpFace = Face;
+        areaV = VectorFace(ff.tmpFace);
+        bconn.AddHalfConn(oindex, areaV, Pc2f, 3, flagForward);
+    }
 
-            //
-            // now, blockconn[n].halfConn[j]
-            //     blockconn[nn].halfConn[jj]
-            //     are a pair of connections
-            connect[iter_conn].begin = n;
-            connect[iter_conn].Ad_dd_begin = blockconn[n].halfConn[j].Ad_dd;
-            connect[iter_conn].end = nn;
-            connect[iter_conn].Ad_dd_end = blockconn[nn].halfConn[jj].Ad_dd;
-            connect[iter_conn].directionType = blockconn[n].halfConn[j].directionType;
-            iter_conn++;
-        }
+    //
+    // (z+) direction
+    //
+    Face.p0 = block.p5;
+    Face.p1 = block.p6;
+    Face.p2 = block.p7;
+    Face.p3 = block.p4;
+    Pface = CenterFace(Face);
+    Pc2f = Pface - Pcenter;
+    dzpoint = Pc2f - dzpoint;
+
+    if (k == nz - 1) {
+        // nothing to do                   
     }
-    numConn = iter_conn;
+    else {
+        // downblock
+        oindex = (k + 1) * nxny + j * nx + i;
+        
+        ff.tmpFace = Face;
+        areaV = VectorFace(ff.tmpFace);                    
+        bconn.AddHalfConn(oindex, areaV, Pc2f, 3, flagForward);
+    }
+
+    // calculate dx,dy,dz
+    dx[cindex] = sqrt(dxpoint.x * dxpoint.x + dxpoint.y * dxpoint.y +
+        dxpoint.z * dxpoint.z);
+    dy[cindex] = sqrt(dypoint.x * dypoint.x + dypoint.y * dypoint.y +
+        dypoint.z * dypoint.z);
+    dz[cindex] = sqrt(dzpoint.x * dzpoint.x + dzpoint.y * dzpoint.y +
+        dzpoint.z * dzpoint.z);
+
+    OCP_ASSERT(!isfinite(dx[cindex]), "Wrong dx!");
+    OCP_ASSERT(!isfinite(dy[cindex]), "Wrong dy!");
+    OCP_ASSERT(!isfinite(dz[cindex]), "Wrong dz!");
 }
 
 
+
 /*----------------------------------------------------------------------------*/
 /*  Brief Change History of This File                                         */
 /*----------------------------------------------------------------------------*/
 /*  Author              Date             Actions                              */
 /*----------------------------------------------------------------------------*/
 /*  Shizhe Li           Nov/19/2021      Create file                          */
+/*  OpenCAEPoro team    Oct/16/2026      Flat arrays, parallel block geometry */
+/*  OpenCAEPoro team    Oct/16/2026      Pair half connections by buckets     */
 /*----------------------------------------------------------------------------*/
\ No newline at end of file
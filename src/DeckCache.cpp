@@ -0,0 +1,122 @@
+/*! \file    DeckCache.cpp
+ *  \brief   Binary cache of a preprocessed input deck
+ *  \author  OpenCAEPoro team
+ *  \date    Oct/16/2026
+ *
+ *-----------------------------------------------------------------------------------
+ *  Copyright (C) 2021--present by the OpenCAEPoro team. All rights reserved.
+ *  Released under the terms of the GNU Lesser General Public License 3.0 or later.
+ *-----------------------------------------------------------------------------------
+ */
+
+// Standard header files
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+// OpenCAEPoro header files
+#include "DeckCache.hpp"
+#include "UtilInput.hpp"
+#include "UtilProfiler.hpp"
+
+void DeckCache::Setup(const string& file, const bool& on)
+{
+    useCache  = on;
+    loaded    = false;
+    inputFile = file;
+    cacheFile = file + ".cache";
+}
+
+bool DeckCache::LoadParam(ParamRead& param)
+{
+    if (!useCache) return false;
+    OCP_PROFILE("ReadCache");
+
+    if (!image.TryBeginLoad(cacheFile)) return false;
+
+    vector<string>  files;
+    vector<OCP_ULL> sizes, hashes;
+    image.Sync(files);
+    image.Sync(sizes);
+    image.Sync(hashes);
+
+    // The first file is the input file itself, given by the same path
+    bool upToDate = !files.empty() && files[0] == inputFile &&
+                    sizes.size() == files.size() && hashes.size() == files.size();
+    for (USI n = 0; n < files.size() && upToDate; n++) {
+        OCP_ULL size, hash;
+        upToDate = HashFile(files[n], size, hash) && size == sizes[n] && hash == hashes[n];
+    }
+    if (!upToDate) {
+        cout << "Deck cache " << cacheFile << " is out of date" << endl;
+        return false;
+    }
+
+    param.SyncCheckpoint(image);
+    loaded = true;
+    cout << "Input files are loaded from " << cacheFile << endl;
+    return true;
+}
+
+void DeckCache::SaveParam(ParamRead& param)
+{
+    if (!useCache) return;
+
+    vector<string>  files = param.fileList;
+    vector<OCP_ULL> sizes(files.size()), hashes(files.size());
+    for (USI n = 0; n < files.size(); n++) {
+        if (!HashFile(files[n], sizes[n], hashes[n])) {
+            OCP_WARNING("Can not read " + files[n] + ", deck cache is off");
+            useCache = false;
+            return;
+        }
+    }
+
+    image.BeginSave();
+    image.Sync(files);
+    image.Sync(sizes);
+    image.Sync(hashes);
+    param.SyncCheckpoint(image);
+}
+
+void DeckCache::Finish()
+{
+    if (!useCache) return;
+
+    if (loaded) {
+        image.EndLoad();
+    } else {
+        image.WriteAsync(cacheFile);
+        cout << "Writing deck cache " << cacheFile << endl;
+    }
+}
+
+bool DeckCache::HashFile(const string& file, OCP_ULL& size, OCP_ULL& hash)
+{
+    if (!ifstream(file).is_open()) return false;
+
+    MappedFile mapped(file);
+    mapped.Map();
+    const char* p = mapped.Data();
+    size          = mapped.Size();
+
+    // FNV-1a over 8-byte words, then the tail bytes
+    const OCP_ULL prime = 1099511628211ULL;
+    hash                = 14695981039346656037ULL;
+    OCP_ULL n           = 0;
+    for (; n + 8 <= size; n += 8) {
+        OCP_ULL w;
+        memcpy(&w, p + n, 8);
+        hash = (hash ^ w) * prime;
+    }
+    for (; n < size; n++) hash = (hash ^ static_cast<unsigned char>(p[n])) * prime;
+    return true;
+}
+
+/*----------------------------------------------------------------------------*/
+/*  Brief Change History of This File                                         */
+/*----------------------------------------------------------------------------*/
+/*  Author              Date             Actions                              */
+/*----------------------------------------------------------------------------*/
+/*  OpenCAEPoro team    Oct/16/2026      Create file                          */
+/*----------------------------------------------------------------------------*/
@@ -468,6 +468,8 @@ static void decouple_rowsum(dBSRmat* A, REAL* diaginv, dBSRmat* B)
 void VectorFaspSolver::Decoupling(dBSRmat* Absr, dvector* b, dBSRmat* Asc, dvector* fsc,
                                   ivector* order, double* Dmatvec, int decoupleType)
 {
+    OCP_PROFILE("Decoupling");
+
     int              nrow = Absr->ROW;
     int              nb   = Absr->nb;
     double*          Dmat = Dmatvec;
@@ -69,6 +69,17 @@ void Dscalar(const int& n, const double& alpha, double* x)
 void Daxpy(const int& n, const double& alpha, const double* x, double* y)
 {
     // y= ax +y
+    switch (n) {
+        case 1: DaxpyFixed<1>(alpha, x, y); return;
+        case 2: DaxpyFixed<2>(alpha, x, y); return;
+        case 3: DaxpyFixed<3>(alpha, x, y); return;
+        case 4: DaxpyFixed<4>(alpha, x, y); return;
+        case 5: DaxpyFixed<5>(alpha, x, y); return;
+        case 6: DaxpyFixed<6>(alpha, x, y); return;
+        case 7: DaxpyFixed<7>(alpha, x, y); return;
+        case 8: DaxpyFixed<8>(alpha, x, y); return;
+        default: break;
+    }
     const int incx = 1, incy = 1;
     daxpy_(&n, &alpha, x, &incx, y, &incy);
 }
@@ -84,6 +95,21 @@ void DaABpbC(const int& m, const int& n, const int& k, const double& alpha,
      *  A' in col-order in Fortran = A in row-order in C/Cpp
      */
 
+    // Jacobian blocks of bulks and wells are square and small, use unrolled kernels
+    if (m == n) {
+        switch (m) {
+            case 1: DaABpbCFixed<1, 1>(k, alpha, A, B, beta, C); return;
+            case 2: DaABpbCFixed<2, 2>(k, alpha, A, B, beta, C); return;
+            case 3: DaABpbCFixed<3, 3>(k, alpha, A, B, beta, C); return;
+            case 4: DaABpbCFixed<4, 4>(k, alpha, A, B, beta, C); return;
+            case 5: DaABpbCFixed<5, 5>(k, alpha, A, B, beta, C); return;
+            case 6: DaABpbCFixed<6, 6>(k, alpha, A, B, beta, C); return;
+            case 7: DaABpbCFixed<7, 7>(k, alpha, A, B, beta, C); return;
+            case 8: DaABpbCFixed<8, 8>(k, alpha, A, B, beta, C); return;
+            default: break;
+        }
+    }
+
     const char transa = 'N', transb = 'N';
     dgemm_(&transa, &transb, &n, &m, &k, &alpha, B, &n, A, &k, &beta, C, &n);
 }
@@ -187,7 +213,17 @@ void LUSolve(const int& nrhs, const int& N, double* A, double* b, int* pivot)
 {
     int info;
 
-    dgesv_(&N, &nrhs, A, &N, pivot, b, &N, &info);
+    switch (N) {
+        case 1: info = LUSolveFixed<1>(nrhs, A, b, pivot); break;
+        case 2: info = LUSolveFixed<2>(nrhs, A, b, pivot); break;
+        case 3: info = LUSolveFixed<3>(nrhs, A, b, pivot); break;
+        case 4: info = LUSolveFixed<4>(nrhs, A, b, pivot); break;
+        case 5: info = LUSolveFixed<5>(nrhs, A, b, pivot); break;
+        case 6: info = LUSolveFixed<6>(nrhs, A, b, pivot); break;
+        case 7: info = LUSolveFixed<7>(nrhs, A, b, pivot); break;
+        case 8: info = LUSolveFixed<8>(nrhs, A, b, pivot); break;
+        default: dgesv_(&N, &nrhs, A, &N, pivot, b, &N, &info); break;
+    }
 
     if (info < 0) {
         cout << "Wrong Input !" << endl;
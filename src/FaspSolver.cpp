@@ -41,11 +41,13 @@ void FaspSolver::SetupParam(const string& dir, const string& file)
 void ScalarFaspSolver::Allocate(const vector<USI>& rowCapacity, const OCP_USI& maxDim,
                                 const USI& blockDim)
 {
-    OCP_USI nnz = 0;
-    for (OCP_USI n = 0; n < maxDim; n++) {
-        nnz += rowCapacity[n];
-    }
-    A = fasp_dcsr_create(maxDim, maxDim, nnz);
+    // Storage of A is owned by LinearSystem and attached in AssembleMat
+    A.row = 0;
+    A.col = 0;
+    A.nnz = 0;
+    A.IA  = nullptr;
+    A.JA  = nullptr;
+    A.val = nullptr;
 }
 
 void ScalarFaspSolver::InitParam()
@@ -116,8 +118,7 @@ void ScalarFaspSolver::InitParam()
     inParam.AMG_smooth_restriction = ON;
 }
 
-void ScalarFaspSolver::AssembleMat(const vector<vector<USI>>&     colId,
-                                   const vector<vector<OCP_DBL>>& val,
+void ScalarFaspSolver::AssembleMat(OCP_USI* IA, OCP_USI* JA, OCP_DBL* val,
                                    const OCP_USI& dim, const USI& blockDim,
                                    vector<OCP_DBL>& rhs, vector<OCP_DBL>& u)
 {
@@ -126,33 +127,21 @@ void ScalarFaspSolver::AssembleMat(const vector<vector<USI>>&     colId,
     b.val = rhs.data();
     x.row = dim;
     x.val = u.data();
-    // A
-    OCP_USI nnz = 0;
-    for (OCP_USI i = 0; i < dim; i++) {
-        nnz += colId[i].size();
-    }
 
+    // A: attach the compressed storage directly
     A.row = dim;
     A.col = dim;
-    A.nnz = nnz;
-
-    // IA
-    OCP_USI count = 0;
-    A.IA[0]       = 0;
-    for (OCP_USI i = 1; i < dim + 1; i++) {
-        USI nnz_Row = colId[i - 1].size();
-        A.IA[i]     = A.IA[i - 1] + nnz_Row;
-
-        for (USI j = 0; j < nnz_Row; j++) {
-            A.JA[count]  = colId[i - 1][j];
-            A.val[count] = val[i - 1][j];
-            count++;
-        }
-    }
+    A.nnz = IA[dim];
+    A.IA  = reinterpret_cast<INT*>(IA);
+    A.JA  = reinterpret_cast<INT*>(JA);
+    A.val = val;
 }
 
 OCP_INT ScalarFaspSolver::Solve()
 {
+    // AMG setup and Krylov iterations both happen inside FASP
+    OCP_PROFILE("FaspSolve");
+
     OCP_INT status = FASP_SUCCESS;
 
     const OCP_INT print_level  = inParam.print_level;
@@ -265,7 +254,15 @@ void VectorFaspSolver::Allocate(const vector<USI>& rowCapacity, const OCP_USI& m
     for (OCP_USI n = 0; n < maxDim; n++) {
         nnz += rowCapacity[n];
     }
-    A     = fasp_dbsr_create(maxDim, maxDim, nnz, blockDim, 0);
+    // Storage of A is owned by LinearSystem and attached in AssembleMat
+    A.ROW            = 0;
+    A.COL            = 0;
+    A.NNZ            = 0;
+    A.nb             = blockDim;
+    A.storage_manner = 0;
+    A.IA             = nullptr;
+    A.JA             = nullptr;
+    A.val            = nullptr;
     Asc   = fasp_dbsr_create(maxDim, maxDim, nnz, blockDim, 0);
     fsc   = fasp_dvec_create(maxDim * blockDim);
     order = fasp_ivec_create(maxDim);
@@ -341,8 +338,7 @@ void VectorFaspSolver::InitParam()
     inParam.AMG_smooth_restriction = ON;
 }
 
-void VectorFaspSolver::AssembleMat(const vector<vector<USI>>&     colId,
-                                   const vector<vector<OCP_DBL>>& val,
+void VectorFaspSolver::AssembleMat(OCP_USI* IA, OCP_USI* JA, OCP_DBL* val,
                                    const OCP_USI& dim, const USI& blockDim,
                                    vector<OCP_DBL>& rhs, vector<OCP_DBL>& u)
 {
@@ -358,10 +354,7 @@ void VectorFaspSolver::AssembleMat(const vector<vector<USI>>&     colId,
     order.row = nrow;
 
     // nnz
-    OCP_USI nnz = 0;
-    for (OCP_USI i = 0; i < dim; i++) {
-        nnz += colId[i].size();
-    }
+    const OCP_USI nnz = IA[dim];
 
     // Asc
     Asc.ROW = dim;
@@ -369,30 +362,14 @@ void VectorFaspSolver::AssembleMat(const vector<vector<USI>>&     colId,
     Asc.nb  = blockDim;
     Asc.NNZ = nnz;
 
-    // A
+    // A: attach the compressed storage directly
     A.ROW = dim;
     A.COL = dim;
     A.nb  = blockDim;
     A.NNZ = nnz;
-
-    OCP_USI count  = 0;
-    OCP_USI count2 = 0;
-    OCP_USI size_row;
-    A.IA[0] = 0;
-    for (OCP_USI i = 1; i < dim + 1; i++) {
-        USI nnb_Row = colId[i - 1].size();
-        A.IA[i]     = A.IA[i - 1] + nnb_Row;
-
-        for (USI j = 0; j < nnb_Row; j++) {
-            A.JA[count] = colId[i - 1][j];
-            count++;
-        }
-        size_row = nnb_Row * blockDim * blockDim;
-        for (USI k = 0; k < size_row; k++) {
-            A.val[count2] = val[i - 1][k];
-            count2++;
-        }
-    }
+    A.IA  = reinterpret_cast<INT*>(IA);
+    A.JA  = reinterpret_cast<INT*>(JA);
+    A.val = val;
 
 #ifdef _DEBUG
     // check x and b  ----  for test
@@ -411,8 +388,27 @@ void VectorFaspSolver::AssembleMat(const vector<vector<USI>>&     colId,
     
 }
 
+bool VectorFaspSolver::CanReusePrecond() const
+{
+    // Direct solvers and other preconditioners build everything in each solve
+    if (inParam.solver_type < 1 || inParam.solver_type > 10) return false;
+    switch (inParam.precond_type) {
+        case PC_BILU:
+#if WITH_FASP4BLKOIL
+        case PC_FASP1_SHARE:
+        case PC_FASP4_SHARE:
+#endif
+            return true;
+        default:
+            return false;
+    }
+}
+
 OCP_INT VectorFaspSolver::Solve()
 {
+    // AMG setup and Krylov iterations both happen inside FASP
+    OCP_PROFILE("FaspSolve");
+
     OCP_INT status = FASP_SUCCESS;
 
     // Set local parameters
@@ -441,9 +437,22 @@ OCP_INT VectorFaspSolver::Solve()
             case PC_DIAG:
                 status = fasp_solver_dbsr_krylov_diag(&A, &b, &x, &itParam);
                 break;
-            case PC_BILU:
-                status = fasp_solver_dbsr_krylov_ilu(&A, &b, &x, &itParam, &iluParam);
+            case PC_BILU: {
+                // ILU factors are kept until the reuse policy asks for new ones
+                if (!reusePrecond || !iluReady) {
+                    if (iluReady) fasp_ilu_data_free(&iluData);
+                    iluReady = fasp_ilu_dbsr_setup(&A, &iluData, &iluParam) >= 0;
+                }
+                if (!iluReady) {
+                    status = ERROR_SOLVER_ILUSETUP;
+                    break;
+                }
+                precond pc;
+                pc.data = &iluData;
+                pc.fct  = fasp_precond_dbsr_ilu;
+                status  = fasp_solver_dbsr_itsolver(&A, &b, &x, &pc, &itParam);
                 break;
+            }
 #if WITH_FASP4BLKOIL
             case PC_FASP1:
                 Decoupling(&A, &b, &Asc, &fsc, &order, Dmat.data(), decoup_type);
@@ -455,14 +464,17 @@ OCP_INT VectorFaspSolver::Solve()
                     &Asc, &fsc, &x, &itParam, &iluParam, &amgParam, NULL, &order);
 #endif                
 		break;
+            // A threshold of 1 builds the setup again, RESET_CONST keeps sharing it
             case PC_FASP1_SHARE: // zhaoli 2021.03.24
                 Decoupling(&A, &b, &Asc, &fsc, &order, Dmat.data(), decoup_type);
 #if WITH_FASP4CUDA
      		    status = fasp_solver_dbsr_krylov_FASP1_cuda_share_interface(
-                    &Asc, &fsc, &x, &itParam, &iluParam, &amgParam, NULL, &order, RESET_CONST);
+                    &Asc, &fsc, &x, &itParam, &iluParam, &amgParam, NULL, &order,
+                    reusePrecond ? RESET_CONST : 1);
 #else     
                 status = fasp_solver_dbsr_krylov_FASP1a_share_interface(
-                    &Asc, &fsc, &x, &itParam, &iluParam, &amgParam, NULL, &order, RESET_CONST);
+                    &Asc, &fsc, &x, &itParam, &iluParam, &amgParam, NULL, &order,
+                    reusePrecond ? RESET_CONST : 1);
 #endif                  
                 break;
             case PC_FASP2:
@@ -490,11 +502,11 @@ OCP_INT VectorFaspSolver::Solve()
 #if WITH_FASP4CUDA // zhaoli 2022.08.03
                 status = fasp_solver_dbsr_krylov_FASP4_cuda_share_interface(
                     &Asc, &fsc, &x, &itParam, &iluParam, &amgParam, NULL, &order,
-                    RESET_CONST);
+                    reusePrecond ? RESET_CONST : 1);
 #else                
                 status = fasp_solver_dbsr_krylov_FASP4_share_interface(
                     &Asc, &fsc, &x, &itParam, &iluParam, &amgParam, NULL, &order,
-                    RESET_CONST);
+                    reusePrecond ? RESET_CONST : 1);
 #endif                    
                 break;
             case PC_FASP5:
@@ -578,4 +590,5 @@ OCP_INT VectorFaspSolver::Solve()
 /*  Shizhe Li           Nov/22/2021      Create file                          */
 /*  Chensong Zhang      Jan/19/2022      Set FASP4BLKOIL as optional          */
 /*  Li Zhao             Apr/04/2022      Set FASP4CUDA   as optional          */
+/*  OpenCAEPoro team    Oct/17/2026      Reuse of preconditioners             */
 /*----------------------------------------------------------------------------*/
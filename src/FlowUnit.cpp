@@ -18,14 +18,14 @@
 ///////////////////////////////////////////////
 
 void FlowUnit_W::CalKrPc(const OCP_DBL* S_in, OCP_DBL* kr_out, OCP_DBL* pc_out,
-                        const OCP_DBL& MySurTen, OCP_DBL& MyFk, OCP_DBL& MyFp)
+                        const OCP_DBL& MySurTen, OCP_DBL& MyFk, OCP_DBL& MyFp) const
 {
     kr_out[0] = 1;
     pc_out[0] = 0;
 }
 
 void FlowUnit_W::CalKrPcDeriv(const OCP_DBL* S_in, OCP_DBL* kr_out, OCP_DBL* pc_out,
-    OCP_DBL* dkrdS, OCP_DBL* dPcjdS, const OCP_DBL& MySurTen, OCP_DBL& MyFk, OCP_DBL& MyFp)
+    OCP_DBL* dkrdS, OCP_DBL* dPcjdS, const OCP_DBL& MySurTen, OCP_DBL& MyFk, OCP_DBL& MyFp) const
 {
     kr_out[0] = 1;
     pc_out[0] = 0;
@@ -43,14 +43,13 @@ FlowUnit_OW::FlowUnit_OW(const ParamReservoir& rs_param, const USI& i)
     SWOF.Setup(rs_param.SWOF_T.data[i]);
     Swco = SWOF.GetCol(0)[0];
 
-    data.resize(4, 0);
-    cdata.resize(4, 0);
 }
 
 
 void FlowUnit_OW::CalKrPc(const OCP_DBL* S_in, OCP_DBL* kr_out, OCP_DBL* pc_out,
-                const OCP_DBL& MySurTen, OCP_DBL& MyFk, OCP_DBL& MyFp)
+                const OCP_DBL& MySurTen, OCP_DBL& MyFk, OCP_DBL& MyFp) const
 {
+    OCP_DBL data[4], cdata[4]; // values and slopes of interpolation
     OCP_DBL Sw = S_in[1];
 
     // three phase black oil model using stone 2
@@ -66,8 +65,9 @@ void FlowUnit_OW::CalKrPc(const OCP_DBL* S_in, OCP_DBL* kr_out, OCP_DBL* pc_out,
 }
 
 void FlowUnit_OW::CalKrPcDeriv(const OCP_DBL* S_in, OCP_DBL* kr_out, OCP_DBL* pc_out,
-    OCP_DBL* dkrdS, OCP_DBL* dPcjdS, const OCP_DBL& MySurTen, OCP_DBL& MyFk, OCP_DBL& MyFp)
+    OCP_DBL* dkrdS, OCP_DBL* dPcjdS, const OCP_DBL& MySurTen, OCP_DBL& MyFk, OCP_DBL& MyFp) const
 {
+    OCP_DBL data[4], cdata[4]; // values and slopes of interpolation
     OCP_DBL Sw = S_in[1];
     SWOF.Eval_All(0, Sw, data, cdata);
     OCP_DBL krw = data[1];
@@ -103,14 +103,13 @@ FlowUnit_OG::FlowUnit_OG(const ParamReservoir& rs_param, const USI& i)
 
     kroMax = SGOF.GetCol(2)[0];
 
-    data.resize(4, 0);
-    cdata.resize(4, 0); 
 }
 
 
 void FlowUnit_OG::CalKrPc(const OCP_DBL* S_in, OCP_DBL* kr_out, OCP_DBL* pc_out,
-                        const OCP_DBL& MySurTen, OCP_DBL& MyFk, OCP_DBL& MyFp)
+                        const OCP_DBL& MySurTen, OCP_DBL& MyFk, OCP_DBL& MyFp) const
 {
+    OCP_DBL data[4], cdata[4]; // values and slopes of interpolation
     OCP_DBL Sg = S_in[1];
 
     // three phase black oil model using stone 2
@@ -126,7 +125,7 @@ void FlowUnit_OG::CalKrPc(const OCP_DBL* S_in, OCP_DBL* kr_out, OCP_DBL* pc_out,
 }
 
 void FlowUnit_OG::CalKrPcDeriv(const OCP_DBL* S_in, OCP_DBL* kr_out, OCP_DBL* pc_out,
-    OCP_DBL* dkrdS, OCP_DBL* dPcjdS, const OCP_DBL& MySurTen, OCP_DBL& MyFk, OCP_DBL& MyFp)
+    OCP_DBL* dkrdS, OCP_DBL* dPcjdS, const OCP_DBL& MySurTen, OCP_DBL& MyFk, OCP_DBL& MyFp) const
 {
     OCP_ABORT("Not Completed Now!");
 }
@@ -173,8 +172,6 @@ FlowUnit_ODGW01::FlowUnit_ODGW01(const ParamReservoir& rs_param, const USI& i)
     kroMax = SWOF.GetCol(2)[0];
     Swco = SWOF.GetCol(0)[0];
 
-    data.resize(4, 0);
-    cdata.resize(4, 0);
 
     Generate_SWPCWG();
 
@@ -189,8 +186,9 @@ FlowUnit_ODGW01::FlowUnit_ODGW01(const ParamReservoir& rs_param, const USI& i)
 }
 
 void FlowUnit_ODGW01::CalKrPc(const OCP_DBL* S_in, OCP_DBL* kr_out, OCP_DBL* pc_out,
-                            const OCP_DBL& MySurTen, OCP_DBL& MyFk, OCP_DBL& MyFp)
+                            const OCP_DBL& MySurTen, OCP_DBL& MyFk, OCP_DBL& MyFp) const
 {
+    OCP_DBL data[4], cdata[4]; // values and slopes of interpolation
     const OCP_DBL Sg = S_in[1];
     const OCP_DBL Sw = S_in[2];
 
@@ -217,8 +215,9 @@ void FlowUnit_ODGW01::CalKrPc(const OCP_DBL* S_in, OCP_DBL* kr_out, OCP_DBL* pc_
 }
 
 void FlowUnit_ODGW01::CalKrPcDeriv(const OCP_DBL* S_in, OCP_DBL* kr_out, OCP_DBL* pc_out,
-    OCP_DBL* dkrdS, OCP_DBL* dPcjdS, const OCP_DBL& MySurTen, OCP_DBL& MyFk, OCP_DBL& MyFp)
+    OCP_DBL* dkrdS, OCP_DBL* dPcjdS, const OCP_DBL& MySurTen, OCP_DBL& MyFk, OCP_DBL& MyFp) const
 {
+    OCP_DBL data[4], cdata[4]; // values and slopes of interpolation
     OCP_DBL Sg = S_in[1];
     OCP_DBL Sw = S_in[2];
 
@@ -341,20 +340,21 @@ void FlowUnit_ODGW01::Generate_SWPCWG()
 ///////////////////////////////////////////////
 
 void FlowUnit_ODGW01_Miscible::CalKrPc(const OCP_DBL* S_in, OCP_DBL* kr_out, OCP_DBL* pc_out,
-                                const OCP_DBL& MySurTen, OCP_DBL& MyFk, OCP_DBL& MyFp)
+                                const OCP_DBL& MySurTen, OCP_DBL& MyFk, OCP_DBL& MyFp) const
 {
-    surTen = MySurTen;
+    OCP_DBL data[4], cdata[4]; // values and slopes of interpolation
+    const OCP_DBL surTen = MySurTen;
     if (surTen >= surTenRef || surTen < TINY) {
         MyFk = 1; MyFp = 1;   
-        FlowUnit_ODGW01::CalKrPc(S_in, kr_out, pc_out, surTen, surTen, surTen);
+        FlowUnit_ODGW01::CalKrPc(S_in, kr_out, pc_out, surTen, MyFk, MyFp);
     }
     else {
         OCP_DBL So = S_in[0];
         OCP_DBL Sg = S_in[1];
         OCP_DBL Sw = S_in[2];
 
-        Fk = min(1.0, pow(surTen / surTenRef, Fkexp));
-        Fp = min(surTenPc, surTen / surTenRef);
+        const OCP_DBL Fk = min(1.0, pow(surTen / surTenRef, Fkexp));
+        const OCP_DBL Fp = min(surTenPc, surTen / surTenRef);
 
         SWOF.Eval_All(0, Sw, data, cdata);
         const OCP_DBL krw = data[1];
@@ -391,20 +391,22 @@ void FlowUnit_ODGW01_Miscible::CalKrPc(const OCP_DBL* S_in, OCP_DBL* kr_out, OCP
 
 
 void FlowUnit_ODGW01_Miscible::CalKrPcDeriv(const OCP_DBL* S_in, OCP_DBL* kr_out, OCP_DBL* pc_out,
-    OCP_DBL* dkrdS, OCP_DBL* dPcjdS, const OCP_DBL& MySurTen, OCP_DBL& MyFk, OCP_DBL& MyFp)
+    OCP_DBL* dkrdS, OCP_DBL* dPcjdS, const OCP_DBL& MySurTen, OCP_DBL& MyFk, OCP_DBL& MyFp) const
 {
-    surTen = MySurTen;
+    OCP_DBL data[4], cdata[4]; // values and slopes of interpolation
+    const OCP_DBL surTen = MySurTen;
     if (surTen >= surTenRef || surTen < TINY) {
         MyFk = 1; MyFp = 1;
-        FlowUnit_ODGW01::CalKrPcDeriv(S_in, kr_out, pc_out, dkrdS, dPcjdS, surTen, surTen, surTen);
+        FlowUnit_ODGW01::CalKrPcDeriv(S_in, kr_out, pc_out, dkrdS, dPcjdS, surTen, MyFk,
+                                      MyFp);
     }
     else {
         const OCP_DBL So = S_in[0];
         const OCP_DBL Sg = S_in[1];
         const OCP_DBL Sw = S_in[2];
 
-        Fk = min(1.0, pow(surTen / surTenRef, Fkexp));
-        Fp = min(surTenPc, surTen / surTenRef);
+        const OCP_DBL Fk = min(1.0, pow(surTen / surTenRef, Fkexp));
+        const OCP_DBL Fp = min(surTenPc, surTen / surTenRef);
 
         SWOF.Eval_All(0, Sw, data, cdata);
         const OCP_DBL krw = data[1];
@@ -484,16 +486,15 @@ FlowUnit_ODGW02::FlowUnit_ODGW02(const ParamReservoir& rs_param, const USI& i)
     kroMax = SOF3.GetCol(1).back();
     Swco = SWFN.GetCol(0)[0];
 
-    data.resize(3, 0);
-    cdata.resize(3, 0);
 
     Generate_SWPCWG();
 }
 
 
 void FlowUnit_ODGW02::CalKrPc(const OCP_DBL* S_in, OCP_DBL* kr_out, OCP_DBL* pc_out,
-                            const OCP_DBL& MySurTen, OCP_DBL& MyFk, OCP_DBL& MyFp)
+                            const OCP_DBL& MySurTen, OCP_DBL& MyFk, OCP_DBL& MyFp) const
 {
+    OCP_DBL data[3], cdata[3]; // values and slopes of interpolation
     OCP_DBL So = S_in[0];
     OCP_DBL Sg = S_in[1];
     OCP_DBL Sw = S_in[2];
@@ -523,8 +524,9 @@ void FlowUnit_ODGW02::CalKrPc(const OCP_DBL* S_in, OCP_DBL* kr_out, OCP_DBL* pc_
 }
 
 void FlowUnit_ODGW02::CalKrPcDeriv(const OCP_DBL* S_in, OCP_DBL* kr_out, OCP_DBL* pc_out,
-    OCP_DBL* dkrdS, OCP_DBL* dPcjdS, const OCP_DBL& MySurTen, OCP_DBL& MyFk, OCP_DBL& MyFp)
+    OCP_DBL* dkrdS, OCP_DBL* dPcjdS, const OCP_DBL& MySurTen, OCP_DBL& MyFk, OCP_DBL& MyFp) const
 {
+    OCP_DBL data[3], cdata[3]; // values and slopes of interpolation
     OCP_DBL So = S_in[0];
     OCP_DBL Sg = S_in[1];
     OCP_DBL Sw = S_in[2];
@@ -639,4 +641,5 @@ void FlowUnit_ODGW02::Generate_SWPCWG()
 /*----------------------------------------------------------------------------*/
 /*  Shizhe Li           Oct/01/2021      Create file                          */
 /*  Chensong Zhang      Oct/15/2021      Format file                          */
+/*  OpenCAEPoro team    Oct/16/2026      Batched kr and Pc over cell lists    */
 /*----------------------------------------------------------------------------*/
\ No newline at end of file
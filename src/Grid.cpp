@@ -9,6 +9,14 @@
  *-----------------------------------------------------------------------------------
  */
 
+// Standard header files
+#include <algorithm>
+
+#if WITH_METIS
+#include <metis.h>
+#endif
+
+// OpenCAEPoro header files
 #include "Grid.hpp"
 
 void Grid::InputParam(const ParamReservoir &rs_param)
@@ -90,6 +98,39 @@ void Grid::Setup()
     CalSomeInfo();
 }
 
+void Grid::SyncSetup(OCPCheckpoint& cache)
+{
+    cache.Sync(nx);
+    cache.Sync(ny);
+    cache.Sync(nz);
+    cache.Sync(numGrid);
+    cache.Sync(numConn);
+    cache.Sync(gridType);
+    cache.Sync(gNeighbor);
+    cache.Sync(tops);
+    cache.Sync(depth);
+    cache.Sync(dx);
+    cache.Sync(dy);
+    cache.Sync(dz);
+    cache.Sync(coord);
+    cache.Sync(zcorn);
+    cache.Sync(v);
+    cache.Sync(ntg);
+    cache.Sync(poro);
+    cache.Sync(kx);
+    cache.Sync(ky);
+    cache.Sync(kz);
+    cache.Sync(SwatInit);
+    cache.Sync(SATNUM);
+    cache.Sync(PVTNUM);
+    cache.Sync(ACTNUM);
+    cache.Sync(activeGridNum);
+    cache.Sync(activeMap_B2G);
+    cache.Sync(activeMap_G2B);
+    cache.Sync(bulkOrder);
+    cache.Sync(numDigutIJK);
+}
+
 void Grid::SetupOrthogonalGrid()
 {
     // x -> y -> z
@@ -324,6 +365,169 @@ void Grid::CalActiveGrid(const OCP_DBL &e1, const OCP_DBL &e2)
          << (numGrid - activeGridNum) << ") of grid cell is inactive" << endl;
 }
 
+/// Find the nodes of the last level of a breadth-first search from root.
+//  Note: mark[i] == stamp means node i has been reached in this search, so no clearing
+//  is needed between searches. Return the number of levels.
+static OCP_USI LastLevel(const vector<OCP_USI>& xadj, const vector<OCP_USI>& adj,
+                         const OCP_USI& root, const OCP_USI& stamp,
+                         vector<OCP_USI>& mark, vector<OCP_USI>& last)
+{
+    vector<OCP_USI> cur{root}, next;
+    OCP_USI         numLevel = 1;
+    mark[root]               = stamp;
+    while (true) {
+        next.clear();
+        for (const auto& i : cur) {
+            for (OCP_USI k = xadj[i]; k < xadj[i + 1]; k++) {
+                if (mark[adj[k]] != stamp) {
+                    mark[adj[k]] = stamp;
+                    next.push_back(adj[k]);
+                }
+            }
+        }
+        if (next.empty()) break;
+        cur.swap(next);
+        numLevel++;
+    }
+    last.swap(cur);
+    return numLevel;
+}
+
+/// Reverse Cuthill-McKee ordering of a graph: perm[i] is the old index of new node i.
+//  Note: Each connected component starts from a pseudo-peripheral node, which is found
+//  by repeated searches from a node of minimum degree in the last level.
+static void CalRCMOrder(const vector<OCP_USI>& xadj, const vector<OCP_USI>& adj,
+                        vector<OCP_USI>& perm)
+{
+    const OCP_USI   num = xadj.size() - 1;
+    vector<OCP_USI> degree(num), mark(num, 0), last;
+    vector<bool>    visited(num, false);
+    for (OCP_USI i = 0; i < num; i++) degree[i] = xadj[i + 1] - xadj[i];
+    auto lessDegree = [&degree](const OCP_USI& a, const OCP_USI& b) {
+        return degree[a] < degree[b] || (degree[a] == degree[b] && a < b);
+    };
+
+    // Nodes in increasing degree, to start each component from
+    vector<OCP_USI> byDegree(num);
+    for (OCP_USI i = 0; i < num; i++) byDegree[i] = i;
+    stable_sort(byDegree.begin(), byDegree.end(), lessDegree);
+
+    perm.clear();
+    perm.reserve(num);
+    OCP_USI stamp = 0;
+    for (const auto& start : byDegree) {
+        if (visited[start]) continue;
+
+        // Find a pseudo-peripheral node of the component
+        OCP_USI root     = start;
+        OCP_USI numLevel = LastLevel(xadj, adj, root, ++stamp, mark, last);
+        while (true) {
+            const OCP_USI cand = *min_element(last.begin(), last.end(), lessDegree);
+            const OCP_USI candLevel = LastLevel(xadj, adj, cand, ++stamp, mark, last);
+            if (candLevel <= numLevel) break;
+            root     = cand;
+            numLevel = candLevel;
+        }
+
+        // Cuthill-McKee: visit neighbors in increasing degree
+        OCP_USI head = perm.size();
+        perm.push_back(root);
+        visited[root] = true;
+        vector<OCP_USI> nbr;
+        while (head < perm.size()) {
+            const OCP_USI i = perm[head++];
+            nbr.clear();
+            for (OCP_USI k = xadj[i]; k < xadj[i + 1]; k++) {
+                if (!visited[adj[k]]) {
+                    visited[adj[k]] = true;
+                    nbr.push_back(adj[k]);
+                }
+            }
+            sort(nbr.begin(), nbr.end(), lessDegree);
+            perm.insert(perm.end(), nbr.begin(), nbr.end());
+        }
+    }
+    reverse(perm.begin(), perm.end());
+}
+
+void Grid::SetupBulkOrder(const USI& order)
+{
+    // Natural ordering: active grids in increasing index
+    vector<OCP_USI> natural;
+    natural.reserve(activeGridNum);
+    for (OCP_USI n = 0; n < numGrid; n++) {
+        if (activeMap_G2B[n].IsAct()) natural.push_back(n);
+    }
+    bulkOrder = order;
+
+    // Graph of bulks in the natural ordering, without self loops
+    vector<OCP_USI> xadj(activeGridNum + 1, 0), adj;
+    if (order != BULK_NATURAL) {
+        for (OCP_USI b = 0; b < activeGridNum; b++) {
+            for (const auto& g : gNeighbor[natural[b]]) {
+                if (activeMap_G2B[g.id].IsAct()) adj.push_back(g.id);
+            }
+            xadj[b + 1] = adj.size();
+        }
+        // Bulk indices of neighbors in the natural ordering
+        vector<OCP_USI> g2n(numGrid, 0);
+        for (OCP_USI b = 0; b < activeGridNum; b++) g2n[natural[b]] = b;
+        for (auto& a : adj) a = g2n[a];
+    }
+
+    vector<OCP_USI> perm;
+    switch (order) {
+        case BULK_NATURAL:
+            perm.resize(activeGridNum);
+            for (OCP_USI b = 0; b < activeGridNum; b++) perm[b] = b;
+            break;
+        case BULK_RCM:
+            CalRCMOrder(xadj, adj, perm);
+            break;
+        case BULK_METIS:
+#if WITH_METIS
+        {
+            idx_t         nvtxs = activeGridNum;
+            vector<idx_t> mxadj(xadj.begin(), xadj.end());
+            vector<idx_t> madj(adj.begin(), adj.end());
+            vector<idx_t> mperm(nvtxs), miperm(nvtxs);
+            if (METIS_NodeND(&nvtxs, mxadj.data(), madj.data(), nullptr, nullptr,
+                             mperm.data(), miperm.data()) != METIS_OK)
+                OCP_ABORT("METIS_NodeND failed!");
+            perm.assign(mperm.begin(), mperm.end());
+        }
+#else
+            OCP_WARNING("METIS is not available, bulks are ordered by RCM");
+            bulkOrder = BULK_RCM;
+            CalRCMOrder(xadj, adj, perm);
+#endif
+            break;
+        default:
+            OCP_ABORT("Wrong bulk ordering!");
+    }
+
+    activeMap_B2G.resize(activeGridNum);
+    for (OCP_USI b = 0; b < activeGridNum; b++) {
+        activeMap_B2G[b]                = natural[perm[b]];
+        activeMap_G2B[activeMap_B2G[b]] = GB_Pair(true, b);
+    }
+
+    if (bulkOrder != BULK_NATURAL) {
+        // Bandwidth of the bulk graph before and after
+        OCP_USI bw0 = 0, bw1 = 0;
+        for (OCP_USI b = 0; b < activeGridNum; b++) {
+            const OCP_USI nb = activeMap_G2B[natural[b]].GetId();
+            for (OCP_USI k = xadj[b]; k < xadj[b + 1]; k++) {
+                const OCP_USI ne = activeMap_G2B[natural[adj[k]]].GetId();
+                bw0              = max(bw0, adj[k] > b ? adj[k] - b : b - adj[k]);
+                bw1              = max(bw1, ne > nb ? ne - nb : nb - ne);
+            }
+        }
+        cout << "Bulks are renumbered by " << (bulkOrder == BULK_RCM ? "RCM" : "METIS")
+             << ", bandwidth " << bw0 << " -> " << bw1 << endl;
+    }
+}
+
 /// Return id of the active cell and abort if the cell is inactive!
 OCP_USI Grid::GetActIndex(const USI &i, const USI &j, const USI &k) const
 {
@@ -455,4 +659,5 @@ void Grid::CalNumDigutIJK()
 /*  Shizhe Li           Oct/01/2021      Create file                          */
 /*  Chensong Zhang      Oct/15/2021      Format file                          */
 /*  Chensong Zhang      Jan/16/2022      Fix Doxygen                          */
+/*  OpenCAEPoro team    Oct/16/2026      Add bulk ordering                    */
 /*----------------------------------------------------------------------------*/
\ No newline at end of file
@@ -207,6 +207,24 @@ void IsothermalSolver::FinishStep(Reservoir &rs, OCPControl &ctrl)
     }
 }
 
+void IsothermalSolver::ResetPattern()
+{
+    LSolver.ResetPattern();
+    auxLSolver.ResetPattern();
+}
+
+void IsothermalSolver::PrintLinearInfo(ostream& out) const
+{
+    LSolver.PrintReuseInfo(out);
+    auxLSolver.PrintReuseInfo(out);
+}
+
+void IsothermalSolver::SyncCheckpoint(OCPCheckpoint& ckpt)
+{
+    LSolver.SyncCheckpoint(ckpt);
+    auxLSolver.SyncCheckpoint(ckpt);
+}
+
 /*----------------------------------------------------------------------------*/
 /*  Brief Change History of This File                                         */
 /*----------------------------------------------------------------------------*/
@@ -10,14 +10,65 @@
 
 #include "LinearSystem.hpp"
 
+bool PrecondReuse::NeedSetup(const vector<OCP_DBL>& rowSum)
+{
+    if (!active) return true;
+
+    USI reason = SETUP_REASON_NUM;
+    if (patternChanged || rowSum.size() != baseRowSum.size()) {
+        reason = SETUP_PATTERN;
+    } else if (lastFailed) {
+        reason = SETUP_FAILURE;
+    } else if (lastIters > maxGrowth * baseIters + minGrowth) {
+        reason = SETUP_ITERS;
+    } else if (age >= maxAge) {
+        reason = SETUP_AGE;
+    } else {
+        OCP_DBL diff = 0;
+        OCP_DBL base = 0;
+        for (OCP_USI n = 0; n < rowSum.size(); n++) {
+            diff += (rowSum[n] - baseRowSum[n]) * (rowSum[n] - baseRowSum[n]);
+            base += baseRowSum[n] * baseRowSum[n];
+        }
+        if (diff > maxDrift * maxDrift * base) reason = SETUP_DRIFT;
+    }
+
+    lastSetup = reason != SETUP_REASON_NUM;
+    if (lastSetup) {
+        numSetup++;
+        numReason[reason]++;
+        baseRowSum     = rowSum;
+        patternChanged = false;
+        age            = 0;
+    } else {
+        numReuse++;
+    }
+    age++;
+    return lastSetup;
+}
+
+void PrecondReuse::Record(const OCP_INT& status, const USI& iters)
+{
+    lastFailed = status < 0;
+    lastIters  = iters;
+    if (lastSetup) baseIters = iters;
+}
+
+void PrecondReuse::PrintInfo(ostream& out) const
+{
+    if (!active || numSetup + numReuse == 0) return;
+    out << "Precond setups:      " << numSetup << " (+" << numReuse << " reused)" << endl
+        << "  for pattern, failure, iters, drift, age: " << numReason[SETUP_PATTERN]
+        << ", " << numReason[SETUP_FAILURE] << ", " << numReason[SETUP_ITERS] << ", "
+        << numReason[SETUP_DRIFT] << ", " << numReason[SETUP_AGE] << endl;
+}
+
 void LinearSystem::AllocateRowMem(const OCP_USI& dimMax, const USI& nb)
 {
     blockSize = nb * nb;
     blockDim  = nb;
     maxDim    = dimMax;
     rowCapacity.resize(maxDim);
-    colId.resize(maxDim);
-    val.resize(maxDim);
     diagPtr.resize(maxDim);
     diagVal.resize(maxDim * blockSize);
     b.resize(maxDim * blockDim);
@@ -26,26 +77,24 @@ void LinearSystem::AllocateRowMem(const OCP_USI& dimMax, const USI& nb)
 
 void LinearSystem::AllocateColMem()
 {
-    for (OCP_USI n = 0; n < maxDim; n++) {
-        colId[n].reserve(rowCapacity[n]);
-        val[n].reserve(rowCapacity[n] * blockSize);
-    }
+    colId.Allocate(rowCapacity, 1);
+    val.Allocate(rowCapacity, blockSize);
 }
 
 void LinearSystem::AllocateColMem(const OCP_USI& colnum)
 {
-    for (OCP_USI n = 0; n < maxDim; n++) {
-        rowCapacity[n] = colnum;
-        colId[n].reserve(colnum);
-        val[n].reserve(colnum * blockSize);
-    }
+    fill(rowCapacity.begin(), rowCapacity.end(), colnum);
+    AllocateColMem();
 }
 
 void LinearSystem::ClearData()
 {
-    for (OCP_USI i = 0; i < maxDim; i++) {
-        colId[i].clear(); // actually, only parts of bulks needs to be clear
-        val[i].clear();
+    if (patternFixed) {
+        // the pattern is kept in compressed form, only values are reset
+        val.Zero(dim);
+    } else {
+        colId.Clear(); // actually, only parts of bulks needs to be clear
+        val.Clear();
     }
     // diagPtr.assign(maxDim, 0);
     fill(diagVal.begin(), diagVal.end(), 0.0);
@@ -54,6 +103,14 @@ void LinearSystem::ClearData()
     // next step, so u will not be set to zero. u.assign(maxDim, 0);
 }
 
+void LinearSystem::ResetPattern()
+{
+    precondReuse.PatternChanged();
+    patternFixed = false;
+    colId.Clear();
+    val.Clear();
+}
+
 void LinearSystem::AssembleRhs(const vector<OCP_DBL>& rhs)
 {
     OCP_USI nrow = dim * blockDim;
@@ -62,6 +119,33 @@ void LinearSystem::AssembleRhs(const vector<OCP_DBL>& rhs)
     }
 }
 
+void LinearSystem::AssembleMatLinearSolver()
+{
+    // Rows are moved together in place, then the storage is in CSR/BSR form
+    colId.Compress(dim);
+    val.Compress(dim);
+    LS->AssembleMat(colId.Start(), colId.Data(), val.Data(), dim, blockDim, b, u);
+}
+
+OCP_INT LinearSystem::Solve()
+{
+    if (!LS->CanReusePrecond()) return LS->Solve();
+
+    // The matrix is compressed, the policy compares its row sums with the last setup
+    rowSum.resize(dim);
+    for (OCP_USI n = 0; n < dim; n++) {
+        const OCP_DBL* v = val.RowData(n);
+        OCP_DBL        s = 0;
+        for (USI i = 0; i < val.RowLen(n); i++) s += fabs(v[i]);
+        rowSum[n] = s;
+    }
+    LS->SetReusePrecond(!precondReuse.NeedSetup(rowSum));
+
+    const OCP_INT status = LS->Solve();
+    precondReuse.Record(status, status < 0 ? LS->GetNumIters() : status);
+    return status;
+}
+
 void LinearSystem::OutputLinearSystem(const string& fileA, const string& fileb) const
 {
     string FileA = solveDir + fileA;
@@ -79,22 +163,22 @@ void LinearSystem::OutputLinearSystem(const string& fileA, const string& fileb)
     OCP_USI rowId = 1;
     for (OCP_USI i = 0; i < dim; i++) {
         outA << rowId << endl;
-        rowId += colId[i].size();
+        rowId += colId.RowLen(i);
     }
     outA << rowId << endl;
     // JA
     USI rowSize = 0;
     for (OCP_USI i = 0; i < dim; i++) {
-        rowSize = colId[i].size();
+        rowSize = colId.RowLen(i);
         for (USI j = 0; j < rowSize; j++) {
-            outA << colId[i][j] + 1 << endl;
+            outA << colId.RowData(i)[j] + 1 << endl;
         }
     }
     // val
     for (OCP_USI i = 0; i < dim; i++) {
-        rowSize = val[i].size();
+        rowSize = val.RowLen(i);
         for (USI j = 0; j < rowSize; j++) {
-            outA << val[i][j] << endl;
+            outA << val.RowData(i)[j] << endl;
         }
     }
     outA.close();
@@ -124,8 +208,9 @@ void LinearSystem::CheckEquation() const
 {
     // check A
     for (OCP_USI n = 0; n < dim; n++) {
-        for (auto v : val[n]) {
-            if (!isfinite(v)) {
+        const OCP_DBL* v = val.RowData(n);
+        for (USI i = 0; i < val.RowLen(n); i++) {
+            if (!isfinite(v[i])) {
                 OCP_ABORT("NAN or INF in MAT");
             }
         }
@@ -160,6 +245,11 @@ void LinearSystem::SetupLinearSolver(const USI& i, const string& dir,
             LS = new ScalarFaspSolver;
             break;
         case VECTORFASP:
+            // Built-in solver, chosen in the same file
+            if (VectorNativeSolver::IsChosen(dir, file)) {
+                LS = new VectorNativeSolver;
+                break;
+            }
             // Blcok Fasp
             LS = new VectorFaspSolver;
             break;
@@ -178,4 +268,6 @@ void LinearSystem::SetupLinearSolver(const USI& i, const string& dir,
 /*----------------------------------------------------------------------------*/
 /*  Shizhe Li           Oct/01/2021      Create file                          */
 /*  Shizhe Li           Nov/22/2021      renamed to LinearSystem              */
+/*  OpenCAEPoro team    Oct/17/2026      Add reuse policy of preconditioners  */
+/*  OpenCAEPoro team    Oct/17/2026      Add built-in vector solver           */
 /*----------------------------------------------------------------------------*/
\ No newline at end of file
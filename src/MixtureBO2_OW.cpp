@@ -9,6 +9,7 @@
  *-----------------------------------------------------------------------------------
  */
 
+#include "Bulk.hpp"
 #include "MixtureBO.hpp"
 
  ///////////////////////////////////////////////
@@ -188,6 +189,14 @@ void BOMixture_OW::FlashDeriv(const OCP_DBL& Pin, const OCP_DBL& Tin,
     
 }
 
+void BOMixture_OW::FlashDerivBatch(const OCP_USI* bulks,
+                                   const OCP_USI& num,
+                                   Bulk&          bk,
+                                   const OCP_USI& slot)
+{
+    bk.FlashDerivBulks<BOMixture_OW, false>(*this, bulks, num, slot);
+}
+
 OCP_DBL BOMixture_OW::XiPhase(const OCP_DBL& Pin, const OCP_DBL& Tin, const OCP_DBL* Ziin)
 {
     if (Ziin[1] > 1 - TINY) {
@@ -196,7 +205,7 @@ OCP_DBL BOMixture_OW::XiPhase(const OCP_DBL& Pin, const OCP_DBL& Tin, const OCP_
         OCP_DBL Pw0 = data[0];
         OCP_DBL bw0 = data[1];
         OCP_DBL cbw = data[2];
-        OCP_DBL bw  = bw0 * (1 - cbw * (P - Pw0));
+        OCP_DBL bw  = bw0 * (1 - cbw * (Pin - Pw0));
         OCP_DBL xiw = 1 / (CONV1 * bw);
         return xiw;
     } else {
@@ -213,7 +222,7 @@ OCP_DBL BOMixture_OW::RhoPhase(const OCP_DBL& Pin, const OCP_DBL& Tin, const OCP
         OCP_DBL Pw0  = data[0];
         OCP_DBL bw0  = data[1];
         OCP_DBL cbw  = data[2];
-        OCP_DBL bw   = bw0 * (1 - cbw * (P - Pw0));
+        OCP_DBL bw   = bw0 * (1 - cbw * (Pin - Pw0));
         OCP_DBL rhow = std_RhoW / bw;
         return rhow;
     } else {
@@ -246,4 +255,5 @@ OCP_DBL BOMixture_OW::GammaPhaseW(const OCP_DBL& Pin)
 /*  Author              Date             Actions                              */
 /*----------------------------------------------------------------------------*/
 /*  Shizhe Li           Oct/01/2021      Create file                          */
+/*  OpenCAEPoro team    Oct/16/2026      Batched flash over bulk lists        */
 /*----------------------------------------------------------------------------*/
\ No newline at end of file
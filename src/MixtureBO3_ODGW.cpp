@@ -9,6 +9,7 @@
  *-----------------------------------------------------------------------------------
  */
 
+#include "Bulk.hpp"
 #include "MixtureBO.hpp"
 
  ///////////////////////////////////////////////
@@ -772,6 +773,14 @@ void BOMixture_ODGW::FlashDeriv(const OCP_DBL& Pin, const OCP_DBL& Tin,
 #endif
 }
 
+void BOMixture_ODGW::FlashDerivBatch(const OCP_USI* bulks,
+                                     const OCP_USI& num,
+                                     Bulk&          bk,
+                                     const OCP_USI& slot)
+{
+    bk.FlashDerivBulks<BOMixture_ODGW, false>(*this, bulks, num, slot);
+}
+
 OCP_DBL BOMixture_ODGW::XiPhase(const OCP_DBL& Pin, const OCP_DBL& Tin, const OCP_DBL* Ziin)
 {
     if (Ziin[1] > 1 - TINY) {
@@ -787,7 +796,7 @@ OCP_DBL BOMixture_ODGW::XiPhase(const OCP_DBL& Pin, const OCP_DBL& Tin, const OC
         OCP_DBL Pw0 = data[0];
         OCP_DBL bw0 = data[1];
         OCP_DBL cbw = data[2];
-        OCP_DBL bw  = bw0 * (1 - cbw * (P - Pw0));
+        OCP_DBL bw  = bw0 * (1 - cbw * (Pin - Pw0));
         // OCP_DBL xiw = 1 / (CONV1 * bw);
         OCP_DBL xiw = 1 / CONV1 / bw;
         return xiw;
@@ -810,7 +819,7 @@ OCP_DBL BOMixture_ODGW::RhoPhase(const OCP_DBL& Pin, const OCP_DBL& Tin, const O
         OCP_DBL Pw0  = data[0];
         OCP_DBL bw0  = data[1];
         OCP_DBL cbw  = data[2];
-        OCP_DBL bw   = bw0 * (1 - cbw * (P - Pw0));
+        OCP_DBL bw   = bw0 * (1 - cbw * (Pin - Pw0));
         OCP_DBL rhow = std_RhoW / bw;
         return rhow;
     } else {
@@ -861,4 +870,5 @@ OCP_DBL BOMixture_ODGW::GammaPhaseW(const OCP_DBL& Pin)
 /*----------------------------------------------------------------------------*/
 /*  Shizhe Li           Oct/01/2021      Create file                          */
 /*  Chensong Zhang      Oct/15/2021      Format file                          */
+/*  OpenCAEPoro team    Oct/16/2026      Batched flash over bulk lists        */
 /*----------------------------------------------------------------------------*/
\ No newline at end of file
@@ -9,6 +9,7 @@
  *-----------------------------------------------------------------------------------
  */
 
+#include "Bulk.hpp"
 #include "MixtureComp.hpp"
 
 COMP::COMP(const vector<string>& comp)
@@ -511,6 +512,14 @@ void MixtureComp::FlashDeriv(const OCP_DBL& Pin, const OCP_DBL& Tin,
 }
 
 
+void MixtureComp::FlashDerivBatch(const OCP_USI* bulks,
+                                  const OCP_USI& num,
+                                  Bulk&          bk,
+                                  const OCP_USI& slot)
+{
+    bk.FlashDerivBulks<MixtureComp, true>(*this, bulks, num, slot);
+}
+
 void MixtureComp::FlashDeriv_n(const OCP_DBL& Pin, const OCP_DBL& Tin,
     const OCP_DBL* Niin, const OCP_DBL* Sjin, const OCP_DBL* xijin,
     const OCP_DBL* njin, const USI& myftype, const USI* phaseExistin, 
@@ -651,7 +660,7 @@ OCP_DBL MixtureComp::XiPhase(const OCP_DBL& Pin, const OCP_DBL& Tin,
         OCP_DBL Pw0   = data[0];
         OCP_DBL bw0   = data[1];
         OCP_DBL cbw   = data[2];
-        OCP_DBL bw    = bw0 * (1 - cbw * (P - Pw0));
+        OCP_DBL bw    = bw0 * (1 - cbw * (Pin - Pw0));
         OCP_DBL xitmp = 1 / (CONV1 * bw);
         return xitmp;
     } else {
@@ -741,6 +750,7 @@ void MixtureComp::AllocateEoS()
     // Allocate Memoery for EoS variables
     Ai.resize(NC);
     Bi.resize(NC);
+    Aik.resize(NC * NC);
     Aj.resize(NPmax);
     Bj.resize(NPmax);
     Zj.resize(NPmax);
@@ -798,6 +808,13 @@ void MixtureComp::CalAiBi()
         Ai[i] = OmegaA[i] * Pri / pow(Tri, 2) * pow((1 + mwi * (1 - sqrt(Tri))), 2);     
         Bi[i] = OmegaB[i] * Pri / Tri;
     }
+
+    // binary attraction terms used by fugacity and its derivatives
+    for (USI i = 0; i < NC; i++) {
+        for (USI k = 0; k < NC; k++) {
+            Aik[i * NC + k] = (1 - BIC[i * NC + k]) * sqrt(Ai[i] * Ai[k]);
+        }
+    }
 }
 
 void MixtureComp::CalAjBj(OCP_DBL& AjT, OCP_DBL& BjT, const vector<OCP_DBL>& xj) const
@@ -856,106 +873,61 @@ void MixtureComp::AllocatePhase()
 
 void MixtureComp::CalFugPhi(vector<OCP_DBL>& phiT, vector<OCP_DBL>& fugT,
                             const vector<OCP_DBL>& xj)
+{
+    CalFugPhi(&phiT[0], &fugT[0], &xj[0]);
+}
+
+void MixtureComp::CalFugPhi(OCP_DBL* phiT, OCP_DBL* fugT, const OCP_DBL* xj)
 {
     OCP_DBL aj, bj, zj;
     CalAjBj(aj, bj, xj);
     SolEoS(zj, aj, bj);
 
-    const OCP_DBL m1 = delta1;
-    const OCP_DBL m2 = delta2;
-    // const OCP_DBL m1Mm2 = delta1M2;
-
-    OCP_DBL tmp;
+    CalPhiKernel(phiT, xj, aj, bj, zj);
     for (USI i = 0; i < NC; i++) {
-        tmp = 0;
-        for (int k = 0; k < NC; k++) {
-            tmp += 2 * (1 - BIC[i * NC + k]) * sqrt(Ai[i] * Ai[k]) * xj[k];
-        }
-        phiT[i] = exp(Bi[i] / bj * (zj - 1) - log(zj - bj) -
-                      aj / (m1 - m2) / bj * (tmp / aj - Bi[i] / bj) *
-                          log((zj + m1 * bj) / (zj + m2 * bj)));
         fugT[i] = phiT[i] * xj[i] * P;
     }
 
-    //   OCP_DBL       tmp01 = log(zj - bj);
-    //   OCP_DBL       tmp02 = aj / (m1Mm2) / bj * log((zj + m1 * bj) / (zj + m2 * bj));
-
-    // for (USI i = 0; i < NC; i++) {
-    //	tmp = 0;
-    //	for (int k = 0; k < NC; k++) {
-    //		tmp += 2 * (1 - BIC[i * NC + k]) * sqrt(Ai[i] * Ai[k]) * xj[k];
-    //	}
-    //       phiT[i] = exp(Bi[i] / bj * (zj - 1) - tmp01 - tmp02 * (tmp / aj - Bi[i] /
-    //       bj));
-    //	fugT[i] = phiT[i] * xj[i] * P;
-    //}
-
     Asta = aj;
     Bsta = bj;
     Zsta = zj;
 }
 
-void MixtureComp::CalFugPhi(OCP_DBL* phiT, OCP_DBL* fugT, const OCP_DBL* xj)
+void MixtureComp::CalFugPhi(OCP_DBL* fugT, const OCP_DBL* xj)
 {
     OCP_DBL aj, bj, zj;
     CalAjBj(aj, bj, xj);
     SolEoS(zj, aj, bj);
 
-    const OCP_DBL m1    = delta1;
-    const OCP_DBL m2    = delta2;
-    const OCP_DBL m1Mm2 = delta1M2;
-
-    // OCP_DBL tmp01 = log(zj - bj);
-    // OCP_DBL tmp02 = aj / (m1Mm2) / bj * log((zj + m1 * bj) / (zj + m2 * bj));
-
-    OCP_DBL tmp;
+    CalPhiKernel(fugT, xj, aj, bj, zj);
     for (USI i = 0; i < NC; i++) {
-        tmp = 0;
-        for (int k = 0; k < NC; k++) {
-            tmp += 2 * (1 - BIC[i * NC + k]) * sqrt(Ai[i] * Ai[k]) * xj[k];
-        }
-        phiT[i] = exp(Bi[i] / bj * (zj - 1) - log(zj - bj) -
-                      aj / (m1Mm2) / bj * (tmp / aj - Bi[i] / bj) *
-                          log((zj + m1 * bj) / (zj + m2 * bj)));
-        fugT[i] = phiT[i] * xj[i] * P;
+        fugT[i] = fugT[i] * xj[i] * P;
     }
-    // for (USI i = 0; i < NC; i++) {
-    //    tmp = 0;
-    //    for (int k = 0; k < NC; k++) {
-    //        tmp += 2 * (1 - BIC[i * NC + k]) * sqrt(Ai[i] * Ai[k]) * xj[k];
-    //    }
-    //    phiT[i] = exp(Bi[i] / bj * (zj - 1) - tmp01 - tmp02 * (tmp / aj - Bi[i] /
-    //    bj)); fugT[i] = phiT[i] * xj[i] * P;
-    //}
 
     Asta = aj;
     Bsta = bj;
     Zsta = zj;
 }
 
-void MixtureComp::CalFugPhi(OCP_DBL* fugT, const OCP_DBL* xj)
+void MixtureComp::CalFugPhiRef(OCP_DBL* phiT, OCP_DBL* fugT, const OCP_DBL* xj)
 {
     OCP_DBL aj, bj, zj;
     CalAjBj(aj, bj, xj);
     SolEoS(zj, aj, bj);
 
-    const OCP_DBL m1    = delta1;
-    const OCP_DBL m2    = delta2;
-    const OCP_DBL m1Mm2 = delta1M2;
-
-    // OCP_DBL tmp01 = log(zj - bj);
-    // OCP_DBL tmp02 = aj / (m1Mm2) / bj * log((zj + m1 * bj) / (zj + m2 * bj));
+    const OCP_DBL m1 = delta1;
+    const OCP_DBL m2 = delta2;
 
     OCP_DBL tmp;
     for (USI i = 0; i < NC; i++) {
         tmp = 0;
-        for (int k = 0; k < NC; k++) {
+        for (USI k = 0; k < NC; k++) {
             tmp += 2 * (1 - BIC[i * NC + k]) * sqrt(Ai[i] * Ai[k]) * xj[k];
         }
-        tmp     = exp(Bi[i] / bj * (zj - 1) - log(zj - bj) -
-                  aj / (m1Mm2) / bj * (tmp / aj - Bi[i] / bj) *
-                      log((zj + m1 * bj) / (zj + m2 * bj)));
-        fugT[i] = tmp * xj[i] * P;
+        phiT[i] = exp(Bi[i] / bj * (zj - 1) - log(zj - bj) -
+                      aj / (m1 - m2) / bj * (tmp / aj - Bi[i] / bj) *
+                          log((zj + m1 * bj) / (zj + m2 * bj)));
+        fugT[i] = phiT[i] * xj[i] * P;
     }
 
     Asta = aj;
@@ -965,11 +937,6 @@ void MixtureComp::CalFugPhi(OCP_DBL* fugT, const OCP_DBL* xj)
 
 void MixtureComp::CalFugPhiAll()
 {
-    OCP_DBL       tmp;// , tmp01, tmp02;
-    const OCP_DBL m1    = delta1;
-    const OCP_DBL m2    = delta2;
-    const OCP_DBL m1Mm2 = delta1M2;
-
     for (USI j = 0; j < NP; j++) {
         const vector<OCP_DBL>& xj   = x[j];
         vector<OCP_DBL>&       phiT = phi[j];
@@ -981,29 +948,31 @@ void MixtureComp::CalFugPhiAll()
         CalAjBj(aj, bj, xj);
         SolEoS(zj, aj, bj);
 
+        CalPhiKernel(&phiT[0], &xj[0], aj, bj, zj);
         for (USI i = 0; i < NC; i++) {
-            tmp = 0;
-            for (int k = 0; k < NC; k++) {
-                tmp += 2 * (1 - BIC[i * NC + k]) * sqrt(Ai[i] * Ai[k]) * xj[k];
-            }
-            phiT[i] = exp(Bi[i] / bj * (zj - 1) - log(zj - bj) -
-                          aj / (m1Mm2) / bj * (tmp / aj - Bi[i] / bj) *
-                              log((zj + m1 * bj) / (zj + m2 * bj)));
             fugT[i] = phiT[i] * xj[i] * P;
         }
+    }
+}
 
-        // tmp01 = log(zj - bj);
-        // tmp02 = aj / (m1Mm2) / bj * log((zj + m1 * bj) / (zj + m2 * bj));
-        // for (USI i = 0; i < NC; i++) {
-        //	tmp = 0;
-        //	for (int k = 0; k < NC; k++) {
-        //		tmp += 2 * (1 - BIC[i * NC + k]) * sqrt(Ai[i] * Ai[k]) * xj[k];
-        //	}
-        //          phiT[i] =
-        //              exp(Bi[i] / bj * (zj - 1) - tmp01 - tmp02 * (tmp / aj - Bi[i] /
-        //              bj));
-        //	fugT[i] = phiT[i] * xj[i] * P;
-        //}
+void MixtureComp::CalPhiKernel(OCP_DBL* phiT, const OCP_DBL* xj, const OCP_DBL& aj,
+                               const OCP_DBL& bj, const OCP_DBL& zj) const
+{
+    // terms only depending on the phase are evaluated once
+    const OCP_DBL lzb = log(zj - bj);
+    const OCP_DBL ab  = aj / delta1M2 / bj;
+    const OCP_DBL lz  = log((zj + delta1 * bj) / (zj + delta2 * bj));
+
+    OCP_DBL tmp;
+    for (USI i = 0; i < NC; i++) {
+        const OCP_DBL* Aiktmp = &Aik[i * NC];
+        tmp                   = 0;
+        for (USI k = 0; k < NC; k++) {
+            tmp += Aiktmp[k] * xj[k];
+        }
+        tmp *= 2;
+        const OCP_DBL bib = Bi[i] / bj;
+        phiT[i]           = exp(bib * (zj - 1) - lzb - ab * (tmp / aj - bib) * lz);
     }
 }
 
@@ -1575,7 +1544,7 @@ void MixtureComp::CalFugXSTA()
     for (USI i = 0; i < NC; i++) {
         tmp = 0;
         for (USI k = 0; k < NC; k++) {
-            tmp += Y[k] * (1 - BIC[i * NC + k]) * sqrt(Ai[i] * Ai[k]);
+            tmp += Y[k] * Aik[i * NC + k];
         }
         Ax[i] = 2 * tmp;
         Zx[i] = ((bj - zj) * Ax[i] + ((aj + m1Tm2 * (3 * bj * bj + 2 * bj)) +
@@ -1599,14 +1568,14 @@ void MixtureComp::CalFugXSTA()
         E = -aj / ((m1Mm2)*bj) * (Ax[i] / aj - Bx[i] / bj);
 
         for (USI k = 0; k < NC; k++) {
-            aik = (1 - BIC[i * NC + k]) * sqrt(Ai[i] * Ai[k]);
+            aik = Aik[i * NC + k];
 
             // Cxk = -Y[i] * (Zx[k] - Bx[k]) / ((zj - bj) * (zj - bj));
             Cxk = ((zj - bj) * delta(i, k) - Y[i] * (Zx[k] - Bx[k])) * P /
                   ((zj - bj) * (zj - bj));
             Dxk = Bx[i] / bj * (Zx[k] - Bx[k] * (zj - 1) / bj);
             /*Exk = (Ax[k] * bj - aj * Bx[k]) / (bj * bj) * (Ax[i] / aj - Bx[i] / bj) +
-               aj / bj * (2 * (1 - BIC[i * NC + k]) * sqrt(Ai[i] * Ai[k]) / aj -
+               aj / bj * (2 * Aik[i * NC + k] / aj -
                 Ax[k] * Ax[i] / (aj * aj) + Bx[i] * Bx[k] / (bj * bj));*/
             Exk = (2 * (aj / bj * Bx[k] * Bx[i] + bj * aik) - Ax[i] * Bx[k] -
                    Ax[k] * Bi[i]) /
@@ -2118,7 +2087,7 @@ void MixtureComp::CalFugNAll(const bool& Znflag)
         for (USI i = 0; i < NC; i++) {
             tmp = 0;
             for (USI m = 0; m < NC; m++) {
-                tmp += (1 - BIC[i * NC + m]) * sqrt(Ai[i] * Ai[m]) * xj[m];
+                tmp += Aik[i * NC + m] * xj[m];
             }
             An[i] = 2 / nu[j] * (tmp - aj);
             Bn[i] = 1 / nu[j] * (Bi[i] - bj);
@@ -2142,14 +2111,14 @@ void MixtureComp::CalFugNAll(const bool& Znflag)
             // D = Bi[i] / bj * (zj - 1);
             tmp = 0;
             for (USI k = 0; k < NC; k++) {
-                tmp += (1 - BIC[i * NC + k]) * sqrt(Ai[i] * Ai[k]) * xj[k];
+                tmp += Aik[i * NC + k] * xj[k];
             }
             E = -aj / ((delta1 - delta2) * bj) * (2 * tmp / aj - Bi[i] / bj);
 
             for (USI k = 0; k <= i; k++) {
                 // k th components
 
-                aik = (1 - BIC[i * NC + k]) * sqrt(Ai[i] * Ai[k]);
+                aik = Aik[i * NC + k];
 
                 Cnk = P / (zj - bj) / (zj - bj) *
                       ((zj - bj) / nu[j] * (delta(i, k) - xj[i]) -
@@ -2248,7 +2217,7 @@ void MixtureComp::CalPhiNSTA()
 	for (USI i = 0; i < NC; i++) {
 		tmp = 0;
 		for (USI m = 0; m < NC; m++) {
-			tmp += (1 - BIC[i * NC + m]) * sqrt(Ai[i] * Ai[m]) * xj[m];
+			tmp += Aik[i * NC + m] * xj[m];
 		}
 		An[i] = 2 / nu[0] * (tmp - aj);
 		Bn[i] = 1 / nu[0] * (Bi[i] - bj);
@@ -2270,14 +2239,14 @@ void MixtureComp::CalPhiNSTA()
 		// D = Bi[i] / bj * (zj - 1);
 		tmp = 0;
 		for (USI k = 0; k < NC; k++) {
-			tmp += (1 - BIC[i * NC + k]) * sqrt(Ai[i] * Ai[k]) * xj[k];
+			tmp += Aik[i * NC + k] * xj[k];
 		}
 		E = -aj / ((delta1 - delta2) * bj) * (2 * tmp / aj - Bi[i] / bj);
 
 		for (USI k = 0; k <= i; k++) {
 			// k th components
 
-			aik = (1 - BIC[i * NC + k]) * sqrt(Ai[i] * Ai[k]);
+			aik = Aik[i * NC + k];
 
             Cnk = (Bn[k] - Znj[k]) / ((zj - bj) * (zj - bj));
 			Dnk = Bi[i] / bj * (Znj[k] - (Bi[k] - bj) * (zj - 1) / (nu[0] * bj));
@@ -2510,7 +2479,7 @@ void MixtureComp::CalFugXAll()
         for (USI i = 0; i < NC; i++) {
             tmp = 0;
             for (USI k = 0; k < NC; k++) {
-                tmp += xj[k] * (1 - BIC[i * NC + k]) * sqrt(Ai[i] * Ai[k]);
+                tmp += xj[k] * Aik[i * NC + k];
             }
             Ax[i] = 2 * tmp;
             Zx[i] =
@@ -2536,14 +2505,14 @@ void MixtureComp::CalFugXAll()
             E = -aj / ((delta1 - delta2) * bj) * (Ax[i] / aj - Bx[i] / bj);
 
             for (USI k = 0; k < NC; k++) {
-                aik = (1 - BIC[i * NC + k]) * sqrt(Ai[i] * Ai[k]);
+                aik = Aik[i * NC + k];
 
                 // kth components
                 Cxk = ((zj - bj) * delta(i, k) - xj[i] * (Zx[k] - Bx[k])) * P /
                       ((zj - bj) * (zj - bj));
                 Dxk = Bx[i] / bj * (Zx[k] - Bx[k] * (zj - 1) / bj);
                 /*Exk = (Ax[k] * bj - aj * Bx[k]) / (bj * bj) * (Ax[i] / aj - Bx[i] /
-                   bj) + aj / bj * (2 * (1 - BIC[i * NC + k]) * sqrt(Ai[i] * Ai[k]) / aj
+                   bj) + aj / bj * (2 * Aik[i * NC + k] / aj
                    - Ax[k] * Ax[i] / (aj * aj) + Bx[i] * Bx[k] / (bj * bj));*/
                 Exk = (2 * (aj / bj * Bx[k] * Bx[i] + bj * aik) - Ax[i] * Bx[k] -
                        Ax[k] * Bi[i]) /
@@ -2603,7 +2572,7 @@ void MixtureComp::CalFugPAll(const bool& Zpflag)
 
             tmp = 0;
             for (USI m = 0; m < NC; m++) {
-                tmp += (1 - BIC[i * NC + m]) * sqrt(Ai[i] * Ai[m]) * xj[m];
+                tmp += Aik[i * NC + m] * xj[m];
             }
 
             E = -aj / ((delta1 - delta2) * bj) * (2 * tmp / aj - Bi[i] / bj);
@@ -2650,7 +2619,7 @@ void MixtureComp::CalVjpVfpVfn_partial()
         for (USI i = 0; i < NC; i++) {
             tmp = 0;
             for (USI m = 0; m < NC; m++) {
-                tmp += (1 - BIC[i * NC + m]) * sqrt(Ai[i] * Ai[m]) * xj[m];
+                tmp += Aik[i * NC + m] * xj[m];
             }
             An[i] = 2 / nu[j] * (tmp - aj);
             Bn[i] = 1 / nu[j] * (Bi[i] - bj);
@@ -2845,7 +2814,7 @@ void MixtureComp::CalVjpVfpVfx_partial()
         for (USI i = 0; i < NC; i++) {
             tmp = 0;
             for (USI k = 0; k < NC; k++) {
-                tmp += xj[k] * (1 - BIC[i * NC + k]) * sqrt(Ai[i] * Ai[k]);
+                tmp += xj[k] * Aik[i * NC + k];
             }
             Ax[i] = 2 * tmp;
             Zx[i] =
@@ -3131,7 +3100,7 @@ void MixtureComp::CalXiPNX_partial()
         for (USI i = 0; i < NC; i++) {
             tmp = 0;
             for (USI k = 0; k < NC; k++) {
-                tmp += xj[k] * (1 - BIC[i * NC + k]) * sqrt(Ai[i] * Ai[k]);
+                tmp += xj[k] * Aik[i * NC + k];
             }
             Ax[i] = 2 * tmp;
             Zx[i] =
@@ -3310,7 +3279,7 @@ void MixtureComp::CalXiPNX_full01()
         for (USI i = 0; i < NC; i++) {
             tmp = 0;
             for (USI k = 0; k < NC; k++) {
-                tmp += xj[k] * (1 - BIC[i * NC + k]) * sqrt(Ai[i] * Ai[k]);
+                tmp += xj[k] * Aik[i * NC + k];
             }
             Ax[i] = 2 * tmp;
             Zx[i] =
@@ -3406,7 +3375,7 @@ void MixtureComp::CalXiPNX_full02()
         for (USI i = 0; i < NC; i++) {
             tmp = 0;
             for (USI k = 0; k < NC; k++) {
-                tmp += xj[k] * (1 - BIC[i * NC + k]) * sqrt(Ai[i] * Ai[k]);
+                tmp += xj[k] * Aik[i * NC + k];
             }
             Ax[i] = 2 * tmp;
             Zx[i] =
@@ -3882,7 +3851,7 @@ void MixtureComp::CalVfiVfp_full01()
         for (USI i = 0; i < NC; i++) {
             tmp = 0;
             for (USI m = 0; m < NC; m++) {
-                tmp += (1 - BIC[i * NC + m]) * sqrt(Ai[i] * Ai[m]) * xj[m];
+                tmp += Aik[i * NC + m] * xj[m];
             }
             An[i] = 2 / nu[0] * (tmp - aj);
             Bn[i] = 1 / nu[0] * (Bi[i] - bj);
@@ -4023,7 +3992,7 @@ void MixtureComp::CalVfiVfp_full02()
         for (USI i = 0; i < NC; i++) {
             tmp = 0;
             for (USI m = 0; m < NC; m++) {
-                tmp += (1 - BIC[i * NC + m]) * sqrt(Ai[i] * Ai[m]) * xj[m];
+                tmp += Aik[i * NC + m] * xj[m];
             }
             An[i] = 2 / nu[0] * (tmp - aj);
             Bn[i] = 1 / nu[0] * (Bi[i] - bj);
@@ -5211,4 +5180,5 @@ void NTcubicroot(OCP_DBL& root, const OCP_DBL& a, const OCP_DBL& b, const OCP_DB
 /*  Author              Date             Actions                              */
 /*----------------------------------------------------------------------------*/
 /*  Shizhe Li           Jan/05/2022      Create file                          */
+/*  OpenCAEPoro team    Oct/16/2026      Batched flash over bulk lists        */
 /*----------------------------------------------------------------------------*/
\ No newline at end of file
@@ -0,0 +1,561 @@
+/*! \file    NativeSolver.cpp
+ *  \brief   Built-in vector linear solver in BSR format with OpenMP
+ *  \author  OpenCAEPoro team
+ *  \date    Oct/17/2026
+ *
+ *-----------------------------------------------------------------------------------
+ *  Copyright (C) 2021--present by the OpenCAEPoro team. All rights reserved.
+ *  Released under the terms of the GNU Lesser General Public License 3.0 or later.
+ *-----------------------------------------------------------------------------------
+ */
+
+// Standard header files
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+
+// OpenCAEPoro header files
+#include "DenseMat.hpp"
+#include "NativeSolver.hpp"
+#include "UtilError.hpp"
+#include "UtilProfiler.hpp"
+
+/// Read "key = value" lines of a FASP file, text after % is a comment.
+static bool ReadParamFile(const string& file, map<string, string>& param)
+{
+    ifstream ifs(file);
+    if (!ifs.is_open()) return false;
+    string line;
+    while (getline(ifs, line)) {
+        istringstream iss(line.substr(0, line.find('%')));
+        string        key, eq, value;
+        if (iss >> key >> eq >> value && eq == "=") param[key] = value;
+    }
+    return true;
+}
+
+/// Return true for preconditioners which need FASP4BLKOIL.
+static bool NeedFasp4BlkOil(const OCP_INT& precondType)
+{
+    return (precondType >= 61 && precondType <= 65) || precondType == 71 ||
+           precondType == 74;
+}
+
+/// Inverse of a small row-major matrix by Gauss-Jordan, return false if singular.
+static bool BlockInverse(const USI& n, OCP_DBL* A, OCP_DBL* inv)
+{
+    fill(inv, inv + n * n, 0.0);
+    for (USI i = 0; i < n; i++) inv[i * n + i] = 1;
+    for (USI c = 0; c < n; c++) {
+        USI p = c;
+        for (USI r = c + 1; r < n; r++) {
+            if (fabs(A[r * n + c]) > fabs(A[p * n + c])) p = r;
+        }
+        if (A[p * n + c] == 0) return false;
+        if (p != c) {
+            swap_ranges(A + p * n, A + p * n + n, A + c * n);
+            swap_ranges(inv + p * n, inv + p * n + n, inv + c * n);
+        }
+        const OCP_DBL d = 1 / A[c * n + c];
+        for (USI j = 0; j < n; j++) {
+            A[c * n + j] *= d;
+            inv[c * n + j] *= d;
+        }
+        for (USI r = 0; r < n; r++) {
+            const OCP_DBL f = A[r * n + c];
+            if (r == c || f == 0) continue;
+            for (USI j = 0; j < n; j++) {
+                A[r * n + j] -= f * A[c * n + j];
+                inv[r * n + j] -= f * inv[c * n + j];
+            }
+        }
+    }
+    return true;
+}
+
+/// Return the inner product of x and y.
+static OCP_DBL Dot(const OCP_USI& n, const OCP_DBL* x, const OCP_DBL* y)
+{
+    OCP_DBL s = 0;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) reduction(+ : s)
+#endif
+    for (OCP_USI i = 0; i < n; i++) s += x[i] * y[i];
+    return s;
+}
+
+/// y = a * x + y.
+static void Axpy(const OCP_USI& n, const OCP_DBL& a, const OCP_DBL* x, OCP_DBL* y)
+{
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for (OCP_USI i = 0; i < n; i++) y[i] += a * x[i];
+}
+
+/// Put rows into levels, where start[l] is the first row of level l in rows.
+static void SortLevels(const vector<OCP_USI>& level, vector<OCP_USI>& start,
+                       vector<OCP_USI>& rows)
+{
+    const OCP_USI numLevel =
+        level.empty() ? 0 : *max_element(level.begin(), level.end()) + 1;
+    start.assign(numLevel + 1, 0);
+    for (const auto& l : level) start[l + 1]++;
+    for (OCP_USI l = 0; l < numLevel; l++) start[l + 1] += start[l];
+    vector<OCP_USI> pos(start.begin(), start.end() - 1);
+    rows.resize(level.size());
+    for (OCP_USI i = 0; i < level.size(); i++) rows[pos[level[i]]++] = i;
+}
+
+bool VectorNativeSolver::IsChosen(const string& dir, const string& file)
+{
+    map<string, string> param;
+    if (!ReadParamFile(dir + file, param) || param.count("precond_type") == 0)
+        return false;
+
+    const OCP_INT precondType = stoi(param["precond_type"]);
+    if (precondType == PC_OCP_BILU || precondType == PC_OCP_BJAC) return true;
+#if !WITH_FASP4BLKOIL
+    // Direct solvers of FASP are kept
+    const OCP_INT solverType =
+        param.count("solver_type") > 0 ? stoi(param["solver_type"]) : 6;
+    if (solverType >= 1 && solverType <= 10 && NeedFasp4BlkOil(precondType))
+        return true;
+#endif
+    return false;
+}
+
+void VectorNativeSolver::SetupParam(const string& dir, const string& file)
+{
+    InitParam();
+    map<string, string> param;
+    if (!ReadParamFile(dir + file, param)) {
+        cout << "The input file " << dir + file << " is missing!" << endl;
+        cout << "Using the default parameters of the built-in solver" << endl;
+        return;
+    }
+    if (param.count("print_level")) printLevel = stoi(param["print_level"]);
+    if (param.count("solver_type")) solverType = stoi(param["solver_type"]);
+    if (param.count("precond_type")) precondType = stoi(param["precond_type"]);
+    if (param.count("itsolver_tol")) tol = stod(param["itsolver_tol"]);
+    if (param.count("itsolver_maxit")) maxit = stoi(param["itsolver_maxit"]);
+    if (param.count("itsolver_restart"))
+        restart = max(stoi(param["itsolver_restart"]), 1);
+
+    if (NeedFasp4BlkOil(precondType)) {
+        // Printed at every print level: the run does not use the preconditioner asked for
+        cout << "\n### WARNING: Preconditioner type " << precondType << " in " << file
+             << " needs FASP4BLKOIL, which is not linked!\n"
+             << "### WARNING: Using block ILU0 (precond_type = " << PC_OCP_BILU
+             << ") of the built-in solver instead!\n"
+             << endl;
+        precondType = PC_OCP_BILU;
+    } else if (precondType != PC_OCP_BILU && precondType != PC_OCP_BJAC) {
+        OCP_ABORT("Preconditioner type " + to_string(precondType) +
+                  " not supported by the built-in solver!");
+    }
+}
+
+void VectorNativeSolver::InitParam()
+{
+    // The same defaults as VectorFaspSolver
+    printLevel  = 1;
+    solverType  = 6;
+    precondType = PC_OCP_BILU;
+    tol         = 1e-3;
+    maxit       = 100;
+    restart     = 30;
+}
+
+void VectorNativeSolver::Allocate(const vector<USI>& rowCapacity, const OCP_USI& maxDim,
+                                  const USI& blockDim)
+{
+    // BiCGStab needs 7 vectors, GMRES needs restart + 1 and restart preconditioned ones
+    const OCP_USI n = maxDim * blockDim;
+    V.assign(max<USI>(restart + 1, 7), vector<OCP_DBL>(n));
+    Z.assign(solverType == 2 ? 0 : restart, vector<OCP_DBL>(n));
+    diagInv.reserve(maxDim * blockDim * blockDim);
+}
+
+void VectorNativeSolver::AssembleMat(OCP_USI* myIA, OCP_USI* myJA, OCP_DBL* myVal,
+                                     const OCP_USI& myDim, const USI& blockDim,
+                                     vector<OCP_DBL>& myRhs, vector<OCP_DBL>& u)
+{
+    IA  = myIA;
+    JA  = myJA;
+    val = myVal;
+    rhs = &myRhs;
+    sol = &u;
+
+    // The pattern changes only with wells, so it's mostly kept
+    const bool samePattern =
+        myDim == dim && blockDim == nb && patIA.size() == myDim + 1 &&
+        equal(patIA.begin(), patIA.end(), IA) && patJA.size() == IA[myDim] &&
+        equal(patJA.begin(), patJA.end(), JA);
+    dim = myDim;
+    nb  = blockDim;
+    nb2 = nb * nb;
+    if (!samePattern) {
+        patIA.assign(IA, IA + dim + 1);
+        patJA.assign(JA, JA + IA[dim]);
+        SetupPattern();
+        precondReady = false;
+    }
+}
+
+void VectorNativeSolver::SetupPattern()
+{
+    // Columns of each row are sorted for ILU0
+    const OCP_USI nnz = IA[dim];
+    luCol.resize(nnz);
+    luPos.resize(nnz);
+    luDiag.assign(dim, nnz);
+    for (OCP_USI i = 0; i < dim; i++) {
+        for (OCP_USI k = IA[i]; k < IA[i + 1]; k++) luPos[k] = k;
+        sort(luPos.begin() + IA[i], luPos.begin() + IA[i + 1],
+             [this](const OCP_USI& a, const OCP_USI& b) { return JA[a] < JA[b]; });
+        for (OCP_USI k = IA[i]; k < IA[i + 1]; k++) {
+            luCol[k] = JA[luPos[k]];
+            if (luCol[k] == i) luDiag[i] = k;
+        }
+        if (luDiag[i] == nnz) OCP_ABORT("No diagonal block in row " + to_string(i));
+    }
+
+    // A row of the lower part waits for rows in its lower columns, and a row of the
+    // upper part waits for rows in its upper columns
+    vector<OCP_USI> level(dim);
+    for (OCP_USI i = 0; i < dim; i++) {
+        level[i] = 0;
+        for (OCP_USI k = IA[i]; k < luDiag[i]; k++)
+            level[i] = max(level[i], level[luCol[k]] + 1);
+    }
+    SortLevels(level, lowerStart, lowerRows);
+    for (OCP_USI i = dim; i-- > 0;) {
+        level[i] = 0;
+        for (OCP_USI k = luDiag[i] + 1; k < IA[i + 1]; k++)
+            level[i] = max(level[i], level[luCol[k]] + 1);
+    }
+    SortLevels(level, upperStart, upperRows);
+}
+
+bool VectorNativeSolver::SetupPrecond()
+{
+    OCP_PROFILE("NativeSetup");
+
+    const OCP_USI nnz = IA[dim];
+    diagInv.resize(dim * nb2);
+    bool singular = false;
+
+    if (precondType == PC_OCP_BJAC) {
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+        {
+            vector<OCP_DBL> tmp(nb2);
+#ifdef _OPENMP
+#pragma omp for schedule(static) reduction(|| : singular)
+#endif
+            for (OCP_USI i = 0; i < dim; i++) {
+                const OCP_DBL* d = val + luPos[luDiag[i]] * nb2;
+                copy(d, d + nb2, tmp.data());
+                if (!BlockInverse(nb, tmp.data(), &diagInv[i * nb2])) singular = true;
+            }
+        }
+        return !singular;
+    }
+
+    // Block ILU0 by rows, rows of one level are factorized at the same time
+    luVal.resize(nnz * nb2);
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+    {
+#ifdef _OPENMP
+#pragma omp for schedule(static)
+#endif
+        for (OCP_USI k = 0; k < nnz; k++) {
+            copy(val + luPos[k] * nb2, val + luPos[k] * nb2 + nb2, &luVal[k * nb2]);
+        }
+
+        vector<OCP_DBL> tmp(nb2);
+        for (OCP_USI l = 0; l + 1 < lowerStart.size(); l++) {
+#ifdef _OPENMP
+#pragma omp for schedule(static) reduction(|| : singular)
+#endif
+            for (OCP_USI t = lowerStart[l]; t < lowerStart[l + 1]; t++) {
+                const OCP_USI i = lowerRows[t];
+                for (OCP_USI k = IA[i]; k < luDiag[i]; k++) {
+                    // L_ic = A_ic * U_cc^{-1}, then row i -= L_ic * (upper part of row c)
+                    const OCP_USI c   = luCol[k];
+                    OCP_DBL*      Lic = &luVal[k * nb2];
+                    copy(Lic, Lic + nb2, tmp.data());
+                    DaABpbC(nb, nb, nb, 1.0, tmp.data(), &diagInv[c * nb2], 0.0, Lic);
+                    OCP_USI p = k + 1;
+                    for (OCP_USI q = luDiag[c] + 1; q < IA[c + 1]; q++) {
+                        while (p < IA[i + 1] && luCol[p] < luCol[q]) p++;
+                        if (p == IA[i + 1]) break;
+                        if (luCol[p] == luCol[q]) {
+                            DaABpbC(nb, nb, nb, -1.0, Lic, &luVal[q * nb2], 1.0,
+                                    &luVal[p * nb2]);
+                        }
+                    }
+                }
+                copy(&luVal[luDiag[i] * nb2], &luVal[luDiag[i] * nb2] + nb2, tmp.data());
+                if (!BlockInverse(nb, tmp.data(), &diagInv[i * nb2])) singular = true;
+            }
+        }
+    }
+    return !singular;
+}
+
+void VectorNativeSolver::Precond(const OCP_DBL* r, OCP_DBL* z) const
+{
+    if (precondType == PC_OCP_BJAC) {
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+        for (OCP_USI i = 0; i < dim; i++) {
+            DaAxpby(nb, nb, 1.0, &diagInv[i * nb2], r + i * nb, 0.0, z + i * nb);
+        }
+        return;
+    }
+
+    // Solve L and U by levels in place
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+    {
+        vector<OCP_DBL> tmp(nb);
+        for (OCP_USI l = 0; l + 1 < lowerStart.size(); l++) {
+#ifdef _OPENMP
+#pragma omp for schedule(static)
+#endif
+            for (OCP_USI t = lowerStart[l]; t < lowerStart[l + 1]; t++) {
+                const OCP_USI i  = lowerRows[t];
+                OCP_DBL*      zi = z + i * nb;
+                copy(r + i * nb, r + i * nb + nb, zi);
+                for (OCP_USI k = IA[i]; k < luDiag[i]; k++) {
+                    DaAxpby(nb, nb, -1.0, &luVal[k * nb2], z + luCol[k] * nb, 1.0, zi);
+                }
+            }
+        }
+        for (OCP_USI l = 0; l + 1 < upperStart.size(); l++) {
+#ifdef _OPENMP
+#pragma omp for schedule(static)
+#endif
+            for (OCP_USI t = upperStart[l]; t < upperStart[l + 1]; t++) {
+                const OCP_USI i  = upperRows[t];
+                OCP_DBL*      zi = z + i * nb;
+                copy(zi, zi + nb, tmp.data());
+                for (OCP_USI k = luDiag[i] + 1; k < IA[i + 1]; k++) {
+                    DaAxpby(nb, nb, -1.0, &luVal[k * nb2], z + luCol[k] * nb, 1.0,
+                            tmp.data());
+                }
+                DaAxpby(nb, nb, 1.0, &diagInv[i * nb2], tmp.data(), 0.0, zi);
+            }
+        }
+    }
+}
+
+void VectorNativeSolver::MatVec(const OCP_DBL* x, OCP_DBL* y) const
+{
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for (OCP_USI i = 0; i < dim; i++) {
+        OCP_DBL* yi = y + i * nb;
+        fill(yi, yi + nb, 0.0);
+        for (OCP_USI k = IA[i]; k < IA[i + 1]; k++) {
+            DaAxpby(nb, nb, 1.0, val + k * nb2, x + JA[k] * nb, 1.0, yi);
+        }
+    }
+}
+
+OCP_INT VectorNativeSolver::Solve()
+{
+    OCP_PROFILE("NativeSolve");
+
+    const OCP_USI n = dim * nb;
+    fill(sol->begin(), sol->begin() + n, 0.0);
+
+    if (!reusePrecond || !precondReady) precondReady = SetupPrecond();
+    if (!precondReady) {
+        if (printLevel > 1) cout << "\n### WARNING: Singular preconditioner!\n" << endl;
+        numIters = maxit;
+        return -1;
+    }
+
+    const OCP_INT status = solverType == 2 ? BiCGStab() : GMRES();
+
+    // Print levels are those of FASP, where 1 is the minimum
+    if (printLevel > 1) {
+        if (status < 0) {
+            cout << "\n### WARNING: Solver does not converge!\n" << endl;
+        } else {
+            cout << "\nSolver converges successfully!\n" << endl;
+        }
+    }
+    return status;
+}
+
+OCP_INT VectorNativeSolver::GMRES()
+{
+    const OCP_USI   n = dim * nb;
+    const USI       m = restart;
+    vector<OCP_DBL> H((m + 1) * m), cs(m), sn(m), g(m + 1), y(m);
+    auto Hij = [&H, m](const USI& i, const USI& j) -> OCP_DBL& { return H[i * m + j]; };
+
+    OCP_DBL*       x = sol->data();
+    const OCP_DBL* b = rhs->data();
+
+    const OCP_DBL normb     = sqrt(Dot(n, b, b));
+    bool          converged = normb == 0;
+    bool          breakdown = false;
+    numIters                = 0;
+
+    while (!converged && !breakdown && numIters < maxit) {
+        // r = b - A * x is kept in V[0]
+        OCP_DBL* r = V[0].data();
+        if (numIters > 0) {
+            MatVec(x, r);
+            for (OCP_USI i = 0; i < n; i++) r[i] = b[i] - r[i];
+        } else {
+            copy(b, b + n, r);
+        }
+        const OCP_DBL beta = sqrt(Dot(n, r, r));
+        if (beta <= tol * normb) {
+            converged = true;
+            break;
+        }
+        for (OCP_USI i = 0; i < n; i++) r[i] /= beta;
+        fill(g.begin(), g.end(), 0.0);
+        g[0] = beta;
+
+        USI k = 0;
+        while (k < m && numIters < maxit) {
+            OCP_DBL* w = V[k + 1].data();
+            Precond(V[k].data(), Z[k].data());
+            MatVec(Z[k].data(), w);
+
+            // Classical Gram-Schmidt twice
+            for (USI j = 0; j <= k; j++) Hij(j, k) = 0;
+            for (USI pass = 0; pass < 2; pass++) {
+                for (USI j = 0; j <= k; j++) {
+                    const OCP_DBL h = Dot(n, w, V[j].data());
+                    Hij(j, k) += h;
+                    Axpy(n, -h, V[j].data(), w);
+                }
+            }
+            Hij(k + 1, k) = sqrt(Dot(n, w, w));
+            if (Hij(k + 1, k) > 0) {
+                const OCP_DBL s = 1 / Hij(k + 1, k);
+                for (OCP_USI i = 0; i < n; i++) w[i] *= s;
+            }
+
+            // Givens rotations keep H upper triangular
+            for (USI j = 0; j < k; j++) {
+                const OCP_DBL t = cs[j] * Hij(j, k) + sn[j] * Hij(j + 1, k);
+                Hij(j + 1, k)   = -sn[j] * Hij(j, k) + cs[j] * Hij(j + 1, k);
+                Hij(j, k)       = t;
+            }
+            const OCP_DBL d = sqrt(Hij(k, k) * Hij(k, k) + Hij(k + 1, k) * Hij(k + 1, k));
+            numIters++;
+            if (d == 0) {
+                breakdown = true;
+                break;
+            }
+            cs[k]         = Hij(k, k) / d;
+            sn[k]         = Hij(k + 1, k) / d;
+            Hij(k, k)     = d;
+            Hij(k + 1, k) = 0;
+            g[k + 1]      = -sn[k] * g[k];
+            g[k]          = cs[k] * g[k];
+            k++;
+            if (fabs(g[k]) <= tol * normb) {
+                converged = true;
+                break;
+            }
+        }
+
+        // x = x + Z * y, where H * y = g
+        for (USI i = k; i-- > 0;) {
+            y[i] = g[i];
+            for (USI j = i + 1; j < k; j++) y[i] -= Hij(i, j) * y[j];
+            y[i] /= Hij(i, i);
+        }
+        for (USI j = 0; j < k; j++) Axpy(n, y[j], Z[j].data(), x);
+    }
+
+    // A negative status tells the caller to take maxit as the num of iterations
+    return converged ? numIters : -1;
+}
+
+OCP_INT VectorNativeSolver::BiCGStab()
+{
+    const OCP_USI n  = dim * nb;
+    OCP_DBL*      x  = sol->data();
+    OCP_DBL*      r  = V[0].data();
+    OCP_DBL*      r0 = V[1].data();
+    OCP_DBL*      p  = V[2].data();
+    OCP_DBL*      v  = V[3].data();
+    OCP_DBL*      ph = V[4].data();
+    OCP_DBL*      sh = V[5].data();
+    OCP_DBL*      t  = V[6].data();
+
+    copy(rhs->begin(), rhs->begin() + n, r);
+    copy(r, r + n, r0);
+    fill(p, p + n, 0.0);
+    fill(v, v + n, 0.0);
+
+    const OCP_DBL normb     = sqrt(Dot(n, r, r));
+    bool          converged = normb == 0;
+    OCP_DBL       rho = 1, alpha = 1, omega = 1;
+    numIters = 0;
+
+    while (!converged && numIters < maxit) {
+        const OCP_DBL rho1 = Dot(n, r0, r);
+        if (rho1 == 0 || omega == 0) break;
+        const OCP_DBL beta = rho1 / rho * alpha / omega;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+        for (OCP_USI i = 0; i < n; i++) p[i] = r[i] + beta * (p[i] - omega * v[i]);
+
+        Precond(p, ph);
+        MatVec(ph, v);
+        const OCP_DBL r0v = Dot(n, r0, v);
+        if (r0v == 0) break;
+        alpha = rho1 / r0v;
+        // s = r - alpha * v is kept in r
+        Axpy(n, -alpha, v, r);
+        Axpy(n, alpha, ph, x);
+        numIters++;
+        if (sqrt(Dot(n, r, r)) <= tol * normb) {
+            converged = true;
+            break;
+        }
+
+        Precond(r, sh);
+        MatVec(sh, t);
+        const OCP_DBL tt = Dot(n, t, t);
+        omega            = tt > 0 ? Dot(n, t, r) / tt : 0;
+        Axpy(n, omega, sh, x);
+        Axpy(n, -omega, t, r);
+        rho       = rho1;
+        converged = sqrt(Dot(n, r, r)) <= tol * normb;
+    }
+
+    return converged ? numIters : -1;
+}
+
+/*----------------------------------------------------------------------------*/
+/*  Brief Change History of This File                                         */
+/*----------------------------------------------------------------------------*/
+/*  Author              Date             Actions                              */
+/*----------------------------------------------------------------------------*/
+/*  OpenCAEPoro team    Oct/17/2026      Create file                          */
+/*  OpenCAEPoro team    Oct/17/2026      Warn of the fallback at any level    */
+/*----------------------------------------------------------------------------*/
@@ -11,6 +11,27 @@
 
 #include "OCP.hpp"
 
+/// Switch on the stage profiler before anything is timed.
+void OpenCAEPoro::SetupProfiler(const USI& argc, const char* options[]) const
+{
+    FastControl fast;
+    fast.ReadParam(argc, options);
+    StageProfiler::Get().Setup(fast.profile);
+}
+
+/// Read the input file, or its preprocessed image if the deck cache is up to date.
+void OpenCAEPoro::ReadInputFile(ParamRead& param, const USI& argc, const char* options[])
+{
+    FastControl fast;
+    fast.ReadParam(argc, options);
+    deckCache.Setup(options[1], fast.cache);
+
+    if (!deckCache.LoadParam(param)) {
+        param.ReadInputFile(options[1]);
+        deckCache.SaveParam(param);
+    }
+}
+
 /// Read from input file and set control and output params.
 void OpenCAEPoro::InputParam(ParamRead& param)
 {
@@ -24,6 +45,8 @@ void OpenCAEPoro::SetupSimulator(ParamRead&  param,
                                  const USI&  argc,
                                  const char* options[])
 {
+    OCP_PROFILE("Setup");
+
     GetWallTime timer;
     timer.Start();
 
@@ -32,9 +55,12 @@ void OpenCAEPoro::SetupSimulator(ParamRead&  param,
     // Read Fast control
     control.SetupFastControl(argc, options);
     // Setup static infomation for reservoir
-    reservoir.Setup();
+    reservoir.Setup(deckCache, control.GetBulkOrder());
     // Setup output for dynamic simulation
-    output.Setup(reservoir, control);
+    {
+        OCP_PROFILE("SetupOutput");
+        output.Setup(reservoir, control);
+    }
     // Setup static information for solver
     solver.Setup(reservoir, control);
 
@@ -52,6 +78,8 @@ void OpenCAEPoro::InitReservoir()
     timer.Start();
 
     solver.InitReservoir(reservoir);
+    // Overwrite the initial state with a checkpoint
+    if (!control.GetRestartFile().empty()) solver.Restart(reservoir, control, output);
 
     cout << endl
          << "Initialization done. Wall time : " << fixed << setprecision(3)
@@ -103,7 +131,17 @@ void OpenCAEPoro::OutputResults() const
     cout << "Linear solve time:   " << control.totalLStime << "s"
          << " (" << 100.0 * control.totalLStime / control.totalSimTime << "%)" << endl;
     cout << "Simulation time:     " << control.totalSimTime << "s" << endl;
-    output.PrintInfo();
+    solver.PrintLinearInfo(cout);
+    {
+        OCP_PROFILE("Output");
+        output.PrintInfo();
+        output.Wait();
+    }
+
+    if (StageProfiler::Get().IsOn()) {
+        StageProfiler::Get().PrintInfo(cout);
+        StageProfiler::Get().OutputInfo(control.workDir);
+    }
 }
 
 /*----------------------------------------------------------------------------*/
@@ -113,4 +151,8 @@ void OpenCAEPoro::OutputResults() const
 /*----------------------------------------------------------------------------*/
 /*  Shizhe Li           Oct/01/2021      Create file                          */
 /*  Chensong Zhang      Dec/05/2021      Format file                          */
+/*  OpenCAEPoro team    Oct/16/2026      Add stage profiler                   */
+/*  OpenCAEPoro team    Oct/16/2026      Add deck cache                       */
+/*  OpenCAEPoro team    Oct/16/2026      Wait for async output                */
+/*  OpenCAEPoro team    Oct/17/2026      Print reuse of preconditioners       */
 /*----------------------------------------------------------------------------*/
\ No newline at end of file
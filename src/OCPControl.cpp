@@ -107,6 +107,82 @@ void FastControl::ReadParam(const USI& argc, const char* optset[])
                 printLevel = stoi(value);
                 break;
 
+            case Map_Str2Int("ckpt", 4):
+                ckpt = stoi(value);
+                break;
+
+            case Map_Str2Int("restart", 7):
+                restart = value;
+                break;
+
+            case Map_Str2Int("cache", 5):
+                if (value == "on") {
+                    cache = true;
+                } else if (value == "off") {
+                    cache = false;
+                } else {
+                    OCP_ABORT("Wrong cache param in command line!");
+                }
+                break;
+
+            case Map_Str2Int("rpt", 3):
+                if (value == "text") {
+                    rptBin = false;
+                } else if (value == "bin") {
+                    rptBin = true;
+                } else {
+                    OCP_ABORT("Wrong rpt param in command line!");
+                }
+                break;
+
+            case Map_Str2Int("async", 5):
+                if (value == "on") {
+                    asyncOut = true;
+                } else if (value == "off") {
+                    asyncOut = false;
+                } else {
+                    OCP_ABORT("Wrong async param in command line!");
+                }
+                break;
+
+            case Map_Str2Int("order", 5):
+                if (value == "natural") {
+                    bulkOrder = BULK_NATURAL;
+                } else if (value == "rcm") {
+                    bulkOrder = BULK_RCM;
+                } else if (value == "metis") {
+                    bulkOrder = BULK_METIS;
+                } else {
+                    OCP_ABORT("Wrong order param in command line!");
+                }
+                break;
+
+            case Map_Str2Int("reuse", 5):
+                if (value == "on") {
+                    precondReuse = true;
+                } else if (value == "off") {
+                    precondReuse = false;
+                } else {
+                    OCP_ABORT("Wrong reuse param in command line!");
+                }
+                break;
+
+            case Map_Str2Int("ls", 2):
+                lsFile = value;
+                break;
+
+            case Map_Str2Int("prof", 4):
+                if (value == "off") {
+                    profile = PROFILE_OFF;
+                } else if (value == "on") {
+                    profile = PROFILE_ON;
+                } else if (value == "trace") {
+                    profile = PROFILE_TRACE;
+                } else {
+                    OCP_ABORT("Wrong prof param in command line!");
+                }
+                break;
+
             default:
                 OCP_ABORT("Unknown Options: " + key + "   See -h");
                 break;
@@ -203,10 +279,9 @@ void OCPControl::InitTime(const USI& i)
     OCP_DBL dt = criticalTime[i + 1] - current_time;
     if (dt <= 0) OCP_ABORT("Non-positive time stepsize!");
 
-    static bool firstflag = true;
-    if (wellChange || firstflag) {
+    if (wellChange || firstInit) {
         current_dt = min(dt, ctrlTime.timeInit);
-        firstflag = false;
+        firstInit  = false;
     }
     else {
         current_dt = min(dt, init_dt);
@@ -234,6 +309,7 @@ void OCPControl::SetupFastControl(const USI& argc, const char* optset[])
                 OCP_ABORT("Wrong method in command line!");
                 break;
         }
+        if (!ctrlFast.lsFile.empty()) linearsolveFile = "./" + ctrlFast.lsFile;
         USI n = ctrlTimeSet.size();
         for (USI i = 0; i < n; i++) {
             ctrlTimeSet[i].timeInit = ctrlFast.timeInit;
@@ -242,6 +318,28 @@ void OCPControl::SetupFastControl(const USI& argc, const char* optset[])
         }
         printLevel = ctrlFast.printLevel;
     }
+    // Checkpoint options take effect without method
+    ckptInterval = ctrlFast.ckpt;
+    restartFile  = ctrlFast.restart;
+}
+
+void OCPControl::SyncCheckpoint(OCPCheckpoint& ckpt)
+{
+    ckpt.Check(method, "solution method");
+    ckpt.Sync(current_dt);
+    ckpt.Sync(last_dt);
+    ckpt.Sync(current_time);
+    ckpt.Sync(end_time);
+    // totalSimTime and totalLStime are wall times of this process, which are not kept
+    ckpt.Sync(init_dt);
+    ckpt.Sync(firstInit);
+    ckpt.Sync(numTstep);
+    ckpt.Sync(iterLS);
+    ckpt.Sync(iterLS_total);
+    ckpt.Sync(iterNR);
+    ckpt.Sync(iterNR_total);
+    ckpt.Sync(wastedIterNR);
+    ckpt.Sync(wastedIterLS);
 }
 
 void OCPControl::CalNextTstepIMPEC(const Reservoir& reservoir)
@@ -228,6 +228,7 @@ void OCP_FIM::Setup(Reservoir& rs, LinearSystem& myLS, const OCPControl& ctrl)
     resFIM.res.resize(num);
 
     myLS.SetupLinearSolver(VECTORFASP, ctrl.GetWorkDir(), ctrl.GetLsFile());
+    myLS.SetupPrecondReuse(ctrl.GetPrecondReuse());
 }
 
 void OCP_FIM::InitReservoir(Reservoir& rs) const
@@ -560,6 +561,7 @@ void OCP_AIMc::Setup(Reservoir& rs, LinearSystem& myLS, const OCPControl& ctrl)
     resFIM.res.resize(num);
 
     myLS.SetupLinearSolver(VECTORFASP, ctrl.GetWorkDir(), ctrl.GetLsFile());
+    myLS.SetupPrecondReuse(ctrl.GetPrecondReuse());
 
 }
 
@@ -750,6 +752,7 @@ void OCP_AIMs::Setup(Reservoir& rs, LinearSystem& myLS, const OCPControl& ctrl)
     resFIM.res.resize(num);
 
     myLS.SetupLinearSolver(VECTORFASP, ctrl.GetWorkDir(), ctrl.GetLsFile());
+    myLS.SetupPrecondReuse(ctrl.GetPrecondReuse());
 }
 
 void OCP_AIMs::Prepare(Reservoir& rs, OCP_DBL& dt)
@@ -981,6 +984,7 @@ void OCP_AIMt::Setup(Reservoir& rs, LinearSystem& myLS, LinearSystem& myAuxLS, c
 
     myLS.SetupLinearSolver(SCALARFASP, ctrl.GetWorkDir(), ctrl.GetLsFile());
     myAuxLS.SetupLinearSolver(VECTORFASP, ctrl.GetWorkDir(), "./bsr.fasp");
+    myAuxLS.SetupPrecondReuse(ctrl.GetPrecondReuse());
 }
 
 void OCP_AIMt::Prepare(Reservoir& rs, OCP_DBL& dt)
@@ -9,6 +9,11 @@
  *-----------------------------------------------------------------------------------
  */
 
+// Standard header files
+#include <cmath>
+#include <sstream>
+
+// OpenCAEPoro header files
 #include "OCPOutput.hpp"
 
 void Summary::InputParam(const OutputSummary &summary_param)
@@ -47,7 +52,7 @@ void Summary::InputParam(const OutputSummary &summary_param)
     // cout << "Summary::InputParam" << endl;
 }
 
-void Summary::Setup(const Reservoir &reservoir, const OCP_DBL &totalTime)
+void Summary::Setup(const string &dir, const Reservoir &reservoir, const bool &restart)
 {
     Sumdata.push_back(SumPair("TIME", "  ", "DAY"));
     Sumdata.push_back(SumPair("NRiter", "  ", "  "));
@@ -440,13 +445,11 @@ void Summary::Setup(const Reservoir &reservoir, const OCP_DBL &totalTime)
         }
     }
 
-    // Allocate memory
-    USI rs = totalTime / 0.1;
-    USI cs = Sumdata.size();
-    for (USI i = 0; i < cs; i++)
-    {
-        Sumdata[i].val.reserve(rs);
-    }
+    row.resize(Sumdata.size());
+    sumName = dir + "SUMMARY.bin";
+    // A restart keeps the steps before its checkpoint, see SyncCheckpoint
+    if (!restart)
+        sumFile.Create(sumName, Sumdata);
 
     // cout << "Summary::Setup" << endl;
 }
@@ -456,91 +459,91 @@ void Summary::SetVal(const Reservoir &rs, const OCPControl &ctrl)
     USI n = 0;
 
     // TIME
-    Sumdata[n++].val.push_back(ctrl.GetCurTime());
+    row[n++] = ctrl.GetCurTime();
     // NRiter
-    Sumdata[n++].val.push_back(ctrl.GetNRiterT());
+    row[n++] = ctrl.GetNRiterT();
     // LSiter
-    Sumdata[n++].val.push_back(ctrl.GetLSiterT());
+    row[n++] = ctrl.GetLSiterT();
 
     // FPR
     if (FPR)
-        Sumdata[n++].val.push_back(rs.bulk.CalFPR());
+        row[n++] = rs.bulk.CalFPR();
     if (FOPR)
-        Sumdata[n++].val.push_back(rs.allWells.GetFOPR());
+        row[n++] = rs.allWells.GetFOPR();
     if (FOPT)
-        Sumdata[n++].val.push_back(rs.allWells.GetFOPT());
+        row[n++] = rs.allWells.GetFOPT();
     if (FGPR)
-        Sumdata[n++].val.push_back(rs.allWells.GetFGPR());
+        row[n++] = rs.allWells.GetFGPR();
     if (FGPt)
-        Sumdata[n++].val.push_back(rs.allWells.GetFGPT());
+        row[n++] = rs.allWells.GetFGPT();
     if (FWPR)
-        Sumdata[n++].val.push_back(rs.allWells.GetFWPR());
+        row[n++] = rs.allWells.GetFWPR();
     if (FWPT)
-        Sumdata[n++].val.push_back(rs.allWells.GetFWPT());
+        row[n++] = rs.allWells.GetFWPT();
     if (FGIR)
-        Sumdata[n++].val.push_back(rs.allWells.GetFGIR());
+        row[n++] = rs.allWells.GetFGIR();
     if (FGIT)
-        Sumdata[n++].val.push_back(rs.allWells.GetFGIT());
+        row[n++] = rs.allWells.GetFGIT();
     if (FWIR)
-        Sumdata[n++].val.push_back(rs.allWells.GetFWIR());
+        row[n++] = rs.allWells.GetFWIR();
     if (FWIT)
-        Sumdata[n++].val.push_back(rs.allWells.GetFWIT());
+        row[n++] = rs.allWells.GetFWIT();
 
     USI len = 0;
     // WOPR
     len = WOPR.index.size();
     for (USI w = 0; w < len; w++)
-        Sumdata[n++].val.push_back(rs.allWells.GetWOPR(WOPR.index[w]));
+        row[n++] = rs.allWells.GetWOPR(WOPR.index[w]);
 
     // WOPT
     len = WOPT.index.size();
     for (USI w = 0; w < len; w++)
-        Sumdata[n++].val.push_back(rs.allWells.GetWOPT(WOPT.index[w]));
+        row[n++] = rs.allWells.GetWOPT(WOPT.index[w]);
 
     // WGPR
     len = WGPR.index.size();
     for (USI w = 0; w < len; w++)
-        Sumdata[n++].val.push_back(rs.allWells.GetWGPR(WGPR.index[w]));
+        row[n++] = rs.allWells.GetWGPR(WGPR.index[w]);
 
     // WGPT
     len = WGPT.index.size();
     for (USI w = 0; w < len; w++)
-        Sumdata[n++].val.push_back(rs.allWells.GetWGPT(WGPT.index[w]));
+        row[n++] = rs.allWells.GetWGPT(WGPT.index[w]);
 
     // WWPR
     len = WWPR.index.size();
     for (USI w = 0; w < len; w++)
-        Sumdata[n++].val.push_back(rs.allWells.GetWWPR(WWPR.index[w]));
+        row[n++] = rs.allWells.GetWWPR(WWPR.index[w]);
 
     // WWPT
     len = WWPT.index.size();
     for (USI w = 0; w < len; w++)
-        Sumdata[n++].val.push_back(rs.allWells.GetWWPT(WWPT.index[w]));
+        row[n++] = rs.allWells.GetWWPT(WWPT.index[w]);
 
     // WGIR
     len = WGIR.index.size();
     for (USI w = 0; w < len; w++)
-        Sumdata[n++].val.push_back(rs.allWells.GetWGIR(WGIR.index[w]));
+        row[n++] = rs.allWells.GetWGIR(WGIR.index[w]);
 
     // WGIT
     len = WGIT.index.size();
     for (USI w = 0; w < len; w++)
-        Sumdata[n++].val.push_back(rs.allWells.GetWGIT(WGIT.index[w]));
+        row[n++] = rs.allWells.GetWGIT(WGIT.index[w]);
 
     // WWIR
     len = WWIR.index.size();
     for (USI w = 0; w < len; w++)
-        Sumdata[n++].val.push_back(rs.allWells.GetWWIR(WWIR.index[w]));
+        row[n++] = rs.allWells.GetWWIR(WWIR.index[w]);
 
     // WWIT
     len = WWIT.index.size();
     for (USI w = 0; w < len; w++)
-        Sumdata[n++].val.push_back(rs.allWells.GetWWIT(WWIT.index[w]));
+        row[n++] = rs.allWells.GetWWIT(WWIT.index[w]);
 
     // WBHP
     len = WBHP.index.size();
     for (USI w = 0; w < len; w++)
-        Sumdata[n++].val.push_back(rs.allWells.GetWBHP(WBHP.index[w]));
+        row[n++] = rs.allWells.GetWBHP(WBHP.index[w]);
 
     // DG
     len = DG.obj.size();
@@ -549,33 +552,44 @@ void Summary::SetVal(const Reservoir &rs, const OCPControl &ctrl)
         USI numperf = rs.allWells.GetWellPerfNum(DG.index[w]);
         for (USI p = 0; p < numperf; p++)
         {
-            Sumdata[n++].val.push_back(rs.allWells.GetWellDg(DG.index[w], p));
+            row[n++] = rs.allWells.GetWellDg(DG.index[w], p);
         }
     }
 
     // BPR
     len = BPR.index.size();
     for (USI i = 0; i < len; i++)
-        Sumdata[n++].val.push_back(rs.bulk.GetP(BPR.index[i]));
+        row[n++] = rs.bulk.GetP(BPR.index[i]);
 
     // SOIL
     len = SOIL.index.size();
     for (USI i = 0; i < len; i++)
-        Sumdata[n++].val.push_back(rs.bulk.GetSOIL(SOIL.index[i]));
+        row[n++] = rs.bulk.GetSOIL(SOIL.index[i]);
 
     // SGAS
     len = SGAS.index.size();
     for (USI i = 0; i < len; i++)
-        Sumdata[n++].val.push_back(rs.bulk.GetSGAS(SGAS.index[i]));
+        row[n++] = rs.bulk.GetSGAS(SGAS.index[i]);
 
     // SWAT
     len = SWAT.index.size();
     for (USI i = 0; i < len; i++)
-        Sumdata[n++].val.push_back(rs.bulk.GetSWAT(SWAT.index[i]));
+        row[n++] = rs.bulk.GetSWAT(SWAT.index[i]);
+
+    sumFile.Append(row);
+}
+
+void Summary::SyncCheckpoint(OCPCheckpoint &ckpt)
+{
+    ckpt.Check(Sumdata.size(), "number of summary items");
+    OCP_ULL nrow = sumFile.GetNumRows();
+    ckpt.Sync(nrow);
+    if (!ckpt.IsSaving())
+        sumFile.Resume(sumName, Sumdata, nrow);
 }
 
-/// Write output information in the dir/SUMMARY.out file.
-void Summary::PrintInfo(const string &dir) const
+/// Write the first nrow time steps of dir/SUMMARY.bin in the dir/SUMMARY.out file.
+void Summary::PrintInfo(const string &dir, const OCP_ULL &nrow)
 {
     string FileOut = dir + "SUMMARY.out";
     ofstream outF(FileOut);
@@ -584,79 +598,9 @@ void Summary::PrintInfo(const string &dir) const
         OCP_ABORT("Can not open " + FileOut);
     }
 
-    USI ns = 12;
-    USI col = 10;
-    USI row = 0;
-    USI num = Sumdata.size();
-    USI len = Sumdata[0].val.size();
-    USI id = 0;
-    USI ID = 1;
-
-    while (id != num)
-    {
-
-        outF << "Row " << ++row << endl;
-
-        // Item
-        // Time
-        outF << "\t" << setw(ns) << Sumdata[0].Item;
-
-        id = ID;
-        for (USI i = 1; i < col; i++)
-        {
-            outF << "\t" << setw(ns) << Sumdata[id++].Item;
-            if (id == num)
-                break;
-        }
-        outF << endl;
-
-        // Unit
-        // Time
-        outF << "\t" << setw(ns) << Sumdata[0].Unit;
-
-        id = ID;
-        for (USI i = 1; i < col; i++)
-        {
-            outF << "\t" << setw(ns) << Sumdata[id++].Unit;
-            if (id == num)
-                break;
-        }
-        outF << endl;
-
-        // Obj
-        // Time
-        outF << "\t" << setw(ns) << Sumdata[0].Obj;
-
-        id = ID;
-        for (USI i = 1; i < col; i++)
-        {
-            outF << "\t" << setw(ns) << Sumdata[id++].Obj;
-            if (id == num)
-                break;
-        }
-        outF << endl;
-
-        // Data
-        for (USI l = 0; l < len; l++)
-        {
-
-            // Time
-            outF << "\t" << setw(ns) << Sumdata[0].val[l];
-
-            id = ID;
-            for (USI i = 1; i < col; i++)
-            {
-                outF << "\t" << setw(ns) << Sumdata[id++].val[l];
-                if (id == num)
-                    break;
-            }
-            outF << endl;
-        }
-
-        ID += (col - 1);
-
-        outF << endl;
-    }
+    SummaryFile sumFile;
+    sumFile.Open(dir + "SUMMARY.bin");
+    sumFile.PrintText(outF, nrow);
 
     outF.close();
 }
@@ -685,6 +629,17 @@ void CriticalInfo::SetVal(const Reservoir &reservoir, const OCPControl &ctrl)
     cfl.push_back(reservoir.cfl);
 }
 
+void CriticalInfo::SyncCheckpoint(OCPCheckpoint &ckpt)
+{
+    ckpt.Sync(time);
+    ckpt.Sync(dt);
+    ckpt.Sync(dPmax);
+    ckpt.Sync(dVmax);
+    ckpt.Sync(dSmax);
+    ckpt.Sync(dNmax);
+    ckpt.Sync(cfl);
+}
+
 void CriticalInfo::PrintInfo(const string &dir) const
 {
     string FileOut = dir + "FastReview.out";
@@ -752,1212 +707,281 @@ void DetailInfo::InputParam(const OutputDetail &detail_param)
     PCW = detail_param.PCW;
 }
 
-void DetailInfo::Setup(const string &dir)
+void DetailInfo::Setup(const string &dir, const Reservoir &rs, const bool &bin)
 {
-    string FileOut = dir + "RPT.out";
-    ofstream outF(FileOut);
-    if (!outF.is_open())
+    binary = bin;
+
+    grid.nx     = rs.grid.GetGridNx();
+    grid.ny     = rs.grid.GetGridNy();
+    grid.nz     = rs.grid.GetGridNz();
+    grid.digits = rs.grid.GetNumDigitIJK();
+    grid.activeId.resize(rs.grid.GetGridNum());
+    for (OCP_USI i = 0; i < grid.activeId.size(); i++)
     {
-        OCP_ABORT("Can not open " + FileOut);
-    }
-    outF.close();
-}
-
-void DetailInfo::PrintInfo(const string &dir, const Reservoir &rs,
-                           const OCP_DBL &days) const
-{
-    string FileOut = dir + "RPT.out";
-    ofstream outF;
-    outF.open(FileOut, ios::app);
-    if (!outF.is_open())
-    {
-        OCP_ABORT("Can not open " + FileOut);
-    }
-
-    const USI     np = rs.bulk.numPhase;
-    const USI     nc = rs.bulk.numCom;
-    const USI OIndex = rs.bulk.phase2Index[OIL];
-    const USI GIndex = rs.bulk.phase2Index[GAS];
-    const USI WIndex = rs.bulk.phase2Index[WATER];
-    const USI     nx  = rs.grid.GetGridNx();
-    const USI     ny  = rs.grid.GetGridNy();
-    const OCP_USI num = rs.grid.GetGridNum();
-    const USI tmpsp = rs.grid.GetNumDigitIJK();
-    OCP_USI bId;
-    OCP_USI tmpId;
-    USI I, J, K;
-
-    const string sep01(50, '=');
-    const string sep02(50, '-');
-
-    outF << sep01 << "\n";
-
-    static bool flag = false;
-    // Print once
-    if (flag)
-    {
-        outF << "DX : feet";
-        for (OCP_USI i = 0; i < num; i++)
-        {
-            if (i % nx == 0)
-                outF << "\n";
-            if (i % (nx * ny) == 0)
-                outF << "\n\n";
-
-            if (i % nx == 0)
-            {
-                rs.grid.GetIJKGrid(I, J, K, i);
-                outF << GetIJKformat("*", to_string(J), to_string(K), tmpsp);
-                // outF << "(*," << setw(3) << J << "," << setw(3) << K << ")";
-            }
-
-            if (rs.grid.MapG2B(i).IsAct())
-            {
-                bId = rs.grid.MapG2B(i).GetId();
-                outF << setw(12) << fixed << setprecision(5) << rs.bulk.dx[bId];
-            }
-            else
-            {
-                outF << setw(12) << "-----  ";
-            }
-        }
-        outF << "\n\n\n";
+        grid.activeId[i] = rs.grid.MapG2B(i).IsAct() ? rs.grid.MapG2B(i).GetId() : -1;
     }
 
-    if (flag)
+    if (binary)
     {
-        outF << "DY : feet";
-        for (OCP_USI i = 0; i < num; i++)
-        {
-            if (i % nx == 0)
-                outF << "\n";
-            if (i % (nx * ny) == 0)
-                outF << "\n\n";
-
-            if (i % nx == 0)
-            {
-                rs.grid.GetIJKGrid(I, J, K, i);
-                outF << GetIJKformat("*", to_string(J), to_string(K), tmpsp);
-                // outF << "(*," << setw(3) << J << "," << setw(3) << K << ")";
-            }
-
-            if (rs.grid.MapG2B(i).IsAct())
-            {
-                bId = rs.grid.MapG2B(i).GetId();
-                outF << setw(12) << fixed << setprecision(5) << rs.bulk.dy[bId];
-            }
-            else
-            {
-                outF << setw(12) << "-----  ";
-            }
-        }
-        outF << "\n\n\n";
+        rptBin.Create(dir + "RPT.bin", grid);
     }
-
-    if (flag)
+    else
     {
-        outF << "DZ : feet";
-        for (OCP_USI i = 0; i < num; i++)
+        string FileOut = dir + "RPT.out";
+        outF.open(FileOut);
+        if (!outF.is_open())
         {
-            if (i % nx == 0)
-                outF << "\n";
-            if (i % (nx * ny) == 0)
-                outF << "\n\n";
-
-            if (i % nx == 0)
-            {
-                rs.grid.GetIJKGrid(I, J, K, i);
-                outF << GetIJKformat("*", to_string(J), to_string(K), tmpsp);
-                // outF << "(*," << setw(3) << J << "," << setw(3) << K << ")";
-            }
-
-            if (rs.grid.MapG2B(i).IsAct())
-            {
-                bId = rs.grid.MapG2B(i).GetId();
-                outF << setw(12) << fixed << setprecision(5) << rs.bulk.dz[bId];
-            }
-            else
-            {
-                outF << setw(12) << "-----  ";
-            }
+            OCP_ABORT("Can not open " + FileOut);
         }
-        outF << "\n\n\n";
     }
+}
 
-    if (flag)
-    {
-        outF << "Depth : feet";
-        for (OCP_USI i = 0; i < num; i++)
-        {
-            if (i % nx == 0)
-                outF << "\n";
-            if (i % (nx * ny) == 0)
-                outF << "\n\n";
+void DetailInfo::PrintInfo(const Reservoir &rs, const OCP_DBL &days,
+                           OCPAsyncWriter &writer) const
+{
+    ostringstream wellStream;
+    SetWellInfo(rs, days, wellStream);
+    string wellInfo = wellStream.str();
 
-            if (i % nx == 0)
-            {
-                rs.grid.GetIJKGrid(I, J, K, i);
-                outF << GetIJKformat("*", to_string(J), to_string(K), tmpsp);
-                // outF << "(*," << setw(3) << J << "," << setw(3) << K << ")";
-            }
+    vector<GridArray> arrays;
+    SetGridArrays(rs, arrays);
 
-            if (rs.grid.MapG2B(i).IsAct())
-            {
-                bId = rs.grid.MapG2B(i).GetId();
-                outF << setw(12) << fixed << setprecision(1) << rs.bulk.depth[bId];
-            }
-            else
-            {
-                outF << setw(12) << "-----  ";
-            }
-        }
-        outF << "\n\n\n";
-    }
+    // Formatting and writing go on with the next time step
+    writer.Post([this, days, wellInfo = move(wellInfo), arrays = move(arrays)]() {
+        WriteInfo(days, wellInfo, arrays);
+    });
+}
 
-    if (flag)
+void DetailInfo::WriteInfo(const OCP_DBL &days, const string &wellInfo,
+                           const vector<GridArray> &arrays) const
+{
+    if (binary)
     {
-        outF << "PERMX : MDarcy";
-        for (OCP_USI i = 0; i < num; i++)
-        {
-            if (i % nx == 0)
-                outF << "\n";
-            if (i % (nx * ny) == 0)
-                outF << "\n\n";
-
-            if (i % nx == 0)
-            {
-                rs.grid.GetIJKGrid(I, J, K, i);
-                outF << GetIJKformat("*", to_string(J), to_string(K), tmpsp);
-                // outF << "(*," << setw(3) << J << "," << setw(3) << K << ")";
-            }
-
-            if (rs.grid.MapG2B(i).IsAct())
-            {
-                bId = rs.grid.MapG2B(i).GetId();
-                outF << setw(12) << fixed << setprecision(5) << rs.bulk.rockKxInit[bId];
-            }
-            else
-            {
-                outF << setw(12) << "-----  ";
-            }
-        }
-        outF << "\n\n\n";
+        rptBin.Append(days, wellInfo, arrays);
     }
-
-    if (flag)
+    else
     {
-        outF << "PERMY : MDarcy";
-        for (OCP_USI i = 0; i < num; i++)
+        PrintReportHead(outF, wellInfo);
+        for (auto &a : arrays)
         {
-            if (i % nx == 0)
-                outF << "\n";
-            if (i % (nx * ny) == 0)
-                outF << "\n\n";
-
-            if (i % nx == 0)
-            {
-                rs.grid.GetIJKGrid(I, J, K, i);
-                outF << GetIJKformat("*", to_string(J), to_string(K), tmpsp);
-                // outF << "(*," << setw(3) << J << "," << setw(3) << K << ")";
-            }
-
-            if (rs.grid.MapG2B(i).IsAct())
-            {
-                bId = rs.grid.MapG2B(i).GetId();
-                outF << setw(12) << fixed << setprecision(5) << rs.bulk.rockKyInit[bId];
-            }
-            else
-            {
-                outF << setw(12) << "-----  ";
-            }
+            PrintGridArray(outF, grid, a, days);
         }
-        outF << "\n\n\n";
+        outF.flush();
     }
+}
 
-    if (flag)
-    {
-        outF << "PERMZ : MDarcy";
-        for (OCP_USI i = 0; i < num; i++)
-        {
-            if (i % nx == 0)
-                outF << "\n";
-            if (i % (nx * ny) == 0)
-                outF << "\n\n";
-
-            if (i % nx == 0)
-            {
-                rs.grid.GetIJKGrid(I, J, K, i);
-                outF << GetIJKformat("*", to_string(J), to_string(K), tmpsp);
-                // outF << "(*," << setw(3) << J << "," << setw(3) << K << ")";
-            }
-
-            if (rs.grid.MapG2B(i).IsAct())
-            {
-                bId = rs.grid.MapG2B(i).GetId();
-                outF << setw(12) << fixed << setprecision(5) << rs.bulk.rockKzInit[bId];
-            }
-            else
-            {
-                outF << setw(12) << "-----  ";
-            }
-        }
-        outF << "\n\n\n";
-    }
-
-    flag = false;
-
-
-    // Well infor
+void DetailInfo::SetWellInfo(const Reservoir &rs, const OCP_DBL &days,
+                             ostream &out) const
+{
     USI numWell = rs.allWells.GetWellNum();
-    outF << "Well Information" << "                    ";
-    outF << fixed << setprecision(3) << days << "  DAYS" << endl;
+    out << "Well Information" << "                    ";
+    out << fixed << setprecision(3) << days << "  DAYS" << endl;
     // INJ
     for (USI w = 0; w < numWell; w++) {
         if (rs.allWells.wells[w].opt.type == INJ) {
-            outF << "-------------------------------------" << endl;
-            outF << rs.allWells.wells[w].name << "   " << w << "   "
+            out << "-------------------------------------" << endl;
+            out << rs.allWells.wells[w].name << "   " << w << "   "
                 << rs.allWells.wells[w].depth << " (feet)     ";
-            outF << rs.allWells.wells[w].I << "   "
+            out << rs.allWells.wells[w].I << "   "
                 << rs.allWells.wells[w].J << endl;
 
             if (rs.allWells.wells[w].opt.state == OPEN) {
-                outF << "OPEN\t" << rs.allWells.wells[w].WGIR << " (MSCF/DAY)\t" << rs.allWells.wells[w].WWIR << " (STB/DAY)" << endl;
+                out << "OPEN\t" << rs.allWells.wells[w].WGIR << " (MSCF/DAY)\t" << rs.allWells.wells[w].WWIR << " (STB/DAY)" << endl;
             }
             else {
-                outF << "SHUTIN" << endl;
+                out << "SHUTIN" << endl;
             }
             // perf
             for (USI p = 0; p < rs.allWells.wells[w].numPerf; p++) {
-                outF << "perf" << p << "   "
+                out << "perf" << p << "   "
                     << rs.allWells.wells[w].perf[p].I << "   "
                     << rs.allWells.wells[w].perf[p].J << "   "
                     << rs.allWells.wells[w].perf[p].K << "   "
                     << rs.allWells.wells[w].perf[p].depth << "   ";
                 if (rs.allWells.wells[w].perf[p].state == OPEN) {
-                    outF << "OPEN";
+                    out << "OPEN";
                 }
                 else {
-                    outF << "SHUTIN";
+                    out << "SHUTIN";
                 }
-                outF << "   " << rs.allWells.wells[w].perf[p].location << endl;
+                out << "   " << rs.allWells.wells[w].perf[p].location << endl;
             }
         }
     }
     // PROD
     for (USI w = 0; w < numWell; w++) {
         if (rs.allWells.wells[w].opt.type == PROD) {
-            outF << "-------------------------------------" << endl;
-            outF << rs.allWells.wells[w].name << "   " << w << "   "
+            out << "-------------------------------------" << endl;
+            out << rs.allWells.wells[w].name << "   " << w << "   "
                 << rs.allWells.wells[w].depth << " (feet)     ";
-            outF << rs.allWells.wells[w].I << "   "
+            out << rs.allWells.wells[w].I << "   "
                 << rs.allWells.wells[w].J << endl;
 
             if (rs.allWells.wells[w].opt.state == OPEN) {
-                outF << "OPEN\t" << rs.allWells.wells[w].WOPR << " (STB/DAY)\t" << rs.allWells.wells[w].WGPR << " (MSCF/DAY)\t" << rs.allWells.wells[w].WWPR << " (STB/DAY)" << endl;
+                out << "OPEN\t" << rs.allWells.wells[w].WOPR << " (STB/DAY)\t" << rs.allWells.wells[w].WGPR << " (MSCF/DAY)\t" << rs.allWells.wells[w].WWPR << " (STB/DAY)" << endl;
             }
             else {
-                outF << "SHUTIN" << endl;
+                out << "SHUTIN" << endl;
             }
             // perf
             for (USI p = 0; p < rs.allWells.wells[w].numPerf; p++) {
-                outF << "perf" << p << "   "
+                out << "perf" << p << "   "
                     << rs.allWells.wells[w].perf[p].I << "   "
                     << rs.allWells.wells[w].perf[p].J << "   "
                     << rs.allWells.wells[w].perf[p].K << "   "
                     << rs.allWells.wells[w].perf[p].depth << "   ";
                 if (rs.allWells.wells[w].perf[p].state == OPEN) {
-                    outF << "OPEN";
+                    out << "OPEN";
                 }
                 else {
-                    outF << "SHUTIN";
-                }
-                outF << "   " << rs.allWells.wells[w].perf[p].location << endl;
-            }
-        }
-    }
-
-    outF << endl << endl;
-
-
-
-    // PRESSURE
-    if (PRE)
-    {
-        outF << "PRESSURE : psia"
-             << "                   ";
-        outF << fixed << setprecision(3) << days << "  DAYS";
-        for (OCP_USI i = 0; i < num; i++)
-        {
-            if (i % nx == 0)
-                outF << "\n";
-            if (i % (nx * ny) == 0)
-                outF << "\n\n";
-
-            if (i % nx == 0)
-            {
-                rs.grid.GetIJKGrid(I, J, K, i);
-                outF << GetIJKformat("*", to_string(J), to_string(K), tmpsp);
-                // outF << "(*," << setw(3) << J << "," << setw(3) << K << ")";
-            }
-
-            if (rs.grid.MapG2B(i).IsAct())
-            {
-                bId = rs.grid.MapG2B(i).GetId();
-                outF << setw(12) << fixed << setprecision(3) << rs.bulk.P[bId];
-            }
-            else
-            {
-                outF << setw(12) << "-----  ";
-            }
-        }
-        outF << "\n\n\n";
-    }
-
-    // DENSITY of OIL
-    if (DENO && rs.bulk.oil)
-    {
-        outF << sep02 << "\n";
-        outF << "DENO : lb/ft3"
-             << "                   ";
-        outF << fixed << setprecision(3) << days << "  DAYS";
-        for (OCP_USI i = 0; i < num; i++)
-        {
-            if (i % nx == 0)
-                outF << "\n";
-            if (i % (nx * ny) == 0)
-                outF << "\n\n";
-
-            if (i % nx == 0)
-            {
-                rs.grid.GetIJKGrid(I, J, K, i);
-                outF << GetIJKformat("*", to_string(J), to_string(K), tmpsp);
-                // outF << "(*," << setw(3) << J << "," << setw(3) << K << ")";
-            }
-
-            if (rs.grid.MapG2B(i).IsAct())
-            {
-                bId = rs.grid.MapG2B(i).GetId();
-                tmpId = bId * np + OIndex;
-                if (rs.bulk.phaseExist[tmpId])
-                {
-                    outF << setw(10) << fixed << setprecision(3) << rs.bulk.rho[tmpId];
+                    out << "SHUTIN";
                 }
-                else
-                {
-                    outF << setw(9) << fixed << setprecision(2) << 0.0 << "N";
-                }
-            }
-            else
-            {
-                outF << setw(10) << " --- ";
+                out << "   " << rs.allWells.wells[w].perf[p].location << endl;
             }
         }
-        outF << "\n\n";
     }
 
-    // DENSITY of GAS
-    if (DENG && rs.bulk.gas)
-    {
-        outF << sep02 << "\n";
-        outF << "DENG : lb/ft3"
-             << "                   ";
-        outF << fixed << setprecision(3) << days << "  DAYS";
-        for (OCP_USI i = 0; i < num; i++)
-        {
-            if (i % nx == 0)
-                outF << "\n";
-            if (i % (nx * ny) == 0)
-                outF << "\n\n";
-
-            if (i % nx == 0)
-            {
-                rs.grid.GetIJKGrid(I, J, K, i);
-                outF << GetIJKformat("*", to_string(J), to_string(K), tmpsp);
-                // outF << "(*," << setw(3) << J << "," << setw(3) << K << ")";
-            }
-
-            if (rs.grid.MapG2B(i).IsAct())
-            {
-                bId = rs.grid.MapG2B(i).GetId();
-                tmpId = bId * np + GIndex;
-                if (rs.bulk.phaseExist[tmpId])
-                {
-                    outF << setw(10) << fixed << setprecision(3) << rs.bulk.rho[tmpId];
-                }
-                else
-                {
-                    outF << setw(9) << fixed << setprecision(2) << 0.0 << "N";
-                }
-            }
-            else
-            {
-                outF << setw(10) << " --- ";
-            }
-        }
-        outF << "\n\n";
-    }
-
-    // DENSITY of WATER
-    if (DENW && rs.bulk.water)
-    {
-        outF << sep02 << "\n";
-        outF << "DENW : lb/ft3"
-             << "                   ";
-        outF << fixed << setprecision(3) << days << "  DAYS";
-        for (OCP_USI i = 0; i < num; i++)
-        {
-            if (i % nx == 0)
-                outF << "\n";
-            if (i % (nx * ny) == 0)
-                outF << "\n\n";
-
-            if (i % nx == 0)
-            {
-                rs.grid.GetIJKGrid(I, J, K, i);
-                outF << GetIJKformat("*", to_string(J), to_string(K), tmpsp);
-                // outF << "(*," << setw(3) << J << "," << setw(3) << K << ")";
-            }
-
-            if (rs.grid.MapG2B(i).IsAct())
-            {
-                bId = rs.grid.MapG2B(i).GetId();
-                tmpId = bId * np + WIndex;
-                if (rs.bulk.phaseExist[tmpId])
-                {
-                    outF << setw(10) << fixed << setprecision(3) << rs.bulk.rho[tmpId];
-                }
-                else
-                {
-                    outF << setw(9) << fixed << setprecision(2) << 0.0 << "N";
-                }
-            }
-            else
-            {
-                outF << setw(10) << " --- ";
-            }
-        }
-        outF << "\n\n";
-    }
-
-    // SATURATION of OIL
-    if (SOIL && rs.bulk.oil)
-    {
-        outF << sep02 << "\n";
-        outF << "SOIL"
-             << "                   ";
-        outF << fixed << setprecision(3) << days << "  DAYS";
-        for (OCP_USI i = 0; i < num; i++)
-        {
-            if (i % nx == 0)
-                outF << "\n";
-            if (i % (nx * ny) == 0)
-                outF << "\n\n";
-
-            if (i % nx == 0)
-            {
-                rs.grid.GetIJKGrid(I, J, K, i);
-                outF << GetIJKformat("*", to_string(J), to_string(K), tmpsp);
-                // outF << "(*," << setw(3) << J << "," << setw(3) << K << ")";
-            }
-
-            if (rs.grid.MapG2B(i).IsAct())
-            {
-                bId = rs.grid.MapG2B(i).GetId();
-                tmpId = bId * np + OIndex;
-                if (rs.bulk.phaseExist[tmpId])
-                {
-                    outF << setw(10) << fixed << setprecision(5) << rs.bulk.S[tmpId];
-                }
-                else
-                {
-                    outF << setw(9) << fixed << setprecision(4) << 0.0 << "N";
-                }
-            }
-            else
-            {
-                outF << setw(10) << " --- ";
-            }
-        }
-        outF << "\n\n";
-    }
-
-    // SATURATION of GAS
-    if (SGAS && rs.bulk.gas)
-    {
-        outF << sep02 << "\n";
-        outF << "SGAS"
-             << "                   ";
-        outF << fixed << setprecision(3) << days << "  DAYS";
-        for (OCP_USI i = 0; i < num; i++)
-        {
-            if (i % nx == 0)
-                outF << "\n";
-            if (i % (nx * ny) == 0)
-                outF << "\n\n";
-
-            if (i % nx == 0)
-            {
-                rs.grid.GetIJKGrid(I, J, K, i);
-                outF << GetIJKformat("*", to_string(J), to_string(K), tmpsp);
-                // outF << "(*," << setw(3) << J << "," << setw(3) << K << ")";
-            }
-
-            if (rs.grid.MapG2B(i).IsAct())
-            {
-                bId = rs.grid.MapG2B(i).GetId();
-                tmpId = bId * np + GIndex;
-                if (rs.bulk.phaseExist[tmpId])
-                {
-                    outF << setw(10) << fixed << setprecision(5) << rs.bulk.S[tmpId];
-                }
-                else
-                {
-                    outF << setw(9) << fixed << setprecision(4) << 0.0 << "N";
-                }
-            }
-            else
-            {
-                outF << setw(10) << " --- ";
-            }
-        }
-        outF << "\n\n";
-    }
-
-    // SATURATION of WATER
-    if (SWAT && rs.bulk.water)
-    {
-        outF << sep02 << "\n";
-        outF << "SWAT"
-             << "                   ";
-        outF << fixed << setprecision(3) << days << "  DAYS";
-        for (OCP_USI i = 0; i < num; i++)
-        {
-            if (i % nx == 0)
-                outF << "\n";
-            if (i % (nx * ny) == 0)
-                outF << "\n\n";
-
-            if (i % nx == 0)
-            {
-                rs.grid.GetIJKGrid(I, J, K, i);
-                outF << GetIJKformat("*", to_string(J), to_string(K), tmpsp);
-                // outF << "(*," << setw(3) << J << "," << setw(3) << K << ")";
-            }
-
-            if (rs.grid.MapG2B(i).IsAct())
-            {
-                bId = rs.grid.MapG2B(i).GetId();
-                tmpId = bId * np + WIndex;
-                if (rs.bulk.phaseExist[tmpId])
-                {
-                    outF << setw(10) << fixed << setprecision(5) << rs.bulk.S[tmpId];
-                }
-                else
-                {
-                    outF << setw(9) << fixed << setprecision(4) << 0.0 << "N";
-                }
-            }
-            else
-            {
-                outF << setw(10) << " --- ";
-            }
-        }
-        outF << "\n\n";
-    }
-
-    // Relative Permeability of OIL
-    if (KRO && rs.bulk.oil)
-    {
-        outF << sep02 << "\n";
-        outF << "KRO"
-             << "                   ";
-        outF << fixed << setprecision(3) << days << "  DAYS";
-        for (OCP_USI i = 0; i < num; i++)
-        {
-            if (i % nx == 0)
-                outF << "\n";
-            if (i % (nx * ny) == 0)
-                outF << "\n\n";
-
-            if (i % nx == 0)
-            {
-                rs.grid.GetIJKGrid(I, J, K, i);
-                outF << GetIJKformat("*", to_string(J), to_string(K), tmpsp);
-                // outF << "(*," << setw(3) << J << "," << setw(3) << K << ")";
-            }
-
-            if (rs.grid.MapG2B(i).IsAct())
-            {
-                bId = rs.grid.MapG2B(i).GetId();
-                tmpId = bId * np + OIndex;
-                if (rs.bulk.phaseExist[tmpId])
-                {
-                    outF << setw(10) << fixed << setprecision(5) << rs.bulk.kr[tmpId];
-                }
-                else
-                {
-                    outF << setw(9) << fixed << setprecision(4) << 0.0 << "N";
-                }
-            }
-            else
-            {
-                outF << setw(10) << " --- ";
-            }
-        }
-        outF << "\n\n";
-    }
-
-    // Relative Permeability of GAS
-    if (KRG && rs.bulk.gas)
-    {
-        outF << sep02 << "\n";
-        outF << "KRG"
-             << "                   ";
-        outF << fixed << setprecision(3) << days << "  DAYS";
-        for (OCP_USI i = 0; i < num; i++)
-        {
-            if (i % nx == 0)
-                outF << "\n";
-            if (i % (nx * ny) == 0)
-                outF << "\n\n";
-
-            if (i % nx == 0)
-            {
-                rs.grid.GetIJKGrid(I, J, K, i);
-                outF << GetIJKformat("*", to_string(J), to_string(K), tmpsp);
-                // outF << "(*," << setw(3) << J << "," << setw(3) << K << ")";
-            }
-
-            if (rs.grid.MapG2B(i).IsAct())
-            {
-                bId = rs.grid.MapG2B(i).GetId();
-                tmpId = bId * np + GIndex;
-                if (rs.bulk.phaseExist[tmpId])
-                {
-                    outF << setw(10) << fixed << setprecision(5) << rs.bulk.kr[tmpId];
-                }
-                else
-                {
-                    outF << setw(9) << fixed << setprecision(4) << 0.0 << "N";
-                }
-            }
-            else
-            {
-                outF << setw(10) << " --- ";
-            }
-        }
-        outF << "\n\n";
-    }
-
-    // Relative Permeability of WATER
-    if (KRW && rs.bulk.water)
-    {
-        outF << sep02 << "\n";
-        outF << "KRW"
-             << "                   ";
-        outF << fixed << setprecision(3) << days << "  DAYS";
-        for (OCP_USI i = 0; i < num; i++)
-        {
-            if (i % nx == 0)
-                outF << "\n";
-            if (i % (nx * ny) == 0)
-                outF << "\n\n";
-
-            if (i % nx == 0)
-            {
-                rs.grid.GetIJKGrid(I, J, K, i);
-                outF << GetIJKformat("*", to_string(J), to_string(K), tmpsp);
-                // outF << "(*," << setw(3) << J << "," << setw(3) << K << ")";
-            }
-
-            if (rs.grid.MapG2B(i).IsAct())
-            {
-                bId = rs.grid.MapG2B(i).GetId();
-                tmpId = bId * np + WIndex;
-                if (rs.bulk.phaseExist[tmpId])
-                {
-                    outF << setw(10) << fixed << setprecision(5) << rs.bulk.kr[tmpId];
-                }
-                else
-                {
-                    outF << setw(9) << fixed << setprecision(4) << 0.0 << "N";
-                }
-            }
-            else
-            {
-                outF << setw(10) << " --- ";
-            }
-        }
-        outF << "\n\n";
-    }
-
-    // Molar Density of OIL
-    if (BOIL && rs.bulk.oil && rs.bulk.comps)
-    {
-        outF << sep02 << "\n";
-        outF << "BOIL : lb-M/rb"
-             << "                   ";
-        outF << fixed << setprecision(3) << days << "  DAYS";
-        for (OCP_USI i = 0; i < num; i++)
-        {
-            if (i % nx == 0)
-                outF << "\n";
-            if (i % (nx * ny) == 0)
-                outF << "\n";
-
-            if (i % nx == 0)
-            {
-                rs.grid.GetIJKGrid(I, J, K, i);
-                outF << GetIJKformat("*", to_string(J), to_string(K), tmpsp);
-                // outF << "(*," << setw(3) << J << "," << setw(3) << K << ")";
-            }
-
-            if (rs.grid.MapG2B(i).IsAct())
-            {
-                bId = rs.grid.MapG2B(i).GetId();
-                tmpId = bId * np + OIndex;
-                if (rs.bulk.phaseExist[tmpId])
-                {
-                    outF << setw(10) << fixed << setprecision(5) << rs.bulk.xi[tmpId] * CONV1;
-                }
-                else
-                {
-                    outF << setw(9) << fixed << setprecision(4) << 0.0 << "N";
-                }
-            }
-            else
-            {
-                outF << setw(10) << " --- ";
-            }
-        }
-        outF << "\n\n";
-    }
-
-    // Molar Density of GAS
-    if (BGAS && rs.bulk.gas && rs.bulk.comps)
-    {
-        outF << sep02 << "\n";
-        outF << "BGAS : lb-M/rb"
-             << "                   ";
-        outF << fixed << setprecision(3) << days << "  DAYS";
-        for (OCP_USI i = 0; i < num; i++)
-        {
-            if (i % nx == 0)
-                outF << "\n";
-            if (i % (nx * ny) == 0)
-                outF << "\n\n";
-
-            if (i % nx == 0)
-            {
-                rs.grid.GetIJKGrid(I, J, K, i);
-                outF << GetIJKformat("*", to_string(J), to_string(K), tmpsp);
-                // outF << "(*," << setw(3) << J << "," << setw(3) << K << ")";
-            }
-
-            if (rs.grid.MapG2B(i).IsAct())
-            {
-                bId = rs.grid.MapG2B(i).GetId();
-                tmpId = bId * np + GIndex;
-                if (rs.bulk.phaseExist[tmpId])
-                {
-                    outF << setw(10) << fixed << setprecision(5) << rs.bulk.xi[tmpId] * CONV1;
-                }
-                else
-                {
-                    outF << setw(9) << fixed << setprecision(4) << 0.0 << "N";
-                }
-            }
-            else
-            {
-                outF << setw(10) << " --- ";
-            }
-        }
-        outF << "\n\n";
-    }
-
-    // Molar Density of WATER
-    if (BWAT && rs.bulk.water)
-    {
-        outF << sep02 << "\n";
-        outF << "BWAT : lb-M/rb"
-             << "                   ";
-        outF << fixed << setprecision(3) << days << "  DAYS";
-        for (OCP_USI i = 0; i < num; i++)
-        {
-            if (i % nx == 0)
-                outF << "\n";
-            if (i % (nx * ny) == 0)
-                outF << "\n\n";
-
-            if (i % nx == 0)
-            {
-                rs.grid.GetIJKGrid(I, J, K, i);
-                outF << GetIJKformat("*", to_string(J), to_string(K), tmpsp);
-                // outF << "(*," << setw(3) << J << "," << setw(3) << K << ")";
-            }
+    out << endl << endl;
+}
 
-            if (rs.grid.MapG2B(i).IsAct())
-            {
-                bId = rs.grid.MapG2B(i).GetId();
-                tmpId = bId * np + WIndex;
-                if (rs.bulk.phaseExist[tmpId])
-                {
-                    outF << setw(10) << fixed << setprecision(5) << rs.bulk.xi[tmpId] * (CONV1 * 19.437216);
-                }
-                else
-                {
-                    outF << setw(9) << fixed << setprecision(4) << 0.0 << "N";
-                }
-            }
-            else
-            {
-                outF << setw(10) << " --- ";
-            }
-        }
-        outF << "\n\n";
-    }
+/// Add a grid array with the text format of RPT.out.
+static vector<OCP_DBL> &AddGridArray(vector<GridArray> &arrays, const string &name,
+                                     const string &title, const USI &width,
+                                     const USI &prec, const USI &layerBreak,
+                                     const OCP_USI &nb)
+{
+    arrays.push_back(GridArray());
+    GridArray &a = arrays.back();
+    a.name       = name;
+    a.title      = title;
+    a.width      = width;
+    a.prec       = prec;
+    a.layerBreak = layerBreak;
+    // pressures are printed wider, without a separating line and with an empty line
+    // after them
+    a.sep      = width != 12;
+    a.endBreak = width == 12 ? 3 : 2;
+    a.val.resize(nb);
+    return a.val;
+}
 
-    // Viscosity of OIL
-    if (VOIL && rs.bulk.oil)
+/// Pick values of phase j from v, NaN if the phase does not exist.
+static void SetPhaseValue(vector<OCP_DBL> &val, const vector<bool> &phaseExist,
+                          const USI &np, const USI &j, const vector<OCP_DBL> &v,
+                          const OCP_DBL &factor = 1.0)
+{
+    for (OCP_USI n = 0; n < val.size(); n++)
     {
-        outF << sep02 << "\n";
-        outF << "VOIL : cp"
-             << "                   ";
-        outF << fixed << setprecision(3) << days << "  DAYS";
-        for (OCP_USI i = 0; i < num; i++)
-        {
-            if (i % nx == 0)
-                outF << "\n";
-            if (i % (nx * ny) == 0)
-                outF << "\n\n";
-
-            if (i % nx == 0)
-            {
-                rs.grid.GetIJKGrid(I, J, K, i);
-                outF << GetIJKformat("*", to_string(J), to_string(K), tmpsp);
-                // outF << "(*," << setw(3) << J << "," << setw(3) << K << ")";
-            }
-
-            if (rs.grid.MapG2B(i).IsAct())
-            {
-                bId = rs.grid.MapG2B(i).GetId();
-                tmpId = bId * np + OIndex;
-                if (rs.bulk.phaseExist[tmpId])
-                {
-                    outF << setw(10) << fixed << setprecision(5) << rs.bulk.mu[tmpId];
-                }
-                else
-                {
-                    outF << setw(9) << fixed << setprecision(4) << 0.0 << "N";
-                }
-            }
-            else
-            {
-                outF << setw(10) << " --- ";
-            }
-        }
-        outF << "\n\n";
+        val[n] = phaseExist[n * np + j] ? v[n * np + j] * factor : NAN;
     }
+}
 
-    // Viscosity of GAS
-    if (VGAS && rs.bulk.gas)
-    {
-        outF << sep02 << "\n";
-        outF << "VGAS : cp"
-             << "                   ";
-        outF << fixed << setprecision(3) << days << "  DAYS";
-        for (OCP_USI i = 0; i < num; i++)
-        {
-            if (i % nx == 0)
-                outF << "\n";
-            if (i % (nx * ny) == 0)
-                outF << "\n\n";
-
-            if (i % nx == 0)
-            {
-                rs.grid.GetIJKGrid(I, J, K, i);
-                outF << GetIJKformat("*", to_string(J), to_string(K), tmpsp);
-                // outF << "(*," << setw(3) << J << "," << setw(3) << K << ")";
-            }
-
-            if (rs.grid.MapG2B(i).IsAct())
-            {
-                bId = rs.grid.MapG2B(i).GetId();
-                tmpId = bId * np + GIndex;
-                if (rs.bulk.phaseExist[tmpId])
-                {
-                    outF << setw(10) << fixed << setprecision(5) << rs.bulk.mu[tmpId];
-                }
-                else
-                {
-                    outF << setw(9) << fixed << setprecision(4) << 0.0 << "N";
-                }
-            }
-            else
-            {
-                outF << setw(10) << " --- ";
-            }
-        }
-        outF << "\n\n";
-    }
+void DetailInfo::SetGridArrays(const Reservoir &rs, vector<GridArray> &arrays) const
+{
+    const Bulk   &bulk   = rs.bulk;
+    const OCP_USI nb     = bulk.numBulk;
+    const USI     np     = bulk.numPhase;
+    const USI     nc     = bulk.numCom;
+    const USI     OIndex = bulk.phase2Index[OIL];
+    const USI     GIndex = bulk.phase2Index[GAS];
+    const USI     WIndex = bulk.phase2Index[WATER];
 
-    // Viscosity of WATER
-    if (VWAT && rs.bulk.water)
+    // PRESSURE
+    if (PRE)
     {
-        outF << sep02 << "\n";
-        outF << "VWAT : cp"
-             << "                   ";
-        outF << fixed << setprecision(3) << days << "  DAYS";
-        for (OCP_USI i = 0; i < num; i++)
-        {
-            if (i % nx == 0)
-                outF << "\n";
-            if (i % (nx * ny) == 0)
-                outF << "\n";
-
-            if (i % nx == 0)
-            {
-                rs.grid.GetIJKGrid(I, J, K, i);
-                outF << GetIJKformat("*", to_string(J), to_string(K), tmpsp);
-                // outF << "(*," << setw(3) << J << "," << setw(3) << K << ")";
-            }
-
-            if (rs.grid.MapG2B(i).IsAct())
-            {
-                bId = rs.grid.MapG2B(i).GetId();
-                tmpId = bId * np + WIndex;
-                if (rs.bulk.phaseExist[tmpId])
-                {
-                    outF << setw(10) << fixed << setprecision(5) << rs.bulk.mu[tmpId];
-                }
-                else
-                {
-                    outF << setw(9) << fixed << setprecision(4) << 0.0 << "N";
-                }
-            }
-            else
-            {
-                outF << setw(10) << " --- ";
-            }
-        }
-        outF << "\n\n";
+        AddGridArray(arrays, "PRESSURE", "PRESSURE : psia", 12, 3, 2, nb) = bulk.P;
     }
+    // DENSITY
+    if (DENO && bulk.oil)
+        SetPhaseValue(AddGridArray(arrays, "DENO", "DENO : lb/ft3", 10, 3, 2, nb),
+                      bulk.phaseExist, np, OIndex, bulk.rho);
+    if (DENG && bulk.gas)
+        SetPhaseValue(AddGridArray(arrays, "DENG", "DENG : lb/ft3", 10, 3, 2, nb),
+                      bulk.phaseExist, np, GIndex, bulk.rho);
+    if (DENW && bulk.water)
+        SetPhaseValue(AddGridArray(arrays, "DENW", "DENW : lb/ft3", 10, 3, 2, nb),
+                      bulk.phaseExist, np, WIndex, bulk.rho);
+    // SATURATION
+    if (SOIL && bulk.oil)
+        SetPhaseValue(AddGridArray(arrays, "SOIL", "SOIL", 10, 5, 2, nb),
+                      bulk.phaseExist, np, OIndex, bulk.S);
+    if (SGAS && bulk.gas)
+        SetPhaseValue(AddGridArray(arrays, "SGAS", "SGAS", 10, 5, 2, nb),
+                      bulk.phaseExist, np, GIndex, bulk.S);
+    if (SWAT && bulk.water)
+        SetPhaseValue(AddGridArray(arrays, "SWAT", "SWAT", 10, 5, 2, nb),
+                      bulk.phaseExist, np, WIndex, bulk.S);
+    // RELATIVE PERMEABILITY
+    if (KRO && bulk.oil)
+        SetPhaseValue(AddGridArray(arrays, "KRO", "KRO", 10, 5, 2, nb),
+                      bulk.phaseExist, np, OIndex, bulk.kr);
+    if (KRG && bulk.gas)
+        SetPhaseValue(AddGridArray(arrays, "KRG", "KRG", 10, 5, 2, nb),
+                      bulk.phaseExist, np, GIndex, bulk.kr);
+    if (KRW && bulk.water)
+        SetPhaseValue(AddGridArray(arrays, "KRW", "KRW", 10, 5, 2, nb),
+                      bulk.phaseExist, np, WIndex, bulk.kr);
+    // MOLAR DENSITY
+    if (BOIL && bulk.oil && bulk.comps)
+        SetPhaseValue(AddGridArray(arrays, "BOIL", "BOIL : lb-M/rb", 10, 5, 1, nb),
+                      bulk.phaseExist, np, OIndex, bulk.xi, CONV1);
+    if (BGAS && bulk.gas && bulk.comps)
+        SetPhaseValue(AddGridArray(arrays, "BGAS", "BGAS : lb-M/rb", 10, 5, 2, nb),
+                      bulk.phaseExist, np, GIndex, bulk.xi, CONV1);
+    if (BWAT && bulk.water)
+        SetPhaseValue(AddGridArray(arrays, "BWAT", "BWAT : lb-M/rb", 10, 5, 2, nb),
+                      bulk.phaseExist, np, WIndex, bulk.xi, CONV1 * 19.437216);
+    // VISCOSITY
+    if (VOIL && bulk.oil)
+        SetPhaseValue(AddGridArray(arrays, "VOIL", "VOIL : cp", 10, 5, 2, nb),
+                      bulk.phaseExist, np, OIndex, bulk.mu);
+    if (VGAS && bulk.gas)
+        SetPhaseValue(AddGridArray(arrays, "VGAS", "VGAS : cp", 10, 5, 2, nb),
+                      bulk.phaseExist, np, GIndex, bulk.mu);
+    if (VWAT && bulk.water)
+        SetPhaseValue(AddGridArray(arrays, "VWAT", "VWAT : cp", 10, 5, 1, nb),
+                      bulk.phaseExist, np, WIndex, bulk.mu);
 
     // liquid component mole fractions.
-    if (XMF && rs.bulk.comps) {     
-        for (USI i = 0; i < nc - 1; i++) {
-            // the ith component
-            outF << sep02 << "\n";
-            outF << "XMF : Oil  " << i+1 << "th Component"
-                << "                   ";
-            outF << fixed << setprecision(3) << days << "  DAYS";
-
-            for (OCP_USI n = 0; n < num; n++) {
-                if (n % nx == 0) outF << "\n";
-                if (n % (nx * ny) == 0) outF << "\n";
-
-                if (n % nx == 0) {
-                    rs.grid.GetIJKGrid(I, J, K, n);
-                    outF << GetIJKformat("*", to_string(J), to_string(K), tmpsp);
-                    // outF << "(*," << setw(3) << J << "," << setw(3) << K << ")";
-                }
-
-                if (rs.grid.MapG2B(n).IsAct()) {
-                    bId = rs.grid.MapG2B(n).GetId();
-                    tmpId = bId * np + OIndex;
-                    if (rs.bulk.phaseExist[tmpId]) {
-                        tmpId = tmpId * nc + i;
-                        outF << setw(10) << fixed << setprecision(6) << rs.bulk.xij[tmpId];
-                    }
-                    else {
-                        outF << setw(9) << fixed << setprecision(5) << 0.0 << "N";
-                    }
-                }
-                else {
-                    outF << setw(10) << " --- ";
-                }
-            }
-            outF << "\n\n";
-        }
-    }
-
-    // gas component mole fractions.
-    if (YMF && rs.bulk.comps) {
-        for (USI i = 0; i < nc - 1; i++) {
-            // the ith component
-            outF << sep02 << "\n";
-            outF << "YMF : Gas  " << i << "th Component"
-                << "                   ";
-            outF << fixed << setprecision(3) << days << "  DAYS";
-
-            for (OCP_USI n = 0; n < num; n++) {
-                if (n % nx == 0) outF << "\n";
-                if (n % (nx * ny) == 0) outF << "\n";
-
-                if (n % nx == 0) {
-                    rs.grid.GetIJKGrid(I, J, K, n);
-                    outF << GetIJKformat("*", to_string(J), to_string(K), tmpsp);
-                    // outF << "(*," << setw(3) << J << "," << setw(3) << K << ")";
-                }
-
-                if (rs.grid.MapG2B(n).IsAct()) {
-                    bId = rs.grid.MapG2B(n).GetId();
-                    tmpId = bId * np + GIndex;
-                    if (rs.bulk.phaseExist[tmpId]) {
-                        tmpId = tmpId * nc + i;
-                        outF << setw(10) << fixed << setprecision(6) << rs.bulk.xij[tmpId];
-                    }
-                    else {
-                        outF << setw(9) << fixed << setprecision(5) << 0.0 << "N";
-                    }
-                }
-                else {
-                    outF << setw(10) << " --- ";
-                }
-            }
-            outF << "\n\n";
-        }
-    }
-
-    // surface tension
-    if (rs.bulk.miscible && false)
+    if (XMF && bulk.comps)
     {
-        outF << sep02 << "\n";
-        outF << "STEN"
-            << "                   ";
-        outF << fixed << setprecision(3) << days << "  DAYS";
-        for (OCP_USI i = 0; i < num; i++)
+        for (USI i = 0; i < nc - 1; i++)
         {
-            if (i % nx == 0)
-                outF << "\n";
-            if (i % (nx * ny) == 0)
-                outF << "\n";
-
-            if (i % nx == 0)
-            {
-                rs.grid.GetIJKGrid(I, J, K, i);
-                outF << GetIJKformat("*", to_string(J), to_string(K), tmpsp);
-                // outF << "(*," << setw(3) << J << "," << setw(3) << K << ")";
-            }
-
-            if (rs.grid.MapG2B(i).IsAct())
-            {
-                bId = rs.grid.MapG2B(i).GetId();
-                outF << setw(10) << fixed << setprecision(5) << rs.bulk.surTen[bId];
-            }
-            else
+            const string title = "XMF : Oil  " + to_string(i + 1) + "th Component";
+            vector<OCP_DBL> &val =
+                AddGridArray(arrays, "XMF" + to_string(i + 1), title, 10, 6, 1, nb);
+            for (OCP_USI n = 0; n < nb; n++)
             {
-                outF << setw(10) << " --- ";
+                const OCP_USI tmpId = n * np + OIndex;
+                val[n] = bulk.phaseExist[tmpId] ? bulk.xij[tmpId * nc + i] : NAN;
             }
         }
-        outF << "\n\n";
     }
-
-    // Fk
-    if (rs.bulk.miscible && false)
-    {
-        outF << sep02 << "\n";
-        outF << "FMISC"
-            << "                   ";
-        outF << fixed << setprecision(3) << days << "  DAYS";
-        for (OCP_USI i = 0; i < num; i++)
-        {
-            if (i % nx == 0)
-                outF << "\n";
-            if (i % (nx * ny) == 0)
-                outF << "\n";
-
-            if (i % nx == 0)
-            {
-                rs.grid.GetIJKGrid(I, J, K, i);
-                outF << GetIJKformat("*", to_string(J), to_string(K), tmpsp);
-                // outF << "(*," << setw(3) << J << "," << setw(3) << K << ")";
-            }
-
-            if (rs.grid.MapG2B(i).IsAct())
-            {
-                bId = rs.grid.MapG2B(i).GetId();
-                outF << setw(10) << fixed << setprecision(5) << rs.bulk.Fk[bId];
-            }
-            else
-            {
-                outF << setw(10) << " --- ";
-            }
-        }
-        outF << "\n\n";
-    }
-
-    // Fp
-    if (rs.bulk.miscible && false)
+    // gas component mole fractions.
+    if (YMF && bulk.comps)
     {
-        outF << sep02 << "\n";
-        outF << "FPC"
-            << "                   ";
-        outF << fixed << setprecision(3) << days << "  DAYS";
-        for (OCP_USI i = 0; i < num; i++)
+        for (USI i = 0; i < nc - 1; i++)
         {
-            if (i % nx == 0)
-                outF << "\n";
-            if (i % (nx * ny) == 0)
-                outF << "\n";
-
-            if (i % nx == 0)
-            {
-                rs.grid.GetIJKGrid(I, J, K, i);
-                outF << GetIJKformat("*", to_string(J), to_string(K), tmpsp);
-                // outF << "(*," << setw(3) << J << "," << setw(3) << K << ")";
-            }
-
-            if (rs.grid.MapG2B(i).IsAct())
-            {
-                bId = rs.grid.MapG2B(i).GetId();
-                outF << setw(10) << fixed << setprecision(5) << rs.bulk.Fp[bId];
-            }
-            else
+            const string title = "YMF : Gas  " + to_string(i) + "th Component";
+            vector<OCP_DBL> &val =
+                AddGridArray(arrays, "YMF" + to_string(i + 1), title, 10, 6, 1, nb);
+            for (OCP_USI n = 0; n < nb; n++)
             {
-                outF << setw(10) << " --- ";
+                const OCP_USI tmpId = n * np + GIndex;
+                val[n] = bulk.phaseExist[tmpId] ? bulk.xij[tmpId * nc + i] : NAN;
             }
         }
-        outF << "\n\n";
     }
 
     // Po - Pw
     if (PCW)
     {
-        OCP_DBL tmp = 1.0;
-
-        outF << "PCW : psia"
-            << "                   ";
-        outF << fixed << setprecision(3) << days << "  DAYS";
-        for (OCP_USI i = 0; i < num; i++)
+        vector<OCP_DBL> &val = AddGridArray(arrays, "PCW", "PCW : psia", 12, 3, 2, nb);
+        for (OCP_USI n = 0; n < nb; n++)
         {
-            if (i % nx == 0)
-                outF << "\n";
-            if (i % (nx * ny) == 0)
-                outF << "\n\n";
-
-            if (i % nx == 0)
-            {
-                rs.grid.GetIJKGrid(I, J, K, i);
-                outF << GetIJKformat("*", to_string(J), to_string(K), tmpsp);
-                // outF << "(*," << setw(3) << J << "," << setw(3) << K << ")";
-            }
-
-            if (rs.grid.MapG2B(i).IsAct())
-            {                
-                bId = rs.grid.MapG2B(i).GetId();
-                outF << setw(12) << fixed << setprecision(3) << -rs.bulk.Pc[bId * np + WIndex];
-            }
-            else
-            {
-                outF << setw(12) << "-----  ";
-            }
+            val[n] = -bulk.Pc[n * np + WIndex];
         }
-        outF << "\n\n\n";
     }
-
-
-    outF.close();
 }
 
 void OCPOutput::InputParam(const ParamOutput &paramOutput)
@@ -1969,9 +993,10 @@ void OCPOutput::InputParam(const ParamOutput &paramOutput)
 void OCPOutput::Setup(const Reservoir &reservoir, const OCPControl &ctrl)
 {
     wordDir = ctrl.workDir;
-    summary.Setup(reservoir, ctrl.criticalTime.back());
+    summary.Setup(wordDir, reservoir, !ctrl.GetRestartFile().empty());
     crtInfo.Setup(ctrl.criticalTime.back());
-    dtlInfo.Setup(wordDir);
+    dtlInfo.Setup(wordDir, reservoir, ctrl.ctrlFast.rptBin);
+    if (ctrl.ctrlFast.asyncOut) writer.Start();
 }
 
 void OCPOutput::SetVal(const Reservoir &reservoir, const OCPControl &ctrl)
@@ -1982,8 +1007,17 @@ void OCPOutput::SetVal(const Reservoir &reservoir, const OCPControl &ctrl)
 
 void OCPOutput::PrintInfo() const
 {
-    summary.PrintInfo(wordDir);
-    crtInfo.PrintInfo(wordDir);
+    // Only the time steps on disk now are written, later ones go on being appended
+    writer.Post([nrow = summary.GetNumRows(), crt = crtInfo, dir = wordDir]() {
+        Summary::PrintInfo(dir, nrow);
+        crt.PrintInfo(dir);
+    });
+}
+
+void OCPOutput::SyncCheckpoint(OCPCheckpoint &ckpt)
+{
+    summary.SyncCheckpoint(ckpt);
+    crtInfo.SyncCheckpoint(ckpt);
 }
 
 void OCPOutput::PrintInfoSched(const Reservoir &rs, const OCPControl &ctrl,
@@ -1993,7 +1027,7 @@ void OCPOutput::PrintInfoSched(const Reservoir &rs, const OCPControl &ctrl,
     cout << "Timestep " << setw(6) << left << ctrl.numTstep
          << ": " << fixed << setw(10) << setprecision(3) << right << days << " Days"
          << "    Wall time: " << time / 1000 << " Sec" << endl;
-    dtlInfo.PrintInfo(wordDir, rs, days);
+    dtlInfo.PrintInfo(rs, days, writer);
 }
 
 /*----------------------------------------------------------------------------*/
@@ -2004,4 +1038,7 @@ void OCPOutput::PrintInfoSched(const Reservoir &rs, const OCPControl &ctrl,
 /*  Shizhe Li           Oct/01/2021      Create file                          */
 /*  Chensong Zhang      Oct/15/2021      Format file                          */
 /*  Chensong Zhang      Jan/09/2022      Update Doxygen                       */
+/*  OpenCAEPoro team    Oct/16/2026      Binary detail report RPT.bin         */
+/*  OpenCAEPoro team    Oct/16/2026      Write reports in the background      */
+/*  OpenCAEPoro team    Oct/16/2026      Stream summary to SUMMARY.bin        */
 /*----------------------------------------------------------------------------*/
\ No newline at end of file
@@ -9,17 +9,20 @@
  *-----------------------------------------------------------------------------------
  */
 
+// Standard header files
+#include <algorithm>
+#include <cmath>
+
+// OpenCAEPoro header files
 #include "OCPTable.hpp"
 
 OCPTable::OCPTable(const USI& row, const USI& col)
 {
-    nRow = row;
-    nCol = col;
-    bId  = 0;
-    data.resize(nCol);
-    for (USI j = 0; j < nCol; j++) {
-        data[j].resize(nRow);
+    data.resize(col);
+    for (USI j = 0; j < col; j++) {
+        data[j].resize(row);
     }
+    SetRowCol();
 }
 
 
@@ -32,9 +35,50 @@ OCPTable::OCPTable(const vector<vector<OCP_DBL>>& src)
 void OCPTable::Setup(const std::vector<std::vector<OCP_DBL>>& src)
 {
     data = src;
-    nCol = data.size();
+    SetRowCol();
+}
+
+
+void OCPTable::SetRowCol()
+{
     nRow = data[0].size();
-    bId  = nRow / 2;
+    nCol = data.size();
+
+    rowData.resize(nRow * nCol);
+    for (USI i = 0; i < nRow; i++) {
+        for (USI k = 0; k < nCol; k++) {
+            rowData[i * nCol + k] = data[k][i];
+        }
+    }
+
+    // slopes over each column, only those of increasing or decreasing ones are used
+    slopes.resize(nCol);
+    for (USI j = 0; j < nCol; j++) {
+        slopes[j].assign(nRow * nCol, 0);
+        for (USI i = 0; i + 1 < nRow; i++) {
+            for (USI k = 0; k < nCol; k++) {
+                slopes[j][i * nCol + k] =
+                    (data[k][i + 1] - data[k][i]) / (data[j][i + 1] - data[j][i]);
+            }
+        }
+    }
+
+    // a column is uniformly spaced if each point lies within half a step of its place
+    invStep.assign(nCol, 0);
+    for (USI j = 0; j < nCol; j++) {
+        if (nRow < 2) continue;
+        const vector<OCP_DBL>& x    = data[j];
+        const OCP_DBL          step = (x[nRow - 1] - x[0]) / (nRow - 1);
+        if (!(step > 0)) continue;
+        bool uniform = true;
+        for (USI i = 1; i < nRow; i++) {
+            if (!(x[i] > x[i - 1]) || fabs(x[i] - x[0] - i * step) > 0.5 * step) {
+                uniform = false;
+                break;
+            }
+        }
+        if (uniform) invStep[j] = 1 / step;
+    }
 }
 
 
@@ -42,7 +86,7 @@ OCP_INT OCPTable::GetRowZero(const USI& mycol) const
 {
     if (mycol > nCol)
         OCP_ABORT("wrong specified column!");
-    for (OCP_INT i = 0; i < nRow; i++) {
+    for (OCP_INT i = 0; i < static_cast<OCP_INT>(nRow); i++) {
         if (data[mycol][i] >= TINY) {
             return i - 1;
         }
@@ -50,170 +94,144 @@ OCP_INT OCPTable::GetRowZero(const USI& mycol) const
 }
 
 
-USI OCPTable::Eval_All(const USI& j, const OCP_DBL& val, vector<OCP_DBL>& outdata,
-                       vector<OCP_DBL>& slope)
+OCP_INT OCPTable::FindRow(const USI& j, const OCP_DBL& val) const
+{
+    const vector<OCP_DBL>& x = data[j];
+    // NaN is taken as below the column
+    if (!(val >= x[0])) return -1;
+    if (val >= x[nRow - 1]) return nRow - 1;
+
+    if (invStep[j] > 0) {
+        // guess the row directly, then correct the rounding of the guess
+        OCP_INT i = static_cast<OCP_INT>((val - x[0]) * invStep[j]);
+        i         = min(max(i, 0), static_cast<OCP_INT>(nRow) - 2);
+        while (val < x[i]) i--;
+        while (val >= x[i + 1]) i++;
+        return i;
+    }
+    return static_cast<OCP_INT>(upper_bound(x.begin(), x.end(), val) - x.begin()) - 1;
+}
+
+
+OCP_INT OCPTable::FindRow(const USI& j, const OCP_DBL& val, USI& hint) const
+{
+    const vector<OCP_DBL>& x = data[j];
+    if (hint + 1 < nRow && val >= x[hint] && val < x[hint + 1]) return hint;
+
+    const OCP_INT i = FindRow(j, val);
+    hint            = max(i, 0);
+    return i;
+}
+
+
+USI OCPTable::EvalRow(const USI& j, const OCP_DBL& val, const OCP_INT& i,
+                      OCP_DBL* outdata, OCP_DBL* slope) const
 {
     // becareful when the memory outdata and slope have not be allocated before
 
-    if (val >= data[j][bId]) {
-        for (USI i = bId + 1; i < nRow; i++) {
-            if (val < data[j][i]) {
-                bId = i - 1;
-                for (USI k = 0; k < nCol; k++) {
-                    slope[k] = (data[k][bId + 1] - data[k][bId]) /
-                               (data[j][bId + 1] - data[j][bId]);
-                    outdata[k] = data[k][bId] + slope[k] * (val - data[j][bId]);
-                }
-                return bId;
-            }
-        }
-        for (USI k = 0; k < nCol; k++) {
-            slope[k]   = 0;
-            outdata[k] = data[k].back();
-        }
-    } else {
-        for (OCP_INT i = bId - 1; i >= 0; i--) {
-            if (val >= data[j][i]) {
-                bId = i;
-                for (USI k = 0; k < nCol; k++) {
-                    slope[k] = (data[k][bId + 1] - data[k][bId]) /
-                               (data[j][bId + 1] - data[j][bId]);
-                    outdata[k] = data[k][bId] + slope[k] * (val - data[j][bId]);
-                }
-                return bId;
-            }
-        }
+    if (i < 0 || i == static_cast<OCP_INT>(nRow) - 1) {
+        const USI      row = i < 0 ? 0 : nRow - 1;
+        const OCP_DBL* y   = &rowData[row * nCol];
         for (USI k = 0; k < nCol; k++) {
             slope[k]   = 0;
-            outdata[k] = data[k].front();
+            outdata[k] = y[k];
         }
+        return row;
     }
-    return bId;
+
+    const OCP_DBL* y  = &rowData[i * nCol];
+    const OCP_DBL* dy = &slopes[j][i * nCol];
+    const OCP_DBL  dx = val - y[j];
+    for (USI k = 0; k < nCol; k++) {
+        slope[k]   = dy[k];
+        outdata[k] = y[k] + dy[k] * dx;
+    }
+    return i;
 }
 
 
-USI OCPTable::Eval_All0(const OCP_DBL& val, vector<OCP_DBL>& outdata)
+USI OCPTable::Eval_All(const USI& j, const OCP_DBL& val, vector<OCP_DBL>& outdata,
+                       vector<OCP_DBL>& slope) const
 {
-    const USI j = 0;
-    OCP_DBL tmpk = 0;
-    if (val >= data[j][bId]) {
-        for (USI i = bId + 1; i < nRow; i++) {
-            if (val < data[j][i]) {
-                bId = i - 1;
-                for (USI k = 1; k < nCol; k++) {
-                    tmpk = (data[k][bId + 1] - data[k][bId]) /
-                        (data[j][bId + 1] - data[j][bId]);
-                    outdata[k - 1] = data[k][bId] + tmpk * (val - data[j][bId]);
-                }
-                return bId;
-            }
-        }
+    return EvalRow(j, val, FindRow(j, val), outdata.data(), slope.data());
+}
+
+
+USI OCPTable::Eval_All(const USI& j, const OCP_DBL& val, vector<OCP_DBL>& outdata,
+                       vector<OCP_DBL>& slope, USI& hint) const
+{
+    return EvalRow(j, val, FindRow(j, val, hint), outdata.data(), slope.data());
+}
+
+
+USI OCPTable::Eval_All(const USI& j, const OCP_DBL& val, OCP_DBL* outdata,
+                       OCP_DBL* slope) const
+{
+    return EvalRow(j, val, FindRow(j, val), outdata, slope);
+}
+
+
+USI OCPTable::Eval_All0(const OCP_DBL& val, vector<OCP_DBL>& outdata) const
+{
+    const USI     j = 0;
+    const OCP_INT i = FindRow(j, val);
+
+    if (i < 0 || i == static_cast<OCP_INT>(nRow) - 1) {
+        const USI      row = i < 0 ? 0 : nRow - 1;
+        const OCP_DBL* y   = &rowData[row * nCol];
         for (USI k = 1; k < nCol; k++) {
-            outdata[k - 1] = data[k].back();
+            outdata[k - 1] = y[k];
         }
+        return row;
     }
-    else {
-        for (OCP_INT i = bId - 1; i >= 0; i--) {
-            if (val >= data[j][i]) {
-                bId = i;
-                for (USI k = 1; k < nCol; k++) {
-                    tmpk = (data[k][bId + 1] - data[k][bId]) /
-                        (data[j][bId + 1] - data[j][bId]);
-                    outdata[k - 1] = data[k][bId] + tmpk * (val - data[j][bId]);
-                }
-                return bId;
-            }
-        }
-        for (USI k = 1; k < nCol; k++) {
-            outdata[k - 1] = data[k].front();
-        }
+
+    const OCP_DBL* y  = &rowData[i * nCol];
+    const OCP_DBL* dy = &slopes[j][i * nCol];
+    const OCP_DBL  dx = val - y[j];
+    for (USI k = 1; k < nCol; k++) {
+        outdata[k - 1] = y[k] + dy[k] * dx;
     }
-    return bId;
+    return i;
 }
 
 
-OCP_DBL OCPTable::Eval(const USI& j, const OCP_DBL& val, const USI& destj)
+OCP_DBL OCPTable::Eval(const USI& j, const OCP_DBL& val, const USI& destj) const
 {
-    // becareful when the memory outdata and slope have not be allocated before
+    const OCP_INT i = FindRow(j, val);
+    if (i < 0) return data[destj].front();
+    if (i == static_cast<OCP_INT>(nRow) - 1) return data[destj].back();
 
-    if (val >= data[j][bId]) {
-        for (USI i = bId + 1; i < nRow; i++) {
-            if (val < data[j][i]) {
-                bId       = i - 1;
-                OCP_DBL k = (data[destj][bId + 1] - data[destj][bId]) /
-                            (data[j][bId + 1] - data[j][bId]);
-                return (data[destj][bId] + k * (val - data[j][bId]));
-            }
-        }
-        return data[destj].back();
-    } else {
-        for (OCP_INT i = bId - 1; i >= 0; i--) {
-            if (val >= data[j][i]) {
-                bId       = i;
-                OCP_DBL k = (data[destj][bId + 1] - data[destj][bId]) /
-                            (data[j][bId + 1] - data[j][bId]);
-                return (data[destj][bId] + k * (val - data[j][bId]));
-            }
-        }
-        return data[destj].front();
-    }
+    const OCP_DBL k = slopes[j][i * nCol + destj];
+    return (data[destj][i] + k * (val - data[j][i]));
 }
 
 
-OCP_DBL OCPTable::Eval(const USI& j, const OCP_DBL& val, const USI& destj, OCP_DBL& myK)
+OCP_DBL OCPTable::Eval(const USI& j, const OCP_DBL& val, const USI& destj,
+                       OCP_DBL& myK) const
 {
-    // becareful when the memory outdata and slope have not be allocated before
+    const OCP_INT i = FindRow(j, val);
+    if (i < 0) return data[destj].front();
+    if (i == static_cast<OCP_INT>(nRow) - 1) return data[destj].back();
 
-    if (val >= data[j][bId]) {
-        for (USI i = bId + 1; i < nRow; i++) {
-            if (val < data[j][i]) {
-                bId = i - 1;
-                myK = (data[destj][bId + 1] - data[destj][bId]) /
-                    (data[j][bId + 1] - data[j][bId]);
-                return (data[destj][bId] + myK * (val - data[j][bId]));
-            }
-        }
-        return data[destj].back();
-    }
-    else {
-        for (OCP_INT i = bId - 1; i >= 0; i--) {
-            if (val >= data[j][i]) {
-                bId = i;
-                myK = (data[destj][bId + 1] - data[destj][bId]) /
-                    (data[j][bId + 1] - data[j][bId]);
-                return (data[destj][bId] + myK * (val - data[j][bId]));
-            }
-        }
-        return data[destj].front();
-    }
+    myK = slopes[j][i * nCol + destj];
+    return (data[destj][i] + myK * (val - data[j][i]));
 }
 
 
-OCP_DBL OCPTable::Eval_Inv(const USI& j, const OCP_DBL& val, const USI& destj)
+OCP_DBL OCPTable::Eval_Inv(const USI& j, const OCP_DBL& val, const USI& destj) const
 {
-    // becareful when the memory outdata and slope have not be allocated before
+    // find the row i with data[j][i] >= val > data[j][i+1]
+    const vector<OCP_DBL>& x = data[j];
+    const OCP_INT          i =
+        static_cast<OCP_INT>(partition_point(x.begin(), x.end(),
+                                             [&val](const OCP_DBL& t) { return t >= val; }) -
+                             x.begin()) -
+        1;
+    if (i < 0) return data[destj].front();
+    if (i == static_cast<OCP_INT>(nRow) - 1) return data[destj].back();
 
-    if (val > data[j][bId]) {
-        for (OCP_INT i = bId - 1; i >= 0; i--) {
-            if (val <= data[j][i]) {
-                bId       = i;
-                OCP_DBL k = (data[destj][bId + 1] - data[destj][bId]) /
-                            (data[j][bId + 1] - data[j][bId]);
-                return (data[destj][bId] + k * (val - data[j][bId]));
-            }
-        }
-        return data[destj].front();
-    } else {
-        for (USI i = bId + 1; i < nRow; i++) {
-            if (val >= data[j][i]) {
-                bId       = i;
-                OCP_DBL k = (data[destj][bId] - data[destj][bId - 1]) /
-                            (data[j][bId] - data[j][bId - 1]);
-                return (data[destj][bId - 1] + k * (val - data[j][bId - 1]));
-            }
-        }
-        return data[destj].back();
-    }
+    const OCP_DBL k = slopes[j][i * nCol + destj];
+    return (data[destj][i] + k * (val - data[j][i]));
 }
 
 void OCPTable::Display() const
@@ -241,4 +259,5 @@ void OCPTable::Display() const
 /*----------------------------------------------------------------------------*/
 /*  Shizhe Li           Oct/01/2021      Create file                          */
 /*  Chensong Zhang      Oct/15/2021      Format file                          */
+/*  OpenCAEPoro team    Oct/16/2026      Stateless evaluation, direct lookup  */
 /*----------------------------------------------------------------------------*/
\ No newline at end of file
@@ -11,6 +11,37 @@
 
 #include "ParamOutput.hpp"
 
+void OutputSummary::SyncCheckpoint(OCPCheckpoint& ckpt)
+{
+    ckpt.Sync(FPR);
+    ckpt.Sync(FOPR);
+    ckpt.Sync(FOPT);
+    ckpt.Sync(FGPR);
+    ckpt.Sync(FGPt);
+    ckpt.Sync(FWPR);
+    ckpt.Sync(FWPT);
+    ckpt.Sync(FGIR);
+    ckpt.Sync(FGIT);
+    ckpt.Sync(FWIR);
+    ckpt.Sync(FWIT);
+    ckpt.Sync(WOPR);
+    ckpt.Sync(WOPT);
+    ckpt.Sync(WGPR);
+    ckpt.Sync(WGPT);
+    ckpt.Sync(WWPR);
+    ckpt.Sync(WWPT);
+    ckpt.Sync(WGIR);
+    ckpt.Sync(WGIT);
+    ckpt.Sync(WWIR);
+    ckpt.Sync(WWIT);
+    ckpt.Sync(WBHP);
+    ckpt.Sync(DG);
+    ckpt.Sync(BPR);
+    ckpt.Sync(SOIL);
+    ckpt.Sync(SGAS);
+    ckpt.Sync(SWAT);
+}
+
 void ParamOutput::InputSUMMARY(ifstream& ifs)
 {
     vector<string> vbuf;
@@ -272,4 +303,5 @@ void ParamOutput::InputRPTSCHED(ifstream& ifs)
 /*----------------------------------------------------------------------------*/
 /*  Shizhe Li           Oct/01/2021      Create file                          */
 /*  Chensong Zhang      Oct/15/2021      Format file                          */
+/*  OpenCAEPoro team    Oct/16/2026      Sync params for the deck cache       */
 /*----------------------------------------------------------------------------*/
\ No newline at end of file
@@ -38,10 +38,13 @@ void ParamRead::GetDirAndName()
 /// This is the general interface for reading input files.
 void ParamRead::ReadInputFile(const string& filename)
 {
+    OCP_PROFILE("ReadInput");
+
     inputFile = filename;
     GetDirAndName();
     Init();
     ReadFile(inputFile);
+    paramRs.DisplayGRID();
     CheckParam();
 }
 
@@ -53,6 +56,9 @@ void ParamRead::ReadFile(const string& filename)
         OCP_MESSAGE("Trying to open file: " << (filename));
         OCP_ABORT("Failed to open the input file!");
     }
+    fileList.push_back(filename);
+    // Large grid arrays are read from a mapped view of the file
+    MappedFile mapped(filename);
 
     while (!ifs.eof()) {
         vector<string> vbuf;
@@ -110,7 +116,7 @@ void ParamRead::ReadFile(const string& filename)
             case Map_Str2Int("PRESSURE", 8):
             case Map_Str2Int("Ni", 2):
             case Map_Str2Int("SWATINIT", 8):
-                paramRs.InputGRID(ifs, keyword);
+                paramRs.InputGRID(ifs, mapped, keyword);
                 break;
 
             case Map_Str2Int("COPY", 4):
@@ -286,6 +292,19 @@ void ParamRead::ReadINCLUDE(ifstream& ifs)
     ReadFile(workDir + vbuf[0]);
 }
 
+/// Save or load all params read from input files.
+void ParamRead::SyncCheckpoint(OCPCheckpoint& ckpt)
+{
+    ckpt.Sync(inputFile);
+    ckpt.Sync(workDir);
+    ckpt.Sync(fileName);
+    ckpt.Sync(fileList);
+    ckpt.Sync(paramRs);
+    ckpt.Sync(paramWell);
+    ckpt.Sync(paramControl);
+    ckpt.Sync(paramOutput);
+}
+
 /// Check parameters in paramRs and paramWell.
 void ParamRead::CheckParam()
 {
@@ -304,4 +323,6 @@ void ParamRead::CheckParam()
 /*  Shizhe Li           Oct/01/2021      Create file                          */
 /*  Chensong Zhang      Oct/15/2021      Format file                          */
 /*  Chensong Zhang      Jan/08/2022      Test robustness for wrong keywords   */
+/*  OpenCAEPoro team    Oct/16/2026      Read grid arrays from mapped files   */
+/*  OpenCAEPoro team    Oct/16/2026      Sync params for the deck cache       */
 /*----------------------------------------------------------------------------*/
\ No newline at end of file
@@ -10,6 +10,70 @@
  */
 
 #include "ParamReservoir.hpp"
+#include "UtilTiming.hpp"
+
+/// Save or load the table set.
+void TableSet::SyncCheckpoint(OCPCheckpoint& ckpt)
+{
+    ckpt.Sync(name);
+    ckpt.Sync(colNum);
+    ckpt.Sync(data);
+}
+
+/// Save or load all params read from the input file.
+void ParamReservoir::SyncCheckpoint(OCPCheckpoint& ckpt)
+{
+    ckpt.Sync(dimens);
+    ckpt.Sync(numGrid);
+    ckpt.Sync(tops);
+    ckpt.Sync(dx);
+    ckpt.Sync(dy);
+    ckpt.Sync(dz);
+    ckpt.Sync(coord);
+    ckpt.Sync(zcorn);
+    ckpt.Sync(gridBytes);
+    ckpt.Sync(gridTime);
+    ckpt.Sync(ntg);
+    ckpt.Sync(poro);
+    ckpt.Sync(permX);
+    ckpt.Sync(permY);
+    ckpt.Sync(permZ);
+    ckpt.Sync(rsTemp);
+    ckpt.Sync(rock);
+    ckpt.Sync(miscstr);
+    ckpt.Sync(P);
+    ckpt.Sync(Ni);
+    ckpt.Sync(Swat);
+    ckpt.Sync(ScalePcow);
+    ckpt.Sync(density);
+    ckpt.Sync(gravity);
+    ckpt.Sync(blackOil);
+    ckpt.Sync(comps);
+    ckpt.Sync(oil);
+    ckpt.Sync(gas);
+    ckpt.Sync(water);
+    ckpt.Sync(disGas);
+    ckpt.Sync(EoSp);
+    ckpt.Sync(NTSFUN);
+    ckpt.Sync(NTPVT);
+    ckpt.Sync(SATNUM);
+    ckpt.Sync(PVTNUM);
+    ckpt.Sync(ACTNUM);
+    ckpt.Sync(SWFN_T);
+    ckpt.Sync(SWOF_T);
+    ckpt.Sync(SGFN_T);
+    ckpt.Sync(SGOF_T);
+    ckpt.Sync(SOF3_T);
+    ckpt.Sync(PBVD_T);
+    ckpt.Sync(ZMFVD_T);
+    ckpt.Sync(EQUIL);
+    ckpt.Sync(numPhase);
+    ckpt.Sync(numCom);
+    ckpt.Sync(PVCO_T);
+    ckpt.Sync(PVDO_T);
+    ckpt.Sync(PVDG_T);
+    ckpt.Sync(PVTW_T);
+}
 
 /// Find pointer to the specified variable.
 vector<OCP_DBL>* ParamReservoir::FindPtr(const string& varName)
@@ -357,7 +421,7 @@ void ParamReservoir::InputEQUALS(ifstream& ifs)
 }
 
 /// TODO: Add Doxygen
-void ParamReservoir::InputGRID(ifstream& ifs, string& keyword)
+void ParamReservoir::InputGRID(ifstream& ifs, MappedFile& file, string& keyword)
 {
     vector<OCP_DBL>* objPtr = nullptr;
 
@@ -366,25 +430,25 @@ void ParamReservoir::InputGRID(ifstream& ifs, string& keyword)
         OCP_ABORT("Unknown keyword!");
     }
 
-    vector<string> vbuf;
-    while (ReadLine(ifs, vbuf)) {
-        if (vbuf[0] == "/") break;
-        
-        for (auto& str : vbuf) {
-            // if m*n occurs, then push back n  m times
-            auto pos = str.find('*');
-            if (pos == string::npos) {
-                objPtr->push_back(stod(str));
-            }
-            else {
-                USI len = str.size();
-                OCP_USI num = stoi(str.substr(0, pos));
-                OCP_DBL val = stod(str.substr(pos + 1, len - (pos + 1)));
-                for (USI i = 0; i < num; i++)
-                    objPtr->push_back(val);
-            }           
-        }
-    }
+    // objPtr has been reserved from DIMENS by FindPtr
+    GetWallTime timer;
+    timer.Start();
+    gridBytes += ReadNumbers(ifs, file, *objPtr);
+    gridTime += timer.Stop();
+}
+
+/// Display the size and parse rate of grid arrays.
+void ParamReservoir::DisplayGRID() const
+{
+    if (gridBytes == 0) return;
+
+    const OCP_DBL mb = gridBytes / 1048576.0;
+    cout << "Grid arrays: " << fixed << setprecision(2) << mb << " MB parsed in "
+         << setprecision(3) << gridTime / 1000 << " s ("
+         << setprecision(1) << (gridTime > 0 ? mb / (gridTime / 1000) : 0.0)
+         << " MB/s)\n\n";
+    cout.unsetf(ios::floatfield);
+    cout << setprecision(6);
 }
 
 /// TODO: Add Doxygen
@@ -761,6 +825,36 @@ void TableSet::DisplayTable() const
     }
 }
 
+/// Save or load the params.
+void EoSparam::SyncCheckpoint(OCPCheckpoint& ckpt)
+{
+    ckpt.Sync(NTPVT);
+    ckpt.Sync(numCom);
+    ckpt.Sync(numPhase);
+    ckpt.Sync(COM);
+    ckpt.Sync(Cname);
+    ckpt.Sync(Tc);
+    ckpt.Sync(Pc);
+    ckpt.Sync(Vc);
+    ckpt.Sync(Zc);
+    ckpt.Sync(MW);
+    ckpt.Sync(Acf);
+    ckpt.Sync(OmegaA);
+    ckpt.Sync(OmegaB);
+    ckpt.Sync(Vshift);
+    ckpt.Sync(Parachor);
+    ckpt.Sync(Vcvis);
+    ckpt.Sync(Zcvis);
+    ckpt.Sync(LBCcoef);
+    ckpt.Sync(BIC);
+    ckpt.Sync(miscible);
+    ckpt.Sync(SSMparamSTA);
+    ckpt.Sync(NRparamSTA);
+    ckpt.Sync(SSMparamSP);
+    ckpt.Sync(NRparamSP);
+    ckpt.Sync(RRparam);
+}
+
 void EoSparam::InitEoSparam()
 {
     // Init LBC coefficient
@@ -1070,4 +1164,6 @@ void EoSparam::InputRR(ifstream& ifs)
 /*  Shizhe Li           Oct/01/2021      Create file                          */
 /*  Chensong Zhang      Oct/15/2021      Format file                          */
 /*  Chensong Zhang      Jan/09/2022      Update output and Doxygen            */
+/*  OpenCAEPoro team    Oct/16/2026      Parse grid arrays with ReadNumbers   */
+/*  OpenCAEPoro team    Oct/16/2026      Sync params for the deck cache       */
 /*----------------------------------------------------------------------------*/
\ No newline at end of file
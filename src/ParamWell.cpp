@@ -47,6 +47,18 @@ WellOptParam::WellOptParam(string intype, vector<string>& vbuf)
     }
 }
 
+void WellOptParam::SyncCheckpoint(OCPCheckpoint& ckpt)
+{
+    ckpt.Sync(type);
+    ckpt.Sync(fluidType);
+    ckpt.Sync(state);
+    ckpt.Sync(optMode);
+    ckpt.Sync(maxRate);
+    ckpt.Sync(maxBHP);
+    ckpt.Sync(minBHP);
+    ckpt.Sync(zi);
+}
+
 WellParam::WellParam(vector<string>& info)
 {
     name = info[0];
@@ -56,6 +68,24 @@ WellParam::WellParam(vector<string>& info)
     if (info[4] != "DEFAULT") depth = stod(info[4]);
 }
 
+void WellParam::SyncCheckpoint(OCPCheckpoint& ckpt)
+{
+    ckpt.Sync(name);
+    ckpt.Sync(group);
+    ckpt.Sync(I);
+    ckpt.Sync(J);
+    ckpt.Sync(depth);
+    ckpt.Sync(I_perf);
+    ckpt.Sync(J_perf);
+    ckpt.Sync(K_perf);
+    ckpt.Sync(WI);
+    ckpt.Sync(diameter);
+    ckpt.Sync(kh);
+    ckpt.Sync(skinFactor);
+    ckpt.Sync(direction);
+    ckpt.Sync(optParam);
+}
+
 Solvent::Solvent(const vector<string>& vbuf)
 {
     name    = vbuf[0];
@@ -355,4 +385,5 @@ void ParamWell::CheckPerf() const
 /*  Shizhe Li           Oct/01/2021      Create file                          */
 /*  Chensong Zhang      Oct/15/2021      Format file                          */
 /*  Chensong Zhang      Oct/27/2021      Unify error messages                 */
+/*  OpenCAEPoro team    Oct/16/2026      Sync params for the deck cache       */
 /*----------------------------------------------------------------------------*/
\ No newline at end of file
@@ -25,16 +25,46 @@ void Reservoir::InputParam(ParamRead& param)
 
 }
 
-void Reservoir::Setup()
+void Reservoir::Setup(const USI& bulkOrder)
 {
     OCP_FUNCNAME;
+    OCP_PROFILE("SetupReservoir");
 
     grid.Setup();
+    grid.SetupBulkOrder(bulkOrder);
     bulk.Setup(grid);
     conn.Setup(grid, bulk);
     allWells.Setup(grid, bulk);
 }
 
+void Reservoir::Setup(DeckCache& cache, const USI& bulkOrder)
+{
+    OCP_FUNCNAME;
+
+    if (!cache.IsLoaded()) {
+        Setup(bulkOrder);
+        if (cache.IsOn()) {
+            grid.SyncSetup(cache.Image());
+            conn.SyncSetup(cache.Image());
+            cache.Finish();
+        }
+        return;
+    }
+
+    OCP_PROFILE("SetupReservoir");
+
+    grid.SyncSetup(cache.Image());
+    grid.CalSomeInfo();
+    // Connections in the cache hold the bulk ordering of the run which wrote it
+    const bool sameOrder = grid.GetBulkOrder() == bulkOrder;
+    grid.SetupBulkOrder(bulkOrder);
+    bulk.Setup(grid);
+    conn.SyncSetup(cache.Image());
+    if (!sameOrder) conn.Setup(grid, bulk);
+    allWells.Setup(grid, bulk);
+    cache.Finish();
+}
+
 void Reservoir::ApplyControl(const USI& i)
 {
     OCP_FUNCNAME;
@@ -46,6 +76,7 @@ void Reservoir::ApplyControl(const USI& i)
 void Reservoir::PrepareWell()
 {
     OCP_FUNCNAME;
+    OCP_PROFILE("PrepareWell");
 
     allWells.PrepareWell(bulk);
 }
@@ -53,6 +84,7 @@ void Reservoir::PrepareWell()
 void Reservoir::CalWellFlux()
 {
     OCP_FUNCNAME;
+    OCP_PROFILE("WellFlux");
 
     allWells.CalFlux(bulk);
 }
@@ -60,6 +92,7 @@ void Reservoir::CalWellFlux()
 void Reservoir::CalWellTrans()
 {
     OCP_FUNCNAME;
+    OCP_PROFILE("WellTrans");
 
     allWells.CalTrans(bulk);
 }
@@ -74,6 +107,7 @@ void Reservoir::CalVpore()
 void Reservoir::CalKrPc()
 {
     OCP_FUNCNAME;
+    OCP_PROFILE("KrPc");
 
     bulk.CalKrPc();
 }
@@ -135,6 +169,16 @@ void Reservoir::GetNTQT(const OCP_DBL& dt)
     cout << setprecision(8) << NT << "   " << QT << endl;
 }
 
+void Reservoir::SyncCheckpoint(OCPCheckpoint& ckpt)
+{
+    OCP_FUNCNAME;
+
+    bulk.SyncCheckpoint(ckpt);
+    conn.SyncCheckpoint(ckpt);
+    allWells.SyncCheckpoint(ckpt);
+    ckpt.Sync(cfl);
+}
+
 /////////////////////////////////////////////////////////////////////
 // IMPEC
 /////////////////////////////////////////////////////////////////////
@@ -182,6 +226,7 @@ OCP_DBL Reservoir::CalCFL(const OCP_DBL& dt)
 void Reservoir::CalFLuxIMPEC()
 {
     OCP_FUNCNAME;
+    OCP_PROFILE("Flux");
 
     conn.CalFluxIMPEC(bulk);
     allWells.CalFlux(bulk);
@@ -190,6 +235,7 @@ void Reservoir::CalFLuxIMPEC()
 void Reservoir::CalConnFluxIMPEC()
 {
     OCP_FUNCNAME;
+    OCP_PROFILE("Flux");
 
     conn.CalFluxIMPEC(bulk);
 }
@@ -205,6 +251,7 @@ void Reservoir::MassConseveIMPEC(const OCP_DBL& dt)
 void Reservoir::CalFlashIMPEC()
 {
     OCP_FUNCNAME;
+    OCP_PROFILE("Flash");
 
     bulk.Flash();
 }
@@ -344,6 +391,7 @@ void Reservoir::InitFIM_n()
 void Reservoir::CalFlashDerivFIM()
 {
     OCP_FUNCNAME;
+    OCP_PROFILE("Flash");
 
     bulk.FlashDeriv();
 }
@@ -351,6 +399,7 @@ void Reservoir::CalFlashDerivFIM()
 void Reservoir::CalFlashDerivFIM_n()
 {
     OCP_FUNCNAME;
+    OCP_PROFILE("Flash");
 
     bulk.FlashDeriv_n();
 }
@@ -358,6 +407,7 @@ void Reservoir::CalFlashDerivFIM_n()
 void Reservoir::CalKrPcDerivFIM()
 {
     OCP_FUNCNAME;
+    OCP_PROFILE("KrPc");
 
     bulk.CalKrPcDeriv();
 }
@@ -393,6 +443,9 @@ void Reservoir::AssembleMatFIM(LinearSystem& myLS, const OCP_DBL& dt) const
 #else
     conn.AssembleMat_FIM(myLS, bulk, dt);
     allWells.AssemblaMatFIM(myLS, bulk, dt);
+    // Pattern is unchanged until wells change, but reinjection inserts entries into
+    // rows of injection wells, so it is built every time then.
+    if (!allWells.GetReinjection()) myLS.FixPattern();
 #endif // OCP_NEW_FIM
 }
 
@@ -434,6 +487,8 @@ void Reservoir::GetSolution01FIM(const vector<OCP_DBL>& u)
 void Reservoir::CalResFIM(ResFIM& resFIM, const OCP_DBL& dt)
 {
     OCP_FUNCNAME;
+    OCP_PROFILE("Residual");
+
     // Initialize
     resFIM.SetZero();
     // Bulk to Bulk
@@ -530,24 +585,33 @@ void Reservoir::AllocateMatAIMt(LinearSystem& myLS) const
     
     myLS.AllocateRowMem(bulk.GetMaxFIMBulk() + allWells.GetWellNum(),
         bulk.GetComNum() + 1);
-    myLS.AllocateColMem(10);
+    // rows are stored with fixed capacity, so bound both bulk and well rows
+    const USI wellNum = allWells.GetWellNum();
+    myLS.AllocateColMem(max(conn.GetMaxNeighborNum() + wellNum,
+                            (allWells.GetMaxWellPerNum() + 1) * wellNum));
 }
 
 
 void Reservoir::CalFlashDerivAIM(const bool& IfAIMs)
 {
+    OCP_PROFILE("Flash");
+
     bulk.FlashDerivAIM(IfAIMs);
 }
 
 
 void Reservoir::CalKrPcDerivAIM(const bool& IfAIMs)
 {
+    OCP_PROFILE("KrPc");
+
     bulk.CalKrPcDerivAIM(IfAIMs);
 }
 
 
 void Reservoir::CalResAIMt(ResFIM& resFIM, const OCP_DBL& dt)
 {
+    OCP_PROFILE("Residual");
+
     // Initialize
     resFIM.SetZero();
     // Bulk to Bulk
@@ -587,6 +651,8 @@ void Reservoir::AllocateAuxAIMs()
 
 void Reservoir::CalResAIMs(ResFIM& resFIM, const OCP_DBL& dt)
 {
+    OCP_PROFILE("Residual");
+
     // Initialize
     resFIM.SetZero();
     // Bulk to Bulk
@@ -663,11 +729,14 @@ void Reservoir::AssembleMatAIMc(LinearSystem& myLS, const OCP_DBL& dt) const
     conn.SetupMatSparsity(myLS);
     conn.AssembleMat_AIMc01(myLS, bulk, dt);
     allWells.AssemblaMatFIM(myLS, bulk, dt);
+    if (!allWells.GetReinjection()) myLS.FixPattern();
 }
 
 void Reservoir::CalResAIMc(ResFIM& resFIM, const OCP_DBL& dt)
 {
     OCP_FUNCNAME;
+    OCP_PROFILE("Residual");
+
     // Initialize
     resFIM.SetZero();
     // Bulk to Bulk
@@ -681,16 +750,22 @@ void Reservoir::CalResAIMc(ResFIM& resFIM, const OCP_DBL& dt)
 
 void Reservoir::CalFlashAIMc()
 {
+    OCP_PROFILE("Flash");
+
     bulk.FlashAIMc();
 }
 
 void Reservoir::CalFlashAIMc01()
 {
+    OCP_PROFILE("Flash");
+
     bulk.FlashAIMc01();
 }
 
 void Reservoir::CalKrPcAIMc()
 {
+    OCP_PROFILE("KrPc");
+
     bulk.CalKrPcAIMc();
 }
 
@@ -698,6 +773,8 @@ void Reservoir::CalKrPcAIMc()
 /// Calculate Flash for local FIM, some derivatives are needed
 void Reservoir::CalFlashDerivAIMc()
 {
+    OCP_PROFILE("Flash");
+
     bulk.FlashDerivAIMc();
 }
 
@@ -705,6 +782,8 @@ void Reservoir::CalFlashDerivAIMc()
 /// Calculate Relative Permeability and Capillary and some derivatives for each Bulk
 void Reservoir::CalKrPcDerivAIMc()
 {
+    OCP_PROFILE("KrPc");
+
     bulk.CalKrPcDerivAIMc();
 }
 
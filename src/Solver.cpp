@@ -12,11 +12,18 @@
 // OpenCAEPoro header files
 #include "Solver.hpp"
 
-void Solver::Setup(Reservoir &rs, const OCPControl &ctrl) { SetupMethod(rs, ctrl); }
+void Solver::Setup(Reservoir &rs, const OCPControl &ctrl)
+{
+    OCP_PROFILE("SetupSolver");
+
+    SetupMethod(rs, ctrl);
+}
 
 /// Initialize the reservoir setting for different solution methods.
 void Solver::InitReservoir(Reservoir &rs) const
 {
+    OCP_PROFILE("Init");
+
     // Initialize the fluid part
     IsoTSolver.InitReservoir(rs);
 }
@@ -28,22 +35,38 @@ void Solver::RunSimulation(Reservoir &rs, OCPControl &ctrl, OCPOutput &output)
     timer.Start();
     output.PrintInfoSched(rs, ctrl, timer.Stop());
     USI numTSteps = ctrl.GetNumTSteps();
-    for (USI d = 0; d < numTSteps - 1; d++)
+    // A restarted run begins with the TSTEP after its checkpoint
+    USI dBegin = 0;
+    while (dBegin < numTSteps - 1 && ctrl.IsCriticalTime(dBegin + 1)) dBegin++;
+    for (USI d = dBegin; d < numTSteps - 1; d++)
     {
         rs.ApplyControl(d);
         ctrl.ApplyControl(d, rs);
+        // Sparsity pattern of the matrix changes with wells
+        if (ctrl.GetWellChange()) IsoTSolver.ResetPattern();
         while (!ctrl.IsCriticalTime(d + 1))
         {
             GoOneStep(rs, ctrl);
+            OCP_PROFILE("Output");
             output.SetVal(rs, ctrl);
         }
-        output.PrintInfoSched(rs, ctrl, timer.Stop());
+        {
+            OCP_PROFILE("Output");
+            output.PrintInfoSched(rs, ctrl, timer.Stop());
+        }
         if (ctrl.printLevel > 2) {
             // Print Summary and critical information at every TSTEP
             output.PrintInfo();
         }       
+        if (ctrl.IfCheckpoint(d) && d + 2 < numTSteps) {
+            OCP_PROFILE("Checkpoint");
+            ckpt.BeginSave();
+            SyncCheckpoint(rs, ctrl, output);
+            ckpt.WriteAsync(ctrl.GetCheckpointFile());
+        }
         // rs.allWells.ShowWellStatus(rs.bulk);
     }
+    ckpt.Wait();
 
     if (rs.bulk.GetMixMode() == EOS_PVTW)
     {
@@ -61,9 +84,32 @@ void Solver::RunSimulation(Reservoir &rs, OCPControl &ctrl, OCPOutput &output)
     ctrl.RecordTotalTime(timer.Stop() / 1000);
 }
 
+/// Load the state at the end of a TSTEP, RunSimulation goes on from the next one.
+void Solver::Restart(Reservoir &rs, OCPControl &ctrl, OCPOutput &output)
+{
+    OCP_PROFILE("Restart");
+
+    ckpt.BeginLoad(ctrl.GetRestartFile());
+    SyncCheckpoint(rs, ctrl, output);
+    ckpt.EndLoad();
+    cout << "Restart from " << ctrl.GetRestartFile() << " at " << fixed
+         << setprecision(3) << ctrl.GetCurTime() << " Days" << endl;
+}
+
+/// Save or load every part of the state in a fixed order.
+void Solver::SyncCheckpoint(Reservoir &rs, OCPControl &ctrl, OCPOutput &output)
+{
+    rs.SyncCheckpoint(ckpt);
+    ctrl.SyncCheckpoint(ckpt);
+    output.SyncCheckpoint(ckpt);
+    IsoTSolver.SyncCheckpoint(ckpt);
+}
+
 /// This is one time step of dynamic simulation in an abstract setting.
 void Solver::GoOneStep(Reservoir &rs, OCPControl &ctrl)
 {
+    OCP_PROFILE("TimeStep");
+
     OCP_DBL &dt = ctrl.GetCurDt();
 
     if (ctrl.printLevel > 0) {
@@ -97,6 +143,8 @@ void Solver::GoOneStep(Reservoir &rs, OCPControl &ctrl)
 /// Get ready for assembling the linear system of this time step.
 void Solver::Prepare(Reservoir &rs, OCP_DBL &dt)
 {
+    OCP_PROFILE("Prepare");
+
     // Prepare for the fluid part
     IsoTSolver.Prepare(rs, dt);
 }
@@ -110,14 +158,22 @@ void Solver::SetupMethod(Reservoir &rs, const OCPControl &ctrl)
 void Solver::AssembleSolve(Reservoir &rs, OCPControl &ctrl)
 {
     // Assemble linear system
-    IsoTSolver.AssembleMat(rs, ctrl.current_dt);
+    {
+        OCP_PROFILE("Assembly");
+        IsoTSolver.AssembleMat(rs, ctrl.current_dt);
+    }
     // Solve linear system
-    IsoTSolver.SolveLinearSystem(rs, ctrl);
+    {
+        OCP_PROFILE("LinearSolve");
+        IsoTSolver.SolveLinearSystem(rs, ctrl);
+    }
 }
 
 /// Update properties after solving.
 bool Solver::UpdateProperty(Reservoir &rs, OCPControl &ctrl)
 {
+    OCP_PROFILE("UpdateProperty");
+
     // Update for the fluid part
     return IsoTSolver.UpdateProperty(rs, ctrl);
 }
@@ -125,6 +181,8 @@ bool Solver::UpdateProperty(Reservoir &rs, OCPControl &ctrl)
 /// Clean up Newton-Raphson iteration if there is any.
 bool Solver::FinishNR(Reservoir &rs, OCPControl &ctrl)
 {
+    OCP_PROFILE("FinishNR");
+
     // Clean up the fluid part
     return IsoTSolver.FinishNR(rs, ctrl);
 }
@@ -132,6 +190,8 @@ bool Solver::FinishNR(Reservoir &rs, OCPControl &ctrl)
 /// Clean up time step.
 void Solver::FinishStep(Reservoir &rs, OCPControl &ctrl)
 {
+    OCP_PROFILE("FinishStep");
+
     // Clean up the fluid part
     IsoTSolver.FinishStep(rs, ctrl);
 }
@@ -0,0 +1,96 @@
+/*! \file    UtilAsyncWriter.cpp
+ *  \brief   Background thread writing output snapshots
+ *  \author  OpenCAEPoro team
+ *  \date    Oct/16/2026
+ *
+ *-----------------------------------------------------------------------------------
+ *  Copyright (C) 2021--present by the OpenCAEPoro team. All rights reserved.
+ *  Released under the terms of the GNU Lesser General Public License 3.0 or later.
+ *-----------------------------------------------------------------------------------
+ */
+
+// OpenCAEPoro header files
+#include "UtilAsyncWriter.hpp"
+#include "UtilError.hpp"
+
+OCPAsyncWriter* OCPAsyncWriter::running = nullptr;
+
+void OCPAsyncWriter::Start()
+{
+    if (writer.joinable()) return;
+    stop    = false;
+    writer  = thread(&OCPAsyncWriter::Run, this);
+    running = this;
+    GetAbortHandler() = &OCPAsyncWriter::FlushOnAbort;
+}
+
+void OCPAsyncWriter::Post(function<void()> job)
+{
+    if (!writer.joinable()) {
+        job();
+        return;
+    }
+    unique_lock<mutex> lock(mtx);
+    // Keep at most one snapshot waiting besides the one being written
+    cv.wait(lock, [this]() { return jobs.empty(); });
+    jobs.push_back(move(job));
+    cv.notify_all();
+}
+
+void OCPAsyncWriter::Wait()
+{
+    if (!writer.joinable()) return;
+    unique_lock<mutex> lock(mtx);
+    cv.wait(lock, [this]() { return jobs.empty() && !busy; });
+}
+
+void OCPAsyncWriter::Stop()
+{
+    if (!writer.joinable()) return;
+    {
+        lock_guard<mutex> lock(mtx);
+        stop = true;
+    }
+    cv.notify_all();
+    writer.join();
+    if (running == this) {
+        running           = nullptr;
+        GetAbortHandler() = nullptr;
+    }
+}
+
+void OCPAsyncWriter::Run()
+{
+    unique_lock<mutex> lock(mtx);
+    while (true) {
+        cv.wait(lock, [this]() { return stop || !jobs.empty(); });
+        if (jobs.empty()) break;
+
+        function<void()> job = move(jobs.front());
+        jobs.pop_front();
+        busy = true;
+        cv.notify_all();
+
+        lock.unlock();
+        job();
+        lock.lock();
+
+        busy = false;
+        cv.notify_all();
+    }
+}
+
+void OCPAsyncWriter::FlushOnAbort()
+{
+    // A job which aborts can not wait for itself
+    if (running == nullptr || this_thread::get_id() == running->writer.get_id()) return;
+    running->Wait();
+}
+
+/*----------------------------------------------------------------------------*/
+/*  Brief Change History of This File                                         */
+/*----------------------------------------------------------------------------*/
+/*  Author              Date             Actions                              */
+/*----------------------------------------------------------------------------*/
+/*  OpenCAEPoro team    Oct/16/2026      Create file                          */
+/*----------------------------------------------------------------------------*/
@@ -0,0 +1,145 @@
+/*! \file    UtilCheckpoint.cpp
+ *  \brief   Binary checkpoint of the simulator state
+ *  \author  OpenCAEPoro team
+ *  \date    Oct/16/2026
+ *
+ *-----------------------------------------------------------------------------------
+ *  Copyright (C) 2021--present by the OpenCAEPoro team. All rights reserved.
+ *  Released under the terms of the GNU Lesser General Public License 3.0 or later.
+ *-----------------------------------------------------------------------------------
+ */
+
+// Standard header files
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+
+// OpenCAEPoro header files
+#include "UtilCheckpoint.hpp"
+
+/// Leading bytes of a checkpoint file, the last digit is the format version
+const char CKPT_MAGIC[8] = {'O', 'C', 'P', 'C', 'K', 'P', 'T', '6'};
+
+void OCPCheckpoint::BeginSave()
+{
+    saving = true;
+    buf.assign(CKPT_MAGIC, CKPT_MAGIC + sizeof(CKPT_MAGIC));
+}
+
+void OCPCheckpoint::BeginLoad(const string& file)
+{
+    if (!TryBeginLoad(file)) OCP_ABORT(file + " is not a checkpoint of this version!");
+}
+
+bool OCPCheckpoint::TryBeginLoad(const string& file)
+{
+    Wait();
+    saving = false;
+    pos    = 0;
+    buf.clear();
+
+    ifstream inF(file, ios::binary | ios::ate);
+    if (!inF.is_open()) return false;
+    buf.resize(inF.tellg());
+    inF.seekg(0);
+    inF.read(buf.data(), buf.size());
+    if (!inF) OCP_ABORT("Can not read " + file);
+    inF.close();
+
+    if (buf.size() < sizeof(CKPT_MAGIC) ||
+        memcmp(buf.data(), CKPT_MAGIC, sizeof(CKPT_MAGIC)) != 0)
+        return false;
+    pos = sizeof(CKPT_MAGIC);
+    return true;
+}
+
+void OCPCheckpoint::EndLoad()
+{
+    if (pos != buf.size()) OCP_ABORT("Checkpoint has unread data!");
+    vector<char>().swap(buf);
+    pos = 0;
+}
+
+void OCPCheckpoint::SyncBytes(void* p, const size_t& n)
+{
+    if (n == 0) return;
+    if (saving) {
+        const char* src = static_cast<const char*>(p);
+        buf.insert(buf.end(), src, src + n);
+    } else {
+        if (pos + n > buf.size()) OCP_ABORT("Checkpoint is truncated!");
+        memcpy(p, &buf[pos], n);
+        pos += n;
+    }
+}
+
+void OCPCheckpoint::Sync(string& v)
+{
+    OCP_USI len = v.size();
+    Sync(len);
+    if (!saving) v.resize(len);
+    SyncBytes(&v[0], len);
+}
+
+void OCPCheckpoint::Sync(vector<bool>& v)
+{
+    OCP_USI len = v.size();
+    Sync(len);
+    if (saving) {
+        for (OCP_USI i = 0; i < len; i++) buf.push_back(v[i] ? 1 : 0);
+    } else {
+        if (pos + len > buf.size()) OCP_ABORT("Checkpoint is truncated!");
+        v.resize(len);
+        for (OCP_USI i = 0; i < len; i++) v[i] = buf[pos + i] != 0;
+        pos += len;
+    }
+}
+
+void OCPCheckpoint::WriteAsync(const string& file)
+{
+    // Only one image is in flight, an older one has long finished in practice
+    Wait();
+    outBuf.swap(buf);
+    buf.clear();
+
+    writer = thread([this, file]() {
+        // Write to a temporary file first, so a kill never leaves a broken checkpoint
+        const string tmpFile = file + ".tmp";
+        ofstream     outF(tmpFile, ios::binary);
+        if (!outF.is_open()) {
+            cout << "### WARNING: Can not open " << tmpFile << endl;
+            return;
+        }
+        outF.write(outBuf.data(), outBuf.size());
+        outF.close();
+        if (!outF) {
+            cout << "### WARNING: Can not write " << tmpFile << endl;
+            return;
+        }
+#if defined(_CONSOLE) || defined(_WIN32) || defined(_WIN64)
+        // rename does not replace an existing file on Windows
+        remove(file.c_str());
+#endif
+        if (rename(tmpFile.c_str(), file.c_str()) != 0)
+            cout << "### WARNING: Can not rename " << tmpFile << endl;
+    });
+}
+
+void OCPCheckpoint::Wait()
+{
+    if (writer.joinable()) writer.join();
+}
+
+/*----------------------------------------------------------------------------*/
+/*  Brief Change History of This File                                         */
+/*----------------------------------------------------------------------------*/
+/*  Author              Date             Actions                              */
+/*----------------------------------------------------------------------------*/
+/*  OpenCAEPoro team    Oct/16/2026      Create file                          */
+/*  OpenCAEPoro team    Oct/16/2026      Sync strings and nested classes      */
+/*  OpenCAEPoro team    Oct/16/2026      Format version 2, summary on disk    */
+/*  OpenCAEPoro team    Oct/16/2026      Format version 3, bulk ordering      */
+/*  OpenCAEPoro team    Oct/17/2026      Format version 4, bulk partition     */
+/*  OpenCAEPoro team    Oct/17/2026      Format version 5, no wall times      */
+/*  OpenCAEPoro team    Oct/17/2026      Format version 6, no bulk partition  */
+/*----------------------------------------------------------------------------*/
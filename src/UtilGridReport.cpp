@@ -0,0 +1,262 @@
+/*! \file    UtilGridReport.cpp
+ *  \brief   Grid arrays of the detail report in text and binary files
+ *  \author  OpenCAEPoro team
+ *  \date    Oct/16/2026
+ *
+ *-----------------------------------------------------------------------------------
+ *  Copyright (C) 2021--present by the OpenCAEPoro team. All rights reserved.
+ *  Released under the terms of the GNU Lesser General Public License 3.0 or later.
+ *-----------------------------------------------------------------------------------
+ */
+
+// Standard header files
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iomanip>
+
+// OpenCAEPoro header files
+#include "UtilError.hpp"
+#include "UtilGridReport.hpp"
+#include "UtilOutput.hpp"
+
+/// Leading bytes of a binary report file, the last digit is the format version
+const char RPT_MAGIC[8] = {'O', 'C', 'P', 'R', 'P', 'T', 'B', '1'};
+
+void PrintGridArray(ostream& out, const GridLayout& grid, const GridArray& a,
+                    const OCP_DBL& days)
+{
+    if (a.sep) out << string(50, '-') << "\n";
+    out << a.title << "                   ";
+    out << fixed << setprecision(3) << days << "  DAYS";
+
+    const OCP_USI num      = grid.activeId.size();
+    const OCP_USI nxy      = grid.nx * grid.ny;
+    const char*   inactive = a.width == 12 ? "-----  " : " --- ";
+    for (OCP_USI i = 0; i < num; i++) {
+        if (i % grid.nx == 0) out << "\n";
+        if (i % nxy == 0) out << string(a.layerBreak, '\n');
+
+        if (i % grid.nx == 0) {
+            const USI J = (i % nxy) / grid.nx + 1;
+            const USI K = i / nxy + 1;
+            out << GetIJKformat("*", to_string(J), to_string(K), grid.digits);
+        }
+
+        const OCP_INT bId = grid.activeId[i];
+        if (bId < 0) {
+            out << setw(a.width) << inactive;
+        } else if (std::isnan(a.val[bId])) {
+            out << setw(a.width - 1) << fixed << setprecision(a.prec - 1) << 0.0 << "N";
+        } else {
+            out << setw(a.width) << fixed << setprecision(a.prec) << a.val[bId];
+        }
+    }
+    out << string(a.endBreak, '\n');
+}
+
+void PrintReportHead(ostream& out, const string& wellInfo)
+{
+    out << string(50, '=') << "\n" << wellInfo;
+}
+
+/// Write plain data to a binary file.
+template <typename T> static void WriteBin(fstream& fs, const T& v)
+{
+    fs.write(reinterpret_cast<const char*>(&v), sizeof(T));
+}
+
+/// Read plain data from a binary file.
+template <typename T> static void ReadBin(fstream& fs, T& v)
+{
+    fs.read(reinterpret_cast<char*>(&v), sizeof(T));
+}
+
+/// Write a string with its length to a binary file.
+static void WriteBin(fstream& fs, const string& s)
+{
+    WriteBin(fs, static_cast<OCP_USI>(s.size()));
+    fs.write(s.data(), s.size());
+}
+
+/// Read a string with its length from a binary file.
+static void ReadBin(fstream& fs, string& s)
+{
+    OCP_USI len = 0;
+    ReadBin(fs, len);
+    s.resize(len);
+    fs.read(&s[0], len);
+}
+
+/// Write an index entry to a binary file.
+static void WriteEntry(fstream& fs, const GridReportFile::Entry& e)
+{
+    WriteBin(fs, e.head.name);
+    WriteBin(fs, e.head.title);
+    WriteBin(fs, e.head.width);
+    WriteBin(fs, e.head.prec);
+    WriteBin(fs, e.head.layerBreak);
+    WriteBin(fs, e.head.endBreak);
+    WriteBin(fs, static_cast<char>(e.head.sep));
+    WriteBin(fs, e.offset);
+    WriteBin(fs, e.count);
+}
+
+/// Read an index entry from a binary file.
+static void ReadEntry(fstream& fs, GridReportFile::Entry& e)
+{
+    char sep = 0;
+    ReadBin(fs, e.head.name);
+    ReadBin(fs, e.head.title);
+    ReadBin(fs, e.head.width);
+    ReadBin(fs, e.head.prec);
+    ReadBin(fs, e.head.layerBreak);
+    ReadBin(fs, e.head.endBreak);
+    ReadBin(fs, sep);
+    e.head.sep = sep != 0;
+    ReadBin(fs, e.offset);
+    ReadBin(fs, e.count);
+}
+
+void GridReportFile::Create(const string& file, const GridLayout& myGrid)
+{
+    grid    = myGrid;
+    lastPos = 0;
+    reports.clear();
+
+    fs.close();
+    fs.open(file, ios::in | ios::out | ios::binary | ios::trunc);
+    if (!fs.is_open()) OCP_ABORT("Can not open " + file);
+
+    fs.write(RPT_MAGIC, sizeof(RPT_MAGIC));
+    WriteBin(fs, lastPos);
+    WriteBin(fs, grid.nx);
+    WriteBin(fs, grid.ny);
+    WriteBin(fs, grid.nz);
+    WriteBin(fs, grid.digits);
+    WriteBin(fs, static_cast<OCP_ULL>(grid.activeId.size()));
+    fs.write(reinterpret_cast<const char*>(grid.activeId.data()),
+             grid.activeId.size() * sizeof(OCP_INT));
+    fs.flush();
+    if (!fs) OCP_ABORT("Can not write " + file);
+}
+
+void GridReportFile::Append(const OCP_DBL& days, const string& wellInfo,
+                            const vector<GridArray>& arrays)
+{
+    Report r;
+    r.days = days;
+
+    // Data of this report come first, after the last index
+    fs.seekp(0, ios::end);
+    r.wells.head.name = "WELLS";
+    r.wells.offset    = fs.tellp();
+    r.wells.count     = wellInfo.size();
+    fs.write(wellInfo.data(), wellInfo.size());
+
+    r.arrays.resize(arrays.size());
+    for (USI n = 0; n < arrays.size(); n++) {
+        Entry& e = r.arrays[n];
+        e.head   = arrays[n];
+        e.head.val.clear();
+        e.offset = fs.tellp();
+        e.count  = arrays[n].val.size();
+        fs.write(reinterpret_cast<const char*>(arrays[n].val.data()),
+                 e.count * sizeof(OCP_DBL));
+    }
+
+    // Then its index, linked to the index of the last report
+    const OCP_ULL pos = fs.tellp();
+    WriteBin(fs, lastPos);
+    WriteBin(fs, r.days);
+    WriteEntry(fs, r.wells);
+    WriteBin(fs, static_cast<OCP_USI>(r.arrays.size()));
+    for (auto& e : r.arrays) WriteEntry(fs, e);
+    fs.flush();
+
+    // Point the head to the new index only when the report is complete
+    fs.seekp(sizeof(RPT_MAGIC));
+    WriteBin(fs, pos);
+    fs.flush();
+    if (!fs) OCP_ABORT("Can not write the binary report!");
+    lastPos = pos;
+}
+
+void GridReportFile::Open(const string& file)
+{
+    fs.close();
+    fs.open(file, ios::in | ios::binary);
+    if (!fs.is_open()) OCP_ABORT("Can not open " + file);
+
+    char magic[sizeof(RPT_MAGIC)];
+    fs.read(magic, sizeof(magic));
+    if (!fs || memcmp(magic, RPT_MAGIC, sizeof(RPT_MAGIC)) != 0)
+        OCP_ABORT(file + " is not a binary report of this version!");
+
+    OCP_ULL num = 0;
+    ReadBin(fs, lastPos);
+    ReadBin(fs, grid.nx);
+    ReadBin(fs, grid.ny);
+    ReadBin(fs, grid.nz);
+    ReadBin(fs, grid.digits);
+    ReadBin(fs, num);
+    grid.activeId.resize(num);
+    fs.read(reinterpret_cast<char*>(grid.activeId.data()), num * sizeof(OCP_INT));
+
+    // Follow the links from the last report back to the first one
+    reports.clear();
+    OCP_ULL pos = lastPos;
+    while (pos > 0) {
+        Report  r;
+        OCP_USI n = 0;
+        fs.seekg(pos);
+        ReadBin(fs, pos);
+        ReadBin(fs, r.days);
+        ReadEntry(fs, r.wells);
+        ReadBin(fs, n);
+        r.arrays.resize(n);
+        for (auto& e : r.arrays) ReadEntry(fs, e);
+        if (!fs) OCP_ABORT(file + " is truncated!");
+        reports.push_back(r);
+    }
+    reverse(reports.begin(), reports.end());
+}
+
+void GridReportFile::ReadWells(const Report& r, string& wellInfo)
+{
+    wellInfo.resize(r.wells.count);
+    fs.seekg(r.wells.offset);
+    fs.read(&wellInfo[0], r.wells.count);
+    if (!fs) OCP_ABORT("The binary report is truncated!");
+}
+
+void GridReportFile::ReadArray(const Entry& e, GridArray& a)
+{
+    a = e.head;
+    a.val.resize(e.count);
+    fs.seekg(e.offset);
+    fs.read(reinterpret_cast<char*>(a.val.data()), e.count * sizeof(OCP_DBL));
+    if (!fs) OCP_ABORT("The binary report is truncated!");
+}
+
+void GridReportFile::PrintText(ostream& out)
+{
+    string    wellInfo;
+    GridArray a;
+    for (auto& r : reports) {
+        ReadWells(r, wellInfo);
+        PrintReportHead(out, wellInfo);
+        for (auto& e : r.arrays) {
+            ReadArray(e, a);
+            PrintGridArray(out, grid, a, r.days);
+        }
+    }
+}
+
+/*----------------------------------------------------------------------------*/
+/*  Brief Change History of This File                                         */
+/*----------------------------------------------------------------------------*/
+/*  Author              Date             Actions                              */
+/*----------------------------------------------------------------------------*/
+/*  OpenCAEPoro team    Oct/16/2026      Create file                          */
+/*----------------------------------------------------------------------------*/
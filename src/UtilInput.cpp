@@ -9,6 +9,27 @@
  *-----------------------------------------------------------------------------------
  */
 
+// Standard header files
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+#if defined(_CONSOLE) || defined(_WIN32) || defined(_WIN64)
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+// OpenCAEPoro header files
 #include "UtilInput.hpp"
 
 bool ReadLine(ifstream& ifs, vector<string>& result)
@@ -47,6 +68,245 @@ bool ReadLine(ifstream& ifs, vector<string>& result)
     return true;
 }
 
+/// Exact powers of ten in double
+static const OCP_DBL EXACT_POW10[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,
+                                      1e8,  1e9,  1e10, 1e11, 1e12, 1e13, 1e14, 1e15,
+                                      1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+/// Return true if c separates numbers in a line.
+static inline bool IsNumSeparator(const char& c)
+{
+    return c == ' ' || c == '\t' || c == '\r' || c == ',' || c == '\'';
+}
+
+/// Convert [begin, end) to a double, abort if it is not a number.
+//  Note: A mantissa of at most 19 digits below 2^53 with a decimal exponent in
+//  [-22, 22] is exact in double, as is the power of ten, so one multiplication or
+//  division rounds correctly and gives the same value as strtod. Other numbers are
+//  passed to strtod.
+static OCP_DBL StrToDbl(const char* begin, const char* end)
+{
+    const char* p   = begin;
+    bool        neg = false;
+    if (p < end && (*p == '+' || *p == '-')) {
+        neg = *p == '-';
+        p++;
+    }
+
+    uint64_t mant   = 0;
+    OCP_INT  exp10  = 0;
+    USI      nSig   = 0; // significant digits
+    USI      nDigit = 0; // all digits of the mantissa
+    for (; p < end && *p >= '0' && *p <= '9'; p++, nDigit++) {
+        if (mant > 0 || *p != '0') {
+            mant = mant * 10 + (*p - '0');
+            nSig++;
+        }
+    }
+    if (p < end && *p == '.') {
+        for (p++; p < end && *p >= '0' && *p <= '9'; p++, nDigit++) {
+            if (mant > 0 || *p != '0') {
+                mant = mant * 10 + (*p - '0');
+                nSig++;
+            }
+            exp10--;
+        }
+    }
+    bool fast = nDigit > 0 && nSig <= 19;
+    if (fast && p < end && (*p == 'e' || *p == 'E')) {
+        p++;
+        bool negExp = false;
+        if (p < end && (*p == '+' || *p == '-')) {
+            negExp = *p == '-';
+            p++;
+        }
+        OCP_INT e      = 0;
+        USI     nDigitE = 0;
+        for (; p < end && *p >= '0' && *p <= '9' && nDigitE < 5; p++, nDigitE++) {
+            e = e * 10 + (*p - '0');
+        }
+        fast = nDigitE > 0;
+        exp10 += negExp ? -e : e;
+    }
+
+    if (fast && p == end && mant <= (uint64_t(1) << 53) && exp10 >= -22 &&
+        exp10 <= 22) {
+        OCP_DBL val = static_cast<OCP_DBL>(mant);
+        val = exp10 < 0 ? val / EXACT_POW10[-exp10] : val * EXACT_POW10[exp10];
+        return neg ? -val : val;
+    }
+
+    // strtod needs a terminated string
+    const string str(begin, end);
+    char*        last = nullptr;
+    OCP_DBL      val  = strtod(str.c_str(), &last);
+    if (str.empty() || last != str.c_str() + str.size())
+        OCP_ABORT("Wrong number: " + str);
+    return val;
+}
+
+/// Append the numbers in the lines of [begin, end) to obj, stop at '/'.
+static const char* ScanNumbers(const char* begin, const char* end, vector<OCP_DBL>& obj)
+{
+    const char* line = begin;
+    while (line < end) {
+        const char* lineEnd = static_cast<const char*>(memchr(line, '\n', end - line));
+        if (lineEnd == nullptr) lineEnd = end;
+        const char* p = line;
+        line          = lineEnd + 1;
+
+        while (p < lineEnd && (*p == ' ' || *p == '\t' || *p == '\r')) p++;
+        if (p < lineEnd && *p == '#') continue;
+
+        while (true) {
+            while (p < lineEnd && IsNumSeparator(*p)) p++;
+            if (p == lineEnd) break;
+            if (*p == '/') return p;
+            if (*p == '-' && p + 1 < lineEnd && p[1] == '-') break;
+
+            const char* q    = p;
+            const char* star = nullptr;
+            for (; q < lineEnd && !IsNumSeparator(*q) && *q != '/'; q++) {
+                if (*q == '*') star = q;
+            }
+
+            if (star == nullptr) {
+                obj.push_back(StrToDbl(p, q));
+            } else {
+                // m*n -> n repeated m times
+                OCP_USI num = 0;
+                for (const char* c = p; c < star; c++) {
+                    if (*c < '0' || *c > '9') OCP_ABORT("Wrong number: " + string(p, q));
+                    num = num * 10 + (*c - '0');
+                }
+                if (star == p) OCP_ABORT("Wrong number: " + string(p, q));
+                obj.insert(obj.end(), num, StrToDbl(star + 1, q));
+            }
+            p = q;
+        }
+    }
+    return end;
+}
+
+/// Return the '/' which ends the array starting at begin, or end if there is none.
+//  Note: A '/' in a comment line or after "--" does not count.
+static const char* FindArrayEnd(const char* begin, const char* end)
+{
+    const char* p = begin;
+    while (p < end) {
+        const char* slash = static_cast<const char*>(memchr(p, '/', end - p));
+        if (slash == nullptr) return end;
+
+        const char* line = slash;
+        while (line > begin && line[-1] != '\n') line--;
+        const char* c = line;
+        while (c < slash && (*c == ' ' || *c == '\t' || *c == '\r')) c++;
+        bool comment = c < slash && *c == '#';
+        for (; c + 1 < slash && !comment; c++) {
+            if (c[0] == '-' && c[1] == '-') comment = true;
+        }
+        if (!comment) return slash;
+
+        p = static_cast<const char*>(memchr(slash, '\n', end - slash));
+        if (p == nullptr) return end;
+    }
+    return end;
+}
+
+OCP_ULL ReadNumbers(ifstream& ifs, MappedFile& file, vector<OCP_DBL>& obj)
+{
+    file.Map();
+    const OCP_ULL pos = ifs.tellg();
+    if (ifs.fail() || pos > file.Size()) OCP_ABORT("Wrong position in " + file.Name());
+
+    const char* begin = file.Data() + pos;
+    const char* end   = file.Data() + file.Size();
+    const char* slash = FindArrayEnd(begin, end);
+
+    // Split the array into chunks at line ends
+    OCP_USI nChunk = (slash - begin) / NUM_CHUNK_BYTES + 1;
+#ifdef _OPENMP
+    nChunk = min(nChunk, static_cast<OCP_USI>(omp_get_max_threads()));
+#else
+    nChunk = 1;
+#endif
+    vector<const char*> bound(nChunk + 1, slash);
+    bound[0] = begin;
+    for (OCP_USI c = 1; c < nChunk; c++) {
+        const char* p  = begin + (slash - begin) * c / nChunk;
+        p              = max(p, bound[c - 1]);
+        const char* nl = static_cast<const char*>(memchr(p, '\n', slash - p));
+        bound[c]       = nl == nullptr ? slash : nl + 1;
+    }
+
+    if (nChunk == 1) {
+        ScanNumbers(begin, slash, obj);
+    } else {
+        vector<vector<OCP_DBL>> part(nChunk);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static, 1)
+#endif
+        for (OCP_INT c = 0; c < static_cast<OCP_INT>(nChunk); c++) {
+            ScanNumbers(bound[c], bound[c + 1], part[c]);
+        }
+        for (auto& v : part) obj.insert(obj.end(), v.begin(), v.end());
+    }
+
+    // Move ifs behind the line of '/', as ReadLine drops the rest of it
+    const char* next = slash;
+    if (slash < end) {
+        next = static_cast<const char*>(memchr(slash, '\n', end - slash));
+        next = next == nullptr ? end : next + 1;
+    }
+    ifs.seekg(next - file.Data());
+    return next - begin;
+}
+
+MappedFile::~MappedFile()
+{
+    if (data == nullptr) return;
+#if defined(_CONSOLE) || defined(_WIN32) || defined(_WIN64)
+    UnmapViewOfFile(data);
+    CloseHandle(mapping);
+    CloseHandle(handle);
+#else
+    munmap(const_cast<char*>(data), size);
+#endif
+}
+
+void MappedFile::Map()
+{
+    if (mapped) return;
+    mapped = true;
+
+#if defined(_CONSOLE) || defined(_WIN32) || defined(_WIN64)
+    handle = CreateFileA(name.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL,
+                         OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (handle == INVALID_HANDLE_VALUE) OCP_ABORT("Failed to open " + name);
+    LARGE_INTEGER len;
+    GetFileSizeEx(handle, &len);
+    size = len.QuadPart;
+    if (size == 0) return;
+    mapping = CreateFileMappingA(handle, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (mapping == NULL) OCP_ABORT("Failed to map " + name);
+    data = static_cast<const char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+    if (data == nullptr) OCP_ABORT("Failed to map " + name);
+#else
+    const int fd = open(name.c_str(), O_RDONLY);
+    if (fd < 0) OCP_ABORT("Failed to open " + name);
+    struct stat st;
+    fstat(fd, &st);
+    size = st.st_size;
+    if (size > 0) {
+        void* p = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (p == MAP_FAILED) OCP_ABORT("Failed to map " + name);
+        data = static_cast<const char*>(p);
+    }
+    // the mapping stays valid after the file is closed
+    close(fd);
+#endif
+}
+
 void DealDefault(vector<string>& result)
 {
     vector<string> tmp;
@@ -78,4 +338,6 @@ void DealDefault(vector<string>& result)
 /*----------------------------------------------------------------------------*/
 /*  Shizhe Li           Oct/01/2021      Create file                          */
 /*  Chensong Zhang      Oct/15/2021      Format file                          */
+/*  OpenCAEPoro team    Oct/16/2026      Add ReadNumbers for grid arrays      */
+/*  OpenCAEPoro team    Oct/16/2026      Read grid arrays from mapped files   */
 /*----------------------------------------------------------------------------*/
\ No newline at end of file
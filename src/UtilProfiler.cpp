@@ -0,0 +1,157 @@
+/*! \file    UtilProfiler.cpp
+ *  \brief   Hierarchical stage profiler definition
+ *  \author  OpenCAEPoro team
+ *  \date    Oct/16/2026
+ *
+ *-----------------------------------------------------------------------------------
+ *  Copyright (C) 2021--present by the OpenCAEPoro team. All rights reserved.
+ *  Released under the terms of the GNU Lesser General Public License 3.0 or later.
+ *-----------------------------------------------------------------------------------
+ */
+
+// Standard header files
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+
+// OpenCAEPoro header files
+#include "UtilProfiler.hpp"
+
+/// Maximum number of calls kept for the Chrome trace (about 24 bytes each)
+const OCP_USI MAX_TRACE_EVENTS = 4000000;
+
+StageProfiler& StageProfiler::Get()
+{
+    static StageProfiler profiler;
+    return profiler;
+}
+
+void StageProfiler::Setup(const USI& m)
+{
+    mode = m;
+    zones.clear();
+    zones.push_back(Zone("Total", 0));
+    current = 0;
+    start.clear();
+    events.clear();
+    t0 = std::chrono::steady_clock::now();
+}
+
+OCP_DBL StageProfiler::Now() const
+{
+    auto elapsedTime = std::chrono::steady_clock::now() - t0;
+    return std::chrono::duration<double, std::micro>(elapsedTime).count();
+}
+
+void StageProfiler::Begin(const char* name)
+{
+    // names are literals, so the pointer matches in almost every call
+    USI next = 0;
+    for (auto& c : zones[current].child) {
+        if (zones[c].name == name || strcmp(zones[c].name, name) == 0) {
+            next = c;
+            break;
+        }
+    }
+    if (next == 0) {
+        next = zones.size();
+        zones[current].child.push_back(next);
+        zones.push_back(Zone(name, current));
+    }
+    current = next;
+    start.push_back(Now());
+}
+
+void StageProfiler::End()
+{
+    const OCP_DBL begin = start.back();
+    const OCP_DBL dur   = Now() - begin;
+    start.pop_back();
+
+    zones[current].time += dur / 1000;
+    zones[current].calls++;
+    if (mode == PROFILE_TRACE && events.size() < MAX_TRACE_EVENTS) {
+        events.push_back(Event{current, begin, dur});
+    }
+    current = zones[current].parent;
+}
+
+void StageProfiler::PrintInfo(ostream& out) const
+{
+    if (zones.empty()) return;
+
+    OCP_DBL total = 0;
+    for (auto& c : zones[0].child) total += zones[c].time;
+
+    out << "=========================================" << endl;
+    out << left << setw(40) << "Stage" << right << setw(12) << "Calls" << setw(14)
+        << "Time (s)" << setw(14) << "Self (s)" << setw(10) << "%" << endl;
+    for (auto& c : zones[0].child) {
+        PrintZone(out, c, 0, total);
+    }
+    out << "=========================================" << endl;
+}
+
+void StageProfiler::PrintZone(ostream& out, const USI& z, const USI& depth,
+                              const OCP_DBL& total) const
+{
+    const Zone& zone = zones[z];
+    OCP_DBL     self = zone.time;
+    for (auto& c : zone.child) self -= zones[c].time;
+
+    out << left << setw(40) << string(2 * depth, ' ') + zone.name << right << setw(12)
+        << zone.calls << fixed << setprecision(3) << setw(14) << zone.time / 1000
+        << setw(14) << self / 1000 << setw(10) << setprecision(1)
+        << (total > 0 ? 100 * zone.time / total : 0.0) << endl;
+
+    for (auto& c : zone.child) {
+        PrintZone(out, c, depth + 1, total);
+    }
+}
+
+void StageProfiler::OutputInfo(const string& dir) const
+{
+    if (!IsOn()) return;
+
+    string   fileName = dir + "Profile.out";
+    ofstream outF(fileName);
+    if (!outF.is_open()) {
+        cout << "### WARNING: Can not open " << fileName << endl;
+        return;
+    }
+    PrintInfo(outF);
+    outF.close();
+
+    if (mode != PROFILE_TRACE) return;
+
+    if (events.size() >= MAX_TRACE_EVENTS) {
+        cout << "### WARNING: Only the first " << MAX_TRACE_EVENTS
+             << " stage calls are kept in the trace!" << endl;
+    }
+
+    // Chrome trace event format, load it in chrome://tracing or Perfetto
+    fileName = dir + "Profile.json";
+    ofstream outJ(fileName);
+    if (!outJ.is_open()) {
+        cout << "### WARNING: Can not open " << fileName << endl;
+        return;
+    }
+    outJ << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    outJ << fixed << setprecision(3);
+    for (OCP_USI n = 0; n < events.size(); n++) {
+        if (n > 0) outJ << ",";
+        outJ << "\n{\"name\":\"" << zones[events[n].zone].name
+             << "\",\"ph\":\"X\",\"pid\":0,\"tid\":0,\"ts\":" << events[n].begin
+             << ",\"dur\":" << events[n].dur << "}";
+    }
+    outJ << "\n]}\n";
+    outJ.close();
+}
+
+/*----------------------------------------------------------------------------*/
+/*  Brief Change History of This File                                         */
+/*----------------------------------------------------------------------------*/
+/*  Author              Date             Actions                              */
+/*----------------------------------------------------------------------------*/
+/*  OpenCAEPoro team    Oct/16/2026      Create file                          */
+/*----------------------------------------------------------------------------*/
@@ -0,0 +1,263 @@
+/*! \file    UtilSummaryFile.cpp
+ *  \brief   Append-only binary file of the summary items of each time step
+ *  \author  OpenCAEPoro team
+ *  \date    Oct/16/2026
+ *
+ *-----------------------------------------------------------------------------------
+ *  Copyright (C) 2021--present by the OpenCAEPoro team. All rights reserved.
+ *  Released under the terms of the GNU Lesser General Public License 3.0 or later.
+ *-----------------------------------------------------------------------------------
+ */
+
+// Standard header files
+#include <cstdio>
+#include <cstring>
+#include <iomanip>
+#include <limits>
+
+// OpenCAEPoro header files
+#include "UtilError.hpp"
+#include "UtilSummaryFile.hpp"
+
+/// Leading bytes of a binary summary file, the last digit is the format version
+const char SUM_MAGIC[8] = {'O', 'C', 'P', 'S', 'U', 'M', 'B', '1'};
+
+/// Write a string with its length to a binary file.
+static void WriteString(fstream& fs, const string& s)
+{
+    const OCP_USI len = s.size();
+    fs.write(reinterpret_cast<const char*>(&len), sizeof(len));
+    fs.write(s.data(), len);
+}
+
+/// Read a string with its length from a binary file.
+static void ReadString(fstream& fs, string& s)
+{
+    OCP_USI len = 0;
+    fs.read(reinterpret_cast<char*>(&len), sizeof(len));
+    s.resize(len);
+    fs.read(&s[0], len);
+}
+
+/// Return true if two lists of items are the same.
+static bool SameItems(const vector<SumPair>& a, const vector<SumPair>& b)
+{
+    if (a.size() != b.size()) return false;
+    for (USI i = 0; i < a.size(); i++) {
+        if (a[i].Item != b[i].Item || a[i].Obj != b[i].Obj || a[i].Unit != b[i].Unit)
+            return false;
+    }
+    return true;
+}
+
+void SummaryFile::WriteHead()
+{
+    fs.write(SUM_MAGIC, sizeof(SUM_MAGIC));
+    const OCP_USI num = items.size();
+    fs.write(reinterpret_cast<const char*>(&num), sizeof(num));
+    for (auto& s : items) {
+        WriteString(fs, s.Item);
+        WriteString(fs, s.Obj);
+        WriteString(fs, s.Unit);
+    }
+    dataPos = fs.tellp();
+}
+
+void SummaryFile::Create(const string& file, const vector<SumPair>& myItems)
+{
+    items   = myItems;
+    numRows = 0;
+
+    fs.close();
+    fs.open(file, ios::out | ios::binary | ios::trunc);
+    if (!fs.is_open()) OCP_ABORT("Can not open " + file);
+    WriteHead();
+    fs.flush();
+    if (!fs) OCP_ABORT("Can not write " + file);
+}
+
+void SummaryFile::Resume(const string& file, const vector<SumPair>& myItems,
+                         const OCP_ULL& nrow)
+{
+    if (!ifstream(file).is_open()) {
+        OCP_WARNING(file + " is not found, the summary starts from the restart!");
+        Create(file, myItems);
+        return;
+    }
+
+    SummaryFile old;
+    old.Open(file);
+    if (!SameItems(old.items, myItems))
+        OCP_ABORT(file + " does not match the input file!");
+    if (old.numRows < nrow) OCP_ABORT(file + " has fewer time steps than the checkpoint!");
+
+    // Copy the rows up to the checkpoint, later ones are computed again
+    const string    tmpFile = file + ".tmp";
+    vector<OCP_DBL> row;
+    Create(tmpFile, myItems);
+    for (OCP_ULL n = 0; n < nrow; n++) {
+        old.ReadRow(n, row);
+        fs.write(reinterpret_cast<const char*>(row.data()), row.size() * sizeof(OCP_DBL));
+    }
+    numRows = nrow;
+    old.fs.close();
+    fs.close();
+    if (!fs) OCP_ABORT("Can not write " + tmpFile);
+
+#if defined(_CONSOLE) || defined(_WIN32) || defined(_WIN64)
+    // rename does not replace an existing file on Windows
+    remove(file.c_str());
+#endif
+    if (rename(tmpFile.c_str(), file.c_str()) != 0)
+        OCP_ABORT("Can not rename " + tmpFile);
+    fs.open(file, ios::in | ios::out | ios::binary | ios::ate);
+    if (!fs.is_open()) OCP_ABORT("Can not open " + file);
+}
+
+void SummaryFile::Append(const vector<OCP_DBL>& row)
+{
+    fs.write(reinterpret_cast<const char*>(row.data()), row.size() * sizeof(OCP_DBL));
+    fs.flush();
+    if (!fs) OCP_ABORT("Can not write the summary file!");
+    numRows++;
+}
+
+void SummaryFile::Open(const string& file)
+{
+    fs.close();
+    fs.open(file, ios::in | ios::binary);
+    if (!fs.is_open()) OCP_ABORT("Can not open " + file);
+
+    char magic[sizeof(SUM_MAGIC)];
+    fs.read(magic, sizeof(magic));
+    if (!fs || memcmp(magic, SUM_MAGIC, sizeof(SUM_MAGIC)) != 0)
+        OCP_ABORT(file + " is not a binary summary of this version!");
+
+    OCP_USI num = 0;
+    fs.read(reinterpret_cast<char*>(&num), sizeof(num));
+    items.resize(num);
+    for (auto& s : items) {
+        ReadString(fs, s.Item);
+        ReadString(fs, s.Obj);
+        ReadString(fs, s.Unit);
+    }
+    if (!fs || num == 0) OCP_ABORT(file + " is truncated!");
+    dataPos = fs.tellg();
+
+    fs.seekg(0, ios::end);
+    const OCP_ULL size = fs.tellg();
+    numRows            = (size - dataPos) / (num * sizeof(OCP_DBL));
+}
+
+void SummaryFile::ReadRow(const OCP_ULL& n, vector<OCP_DBL>& row)
+{
+    const OCP_USI num = items.size();
+    row.resize(num);
+    fs.seekg(dataPos + n * num * sizeof(OCP_DBL));
+    fs.read(reinterpret_cast<char*>(row.data()), num * sizeof(OCP_DBL));
+    if (!fs) OCP_ABORT("The summary file is truncated!");
+}
+
+void SummaryFile::PrintText(ostream& out, const OCP_ULL& nrow)
+{
+    USI ns  = 12;
+    USI col = 10;
+    USI row = 0;
+    USI num = items.size();
+    USI id  = 0;
+    USI ID  = 1;
+
+    vector<OCP_DBL> val;
+    while (id != num) {
+
+        out << "Row " << ++row << endl;
+
+        // Item
+        // Time
+        out << "\t" << setw(ns) << items[0].Item;
+
+        id = ID;
+        for (USI i = 1; i < col; i++) {
+            out << "\t" << setw(ns) << items[id++].Item;
+            if (id == num) break;
+        }
+        out << endl;
+
+        // Unit
+        // Time
+        out << "\t" << setw(ns) << items[0].Unit;
+
+        id = ID;
+        for (USI i = 1; i < col; i++) {
+            out << "\t" << setw(ns) << items[id++].Unit;
+            if (id == num) break;
+        }
+        out << endl;
+
+        // Obj
+        // Time
+        out << "\t" << setw(ns) << items[0].Obj;
+
+        id = ID;
+        for (USI i = 1; i < col; i++) {
+            out << "\t" << setw(ns) << items[id++].Obj;
+            if (id == num) break;
+        }
+        out << endl;
+
+        // Data
+        for (OCP_ULL l = 0; l < nrow; l++) {
+            ReadRow(l, val);
+
+            // Time
+            out << "\t" << setw(ns) << val[0];
+
+            id = ID;
+            for (USI i = 1; i < col; i++) {
+                out << "\t" << setw(ns) << val[id++];
+                if (id == num) break;
+            }
+            out << endl;
+        }
+
+        ID += (col - 1);
+
+        out << endl;
+    }
+}
+
+/// Return a name without leading and trailing blanks.
+static string Trim(const string& s)
+{
+    const size_t b = s.find_first_not_of(' ');
+    if (b == string::npos) return "";
+    return s.substr(b, s.find_last_not_of(' ') - b + 1);
+}
+
+void SummaryFile::PrintCSV(ostream& out, const OCP_ULL& nrow)
+{
+    const USI num = items.size();
+    for (USI i = 0; i < num; i++) {
+        const string obj  = Trim(items[i].Obj);
+        const string unit = Trim(items[i].Unit);
+        out << (i > 0 ? "," : "") << items[i].Item << (obj.empty() ? "" : ":" + obj)
+            << (unit.empty() ? "" : " [" + unit + "]");
+    }
+    out << "\n";
+
+    vector<OCP_DBL> val;
+    out << setprecision(numeric_limits<OCP_DBL>::max_digits10);
+    for (OCP_ULL l = 0; l < nrow; l++) {
+        ReadRow(l, val);
+        for (USI i = 0; i < num; i++) out << (i > 0 ? "," : "") << val[i];
+        out << "\n";
+    }
+}
+
+/*----------------------------------------------------------------------------*/
+/*  Brief Change History of This File                                         */
+/*----------------------------------------------------------------------------*/
+/*  Author              Date             Actions                              */
+/*----------------------------------------------------------------------------*/
+/*  OpenCAEPoro team    Oct/16/2026      Create file                          */
+/*----------------------------------------------------------------------------*/
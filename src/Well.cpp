@@ -1209,6 +1209,41 @@ void Well::ShowPerfStatus(const Bulk& myBulk) const
     }
 }
 
+void Well::SyncCheckpoint(OCPCheckpoint& ckpt)
+{
+    OCP_FUNCNAME;
+
+    ckpt.Check(numPerf, "number of perforations of " + name);
+    ckpt.Sync(lBHP);
+    ckpt.Sync(BHP);
+    ckpt.Sync(dG);
+    ckpt.Sync(ldG);
+    ckpt.Sync(qi_lbmol);
+    ckpt.Sync(factor);
+    ckpt.Sync(prodWeight);
+    ckpt.Sync(WOPR);
+    ckpt.Sync(WOPT);
+    ckpt.Sync(WGPR);
+    ckpt.Sync(WGPT);
+    ckpt.Sync(WWPR);
+    ckpt.Sync(WWPT);
+    ckpt.Sync(WGIR);
+    ckpt.Sync(WGIT);
+    ckpt.Sync(WWIR);
+    ckpt.Sync(WWIT);
+
+    for (auto& p : perf) {
+        ckpt.Sync(p.state);
+        ckpt.Sync(p.P);
+        ckpt.Sync(p.xi);
+        ckpt.Sync(p.qi_lbmol);
+        ckpt.Sync(p.transj);
+        ckpt.Sync(p.transINJ);
+        ckpt.Sync(p.qj_ft3);
+        ckpt.Sync(p.qt_ft3);
+    }
+}
+
 /////////////////////////////////////////////////////////////////////
 // IMPEC
 /////////////////////////////////////////////////////////////////////
@@ -1603,8 +1638,7 @@ void Well::AssembleMatINJ_FIM(const Bulk& myBulk, LinearSystem& myLS,
         // Insert
         bmat = dQdXpW;
         Dscalar(bsize, dt, bmat.data());
-        myLS.val[n].insert(myLS.val[n].end(), bmat.begin(), bmat.end());
-        myLS.colId[n].push_back(wId);
+        perf[p].matPtr = myLS.InsertBlock(n, wId, perf[p].matPtr, bmat.data());
 
         // Well
         switch (opt.optMode) {
@@ -1634,8 +1668,7 @@ void Well::AssembleMatINJ_FIM(const Bulk& myBulk, LinearSystem& myLS,
                 for (USI i = 0; i < nc; i++) {
                     Daxpy(ncol, 1.0, bmat.data() + (i + 1) * ncol, bmat2.data());
                 }
-                myLS.val[wId].insert(myLS.val[wId].end(), bmat2.begin(), bmat2.end());
-                myLS.colId[wId].push_back(n);
+                myLS.InsertBlock(wId, n, p, bmat2.data());
                 break;
 
             case BHP_MODE:
@@ -1651,8 +1684,7 @@ void Well::AssembleMatINJ_FIM(const Bulk& myBulk, LinearSystem& myLS,
                 // OffDiag
                 fill(bmat.begin(), bmat.end(), 0.0);
                 // Insert
-                myLS.val[wId].insert(myLS.val[wId].end(), bmat.begin(), bmat.end());
-                myLS.colId[wId].push_back(n);
+                myLS.InsertBlock(wId, n, p, bmat.data());
                 // Solution
                 // myLS.u[wId * ncol] = opt.maxBHP - BHP;
                 break;
@@ -1662,12 +1694,10 @@ void Well::AssembleMatINJ_FIM(const Bulk& myBulk, LinearSystem& myLS,
                 break;
         }
     }
-    assert(myLS.val[wId].size() == numPerf * bsize);
+    assert(myLS.IfPatternFixed() || myLS.val[wId].size() == numPerf * bsize);
     // Well self
-    myLS.colId[wId].push_back(wId);
+    myLS.InsertBlock(wId, wId, numPerf, myLS.diagVal.data() + wId * bsize);
     myLS.diagPtr[wId] = numPerf;
-    myLS.val[wId].insert(myLS.val[wId].end(), myLS.diagVal.data() + wId * bsize,
-                         myLS.diagVal.data() + wId * bsize + bsize);
 }
 
 void Well::AssembleMatPROD_FIM(const Bulk& myBulk, LinearSystem& myLS,
@@ -1766,8 +1796,7 @@ void Well::AssembleMatPROD_FIM(const Bulk& myBulk, LinearSystem& myLS,
         // Insert
         bmat = dQdXpW;
         Dscalar(bsize, dt, bmat.data());
-        myLS.val[n].insert(myLS.val[n].end(), bmat.begin(), bmat.end());
-        myLS.colId[n].push_back(wId);
+        perf[p].matPtr = myLS.InsertBlock(n, wId, perf[p].matPtr, bmat.data());
 
         // Well
         switch (opt.optMode) {
@@ -1798,8 +1827,7 @@ void Well::AssembleMatPROD_FIM(const Bulk& myBulk, LinearSystem& myLS,
                     Daxpy(ncol, prodWeight[i], bmat.data() + (i + 1) * ncol,
                           bmat2.data());
                 }
-                myLS.val[wId].insert(myLS.val[wId].end(), bmat2.begin(), bmat2.end());
-                myLS.colId[wId].push_back(n);
+                myLS.InsertBlock(wId, n, p, bmat2.data());
                 break;
 
             case BHP_MODE:
@@ -1815,8 +1843,7 @@ void Well::AssembleMatPROD_FIM(const Bulk& myBulk, LinearSystem& myLS,
                 // OffDiag
                 fill(bmat.begin(), bmat.end(), 0.0);
                 // Insert
-                myLS.val[wId].insert(myLS.val[wId].end(), bmat.begin(), bmat.end());
-                myLS.colId[wId].push_back(n);
+                myLS.InsertBlock(wId, n, p, bmat.data());
                 // Solution
                 // myLS.u[wId * ncol] = opt.minBHP - BHP;
                 break;
@@ -1826,12 +1853,10 @@ void Well::AssembleMatPROD_FIM(const Bulk& myBulk, LinearSystem& myLS,
                 break;
         }
     }
-    assert(myLS.val[wId].size() == numPerf * bsize);
+    assert(myLS.IfPatternFixed() || myLS.val[wId].size() == numPerf * bsize);
     // Well self
-    myLS.colId[wId].push_back(wId);
+    myLS.InsertBlock(wId, wId, numPerf, myLS.diagVal.data() + wId * bsize);
     myLS.diagPtr[wId] = numPerf;
-    myLS.val[wId].insert(myLS.val[wId].end(), myLS.diagVal.data() + wId * bsize,
-                         myLS.diagVal.data() + wId * bsize + bsize);
 
     // test
     // for (USI i = 0; i < bsize; i++) {